@@ -22,6 +22,7 @@
 #include "bool/kit/kit.h"
 #include "bool/bdc/bdc.h"
 #include "aig/ioa/ioa.h"
+#include "misc/util/utilTask.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -79,6 +80,7 @@ struct Aig_RMan_t_
     int           nUniqueVars;
 };
 
+// the recorded library is shared by the threads and is used under Util_TaskGlobalLock()
 static Aig_RMan_t * s_pRMan = NULL;
 
 ////////////////////////////////////////////////////////////////////////
@@ -284,14 +286,17 @@ void Aig_RManQuit()
 {
 //    extern void Ioa_WriteAiger( Aig_Man_t * pMan, char * pFileName, int fWriteSymbols, int fCompact );
     char Buffer[20];
-    if ( s_pRMan == NULL )
-        return;
-    // dump the library file
-    sprintf( Buffer, "aiglib%02d.aig", s_pRMan->nVars );
-    Ioa_WriteAiger( s_pRMan->pAig, Buffer, 0, 1 );
-    // quit the manager
-    Aig_RManStop( s_pRMan );
-    s_pRMan = NULL;
+    Util_TaskGlobalLock();
+    if ( s_pRMan != NULL )
+    {
+        // dump the library file
+        sprintf( Buffer, "aiglib%02d.aig", s_pRMan->nVars );
+        Ioa_WriteAiger( s_pRMan->pAig, Buffer, 0, 1 );
+        // quit the manager
+        Aig_RManStop( s_pRMan );
+        s_pRMan = NULL;
+    }
+    Util_TaskGlobalUnlock();
 }
 
 /**Function*************************************************************
@@ -595,7 +600,7 @@ void Aig_RManSaveOne( Aig_RMan_t * p, unsigned * pTruth, int nVars )
   SeeAlso     []
 
 ***********************************************************************/
-void Aig_RManRecord( unsigned * pTruth, int nVarsInit )
+static void Aig_RManRecord_int( unsigned * pTruth, int nVarsInit )
 {
     int fVerify = 1;
     Kit_DsdNtk_t * pNtk;
@@ -691,6 +696,12 @@ Extra_PrintBinary( stdout, s_pRMan->pTruth, 1<<nVars ); printf( "\n\n" );
 //Aig_RManPrintVarProfile( s_pRMan->pTruth, nVars, s_pRMan->pTruthTemp );
 //Extra_PrintBinary( stdout, s_pRMan->pTruth, 1<<nVars ); printf( "\n" );
 }
+void Aig_RManRecord( unsigned * pTruth, int nVarsInit )
+{
+    Util_TaskGlobalLock();
+    Aig_RManRecord_int( pTruth, nVarsInit );
+    Util_TaskGlobalUnlock();
+}
 
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
@@ -42,8 +42,18 @@
 
 ABC_NAMESPACE_HEADER_START
 
+// the wide build (ABC_USE_WIDE_GIA) stores the fanin diffs in 31 bits
+// and allows for up to 2^30 objects (the largest literal fitting into int);
+// the objects take 16 bytes instead of 12 and the representatives 8 bytes instead of 4
+#ifdef ABC_USE_WIDE_GIA
+#define GIA_NONE 0x7FFFFFFF
+#define GIA_VOID 0x3FFFFFFF
+#define GIA_MAX_OBJS (1 << 30)
+#else
 #define GIA_NONE 0x1FFFFFFF
 #define GIA_VOID 0x0FFFFFFF
+#define GIA_MAX_OBJS (1 << 29)
+#endif
 
 ////////////////////////////////////////////////////////////////////////
 ///                         BASIC TYPES                              ///
@@ -53,11 +63,16 @@ typedef struct Gia_MmFixed_t_        Gia_MmFixed_t;
 typedef struct Gia_MmFlex_t_         Gia_MmFlex_t;     
 typedef struct Gia_MmStep_t_         Gia_MmStep_t;     
 typedef struct Gia_Dat_t_            Gia_Dat_t;
+typedef struct Gia_Col_t_            Gia_Col_t;
 
 typedef struct Gia_Rpr_t_ Gia_Rpr_t;
 struct Gia_Rpr_t_
 {
+#ifdef ABC_USE_WIDE_GIA
+    unsigned       iRepr   : 31;  // representative node
+#else
     unsigned       iRepr   : 28;  // representative node
+#endif
     unsigned       fProved :  1;  // marks the proved equivalence
     unsigned       fFailed :  1;  // marks the failed equivalence
     unsigned       fColorA :  1;  // marks cone of A
@@ -76,6 +91,19 @@ struct Gia_Plc_t_
 typedef struct Gia_Obj_t_ Gia_Obj_t;
 struct Gia_Obj_t_
 {
+#ifdef ABC_USE_WIDE_GIA
+    unsigned       iDiff0 :  31;  // the diff of the first fanin
+    unsigned       fCompl0:   1;  // the complemented attribute
+
+    unsigned       iDiff1 :  31;  // the diff of the second fanin
+    unsigned       fCompl1:   1;  // the complemented attribute
+
+    unsigned       fMark0 :   1;  // first user-controlled mark
+    unsigned       fTerm  :   1;  // terminal node (CI/CO)
+    unsigned       fMark1 :   1;  // second user-controlled mark
+    unsigned       fPhase :   1;  // value under 000 pattern
+    unsigned       fUnused:  28;  // unused
+#else
     unsigned       iDiff0 :  29;  // the diff of the first fanin
     unsigned       fCompl0:   1;  // the complemented attribute
     unsigned       fMark0 :   1;  // first user-controlled mark
@@ -85,6 +113,7 @@ struct Gia_Obj_t_
     unsigned       fCompl1:   1;  // the complemented attribute
     unsigned       fMark1 :   1;  // second user-controlled mark
     unsigned       fPhase :   1;  // value under 000 pattern
+#endif
 
     unsigned       Value;         // application-specific value
 };
@@ -240,6 +269,7 @@ struct Gia_Man_t_
     Vec_Int_t      vCopiesTwo;    // intermediate copies
     Vec_Int_t      vSuppVars;     // used variables
     Vec_Int_t      vVarMap;       // used variables
+    Vec_Ptr_t *    vCols;         // named attribute columns (giaCol.c)
     Gia_Dat_t *    pUData;
     // // selfdefine toggles 
     // Vec_Int_t *    vUser;    // vector of parameters
@@ -577,6 +607,12 @@ static inline int          Gia_ObjCopy2Array( Gia_Man_t * p, int iObj )
 static inline void         Gia_ObjSetCopy2Array( Gia_Man_t * p, int iObj, int iLit )             { Vec_IntWriteEntry(&p->vCopies2, iObj, iLit);                                      }
 static inline void         Gia_ManCleanCopy2Array( Gia_Man_t * p )                               { Vec_IntFill( &p->vCopies2, Gia_ManObjNum(p), -1 );                                }
 
+extern void * Gia_ManColLease( Gia_Man_t * p, char * pName, int nBytes, int Fill );
+static inline int *        Gia_ManColLeaseInt( Gia_Man_t * p, char * pName, int Fill )          { return (int *)Gia_ManColLease( p, pName, sizeof(int), Fill );                    }
+static inline unsigned *   Gia_ManColLeaseUns( Gia_Man_t * p, char * pName, int Fill )          { return (unsigned *)Gia_ManColLease( p, pName, sizeof(unsigned), Fill );          }
+static inline word *       Gia_ManColLeaseWrd( Gia_Man_t * p, char * pName, int Fill )          { return (word *)Gia_ManColLease( p, pName, sizeof(word), Fill );                  }
+static inline char *       Gia_ManColLeaseStr( Gia_Man_t * p, char * pName, int Fill )          { return (char *)Gia_ManColLease( p, pName, sizeof(char), Fill );                  }
+
 static inline int          Gia_ObjFanin0CopyF( Gia_Man_t * p, int f, Gia_Obj_t * pObj )         { return Abc_LitNotCond(Gia_ObjCopyF(p, f, Gia_ObjFanin0(pObj)), Gia_ObjFaninC0(pObj));   }
 static inline int          Gia_ObjFanin1CopyF( Gia_Man_t * p, int f, Gia_Obj_t * pObj )         { return Abc_LitNotCond(Gia_ObjCopyF(p, f, Gia_ObjFanin1(pObj)), Gia_ObjFaninC1(pObj));   }
 static inline int          Gia_ObjFanin0CopyArray( Gia_Man_t * p, Gia_Obj_t * pObj )            { return Abc_LitNotCond(Gia_ObjCopyArray(p, Gia_ObjFaninId0p(p,pObj)), Gia_ObjFaninC0(pObj));  }
@@ -661,13 +697,19 @@ static inline word *       Gia_ObjSimObj( Gia_Man_t * p, Gia_Obj_t * pObj )    {
 
 // AIG construction
 extern void Gia_ObjAddFanout( Gia_Man_t * p, Gia_Obj_t * pObj, Gia_Obj_t * pFanout );
+// the object storage doubles up to GIA_MAX_OBJS-1; the last ID is left unused, so that the fanin diff never equals GIA_NONE
+static inline int Gia_ManObjAllocNext( int nObjsAlloc )  { return nObjsAlloc < GIA_MAX_OBJS / 2 ? 2 * nObjsAlloc : GIA_MAX_OBJS - 1; }
 static inline Gia_Obj_t * Gia_ManAppendObj( Gia_Man_t * p )  
 { 
     if ( p->nObjs == p->nObjsAlloc )
     {
-        int nObjNew = Abc_MinInt( 2 * p->nObjsAlloc, (1 << 29) );
-        if ( p->nObjs == (1 << 29) )
-            printf( "Hard limit on the number of nodes (2^29) is reached. Quitting...\n" ), exit(1);
+        int nObjNew = Gia_ManObjAllocNext( p->nObjsAlloc );
+        if ( p->nObjs == GIA_MAX_OBJS - 1 )
+#ifdef ABC_USE_WIDE_GIA
+            printf( "Hard limit on the number of nodes of the wide build (2^30) is reached. Quitting...\n" ), exit(1);
+#else
+            printf( "Hard limit on the number of nodes (2^29) is reached. The wide build (ABC_USE_WIDE_GIA) allows up to 2^30. Quitting...\n" ), exit(1);
+#endif
         assert( p->nObjs < nObjNew );
         if ( p->fVerbose )
             printf("Extending GIA object storage: %d -> %d.\n", p->nObjsAlloc, nObjNew );
@@ -1250,7 +1292,8 @@ static inline int         Gia_ObjCellId( Gia_Man_t * p, int iLit )          { re
 
 /*=== giaAiger.c ===========================================================*/
 extern int                 Gia_FileSize( char * pFileName );
-extern Gia_Man_t *         Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSimple, int fSkipStrash, int fCheck );
+extern Gia_Man_t *         Gia_AigerReadFromMemory( char * pContents, size_t nFileSize, int fGiaSimple, int fSkipStrash, int fCheck );
+extern Gia_Man_t *         Gia_AigerReadFile( char * pFileName, int fGiaSimple, int fSkipStrash, int fCheck, int fVerbose );
 extern Gia_Man_t *         Gia_AigerRead( char * pFileName, int fGiaSimple, int fSkipStrash, int fCheck );
 extern void                Gia_AigerWrite( Gia_Man_t * p, char * pFileName, int fWriteSymbols, int fCompact, int fWriteNewLine );
 extern void                Gia_DumpAiger( Gia_Man_t * p, char * pFilePrefix, int iFileNum, int nFileNumDigits );
@@ -1293,6 +1336,13 @@ extern void                Gia_ManPrintFanio( Gia_Man_t * pGia, int nNodes );
 extern Gia_Man_t *         Gia_ManDupCof( Gia_Man_t * p, int iVar );
 extern Gia_Man_t *         Gia_ManDupCofAllInt( Gia_Man_t * p, Vec_Int_t * vSigs, int fVerbose );
 extern Gia_Man_t *         Gia_ManDupCofAll( Gia_Man_t * p, int nFanLim, int fVerbose );
+/*=== giaCol.c =============================================================*/
+extern void                Gia_ManColRelease( Gia_Man_t * p, void * pData );
+extern void                Gia_ManColFill( Gia_Man_t * p, void * pData, int Fill );
+extern int                 Gia_ManColSize( Gia_Man_t * p, void * pData );
+extern int                 Gia_ManColIsLeased( Gia_Man_t * p, char * pName );
+extern void                Gia_ManColFree( Gia_Man_t * p );
+extern void                Gia_ManColPrint( Gia_Man_t * p );
 /*=== giaDecs.c ============================================================*/
 extern int                 Gia_ResubVarNum( Vec_Int_t * vResub );
 extern word                Gia_ResubToTruth6( Vec_Int_t * vResub );
@@ -1566,8 +1616,23 @@ extern void                Gia_ManCountMuxXor( Gia_Man_t * p, int * pnMuxes, int
 extern void                Gia_ManPrintMuxStats( Gia_Man_t * p );
 extern Gia_Man_t *         Gia_ManDupMuxes( Gia_Man_t * p, int Limit );
 extern Gia_Man_t *         Gia_ManDupNoMuxes( Gia_Man_t * p, int fSkipBufs );
+/*=== giaOrch.c ===========================================================*/
+extern Vec_Int_t *         Gia_ManOrchNtkIds( Gia_Man_t * p );
+extern Vec_Int_t *         Gia_ManOrchReadPolicy( char * pFileName, int nObjs, Vec_Int_t * vNtkIds );
+extern void                Gia_ManOrchWriteDecisions( char * pFileName, Vec_Int_t * vDecisions, Vec_Int_t * vNtkIds );
+extern void                Gia_ManOrchWriteGains( char * pFileName, Vec_Wec_t * vGains );
+extern Vec_Wec_t *         Gia_ManOrchGains( Gia_Man_t * p, int nCutMax, int fUpdateLevel, int nProcs, int fVerbose );
+extern Gia_Man_t *         Gia_ManOrchestrate( Gia_Man_t * p, int nCutMax, int fUpdateLevel, int fUseZerosRw, int fUseZerosRf, Vec_Wec_t * vGains, char * pPolicyFile, char * pDecisionFile, char * pCacheFile, int fNtkIds, int fVerbose );
 /*=== giaPat.c ===========================================================*/
 extern void                Gia_SatVerifyPattern( Gia_Man_t * p, Gia_Obj_t * pRoot, Vec_Int_t * vCex, Vec_Int_t * vVisit );
+/*=== giaReorder.c ===========================================================*/
+#define GIA_REORDER_DFS      0    // DFS visiting the deeper fanin first
+#define GIA_REORDER_CLUSTER  1    // DFS followed by the ready fanouts
+#define GIA_REORDER_LEVEL    2    // levels sorted by the position of the last fanin
+extern double              Gia_ManReorderFaninDist( Gia_Man_t * p );
+extern Vec_Int_t *         Gia_ManReorderDfs( Gia_Man_t * p, int fCluster );
+extern Vec_Int_t *         Gia_ManReorderLevel( Gia_Man_t * p );
+extern Gia_Man_t *         Gia_ManReorder( Gia_Man_t * p, int Type, int fVerbose );
 /*=== giaRetime.c ===========================================================*/
 extern Gia_Man_t *         Gia_ManRetimeForward( Gia_Man_t * p, int nMaxIters, int fVerbose );
 /*=== giaSat.c ============================================================*/
@@ -1587,6 +1652,10 @@ extern void                Gia_ColorMap( char* pFileName);
 /*=== giaShrink.c ===========================================================*/
 extern Gia_Man_t *         Gia_ManMapShrink4( Gia_Man_t * p, int fKeepLevel, int fVerbose );
 extern Gia_Man_t *         Gia_ManMapShrink6( Gia_Man_t * p, int nFanoutMax, int fKeepLevel, int fVerbose );
+/*=== giaSnap.c ============================================================*/
+extern int                 Gia_ManSnapWrite( Gia_Man_t * p, char * pFileName, int fVerbose );
+extern int                 Gia_ManSnapIsSnapshot( char * pContents, size_t nSize );
+extern Gia_Man_t *         Gia_ManSnapReadFromMemory( char * pContents, size_t nSize );
 /*=== giaSopb.c ============================================================*/
 extern Gia_Man_t *         Gia_ManExtractWindow( Gia_Man_t * p, int LevelMax, int nTimeWindow, int fVerbose );
 extern Gia_Man_t *         Gia_ManPerformSopBalanceWin( Gia_Man_t * p, int LevelMax, int nTimeWindow, int nCutNum, int nRelaxRatio, int fVerbose );
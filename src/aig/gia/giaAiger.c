@@ -23,6 +23,13 @@
 #include "misc/tim/tim.h"
 #include "base/main/main.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 #define XAIG_VERBOSE 0
@@ -173,12 +180,13 @@ Vec_Str_t * Gia_AigerWriteLiterals( Vec_Int_t * vLits )
   SeeAlso     []
 
 ***********************************************************************/
-Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSimple, int fSkipStrash, int fCheck )
+Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, size_t nFileSize, int fGiaSimple, int fSkipStrash, int fCheck )
 {
     Gia_Man_t * pNew, * pTemp;
     Vec_Ptr_t * vNamesIn = NULL, * vNamesOut = NULL, * vNamesRegIn = NULL, * vNamesRegOut = NULL, * vNamesNode = NULL;
     Vec_Int_t * vLits = NULL, * vPoTypes = NULL;
-    Vec_Int_t * vNodes, * vDrivers, * vInits = NULL;
+    Vec_Int_t * vDrivers, * vInits = NULL;
+    Gia_Obj_t * pObjs;
     int iObj, iNode0, iNode1, fHieOnly = 0;
     int nTotal, nInputs, nOutputs, nLatches, nAnds, i;
     int nBad = 0, nConstr = 0, nJust = 0, nFair = 0;
@@ -253,20 +261,33 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
             fprintf( stdout, "Warning: The last %d outputs are interpreted as constraints.\n", nConstr );
     }
 
+    if ( (word)nTotal + nLatches + nOutputs + 1 >= (word)GIA_MAX_OBJS )
+    {
+#ifdef ABC_USE_WIDE_GIA
+        fprintf( stdout, "The number of objects exceeds the limit of the wide build (2^30).\n" );
+#else
+        fprintf( stdout, "The number of objects exceeds the limit (2^29). The wide build (ABC_USE_WIDE_GIA) reads up to 2^30 objects.\n" );
+#endif
+        return NULL;
+    }
+
     // allocate the empty AIG
     pNew = Gia_ManStart( nTotal + nLatches + nOutputs + 1 );
     pNew->nConstrs = nConstr;
     pNew->fGiaSimple = fGiaSimple;
 
-    // prepare the array of nodes
-    vNodes = Vec_IntAlloc( 1 + nTotal );
-    Vec_IntPush( vNodes, 0 );
+    // the object array is allocated for the whole AIG and never moves while reading;
+    // the literal of the i-th AIGER variable is kept in the Value of the i-th object 
+    // (the objects are created in the topological order and never come ahead of the variables)
+    pObjs = pNew->pObjs;
+    assert( pNew->nObjsAlloc > nTotal );
+    pObjs[0].Value = 0;
 
     // create the PIs
     for ( i = 0; i < nInputs + nLatches; i++ )
     {
         iObj = Gia_ManAppendCi(pNew);    
-        Vec_IntPush( vNodes, iObj );
+        pObjs[i+1].Value = iObj;
     }
 
     // remember the beginning of latch/PO literals
@@ -292,19 +313,20 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
         uLit1 = uLit  - Gia_AigerReadUnsigned( &pCur );
         uLit0 = uLit1 - Gia_AigerReadUnsigned( &pCur );
 //        assert( uLit1 > uLit0 );
-        iNode0 = Abc_LitNotCond( Vec_IntEntry(vNodes, uLit0 >> 1), uLit0 & 1 );
-        iNode1 = Abc_LitNotCond( Vec_IntEntry(vNodes, uLit1 >> 1), uLit1 & 1 );
-        assert( Vec_IntSize(vNodes) == i + 1 + nInputs + nLatches );
+        iNode0 = Abc_LitNotCond( pObjs[uLit0 >> 1].Value, uLit0 & 1 );
+        iNode1 = Abc_LitNotCond( pObjs[uLit1 >> 1].Value, uLit1 & 1 );
         if ( !fGiaSimple && fSkipStrash )
         {
             if ( iNode0 == iNode1 )
-                Vec_IntPush( vNodes, Gia_ManAppendBuf(pNew, iNode0) );
+                iObj = Gia_ManAppendBuf(pNew, iNode0);
             else
-                Vec_IntPush( vNodes, Gia_ManAppendAnd(pNew, iNode0, iNode1) );
+                iObj = Gia_ManAppendAnd(pNew, iNode0, iNode1);
         }
         else
-            Vec_IntPush( vNodes, Gia_ManHashAnd(pNew, iNode0, iNode1) );
+            iObj = Gia_ManHashAnd(pNew, iNode0, iNode1);
+        pObjs[uLit >> 1].Value = iObj;
     }
+    assert( pObjs == pNew->pObjs );
     if ( !fGiaSimple && !fSkipStrash )
         Gia_ManHashStop( pNew );
 
@@ -333,14 +355,14 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
                 pCur++;
                 Vec_IntPush( vInits, 0 );
             }
-            iNode0 = Abc_LitNotCond( Vec_IntEntry(vNodes, uLit0 >> 1), (uLit0 & 1) );
+            iNode0 = Abc_LitNotCond( pObjs[uLit0 >> 1].Value, (uLit0 & 1) );
             Vec_IntPush( vDrivers, iNode0 );
         }
         // read the PO driver literals
         for ( i = 0; i < nOutputs; i++ )
         {
             uLit0 = atoi( (char *)pCur );   while ( *pCur++ != '\n' );
-            iNode0 = Abc_LitNotCond( Vec_IntEntry(vNodes, uLit0 >> 1), (uLit0 & 1) );
+            iNode0 = Abc_LitNotCond( pObjs[uLit0 >> 1].Value, (uLit0 & 1) );
             Vec_IntPush( vDrivers, iNode0 );
         }
 
@@ -351,18 +373,21 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
         for ( i = 0; i < nLatches; i++ )
         {
             uLit0 = Vec_IntEntry( vLits, i );
-            iNode0 = Abc_LitNotCond( Vec_IntEntry(vNodes, uLit0 >> 1), (uLit0 & 1) );
+            iNode0 = Abc_LitNotCond( pObjs[uLit0 >> 1].Value, (uLit0 & 1) );
             Vec_IntPush( vDrivers, iNode0 );
         }
         // read the PO driver literals
         for ( i = 0; i < nOutputs; i++ )
         {
             uLit0 = Vec_IntEntry( vLits, i+nLatches );
-            iNode0 = Abc_LitNotCond( Vec_IntEntry(vNodes, uLit0 >> 1), (uLit0 & 1) );
+            iNode0 = Abc_LitNotCond( pObjs[uLit0 >> 1].Value, (uLit0 & 1) );
             Vec_IntPush( vDrivers, iNode0 );
         }
         Vec_IntFree( vLits );
     }
+    // the variable map is not needed any more
+    for ( i = 0; i <= nTotal; i++ )
+        pObjs[i].Value = 0;
 
     // create the POs
     for ( i = 0; i < nOutputs; i++ )
@@ -620,12 +645,11 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
             // read extra AIG
             if ( *pCur == 'a' )
             {
+                int nSize;
                 pCur++;
-                vStr = Vec_StrStart( Gia_AigerReadInt(pCur) );             pCur += 4;
-                memcpy( Vec_StrArray(vStr), pCur, (size_t)Vec_StrSize(vStr) );
-                pCur += Vec_StrSize(vStr);
-                pNew->pAigExtra = Gia_AigerReadFromMemory( Vec_StrArray(vStr), Vec_StrSize(vStr), 0, 0, 0 );
-                Vec_StrFree( vStr );
+                nSize = Gia_AigerReadInt(pCur);                            pCur += 4;
+                pNew->pAigExtra = Gia_AigerReadFromMemory( (char *)pCur, (size_t)nSize, 0, 0, 0 );
+                pCur += nSize;
                 if ( fVerbose ) printf( "Finished reading extension \"a\".\n" );
             }
             // read number of constraints
@@ -723,9 +747,17 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
                 pCur++;
                 nSize = Gia_AigerReadInt(pCur);
                 pCurTemp = pCur + nSize + 4;           pCur += 4;
-                pNew->vMapping = Gia_AigerReadMappingDoc( &pCur, Gia_ManObjNum(pNew) );
-                assert( pCur == pCurTemp );
-                if ( fVerbose ) printf( "Finished reading extension \"m\".\n" );
+                if ( fGiaSimple || fSkipStrash )
+                {
+                    pNew->vMapping = Gia_AigerReadMappingDoc( &pCur, Gia_ManObjNum(pNew) );
+                    assert( pCur == pCurTemp );
+                    if ( fVerbose ) printf( "Finished reading extension \"m\".\n" );
+                }
+                else // the mapping does not survive structural hashing
+                {
+                    Abc_Print( 0, "Structural hashing enabled while reading AIGER invalidated the mapping.  Consider using \"&r -s\".\n" );
+                    pCur = pCurTemp;
+                }
             }
             // read model name
             else if ( *pCur == 'n' )
@@ -856,27 +888,25 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
                 int i, nPairs;
                 pCur++;
                 pCurTemp = pCur + Gia_AigerReadInt(pCur) + 4;           pCur += 4;
+                if ( !fSkipStrash )
+                {
+                    printf( "Cannot read extension \"w\" because AIG is rehashed. Use \"&r -s <file.aig>\".\n" );
+                    pCur = pCurTemp;
+                    continue;
+                }
                 nPairs = Gia_AigerReadInt(pCur);                        pCur += 4;
                 vPairs = Vec_IntAlloc( 2*nPairs );
                 for ( i = 0; i < 2*nPairs; i++ )
                     Vec_IntPush( vPairs, Gia_AigerReadInt(pCur) ),      pCur += 4;
                 assert( pCur == pCurTemp );
-                if ( fSkipStrash )
-                {
-                    Gia_ManEdgeFromArray( pNew, vPairs );
-                    if ( fVerbose ) printf( "Finished reading extension \"w\".\n" );
-                }
-                else
-                    printf( "Cannot read extension \"w\" because AIG is rehashed. Use \"&r -s <file.aig>\".\n" );
+                Gia_ManEdgeFromArray( pNew, vPairs );
+                if ( fVerbose ) printf( "Finished reading extension \"w\".\n" );
                 Vec_IntFree( vPairs );
             }
             else break;
         }
     }
 
-    // skipping the comments
-    Vec_IntFree( vNodes );
-
     // update polarity of the additional outputs
     if ( nBad || nConstr || nJust || nFair )
         Gia_ManInvertConstraints( pNew );
@@ -1000,35 +1030,107 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fGiaSi
     return pNew;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Maps the file into memory.]
+
+  Description [The pages are private and writable because the reader 
+  terminates the names in place; only the touched pages are copied.
+  Returns NULL if the file cannot be read.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static char * Gia_AigerMapFile( char * pFileName, size_t * pnFileSize )
+{
+    char * pContents;
+#ifndef _WIN32
+    struct stat st;
+    int fd = open( pFileName, O_RDONLY );
+    if ( fd < 0 )
+    {
+        printf( "Gia_AigerRead(): The file is unavailable (absent or open).\n" );
+        return NULL;
+    }
+    if ( fstat( fd, &st ) != 0 || st.st_size == 0 )
+    {
+        printf( "Gia_AigerRead(): The file \"%s\" is empty.\n", pFileName );
+        close( fd );
+        return NULL;
+    }
+    *pnFileSize = (size_t)st.st_size;
+    pContents = (char *)mmap( NULL, *pnFileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if ( pContents == MAP_FAILED )
+    {
+        printf( "Gia_AigerRead(): Cannot map file \"%s\" into memory.\n", pFileName );
+        return NULL;
+    }
+    // the file is decoded in one pass from the beginning to the end
+    madvise( pContents, *pnFileSize, MADV_SEQUENTIAL );
+#else
+    FILE * pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+    {
+        printf( "Gia_AigerRead(): The file is unavailable (absent or open).\n" );
+        return NULL;
+    }
+    fseek( pFile, 0, SEEK_END );
+    *pnFileSize = (size_t)ftell( pFile );
+    rewind( pFile );
+    pContents = ABC_ALLOC( char, *pnFileSize );
+    if ( fread( pContents, *pnFileSize, 1, pFile ) != 1 )
+        ABC_FREE( pContents );
+    fclose( pFile );
+#endif
+    return pContents;
+}
+static void Gia_AigerUnmapFile( char * pContents, size_t nFileSize )
+{
+#ifndef _WIN32
+    munmap( pContents, nFileSize );
+#else
+    ABC_FREE( pContents );
+#endif
+}
+
 /**Function*************************************************************
 
   Synopsis    [Reads the AIG in the binary AIGER format.]
 
-  Description []
+  Description [The file is mapped into memory and decoded in place.
+  The GIA snapshots written by "&w -z" are recognized and loaded too.
+  The verbose mode reports the load throughput.]
   
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Gia_Man_t * Gia_AigerRead( char * pFileName, int fGiaSimple, int fSkipStrash, int fCheck )
+Gia_Man_t * Gia_AigerReadFile( char * pFileName, int fGiaSimple, int fSkipStrash, int fCheck, int fVerbose )
 {
-    FILE * pFile;
     Gia_Man_t * pNew;
     char * pName, * pContents;
-    int nFileSize;
-    int RetValue;
+    size_t nFileSize = 0;
+    abctime clk = Abc_Clock();
 
-    // read the file into the buffer
+    // map the file into memory
     Gia_FileFixName( pFileName );
-    nFileSize = Gia_FileSize( pFileName );
-    pFile = fopen( pFileName, "rb" );
-    pContents = ABC_ALLOC( char, nFileSize );
-    RetValue = fread( pContents, nFileSize, 1, pFile );
-    fclose( pFile );
+    pContents = Gia_AigerMapFile( pFileName, &nFileSize );
+    if ( pContents == NULL )
+        return NULL;
 
-    pNew = Gia_AigerReadFromMemory( pContents, nFileSize, fGiaSimple, fSkipStrash, fCheck );
-    ABC_FREE( pContents );
+    if ( Gia_ManSnapIsSnapshot( pContents, nFileSize ) )
+    {
+        pNew = Gia_ManSnapReadFromMemory( pContents, nFileSize );
+        if ( pNew )
+            ABC_FREE( pNew->pSpec );
+    }
+    else
+        pNew = Gia_AigerReadFromMemory( pContents, nFileSize, fGiaSimple, fSkipStrash, fCheck );
+    Gia_AigerUnmapFile( pContents, nFileSize );
     if ( pNew )
     {
         ABC_FREE( pNew->pName );
@@ -1039,8 +1141,18 @@ Gia_Man_t * Gia_AigerRead( char * pFileName, int fGiaSimple, int fSkipStrash, in
         assert( pNew->pSpec == NULL );
         pNew->pSpec = Abc_UtilStrsav( pFileName );
     }
+    if ( fVerbose )
+    {
+        double Time = 1.0*(Abc_Clock() - clk)/CLOCKS_PER_SEC;
+        double nMBytes = 1.0*nFileSize/(1<<20);
+        printf( "Read %.2f MB in %.2f sec (%.2f MB/s).\n", nMBytes, Time, Time > 0 ? nMBytes/Time : 0.0 );
+    }
     return pNew;
 }
+Gia_Man_t * Gia_AigerRead( char * pFileName, int fGiaSimple, int fSkipStrash, int fCheck )
+{
+    return Gia_AigerReadFile( pFileName, fGiaSimple, fSkipStrash, fCheck, 0 );
+}
 
 
 
@@ -1231,6 +1343,10 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         printf( "AIG cannot be written because it has no POs.\n" );
         return;
     }
+#ifdef ABC_USE_WIDE_GIA
+    if ( Gia_ManObjNum(pInit) >= (1 << 29) )
+        printf( "Warning: The AIG has more than 2^29 objects (the wide build allows up to 2^30); the file can be read only by the wide build.\n" );
+#endif
 
     // start the output stream
     pFile = fopen( pFileName, "wb" );
@@ -1286,9 +1402,9 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
     }
     Gia_ManInvertConstraints( p );
 
-    // write the nodes into the buffer
+    // write the nodes through the buffer, which is flushed when full
     Pos = 0;
-    nBufferSize = 8 * Gia_ManAndNum(p) + 100; // skeptically assuming 3 chars per one AIG edge
+    nBufferSize = 8 * Abc_MinInt( Gia_ManAndNum(p), (1 << 21) ) + 100; // skeptically assuming 3 chars per one AIG edge
     pBuffer = ABC_ALLOC( unsigned char, nBufferSize );
     Gia_ManForEachAnd( p, pObj, i )
     {
@@ -1300,11 +1416,8 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         Pos = Gia_AigerWriteUnsignedBuffer( pBuffer, Pos, uLit1 - uLit0 );
         if ( Pos > nBufferSize - 10 )
         {
-            printf( "Gia_AigerWrite(): AIGER generation has failed because the allocated buffer is too small.\n" );
-            fclose( pFile );
-            if ( p != pInit )
-                Gia_ManStop( p );
-            return;
+            fwrite( pBuffer, 1, Pos, pFile );
+            Pos = 0;
         }
     }
     assert( Pos < nBufferSize );
@@ -92,6 +92,37 @@ void Gia_ManFrontTransform( Gia_Man_t * p )
     ABC_FREE( pFrontToId );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Counts the references of the objects.]
+
+  Description [The counters are kept in a column of the manager, so that
+  pObj->Value is not changed. The column should be released by the caller.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static unsigned * Gia_ManFrontRefs( Gia_Man_t * p )
+{
+    Gia_Obj_t * pObj;
+    unsigned * pRefs = Gia_ManColLeaseUns( p, "FrontRefs", 0 );
+    int i;
+    Gia_ManForEachObj( p, pObj, i )
+    {
+        if ( Gia_ObjIsAnd(pObj) )
+        {
+            pRefs[Gia_ObjFaninId0(pObj, i)]++;
+            if ( !Gia_ObjIsBuf(pObj) )
+                pRefs[Gia_ObjFaninId1(pObj, i)]++;
+        }
+        else if ( Gia_ObjIsCo(pObj) )
+            pRefs[Gia_ObjFaninId0(pObj, i)]++;
+    }
+    return pRefs;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Determine the frontier.]
@@ -107,28 +138,29 @@ int Gia_ManCrossCutSimple( Gia_Man_t * p )
 {
     Gia_Obj_t * pObj;
     int i, nCutCur = 0, nCutMax = 0;
-    Gia_ManCreateValueRefs( p );
+    unsigned * pRefs = Gia_ManFrontRefs( p );
     Gia_ManForEachObj( p, pObj, i )
     {
-        if ( pObj->Value )
+        if ( pRefs[i] )
             nCutCur++;
         if ( nCutMax < nCutCur )
             nCutMax = nCutCur;
         if ( Gia_ObjIsAnd(pObj) )
         {
-            if ( --Gia_ObjFanin0(pObj)->Value == 0 )
+            if ( --pRefs[Gia_ObjFaninId0(pObj, i)] == 0 )
                 nCutCur--;
-            if ( --Gia_ObjFanin1(pObj)->Value == 0 )
+            if ( --pRefs[Gia_ObjFaninId1(pObj, i)] == 0 )
                 nCutCur--;
         }
         else if ( Gia_ObjIsCo(pObj) )
         {
-            if ( --Gia_ObjFanin0(pObj)->Value == 0 )
+            if ( --pRefs[Gia_ObjFaninId0(pObj, i)] == 0 )
                 nCutCur--;
         }
     }
 //    Gia_ManForEachObj( p, pObj, i )
-//        assert( pObj->Value == 0 );
+//        assert( pRefs[i] == 0 );
+    Gia_ManColRelease( p, pRefs );
     return nCutMax;
 }
 
@@ -149,11 +181,12 @@ Gia_Man_t * Gia_ManFront( Gia_Man_t * p )
     Gia_Man_t * pNew;
     Gia_Obj_t * pObj, * pFanin0New, * pFanin1New, * pObjNew;
     char * pFront;    // places used for the frontier
+    unsigned * pRefs; // the references of the objects
     int i, iLit, nCrossCut = 0, nCrossCutMax = 0;
     int nCrossCutMaxInit = Gia_ManCrossCutSimple( p );
     int iFront = 0;//, clk = Abc_Clock(); 
     // set references for all objects
-    Gia_ManCreateValueRefs( p );
+    pRefs = Gia_ManFrontRefs( p );
     // start the new manager
     pNew = Gia_ManStart( Gia_ManObjNum(p) );
     pNew->pName = Abc_UtilStrsav( p->pName );
@@ -163,7 +196,7 @@ Gia_Man_t * Gia_ManFront( Gia_Man_t * p )
     pFront = ABC_CALLOC( char, pNew->nFront );
     // add constant node
     Gia_ManConst0(pNew)->Value = iFront = Gia_ManFrontFindNext( pFront, pNew->nFront, iFront );
-    if ( Gia_ObjValue(Gia_ManConst0(p)) == 0 )
+    if ( pRefs[0] == 0 )
         pFront[iFront] = 0;
     else
         nCrossCut = 1;
@@ -172,7 +205,7 @@ Gia_Man_t * Gia_ManFront( Gia_Man_t * p )
     {
         if ( Gia_ObjIsCi(pObj) )
         {
-            if ( Gia_ObjValue(pObj) && nCrossCutMax < ++nCrossCut )
+            if ( pRefs[i] && nCrossCutMax < ++nCrossCut )
                 nCrossCutMax = nCrossCut;
             // create new node
             iLit = Gia_ManAppendCi( pNew );
@@ -180,13 +213,13 @@ Gia_Man_t * Gia_ManFront( Gia_Man_t * p )
             assert( Gia_ObjId(pNew, pObjNew) == Gia_ObjId(p, pObj) );
             pObjNew->Value = iFront = Gia_ManFrontFindNext( pFront, pNew->nFront, iFront );
             // handle CIs without fanout
-            if ( Gia_ObjValue(pObj) == 0 )
+            if ( pRefs[i] == 0 )
                 pFront[iFront] = 0;
             continue;
         }
         if ( Gia_ObjIsCo(pObj) )
         {
-            assert( Gia_ObjValue(pObj) == 0 );
+            assert( pRefs[i] == 0 );
             // create new node
             iLit = Gia_ManAppendCo( pNew, 0 );
             pObjNew = Gia_ManObj( pNew, Abc_Lit2Var(iLit) );
@@ -198,14 +231,14 @@ Gia_Man_t * Gia_ManFront( Gia_Man_t * p )
             pObjNew->iDiff0 = pFanin0New->Value;
             pObjNew->fCompl0 = Gia_ObjFaninC0(pObj);
             // deref the fanin
-            if ( --Gia_ObjFanin0(pObj)->Value == 0 )
+            if ( --pRefs[Gia_ObjFaninId0(pObj, i)] == 0 )
             {
                 pFront[pFanin0New->Value] = 0;
                 nCrossCut--;
             }
             continue;
         }
-        if ( Gia_ObjValue(pObj) && nCrossCutMax < ++nCrossCut )
+        if ( pRefs[i] && nCrossCutMax < ++nCrossCut )
             nCrossCutMax = nCrossCut;
         // create new node
         pObjNew = Gia_ManAppendObj( pNew );
@@ -223,18 +256,18 @@ Gia_Man_t * Gia_ManFront( Gia_Man_t * p )
         // assign the frontier number
         pObjNew->Value = iFront = Gia_ManFrontFindNext( pFront, pNew->nFront, iFront );
         // deref the fanins
-        if ( --Gia_ObjFanin0(pObj)->Value == 0 )
+        if ( --pRefs[Gia_ObjFaninId0(pObj, i)] == 0 )
         {
             pFront[pFanin0New->Value] = 0;
             nCrossCut--;
         }
-        if ( --Gia_ObjFanin1(pObj)->Value == 0 )
+        if ( --pRefs[Gia_ObjFaninId1(pObj, i)] == 0 )
         {
             pFront[pFanin1New->Value] = 0;
             nCrossCut--;
         }
         // handle nodes without fanout (choice nodes)
-        if ( Gia_ObjValue(pObj) == 0 )
+        if ( pRefs[i] == 0 )
             pFront[iFront] = 0;
     }
     assert( pNew->nObjs == p->nObjs );
@@ -242,6 +275,7 @@ Gia_Man_t * Gia_ManFront( Gia_Man_t * p )
     for ( i = 0; i < pNew->nFront; i++ )
         assert( pFront[i] == 0 );
     ABC_FREE( pFront );
+    Gia_ManColRelease( p, pRefs );
 //printf( "Crosscut = %6d. Frontier = %6d. ", nCrossCutMaxInit, pNew->nFront );
 //ABC_PRT( "Time", Abc_Clock() - clk );
     Gia_ManSetRegNum( pNew, Gia_ManRegNum(p) );
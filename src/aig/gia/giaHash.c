@@ -44,9 +44,9 @@ ABC_NAMESPACE_IMPL_START
 ***********************************************************************/
 static inline int Gia_ManHashOne( int iLit0, int iLit1, int iLitC, int TableSize ) 
 {
-    unsigned Key = iLitC * 2011;
-    Key += Abc_Lit2Var(iLit0) * 7937;
-    Key += Abc_Lit2Var(iLit1) * 2971;
+    unsigned Key = (unsigned)iLitC * 2011;
+    Key += (unsigned)Abc_Lit2Var(iLit0) * 7937;
+    Key += (unsigned)Abc_Lit2Var(iLit1) * 2971;
     Key += Abc_LitIsCompl(iLit0) * 911;
     Key += Abc_LitIsCompl(iLit1) * 353;
     return (int)(Key % TableSize);
@@ -478,7 +478,7 @@ int Gia_ManHashXorReal( Gia_Man_t * p, int iLit0, int iLit1 )
         return 0;
     if ( iLit0 == Abc_LitNot(iLit1) )
         return 1;
-    if ( (p->nObjs & 0xFF) == 0 && 2 * Vec_IntSize(&p->vHTable) < Gia_ManAndNum(p) )
+    if ( (p->nObjs & 0xFF) == 0 && (word)2 * Vec_IntSize(&p->vHTable) < (word)Gia_ManAndNum(p) )
         Gia_ManHashResize( p );
     if ( iLit0 < iLit1 )
         iLit0 ^= iLit1, iLit1 ^= iLit0, iLit0 ^= iLit1;
@@ -588,7 +588,7 @@ int Gia_ManHashAnd( Gia_Man_t * p, int iLit0, int iLit1 )
         assert( Vec_IntSize(&p->vHTable) == 0 );
         return Gia_ManAppendAnd( p, iLit0, iLit1 );
     }
-    if ( (p->nObjs & 0xFF) == 0 && 2 * Vec_IntSize(&p->vHTable) < Gia_ManAndNum(p) )
+    if ( (p->nObjs & 0xFF) == 0 && (word)2 * Vec_IntSize(&p->vHTable) < (word)Gia_ManAndNum(p) )
         Gia_ManHashResize( p );
     if ( p->fAddStrash )
     {
@@ -395,7 +395,7 @@ static inline Lf_Cut_t * Lf_ManFetchSet( Lf_Man_t * p, int i )
 }
 static inline int Lf_ManPrepareSet( Lf_Man_t * p, int iObj, int Index, Lf_Cut_t ** ppCutSet )
 {
-    static word CutTemp[3][LF_CUT_WORDS];
+    static ABC_THREAD_LOCAL word CutTemp[3][LF_CUT_WORDS];
     if ( Vec_IntEntry(&p->vOffsets, iObj) == -1 )
         return Lf_CutCreateUnit( (*ppCutSet = (Lf_Cut_t *)CutTemp[Index]), iObj );
     {
@@ -589,12 +589,12 @@ static inline Lf_Cut_t * Lf_MemLoadMuxCut( Lf_Man_t * p, int iObj, Lf_Cut_t * pC
 }
 static inline Lf_Cut_t * Lf_ObjCutMux( Lf_Man_t * p, int i )
 {
-    static word CutSet[LF_CUT_WORDS];
+    static ABC_THREAD_LOCAL word CutSet[LF_CUT_WORDS];
     return Lf_MemLoadMuxCut( p, i, (Lf_Cut_t *)CutSet );
 }
 static inline Lf_Cut_t * Lf_ObjCutBest( Lf_Man_t * p, int i )
 {
-    static word CutSet[LF_CUT_WORDS];
+    static ABC_THREAD_LOCAL word CutSet[LF_CUT_WORDS];
     Lf_Bst_t * pBest = Lf_ObjReadBest( p, i );
     Lf_Cut_t * pCut = (Lf_Cut_t *)CutSet;
     int Index = Lf_BestCutIndex( pBest );
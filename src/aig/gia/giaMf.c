@@ -116,8 +116,8 @@ extern int Kit_TruthToGia( Gia_Man_t * pMan, unsigned * pTruth, int nVars, Vec_I
   SeeAlso     []
 
 ***********************************************************************/
-static int s_nCalls = 0;
-static Vec_Mem_t * s_vTtMem = NULL;
+static ABC_THREAD_LOCAL int s_nCalls = 0;
+static ABC_THREAD_LOCAL Vec_Mem_t * s_vTtMem = NULL;
 int Mf_ManTruthCanonicize( word * t, int nVars )
 {
     word Temp, Best = *t;
@@ -0,0 +1,1890 @@
+/**CFile****************************************************************
+
+  FileName    [giaOrch.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Scalable AIG package.]
+
+  Synopsis    [Orchestration of rewriting, resubstitution and refactoring.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: giaOrch.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "gia.h"
+#include "bool/bdc/bdc.h"
+#include "bool/kit/kit.h"
+#include "misc/util/utilTruth.h"
+#include "misc/vec/vecHsh.h"
+
+#include "misc/util/utilTask.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define GIA_ORCH_RW      0     // rewriting (bi-decomposition of the cut function)
+#define GIA_ORCH_RS      1     // resubstitution with 0 or 1 new nodes
+#define GIA_ORCH_RF      2     // refactoring (factored ISOP of the cut function)
+#define GIA_ORCH_OPS     3
+
+#define GIA_ORCH_DIV_MAX 150   // the largest number of resub divisors
+#define GIA_ORCH_CONE_MAX 100  // the largest number of internal nodes in the cut
+#define GIA_ORCH_CUT_NUM 32    // the largest number of 4-input cuts of a node
+#define GIA_ORCH_STRUCTS 20    // the largest number of library structures of an NPN class
+#define GIA_ORCH_CHUNK   256   // the number of objects given to a thread at a time
+#define GIA_ORCH_CACHE_VER 3   // the version of the window cache file
+
+extern void Dar_LibPrepare( int nSubgraphs );
+extern int  Dar_LibStructs( unsigned uTruth, Vec_Int_t * vStructs );
+
+// the operator order for each policy, as in Abc_NtkOrchSA()
+static int s_OrchOrders[6][3] = {
+    { GIA_ORCH_RW, GIA_ORCH_RS, GIA_ORCH_RF },
+    { GIA_ORCH_RW, GIA_ORCH_RF, GIA_ORCH_RS },
+    { GIA_ORCH_RS, GIA_ORCH_RW, GIA_ORCH_RF },
+    { GIA_ORCH_RS, GIA_ORCH_RF, GIA_ORCH_RW },
+    { GIA_ORCH_RF, GIA_ORCH_RW, GIA_ORCH_RS },
+    { GIA_ORCH_RF, GIA_ORCH_RS, GIA_ORCH_RW }
+};
+// the operator codes in the decision file, as in Abc_NtkOrchSA()
+static int s_OrchCodes[3] = { 0, 2, 3 };
+static char * s_OrchNames[3] = { "rw", "rs", "rf" };
+
+// the replacement of one node is a small program over the inputs:
+// literals of var 0 are constants, vars 1..nIns are the inputs,
+// and var nIns+1+k is the k-th gate stored as a pair of literals
+typedef struct Gia_OrchProg_t_ Gia_OrchProg_t;
+struct Gia_OrchProg_t_
+{
+    Vec_Int_t *    vIns;          // the input literals in the working AIG
+    Vec_Int_t *    vGates;        // the gates as pairs of program literals
+    int            iRoot;         // the program literal of the root (-1 if none)
+    int            nNew;          // the number of nodes to be added
+    int            Gain;          // the number of nodes saved
+    int            Level;         // the level of the new root
+};
+
+typedef struct Gia_Orch_t_ Gia_Orch_t;
+struct Gia_Orch_t_
+{
+    // parameters
+    int            nCutMax;       // the largest number of cut leaves
+    int            fUpdateLevel;  // preserves the levels
+    int            fUseZerosRw;   // accepts zero-gain rewrites
+    int            fUseZerosRf;   // accepts zero-gain refactors
+    // the working AIG, updated in place
+    Gia_Man_t *    pGia;          // the AIG with the new nodes appended
+    Vec_Int_t *    vRepl;         // the literal replacing each object, or -1
+    Vec_Int_t *    vTable;        // the hash table of the nodes by their current fanins
+    Vec_Wec_t *    vFanouts;      // the nodes whose current fanin is the object
+    int            nTableUsed;    // the number of entries in the hash table
+    Vec_Int_t *    vRefs;         // the number of live fanouts, including COs
+    Vec_Int_t *    vLevel;        // the level of each object
+    Vec_Int_t *    vRequired;     // the required level of each original object
+    Vec_Str_t *    vDirty;        // the objects changed since the start
+    // traversal stamps
+    Vec_Int_t *    vCutId;        // the objects of the current cut
+    Vec_Int_t *    vConeId;       // the objects of the current cone
+    Vec_Int_t *    vMffcId;       // the objects of the current MFFC
+    Vec_Int_t *    vDeadId;       // the dead objects counted by the evaluation
+    Vec_Int_t *    vSlot;         // the truth table slot of the cut objects
+    int            nCutId;
+    int            nConeId;
+    int            nMffcId;
+    int            nDeadId;
+    // the current node
+    int            iRoot;         // the node being resynthesized
+    int            nMffc;         // the size of its MFFC in the cut
+    Vec_Int_t *    vLeaves;       // the cut leaves
+    Vec_Int_t *    vCone;         // the internal nodes in a topological order
+    Vec_Int_t *    vSide;         // the nodes outside of the cone with both fanins in the cut
+    Vec_Int_t *    vDivs;         // the divisors for resubstitution
+    Vec_Wrd_t *    vTruths;       // the truth tables of the cut objects
+    Vec_Int_t *    vCuts;         // the 4-input cuts of the cut objects
+    Vec_Int_t *    vCutNum;       // the number of 4-input cuts of the cut objects
+    Vec_Int_t *    vSims;         // the 4-input truth tables of the cut objects
+    Vec_Int_t *    vStructs;      // the library structures of a 4-input function
+    Vec_Wrd_t *    vElems;        // the elementary truth tables
+    word *         pTemp;         // the temporary truth table
+    int            nWords;        // the number of words in the truth tables
+    // the operators
+    Bdc_Par_t      BdcPars;       // the bi-decomposition parameters
+    Bdc_Man_t *    pBdc;          // the bi-decomposition manager
+    Vec_Int_t *    vMemory;       // the memory for the ISOP computation
+    Vec_Int_t *    vMap;          // the program vars mapped into literals
+    Vec_Int_t *    vMapLev;       // the levels of the program vars
+    Gia_OrchProg_t Progs[GIA_ORCH_OPS];
+    Gia_OrchProg_t ProgTemp;      // the candidate being evaluated
+    // the candidates of the windows seen before
+    Hsh_VecMan_t * pCache;        // the windows by their signatures
+    Vec_Wec_t *    vCacheData;    // the candidates of each window
+    Vec_Int_t *    vCacheKey;     // the signature of the current window
+    Vec_Int_t *    vCacheIds;     // the sorted IDs of the current window
+    Vec_Int_t *    vCacheCands[GIA_ORCH_OPS]; // the candidates of the current window
+    Vec_Wrd_t *    vCacheSims;    // the truth tables of the gates of a candidate
+    // statistics
+    int            nOps[GIA_ORCH_OPS];
+    int            nGains[GIA_ORCH_OPS];
+    int            nNodesTried;
+    int            nNodesReused;
+    int            nCacheHits;
+    abctime        timeCut;
+    abctime        timeEval[GIA_ORCH_OPS];
+    abctime        timeUpdate;
+};
+
+static void Gia_OrchGrow( Gia_Orch_t * p );
+static void Gia_OrchCacheAdd( Gia_Orch_t * p, int Op, Gia_OrchProg_t * pProg );
+
+static inline int  Gia_OrchRefs( Gia_Orch_t * p, int iObj )           { return Vec_IntEntry(p->vRefs, iObj);                 }
+static inline int  Gia_OrchLevel( Gia_Orch_t * p, int iObj )          { return Vec_IntEntry(p->vLevel, iObj);                }
+static inline int  Gia_OrchIsAnd( Gia_Orch_t * p, int iObj )          { return Gia_ObjIsAnd(Gia_ManObj(p->pGia, iObj));      }
+static inline int  Gia_OrchIsCut( Gia_Orch_t * p, int iObj )          { return Vec_IntEntry(p->vCutId, iObj) == p->nCutId;   }
+static inline int  Gia_OrchIsMffc( Gia_Orch_t * p, int iObj )         { return Vec_IntEntry(p->vMffcId, iObj) == p->nMffcId; }
+static inline int  Gia_OrchIsDirty( Gia_Orch_t * p, int iObj )        { return Vec_StrEntry(p->vDirty, iObj);                }
+static inline void Gia_OrchSetDirty( Gia_Orch_t * p, int iObj )       { Vec_StrWriteEntry(p->vDirty, iObj, 1);               }
+static inline word * Gia_OrchTruth( Gia_Orch_t * p, int iObj )        { return Vec_WrdEntryP(p->vTruths, p->nWords * Vec_IntEntry(p->vSlot, iObj)); }
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the literal currently implementing the literal.]
+
+  Description [Follows the chain of replacements, so that the fanins of
+  all nodes are seen as if the AIG had been rebuilt after each update.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Gia_OrchResolve( Gia_Orch_t * p, int iLit )
+{
+    int iRepl;
+    while ( (iRepl = Vec_IntEntry(p->vRepl, Abc_Lit2Var(iLit))) >= 0 )
+        iLit = Abc_LitNotCond( iRepl, Abc_LitIsCompl(iLit) );
+    return iLit;
+}
+static inline int Gia_OrchFaninLit( Gia_Orch_t * p, int iObj, int k )
+{
+    Gia_Obj_t * pObj = Gia_ManObj( p->pGia, iObj );
+    return Gia_OrchResolve( p, k ? Gia_ObjFaninLit1(pObj, iObj) : Gia_ObjFaninLit0(pObj, iObj) );
+}
+static inline int Gia_OrchFanin( Gia_Orch_t * p, int iObj, int k )
+{
+    return Abc_Lit2Var( Gia_OrchFaninLit(p, iObj, k) );
+}
+static inline int Gia_OrchObjLevel( Gia_Orch_t * p, int iObj )
+{
+    return 1 + Abc_MaxInt( Gia_OrchLevel(p, Gia_OrchFanin(p, iObj, 0)), Gia_OrchLevel(p, Gia_OrchFanin(p, iObj, 1)) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Structural hashing by the current fanins.]
+
+  Description [The nodes of the working AIG cannot take new fanins with
+  larger IDs, so the fanins are changed by the replacements instead, and
+  the nodes are hashed by their current fanins. An entry is valid if the
+  node is not replaced and its current fanins match the key. The stale
+  entries are left in the table until it is rehashed.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Gia_OrchHashKey( Gia_Orch_t * p, int iLit0, int iLit1 )
+{
+    return (int)(((unsigned)iLit0 * 12582917 + (unsigned)iLit1 * 4256249) & (unsigned)(Vec_IntSize(p->vTable) - 1));
+}
+static inline void Gia_OrchObjLits( Gia_Orch_t * p, int iObj, int * piLit0, int * piLit1 )
+{
+    int iLit0 = Gia_OrchFaninLit( p, iObj, 0 );
+    int iLit1 = Gia_OrchFaninLit( p, iObj, 1 );
+    *piLit0 = Abc_MinInt( iLit0, iLit1 );
+    *piLit1 = Abc_MaxInt( iLit0, iLit1 );
+}
+static int Gia_OrchTableLookup( Gia_Orch_t * p, int iLit0, int iLit1 )
+{
+    int k, iObj, iFan0, iFan1;
+    assert( iLit0 < iLit1 );
+    for ( k = Gia_OrchHashKey(p, iLit0, iLit1); (iObj = Vec_IntEntry(p->vTable, k)); k = (k + 1) & (Vec_IntSize(p->vTable) - 1) )
+    {
+        if ( Vec_IntEntry(p->vRepl, iObj) >= 0 )
+            continue;
+        Gia_OrchObjLits( p, iObj, &iFan0, &iFan1 );
+        if ( iFan0 == iLit0 && iFan1 == iLit1 )
+            return iObj;
+    }
+    return 0;
+}
+static void Gia_OrchTableInsert( Gia_Orch_t * p, int iObj )
+{
+    int k, iLit0, iLit1;
+    Gia_OrchObjLits( p, iObj, &iLit0, &iLit1 );
+    for ( k = Gia_OrchHashKey(p, iLit0, iLit1); Vec_IntEntry(p->vTable, k); k = (k + 1) & (Vec_IntSize(p->vTable) - 1) );
+    Vec_IntWriteEntry( p->vTable, k, iObj );
+    p->nTableUsed++;
+}
+static void Gia_OrchTableRehash( Gia_Orch_t * p )
+{
+    int i;
+    Vec_IntFill( p->vTable, 1 << Abc_Base2Log(4 * Gia_ManObjNum(p->pGia)), 0 );
+    p->nTableUsed = 0;
+    for ( i = 1; i < Gia_ManObjNum(p->pGia); i++ )
+        if ( Gia_ObjIsAnd(Gia_ManObj(p->pGia, i)) && Vec_IntEntry(p->vRepl, i) == -1 )
+            Gia_OrchTableInsert( p, i );
+}
+static void Gia_OrchTableAdd( Gia_Orch_t * p, int iObj )
+{
+    if ( 2 * (p->nTableUsed + 1) > Vec_IntSize(p->vTable) )
+        Gia_OrchTableRehash( p );
+    else
+        Gia_OrchTableInsert( p, iObj );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Finds or creates the AND of two literals.]
+
+  Description [Gia_OrchAndLookup() returns -1 if there is no such node.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Gia_OrchAndLookup( Gia_Orch_t * p, int iLit0, int iLit1 )
+{
+    int iObj;
+    if ( iLit0 < 2 )
+        return iLit0 ? iLit1 : 0;
+    if ( iLit1 < 2 )
+        return iLit1 ? iLit0 : 0;
+    if ( iLit0 == iLit1 )
+        return iLit0;
+    if ( iLit0 == Abc_LitNot(iLit1) )
+        return 0;
+    iObj = Gia_OrchTableLookup( p, Abc_MinInt(iLit0, iLit1), Abc_MaxInt(iLit0, iLit1) );
+    return iObj ? Abc_Var2Lit( iObj, 0 ) : -1;
+}
+static int Gia_OrchAnd( Gia_Orch_t * p, int iLit0, int iLit1 )
+{
+    int iLit = Gia_OrchAndLookup( p, iLit0, iLit1 ), iObj;
+    if ( iLit >= 0 )
+        return iLit;
+    iLit = Gia_ManAppendAnd( p->pGia, iLit0, iLit1 );
+    iObj = Abc_Lit2Var( iLit );
+    Gia_OrchGrow( p );
+    Vec_IntWriteEntry( p->vLevel, iObj, Gia_OrchObjLevel(p, iObj) );
+    Vec_WecPush( p->vFanouts, Abc_Lit2Var(iLit0), iObj );
+    Vec_WecPush( p->vFanouts, Abc_Lit2Var(iLit1), iObj );
+    Gia_OrchSetDirty( p, Abc_Lit2Var(iLit0) );
+    Gia_OrchSetDirty( p, Abc_Lit2Var(iLit1) );
+    Gia_OrchTableAdd( p, iObj );
+    return iLit;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts and stops the manager.]
+
+  Description [The required levels are computed once for the original AIG,
+  as the reverse levels in Abc_NtkStartReverseLevels().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_OrchGrow( Gia_Orch_t * p )
+{
+    int nObjs = Gia_ManObjNum( p->pGia );
+    if ( Vec_IntSize(p->vRepl) >= nObjs )
+        return;
+    Vec_IntFillExtra( p->vRepl,   nObjs, -1 );
+    Vec_IntFillExtra( p->vRefs,   nObjs,  0 );
+    Vec_IntFillExtra( p->vLevel,  nObjs,  0 );
+    Vec_IntFillExtra( p->vCutId,  nObjs,  0 );
+    Vec_IntFillExtra( p->vConeId, nObjs,  0 );
+    Vec_IntFillExtra( p->vMffcId, nObjs,  0 );
+    Vec_IntFillExtra( p->vDeadId, nObjs,  0 );
+    Vec_IntFillExtra( p->vSlot,   nObjs, -1 );
+    Vec_StrFillExtra( p->vDirty,  nObjs,  1 );
+    while ( Vec_WecSize(p->vFanouts) < nObjs )
+        Vec_WecPushLevel( p->vFanouts );
+}
+static Vec_Int_t * Gia_OrchRequired( Gia_Orch_t * p )
+{
+    Vec_Int_t * vRequired = Vec_IntAlloc( Gia_ManObjNum(p->pGia) );
+    Gia_Obj_t * pObj;
+    int i, Required, LevelMax = 0;
+    Gia_ManForEachCo( p->pGia, pObj, i )
+        LevelMax = Abc_MaxInt( LevelMax, Gia_OrchLevel(p, Gia_ObjFaninId0p(p->pGia, pObj)) );
+    Vec_IntFill( vRequired, Gia_ManObjNum(p->pGia), LevelMax );
+    Gia_ManForEachAndReverse( p->pGia, pObj, i )
+    {
+        Required = Vec_IntEntry( vRequired, i ) - 1;
+        if ( Vec_IntEntry(vRequired, Gia_ObjFaninId0(pObj, i)) > Required )
+            Vec_IntWriteEntry( vRequired, Gia_ObjFaninId0(pObj, i), Required );
+        if ( Vec_IntEntry(vRequired, Gia_ObjFaninId1(pObj, i)) > Required )
+            Vec_IntWriteEntry( vRequired, Gia_ObjFaninId1(pObj, i), Required );
+    }
+    return vRequired;
+}
+static Gia_Orch_t * Gia_OrchStart( Gia_Man_t * pGia, int nCutMax, int fUpdateLevel, int fUseZerosRw, int fUseZerosRf )
+{
+    Gia_Orch_t * p = ABC_CALLOC( Gia_Orch_t, 1 );
+    Gia_Obj_t * pObj;
+    int i;
+    p->nCutMax      = nCutMax;
+    p->fUpdateLevel = fUpdateLevel;
+    p->fUseZerosRw  = fUseZerosRw;
+    p->fUseZerosRf  = fUseZerosRf;
+    // the working AIG
+    p->pGia    = Gia_ManDup( pGia );
+    p->vRepl   = Vec_IntAlloc( 0 );
+    p->vTable  = Vec_IntAlloc( 0 );
+    p->vFanouts = Vec_WecAlloc( Gia_ManObjNum(pGia) );
+    p->vRefs   = Vec_IntAlloc( 0 );
+    p->vLevel  = Vec_IntAlloc( 0 );
+    p->vCutId  = Vec_IntAlloc( 0 );
+    p->vConeId = Vec_IntAlloc( 0 );
+    p->vMffcId = Vec_IntAlloc( 0 );
+    p->vDeadId = Vec_IntAlloc( 0 );
+    p->vSlot   = Vec_IntAlloc( 0 );
+    p->vDirty  = Vec_StrAlloc( 0 );
+    Gia_OrchGrow( p );
+    Vec_StrFill( p->vDirty, Gia_ManObjNum(p->pGia), 0 );
+    Gia_ManForEachAnd( p->pGia, pObj, i )
+    {
+        Vec_IntAddToEntry( p->vRefs, Gia_ObjFaninId0(pObj, i), 1 );
+        Vec_IntAddToEntry( p->vRefs, Gia_ObjFaninId1(pObj, i), 1 );
+        Vec_IntWriteEntry( p->vLevel, i, Gia_OrchObjLevel(p, i) );
+        Vec_WecPush( p->vFanouts, Gia_ObjFaninId0(pObj, i), i );
+        Vec_WecPush( p->vFanouts, Gia_ObjFaninId1(pObj, i), i );
+    }
+    Gia_OrchTableRehash( p );
+    Gia_ManForEachCo( p->pGia, pObj, i )
+        Vec_IntAddToEntry( p->vRefs, Gia_ObjFaninId0p(p->pGia, pObj), 1 );
+    p->vRequired = Gia_OrchRequired( p );
+    // the cut data
+    p->vLeaves = Vec_IntAlloc( nCutMax );
+    p->vCone   = Vec_IntAlloc( GIA_ORCH_CONE_MAX );
+    p->vSide   = Vec_IntAlloc( GIA_ORCH_DIV_MAX );
+    p->vDivs   = Vec_IntAlloc( GIA_ORCH_DIV_MAX );
+    p->vTruths = Vec_WrdAlloc( 0 );
+    p->vCuts   = Vec_IntAlloc( 0 );
+    p->vCutNum = Vec_IntAlloc( 0 );
+    p->vSims   = Vec_IntAlloc( 0 );
+    p->vStructs = Vec_IntAlloc( 1000 );
+    p->vElems  = Vec_WrdStart( nCutMax * Abc_TtWordNum(nCutMax) );
+    p->pTemp   = ABC_CALLOC( word, Abc_TtWordNum(nCutMax) );
+    // the operators
+    p->BdcPars.nVarsMax = nCutMax;
+    p->pBdc    = Bdc_ManAlloc( &p->BdcPars );
+    p->vMemory = Vec_IntAlloc( 1 << 16 );
+    p->vMap    = Vec_IntAlloc( 100 );
+    p->vMapLev = Vec_IntAlloc( 100 );
+    for ( i = 0; i < GIA_ORCH_OPS; i++ )
+    {
+        p->Progs[i].vIns   = Vec_IntAlloc( 100 );
+        p->Progs[i].vGates = Vec_IntAlloc( 100 );
+    }
+    p->ProgTemp.vIns   = Vec_IntAlloc( 100 );
+    p->ProgTemp.vGates = Vec_IntAlloc( 100 );
+    return p;
+}
+static void Gia_OrchStop( Gia_Orch_t * p )
+{
+    int i;
+    for ( i = 0; i < GIA_ORCH_OPS; i++ )
+    {
+        Vec_IntFree( p->Progs[i].vIns );
+        Vec_IntFree( p->Progs[i].vGates );
+    }
+    Vec_IntFree( p->ProgTemp.vIns );
+    Vec_IntFree( p->ProgTemp.vGates );
+    if ( p->pCache )
+    {
+        Hsh_VecManStop( p->pCache );
+        Vec_WecFree( p->vCacheData );
+        Vec_IntFree( p->vCacheKey );
+        Vec_IntFree( p->vCacheIds );
+        Vec_WrdFree( p->vCacheSims );
+        for ( i = 0; i < GIA_ORCH_OPS; i++ )
+            Vec_IntFree( p->vCacheCands[i] );
+    }
+    Vec_IntFree( p->vCuts );
+    Vec_IntFree( p->vCutNum );
+    Vec_IntFree( p->vSims );
+    Vec_IntFree( p->vStructs );
+    Bdc_ManFree( p->pBdc );
+    Vec_IntFree( p->vMemory );
+    Vec_IntFree( p->vMap );
+    Vec_IntFree( p->vMapLev );
+    Vec_IntFree( p->vLeaves );
+    Vec_IntFree( p->vCone );
+    Vec_IntFree( p->vSide );
+    Vec_IntFree( p->vDivs );
+    Vec_WrdFree( p->vTruths );
+    Vec_WrdFree( p->vElems );
+    ABC_FREE( p->pTemp );
+    Vec_IntFree( p->vRepl );
+    Vec_IntFree( p->vTable );
+    Vec_WecFree( p->vFanouts );
+    Vec_IntFree( p->vRefs );
+    Vec_IntFree( p->vLevel );
+    Vec_IntFree( p->vRequired );
+    Vec_IntFree( p->vCutId );
+    Vec_IntFree( p->vConeId );
+    Vec_IntFree( p->vMffcId );
+    Vec_IntFree( p->vDeadId );
+    Vec_IntFree( p->vSlot );
+    Vec_StrFree( p->vDirty );
+    Gia_ManStop( p->pGia );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the reconvergence-driven cut of the node.]
+
+  Description [Expands the leaf whose expansion adds the fewest new
+  leaves, as long as the cut has at most nCutMax leaves. The constant
+  node is never a leaf. The cut is shared by all operators.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Gia_OrchLeafCost( Gia_Orch_t * p, int iObj )
+{
+    int iFan0, iFan1, Cost = -1;
+    if ( !Gia_OrchIsAnd(p, iObj) )
+        return ABC_INFINITY;
+    iFan0 = Gia_OrchFanin( p, iObj, 0 );
+    iFan1 = Gia_OrchFanin( p, iObj, 1 );
+    Cost += (iFan0 > 0 && !Gia_OrchIsCut(p, iFan0));
+    Cost += (iFan1 > 0 && !Gia_OrchIsCut(p, iFan1) && iFan1 != iFan0);
+    return Cost;
+}
+static inline void Gia_OrchAddLeaf( Gia_Orch_t * p, int iObj )
+{
+    if ( iObj == 0 || Gia_OrchIsCut(p, iObj) )
+        return;
+    Vec_IntWriteEntry( p->vCutId, iObj, p->nCutId );
+    Vec_IntPush( p->vLeaves, iObj );
+}
+static void Gia_OrchFindCut( Gia_Orch_t * p, int iRoot )
+{
+    int i, iLeaf, Cost, iBest, CostBest, nExpands = 0;
+    p->nCutId++;
+    Vec_IntClear( p->vLeaves );
+    Vec_IntWriteEntry( p->vCutId, iRoot, p->nCutId );
+    Vec_IntWriteEntry( p->vCutId, 0, p->nCutId );
+    Gia_OrchAddLeaf( p, Gia_OrchFanin(p, iRoot, 0) );
+    Gia_OrchAddLeaf( p, Gia_OrchFanin(p, iRoot, 1) );
+    while ( nExpands++ < GIA_ORCH_CONE_MAX )
+    {
+        iBest = -1, CostBest = ABC_INFINITY;
+        Vec_IntForEachEntry( p->vLeaves, iLeaf, i )
+        {
+            Cost = Gia_OrchLeafCost( p, iLeaf );
+            if ( CostBest > Cost || (iBest >= 0 && CostBest == Cost && Gia_OrchLevel(p, iLeaf) > Gia_OrchLevel(p, Vec_IntEntry(p->vLeaves, iBest))) )
+                CostBest = Cost, iBest = i;
+        }
+        if ( iBest == -1 || Vec_IntSize(p->vLeaves) + CostBest > p->nCutMax )
+            break;
+        iLeaf = Vec_IntEntry( p->vLeaves, iBest );
+        Vec_IntDrop( p->vLeaves, iBest );
+        Gia_OrchAddLeaf( p, Gia_OrchFanin(p, iLeaf, 0) );
+        Gia_OrchAddLeaf( p, Gia_OrchFanin(p, iLeaf, 1) );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the truth tables of the cone of the cut.]
+
+  Description [Collects the internal nodes in a topological order and
+  derives their functions in terms of the leaves. Also collects the live
+  nodes outside of the cone whose fanins are the leaves, the internal
+  nodes other than the root, or the nodes collected before, skipping the
+  objects with more than 100 fanouts, as in Abc_ManResubCollectDivs().
+  These are the extra divisors of resubstitution.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_OrchCollectCone_rec( Gia_Orch_t * p, int iObj )
+{
+    if ( Vec_IntEntry(p->vConeId, iObj) == p->nConeId )
+        return;
+    Vec_IntWriteEntry( p->vConeId, iObj, p->nConeId );
+    assert( Gia_OrchIsAnd(p, iObj) );
+    Gia_OrchCollectCone_rec( p, Gia_OrchFanin(p, iObj, 0) );
+    Gia_OrchCollectCone_rec( p, Gia_OrchFanin(p, iObj, 1) );
+    Vec_IntPush( p->vCone, iObj );
+}
+static inline int Gia_OrchWinObj( Gia_Orch_t * p, int i )
+{
+    int nLeaves = Vec_IntSize(p->vLeaves), nCone = Vec_IntSize(p->vCone);
+    if ( i < nLeaves )
+        return Vec_IntEntry( p->vLeaves, i );
+    if ( i < nLeaves + nCone )
+        return Vec_IntEntry( p->vCone, i - nLeaves );
+    return Vec_IntEntry( p->vSide, i - nLeaves - nCone );
+}
+static void Gia_OrchCollectSide( Gia_Orch_t * p, int iRoot )
+{
+    Vec_Int_t * vFanouts;
+    int i, k, iObj, iFan, nLimit = GIA_ORCH_DIV_MAX - Vec_IntSize(p->vLeaves) - Vec_IntSize(p->vCone);
+    Vec_IntClear( p->vSide );
+    // the fanouts of the root are in its TFO
+    Vec_IntWriteEntry( p->vConeId, iRoot, 0 );
+    for ( i = 0; i < Vec_IntSize(p->vLeaves) + Vec_IntSize(p->vCone) + Vec_IntSize(p->vSide); i++ )
+    {
+        iObj = Gia_OrchWinObj( p, i );
+        if ( iObj == iRoot || Gia_OrchRefs(p, iObj) > 100 )
+            continue;
+        vFanouts = Vec_WecEntry( p->vFanouts, iObj );
+        Vec_IntForEachEntry( vFanouts, iFan, k )
+        {
+            if ( Vec_IntSize(p->vSide) == nLimit )
+                break;
+            if ( iFan == iRoot || Vec_IntEntry(p->vConeId, iFan) == p->nConeId || Vec_IntEntry(p->vRepl, iFan) >= 0 || Gia_OrchRefs(p, iFan) == 0 )
+                continue;
+            if ( Vec_IntEntry(p->vConeId, Gia_OrchFanin(p, iFan, 0)) != p->nConeId || Vec_IntEntry(p->vConeId, Gia_OrchFanin(p, iFan, 1)) != p->nConeId )
+                continue;
+            Vec_IntWriteEntry( p->vConeId, iFan, p->nConeId );
+            Vec_IntPush( p->vSide, iFan );
+        }
+    }
+    Vec_IntWriteEntry( p->vConeId, iRoot, p->nConeId );
+}
+static void Gia_OrchComputeTruths( Gia_Orch_t * p, int iRoot )
+{
+    int i, iObj, iLit0, iLit1, nLeaves = Vec_IntSize(p->vLeaves), nObjs;
+    p->nWords = Abc_TtWordNum( nLeaves );
+    // collect the cone
+    p->nConeId++;
+    Vec_IntClear( p->vCone );
+    Vec_IntWriteEntry( p->vConeId, 0, p->nConeId );
+    Vec_IntForEachEntry( p->vLeaves, iObj, i )
+        Vec_IntWriteEntry( p->vConeId, iObj, p->nConeId );
+    Gia_OrchCollectCone_rec( p, iRoot );
+    Gia_OrchCollectSide( p, iRoot );
+    nObjs = nLeaves + Vec_IntSize(p->vCone) + Vec_IntSize(p->vSide);
+    // assign the slots
+    Vec_WrdFill( p->vTruths, p->nWords * (1 + nObjs), 0 );
+    Vec_IntWriteEntry( p->vSlot, 0, 0 );
+    Abc_TtElemInit2( Vec_WrdArray(p->vElems), nLeaves );
+    Vec_IntForEachEntry( p->vLeaves, iObj, i )
+    {
+        Vec_IntWriteEntry( p->vSlot, iObj, 1 + i );
+        Abc_TtCopy( Gia_OrchTruth(p, iObj), Vec_WrdEntryP(p->vElems, i * p->nWords), p->nWords, 0 );
+    }
+    for ( i = nLeaves; i < nObjs; i++ )
+    {
+        iObj = Gia_OrchWinObj( p, i );
+        Vec_IntWriteEntry( p->vSlot, iObj, 1 + i );
+        iLit0 = Gia_OrchFaninLit( p, iObj, 0 );
+        iLit1 = Gia_OrchFaninLit( p, iObj, 1 );
+        Abc_TtAndCompl( Gia_OrchTruth(p, iObj), Gia_OrchTruth(p, Abc_Lit2Var(iLit0)), Abc_LitIsCompl(iLit0),
+            Gia_OrchTruth(p, Abc_Lit2Var(iLit1)), Abc_LitIsCompl(iLit1), p->nWords );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Referencing and dereferencing of the live nodes.]
+
+  Description [The fanins are always the current ones. A node whose
+  reference counter drops to zero dereferences its fanins, and a node
+  revived by a reference references them again.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_OrchRef_rec( Gia_Orch_t * p, int iObj )
+{
+    Gia_OrchSetDirty( p, iObj );
+    if ( Vec_IntAddToEntry(p->vRefs, iObj, 1), Gia_OrchRefs(p, iObj) > 1 || !Gia_OrchIsAnd(p, iObj) )
+        return;
+    Vec_IntWriteEntry( p->vLevel, iObj, Gia_OrchObjLevel(p, iObj) );
+    Gia_OrchRef_rec( p, Gia_OrchFanin(p, iObj, 0) );
+    Gia_OrchRef_rec( p, Gia_OrchFanin(p, iObj, 1) );
+}
+static void Gia_OrchDeref_rec( Gia_Orch_t * p, int iObj )
+{
+    assert( Gia_OrchRefs(p, iObj) > 0 );
+    Gia_OrchSetDirty( p, iObj );
+    if ( Vec_IntAddToEntry(p->vRefs, iObj, -1), Gia_OrchRefs(p, iObj) > 0 || !Gia_OrchIsAnd(p, iObj) )
+        return;
+    Gia_OrchDeref_rec( p, Gia_OrchFanin(p, iObj, 0) );
+    Gia_OrchDeref_rec( p, Gia_OrchFanin(p, iObj, 1) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Marks the MFFC of the node bounded by the cut.]
+
+  Description [Returns the number of its nodes, including the root.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Gia_OrchMffcMark_rec( Gia_Orch_t * p, int iObj )
+{
+    int k, iFan, Count = 1;
+    Vec_IntWriteEntry( p->vMffcId, iObj, p->nMffcId );
+    for ( k = 0; k < 2; k++ )
+    {
+        iFan = Gia_OrchFanin( p, iObj, k );
+        Vec_IntAddToEntry( p->vRefs, iFan, -1 );
+        if ( Gia_OrchRefs(p, iFan) == 0 && Gia_OrchIsAnd(p, iFan) )
+            Count += Gia_OrchMffcMark_rec( p, iFan );
+    }
+    return Count;
+}
+static void Gia_OrchMffcUnmark_rec( Gia_Orch_t * p, int iObj )
+{
+    int k, iFan;
+    for ( k = 0; k < 2; k++ )
+    {
+        iFan = Gia_OrchFanin( p, iObj, k );
+        Vec_IntAddToEntry( p->vRefs, iFan, 1 );
+        if ( Gia_OrchRefs(p, iFan) == 1 && Gia_OrchIsAnd(p, iFan) )
+            Gia_OrchMffcUnmark_rec( p, iFan );
+    }
+}
+static int Gia_OrchMffc( Gia_Orch_t * p, int iRoot, int * pLeaves, int nLeaves )
+{
+    int i, Count;
+    p->nMffcId++;
+    for ( i = 0; i < nLeaves; i++ )
+        Vec_IntAddToEntry( p->vRefs, pLeaves[i], 1 );
+    Count = Gia_OrchMffcMark_rec( p, iRoot );
+    Gia_OrchMffcUnmark_rec( p, iRoot );
+    for ( i = 0; i < nLeaves; i++ )
+        Vec_IntAddToEntry( p->vRefs, pLeaves[i], -1 );
+    return Count;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Evaluates the program in the current AIG.]
+
+  Description [Maps the program into the existing nodes using structural
+  hashing. A gate found among the live nodes outside of the MFFC is free,
+  other gates are new. Returns 0 if the program would reproduce the root
+  or exceed its required level in the original AIG (with level
+  preservation), or if it adds more nodes than the MFFC has. Otherwise records the number of new nodes and
+  the level of the new root.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Gia_OrchDeadCone_rec( Gia_Orch_t * p, int iObj )
+{
+    if ( Gia_OrchRefs(p, iObj) > 0 || !Gia_OrchIsAnd(p, iObj) || Vec_IntEntry(p->vDeadId, iObj) == p->nDeadId )
+        return 0;
+    Vec_IntWriteEntry( p->vDeadId, iObj, p->nDeadId );
+    return 1 + Gia_OrchDeadCone_rec(p, Gia_OrchFanin(p, iObj, 0)) + Gia_OrchDeadCone_rec(p, Gia_OrchFanin(p, iObj, 1));
+}
+static inline int Gia_OrchProgLit( Gia_Orch_t * p, int iProgLit, int * pLevel )
+{
+    int iLit = Vec_IntEntry( p->vMap, Abc_Lit2Var(iProgLit) );
+    *pLevel = Vec_IntEntry( p->vMapLev, Abc_Lit2Var(iProgLit) );
+    return iLit < 0 ? -1 : Abc_LitNotCond( iLit, Abc_LitIsCompl(iProgLit) );
+}
+static int Gia_OrchProgEval( Gia_Orch_t * p, Gia_OrchProg_t * pProg )
+{
+    int i, iIn, iLit0, iLit1, iLit, Lev0, Lev1, Level, nNew = 0;
+    if ( pProg->iRoot < 0 )
+        return 0;
+    p->nDeadId++;
+    Vec_IntClear( p->vMap );
+    Vec_IntClear( p->vMapLev );
+    Vec_IntPush( p->vMap, 0 );
+    Vec_IntPush( p->vMapLev, 0 );
+    Vec_IntForEachEntry( pProg->vIns, iIn, i )
+    {
+        Vec_IntPush( p->vMap, iIn );
+        Vec_IntPush( p->vMapLev, Gia_OrchLevel(p, Abc_Lit2Var(iIn)) );
+    }
+    for ( i = 0; i + 1 < Vec_IntSize(pProg->vGates); i += 2 )
+    {
+        iLit0 = Gia_OrchProgLit( p, Vec_IntEntry(pProg->vGates, i),   &Lev0 );
+        iLit1 = Gia_OrchProgLit( p, Vec_IntEntry(pProg->vGates, i+1), &Lev1 );
+        iLit  = -1;
+        Level = 1 + Abc_MaxInt( Lev0, Lev1 );
+        if ( iLit0 >= 0 && iLit1 >= 0 )
+        {
+            if ( iLit0 < 2 )
+                iLit = iLit0 ? iLit1 : 0, Level = iLit0 ? Lev1 : 0;
+            else if ( iLit1 < 2 )
+                iLit = iLit1 ? iLit0 : 0, Level = iLit1 ? Lev0 : 0;
+            else if ( iLit0 == iLit1 )
+                iLit = iLit0, Level = Lev0;
+            else if ( iLit0 == Abc_LitNot(iLit1) )
+                iLit = 0, Level = 0;
+            else if ( (iLit = Gia_OrchAndLookup(p, iLit0, iLit1)) >= 0 )
+            {
+                Level = Gia_OrchLevel( p, Abc_Lit2Var(iLit) );
+                if ( Abc_Lit2Var(iLit) == p->iRoot )
+                    return 0;
+                if ( Gia_OrchIsMffc(p, Abc_Lit2Var(iLit)) )
+                    nNew++;
+                else
+                    nNew += Gia_OrchDeadCone_rec( p, Abc_Lit2Var(iLit) );
+            }
+            else
+                iLit = -1;
+        }
+        if ( iLit == -1 )
+            nNew++;
+        if ( nNew > p->nMffc )
+            return 0;
+        Vec_IntPush( p->vMap, iLit );
+        Vec_IntPush( p->vMapLev, Level );
+    }
+    iLit = Gia_OrchProgLit( p, pProg->iRoot, &Level );
+    if ( iLit >= 0 && Abc_Lit2Var(iLit) == p->iRoot )
+        return 0;
+    if ( iLit >= 0 && iLit < 2 )
+        Level = 0;
+    if ( p->fUpdateLevel && Level > Abc_MaxInt(Gia_OrchLevel(p, p->iRoot), Vec_IntEntry(p->vRequired, p->iRoot)) )
+        return 0;
+    pProg->nNew  = nNew;
+    pProg->Gain  = p->nMffc - nNew;
+    pProg->Level = Level;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Replaces the node by the literal.]
+
+  Description [Transfers the fanouts of the node to the literal and
+  dereferences the old cone. The fanouts get new fanins, so they are
+  rehashed, and a fanout that became structurally equal to another node
+  or trivial is replaced in turn.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_OrchReplace( Gia_Orch_t * p, int iObj, int iLitNew )
+{
+    int i, iFan, iLit0, iLit1, iLit, nRefs = Gia_OrchRefs( p, iObj );
+    int iObjNew = Abc_Lit2Var( iLitNew );
+    assert( iObjNew != iObj && Vec_IntEntry(p->vRepl, iObj) == -1 );
+    if ( nRefs > 0 )
+    {
+        Gia_OrchRef_rec( p, iObjNew );
+        Vec_IntAddToEntry( p->vRefs, iObjNew, nRefs - 1 );
+        Vec_IntWriteEntry( p->vRefs, iObj, 1 );
+        Gia_OrchDeref_rec( p, iObj );
+    }
+    Vec_IntWriteEntry( p->vRepl, iObj, iLitNew );
+    Gia_OrchSetDirty( p, iObj );
+    Gia_OrchSetDirty( p, iObjNew );
+    // the array of fanouts may be reallocated by the recursive calls
+    for ( i = 0; i < Vec_IntSize(Vec_WecEntry(p->vFanouts, iObj)); i++ )
+    {
+        iFan = Vec_IntEntry( Vec_WecEntry(p->vFanouts, iObj), i );
+        if ( Vec_IntEntry(p->vRepl, iFan) >= 0 )
+            continue;
+        if ( iObjNew > 0 )
+            Vec_WecPush( p->vFanouts, iObjNew, iFan );
+        Gia_OrchSetDirty( p, iFan );
+        Gia_OrchObjLits( p, iFan, &iLit0, &iLit1 );
+        iLit = Gia_OrchAndLookup( p, iLit0, iLit1 );
+        if ( iLit == -1 )
+            Gia_OrchTableAdd( p, iFan );
+        else if ( Abc_Lit2Var(iLit) != iFan )
+            Gia_OrchReplace( p, iFan, iLit );
+    }
+    Vec_IntErase( Vec_WecEntry(p->vFanouts, iObj) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Replaces the root by the program.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_OrchProgApply( Gia_Orch_t * p, Gia_OrchProg_t * pProg )
+{
+    int i, iIn, iLit0, iLit1, iLit, Level;
+    Vec_IntClear( p->vMap );
+    Vec_IntPush( p->vMap, 0 );
+    Vec_IntForEachEntry( pProg->vIns, iIn, i )
+        Vec_IntPush( p->vMap, iIn );
+    Vec_IntFill( p->vMapLev, Vec_IntSize(p->vMap) + Vec_IntSize(pProg->vGates) / 2, 0 );
+    for ( i = 0; i + 1 < Vec_IntSize(pProg->vGates); i += 2 )
+    {
+        iLit0 = Gia_OrchProgLit( p, Vec_IntEntry(pProg->vGates, i),   &Level );
+        iLit1 = Gia_OrchProgLit( p, Vec_IntEntry(pProg->vGates, i+1), &Level );
+        Vec_IntPush( p->vMap, Gia_OrchAnd(p, iLit0, iLit1) );
+    }
+    iLit = Gia_OrchProgLit( p, pProg->iRoot, &Level );
+    Gia_OrchReplace( p, p->iRoot, iLit );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the candidates of the three operators.]
+
+  Description [Rewriting tries the library structures of all 4-input
+  cuts of the root in the cone, as Rwr_NodeRewrite() does, and the
+  bi-decomposition of the cut function, limited by the size of the MFFC.
+  Refactoring is the factored form of
+  the ISOP of the cut function. Resubstitution expresses the root by a
+  divisor or by an AND/OR of two divisors, where the divisors are the
+  leaves, the cone nodes outside of the MFFC, and the nodes outside of
+  the cone computed from them.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_OrchProgStart( Gia_Orch_t * p, Gia_OrchProg_t * pProg, Vec_Int_t * vIns )
+{
+    int i, iObj;
+    Vec_IntClear( pProg->vIns );
+    Vec_IntForEachEntry( vIns, iObj, i )
+        Vec_IntPush( pProg->vIns, Abc_Var2Lit(iObj, 0) );
+    Vec_IntClear( pProg->vGates );
+    pProg->iRoot = -1;
+}
+static int Gia_OrchTruthConst( Gia_Orch_t * p, word * pTruth )
+{
+    if ( Abc_TtIsConst0(pTruth, p->nWords) )
+        return 0;
+    if ( Abc_TtIsConst1(pTruth, p->nWords) )
+        return 1;
+    return -1;
+}
+static inline int * Gia_OrchCuts( Gia_Orch_t * p, int iSlot )
+{
+    return Vec_IntEntryP( p->vCuts, 5 * GIA_ORCH_CUT_NUM * iSlot );
+}
+static inline int Gia_OrchCutMerge( int * pCut0, int * pCut1, int * pCut )
+{
+    int i = 1, k = 1, n = 0;
+    while ( i <= pCut0[0] || k <= pCut1[0] )
+    {
+        if ( n == 4 )
+            return 0;
+        if ( k > pCut1[0] || (i <= pCut0[0] && pCut0[i] < pCut1[k]) )
+            pCut[1 + n++] = pCut0[i++];
+        else if ( i > pCut0[0] || pCut1[k] < pCut0[i] )
+            pCut[1 + n++] = pCut1[k++];
+        else
+            pCut[1 + n++] = pCut0[i++], k++;
+    }
+    pCut[0] = n;
+    return 1;
+}
+static inline int Gia_OrchCutContains( int * pBig, int * pSmall )
+{
+    int i, k;
+    for ( i = 1; i <= pSmall[0]; i++ )
+    {
+        for ( k = 1; k <= pBig[0]; k++ )
+            if ( pBig[k] == pSmall[i] )
+                break;
+        if ( k > pBig[0] )
+            return 0;
+    }
+    return 1;
+}
+static void Gia_OrchEnumCuts( Gia_Orch_t * p )
+{
+    int i, k, c0, c1, iObj, nCuts, * pCuts, * pCut0, * pCut1, * pCut;
+    int nLeaves = Vec_IntSize(p->vLeaves), nSlots = 1 + nLeaves + Vec_IntSize(p->vCone);
+    Vec_IntFill( p->vCuts, 5 * GIA_ORCH_CUT_NUM * nSlots, 0 );
+    Vec_IntFill( p->vCutNum, nSlots, 1 );
+    // the constant has the empty cut and the leaves have the trivial cuts
+    Vec_IntForEachEntry( p->vLeaves, iObj, i )
+        pCuts = Gia_OrchCuts( p, 1 + i ), pCuts[0] = 1, pCuts[1] = iObj;
+    Vec_IntForEachEntry( p->vCone, iObj, i )
+    {
+        int iSlot0 = Vec_IntEntry( p->vSlot, Gia_OrchFanin(p, iObj, 0) );
+        int iSlot1 = Vec_IntEntry( p->vSlot, Gia_OrchFanin(p, iObj, 1) );
+        pCuts = Gia_OrchCuts( p, 1 + nLeaves + i );
+        pCuts[0] = 1, pCuts[1] = iObj, nCuts = 1;
+        for ( c0 = 0; c0 < Vec_IntEntry(p->vCutNum, iSlot0); c0++ )
+        for ( c1 = 0; c1 < Vec_IntEntry(p->vCutNum, iSlot1) && nCuts < GIA_ORCH_CUT_NUM; c1++ )
+        {
+            pCut0 = Gia_OrchCuts( p, iSlot0 ) + 5 * c0;
+            pCut1 = Gia_OrchCuts( p, iSlot1 ) + 5 * c1;
+            pCut  = pCuts + 5 * nCuts;
+            if ( !Gia_OrchCutMerge(pCut0, pCut1, pCut) )
+                continue;
+            for ( k = 1; k < nCuts; k++ )
+                if ( Gia_OrchCutContains(pCut, pCuts + 5 * k) )
+                    break;
+            if ( k == nCuts )
+                nCuts++;
+        }
+        Vec_IntWriteEntry( p->vCutNum, 1 + nLeaves + i, nCuts );
+    }
+}
+static int Gia_OrchCutTruth( Gia_Orch_t * p, int * pCut )
+{
+    static int Elems[4] = { 0xAAAA, 0xCCCC, 0xF0F0, 0xFF00 };
+    int i, iObj, iLit0, iLit1, Sim0, Sim1, nLeaves = Vec_IntSize(p->vLeaves);
+    Vec_IntFill( p->vSims, 1 + nLeaves + Vec_IntSize(p->vCone), -1 );
+    Vec_IntWriteEntry( p->vSims, 0, 0 );
+    for ( i = 0; i < pCut[0]; i++ )
+        Vec_IntWriteEntry( p->vSims, Vec_IntEntry(p->vSlot, pCut[1+i]), Elems[i] );
+    Vec_IntForEachEntry( p->vCone, iObj, i )
+    {
+        if ( Vec_IntEntry(p->vSims, 1 + nLeaves + i) >= 0 )
+            continue;
+        iLit0 = Gia_OrchFaninLit( p, iObj, 0 );
+        iLit1 = Gia_OrchFaninLit( p, iObj, 1 );
+        Sim0  = Vec_IntEntry( p->vSims, Vec_IntEntry(p->vSlot, Abc_Lit2Var(iLit0)) );
+        Sim1  = Vec_IntEntry( p->vSims, Vec_IntEntry(p->vSlot, Abc_Lit2Var(iLit1)) );
+        if ( Sim0 < 0 || Sim1 < 0 )
+            continue;
+        Sim0 ^= Abc_LitIsCompl(iLit0) ? 0xFFFF : 0;
+        Sim1 ^= Abc_LitIsCompl(iLit1) ? 0xFFFF : 0;
+        Vec_IntWriteEntry( p->vSims, 1 + nLeaves + i, Sim0 & Sim1 );
+    }
+    return Vec_IntEntry( p->vSims, Vec_IntEntry(p->vSlot, p->iRoot) );
+}
+static int Gia_OrchProgTruth4( Gia_OrchProg_t * pProg )
+{
+    int Sims[64] = { 0, 0xAAAA, 0xCCCC, 0xF0F0, 0xFF00 }, i, iLit0, iLit1;
+    assert( Vec_IntSize(pProg->vIns) == 4 && Vec_IntSize(pProg->vGates) / 2 + 5 <= 64 );
+    for ( i = 0; i + 1 < Vec_IntSize(pProg->vGates); i += 2 )
+    {
+        iLit0 = Vec_IntEntry( pProg->vGates, i );
+        iLit1 = Vec_IntEntry( pProg->vGates, i+1 );
+        Sims[5 + i/2] = (Sims[Abc_Lit2Var(iLit0)] ^ (Abc_LitIsCompl(iLit0) ? 0xFFFF : 0)) & (Sims[Abc_Lit2Var(iLit1)] ^ (Abc_LitIsCompl(iLit1) ? 0xFFFF : 0));
+    }
+    return Sims[Abc_Lit2Var(pProg->iRoot)] ^ (Abc_LitIsCompl(pProg->iRoot) ? 0xFFFF : 0);
+}
+static void Gia_OrchProgUpdate( Gia_Orch_t * p, Gia_OrchProg_t * pProg, int * pfFound )
+{
+    Gia_OrchProg_t Temp;
+    if ( !Gia_OrchProgEval(p, &p->ProgTemp) )
+        return;
+    if ( *pfFound && (p->ProgTemp.Gain < pProg->Gain || (p->ProgTemp.Gain == pProg->Gain && p->ProgTemp.Level >= pProg->Level)) )
+        return;
+    Temp = *pProg, *pProg = p->ProgTemp, p->ProgTemp = Temp;
+    *pfFound = 1;
+}
+static int Gia_OrchDeriveRw( Gia_Orch_t * p, Gia_OrchProg_t * pProg, word * pTruth )
+{
+    Gia_OrchProg_t * pTemp = &p->ProgTemp;
+    Bdc_Fun_t * pFunc;
+    int i, c, s, k, uTruth, nStructs, nGates, * pCut, fFound = 0;
+    int nLeaves = Vec_IntSize(p->vLeaves), iSlot = Vec_IntEntry(p->vSlot, p->iRoot);
+    Gia_OrchProgStart( p, pProg, p->vLeaves );
+    if ( (pProg->iRoot = Gia_OrchTruthConst(p, pTruth)) >= 0 )
+    {
+        Gia_OrchCacheAdd( p, GIA_ORCH_RW, pProg );
+        return Gia_OrchProgEval( p, pProg );
+    }
+    // the library structures of the 4-input cuts in the cone
+    Gia_OrchEnumCuts( p );
+    for ( c = 1; c < Vec_IntEntry(p->vCutNum, iSlot); c++ )
+    {
+        pCut = Gia_OrchCuts( p, iSlot ) + 5 * c;
+        uTruth = Gia_OrchCutTruth( p, pCut );
+        if ( uTruth == 0 || uTruth == 0xFFFF )
+            continue;
+        // the nodes below the leaves of this cut are not saved
+        p->nMffc = Gia_OrchMffc( p, p->iRoot, pCut + 1, pCut[0] );
+        nStructs = Dar_LibStructs( (unsigned)uTruth, p->vStructs );
+        for ( s = k = 0; s < nStructs; s++, k += 2 + 2 * nGates )
+        {
+            nGates = Vec_IntEntry( p->vStructs, k );
+            Vec_IntClear( pTemp->vIns );
+            for ( i = 0; i < 4; i++ )
+                Vec_IntPush( pTemp->vIns, i < pCut[0] ? Abc_Var2Lit(pCut[1+i], 0) : 0 );
+            Vec_IntClear( pTemp->vGates );
+            for ( i = 0; i < 2 * nGates; i++ )
+                Vec_IntPush( pTemp->vGates, Vec_IntEntry(p->vStructs, k + 1 + i) );
+            pTemp->iRoot = Vec_IntEntry( p->vStructs, k + 1 + 2 * nGates );
+            if ( Gia_OrchProgTruth4(pTemp) != uTruth )
+                pTemp->iRoot = Abc_LitNot( pTemp->iRoot );
+            assert( Gia_OrchProgTruth4(pTemp) == uTruth );
+            Gia_OrchCacheAdd( p, GIA_ORCH_RW, pTemp );
+            Gia_OrchProgUpdate( p, pProg, &fFound );
+        }
+    }
+    // the bi-decomposition of the function of the large cut
+    p->nMffc = Gia_OrchMffc( p, p->iRoot, Vec_IntArray(p->vLeaves), nLeaves );
+    Gia_OrchProgStart( p, pTemp, p->vLeaves );
+    if ( Bdc_ManDecompose(p->pBdc, (unsigned *)pTruth, NULL, nLeaves, NULL, p->nMffc) < 0 )
+        return fFound;
+    Bdc_FuncSetCopyInt( Bdc_ManFunc(p->pBdc, 0), 1 );
+    for ( i = 0; i < nLeaves; i++ )
+        Bdc_FuncSetCopyInt( Bdc_ManFunc(p->pBdc, i+1), Abc_Var2Lit(i+1, 0) );
+    for ( i = nLeaves + 1; i < Bdc_ManNodeNum(p->pBdc); i++ )
+    {
+        pFunc = Bdc_ManFunc( p->pBdc, i );
+        Vec_IntPushTwo( pTemp->vGates, Bdc_FunFanin0Copy(pFunc), Bdc_FunFanin1Copy(pFunc) );
+        Bdc_FuncSetCopyInt( pFunc, Abc_Var2Lit(nLeaves + Vec_IntSize(pTemp->vGates) / 2, 0) );
+    }
+    pTemp->iRoot = Bdc_FunObjCopy( Bdc_ManRoot(p->pBdc) );
+    Gia_OrchCacheAdd( p, GIA_ORCH_RW, pTemp );
+    Gia_OrchProgUpdate( p, pProg, &fFound );
+    return fFound;
+}
+static inline int Gia_OrchKitLit( Kit_Edge_t eEdge )
+{
+    return Abc_Var2Lit( 1 + eEdge.Node, eEdge.fCompl );
+}
+static void Gia_OrchDeriveRf( Gia_Orch_t * p, Gia_OrchProg_t * pProg, word * pTruth )
+{
+    Kit_Graph_t * pGraph;
+    Kit_Node_t * pNode;
+    int i;
+    Gia_OrchProgStart( p, pProg, p->vLeaves );
+    if ( (pProg->iRoot = Gia_OrchTruthConst(p, pTruth)) >= 0 )
+    {
+        Gia_OrchCacheAdd( p, GIA_ORCH_RF, pProg );
+        return;
+    }
+    pGraph = Kit_TruthToGraph( (unsigned *)pTruth, Vec_IntSize(p->vLeaves), p->vMemory );
+    if ( pGraph == NULL )
+        return;
+    // the leaves and the nodes of the graph are numbered consecutively
+    Kit_GraphForEachNode( pGraph, pNode, i )
+        Vec_IntPushTwo( pProg->vGates, Gia_OrchKitLit(pNode->eEdge0), Gia_OrchKitLit(pNode->eEdge1) );
+    if ( Kit_GraphIsConst(pGraph) )
+        pProg->iRoot = Kit_GraphIsConst1(pGraph);
+    else
+        pProg->iRoot = Gia_OrchKitLit( pGraph->eRoot );
+    Kit_GraphFree( pGraph );
+    Gia_OrchCacheAdd( p, GIA_ORCH_RF, pProg );
+}
+static inline int Gia_OrchTruthImply( word * pIn1, word * pIn2, int fCompl, int nWords )
+{
+    int w;
+    for ( w = 0; w < nWords; w++ )
+        if ( pIn1[w] & (fCompl ? pIn2[w] : ~pIn2[w]) )
+            return 0;
+    return 1;
+}
+// the first accepted candidate is the result; with the cache, the enumeration continues to record the others
+static int Gia_OrchRsTry( Gia_Orch_t * p, Gia_OrchProg_t * pProg, int * pfFound )
+{
+    Gia_OrchCacheAdd( p, GIA_ORCH_RS, &p->ProgTemp );
+    if ( !*pfFound && Gia_OrchProgEval(p, &p->ProgTemp) )
+    {
+        Gia_OrchProg_t Temp = *pProg; *pProg = p->ProgTemp, p->ProgTemp = Temp;
+        *pfFound = 1;
+    }
+    return *pfFound && p->pCache == NULL;
+}
+static void Gia_OrchDeriveRs( Gia_Orch_t * p, Gia_OrchProg_t * pProg, word * pTruth )
+{
+    Gia_OrchProg_t * pTemp = &p->ProgTemp;
+    int Impl[2][2*GIA_ORCH_DIV_MAX], nImpl[2] = {0};
+    int i, k, c, iObj, iLit0, iLit1, nIns, fFound = 0, nWords = p->nWords;
+    word * pTruth0, * pTruth1;
+    // collect the divisors
+    Vec_IntClear( p->vDivs );
+    Vec_IntForEachEntry( p->vLeaves, iObj, i )
+        Vec_IntPush( p->vDivs, iObj );
+    Vec_IntForEachEntry( p->vCone, iObj, i )
+        if ( !Gia_OrchIsMffc(p, iObj) && Vec_IntSize(p->vDivs) < GIA_ORCH_DIV_MAX )
+            Vec_IntPush( p->vDivs, iObj );
+    Vec_IntForEachEntry( p->vSide, iObj, i )
+        if ( Vec_IntSize(p->vDivs) < GIA_ORCH_DIV_MAX )
+            Vec_IntPush( p->vDivs, iObj );
+    Gia_OrchProgStart( p, pProg, p->vDivs );
+    Gia_OrchProgStart( p, pTemp, p->vDivs );
+    nIns = Vec_IntSize( p->vDivs );
+    if ( (pProg->iRoot = Gia_OrchTruthConst(p, pTruth)) >= 0 )
+    {
+        Gia_OrchCacheAdd( p, GIA_ORCH_RS, pProg );
+        return;
+    }
+    // 0-resub: the root is a divisor or its complement
+    Vec_IntForEachEntry( p->vDivs, iObj, i )
+    {
+        pTruth0 = Gia_OrchTruth( p, iObj );
+        if ( Abc_TtEqual(pTruth, pTruth0, nWords) || Abc_TtOpposite(pTruth, pTruth0, nWords) )
+        {
+            pTemp->iRoot = Abc_Var2Lit( 1 + i, !Abc_TtEqual(pTruth, pTruth0, nWords) );
+            if ( Gia_OrchRsTry(p, pProg, &fFound) )
+                return;
+        }
+    }
+    if ( p->nMffc < 2 )
+        return;
+    // 1-resub: the root (c = 0) or its complement (c = 1) is an AND of two divisors,
+    // each implied by it; these are collected as program literals
+    for ( c = 0; c < 2; c++ )
+    {
+        if ( c ) Abc_TtNot( pTruth, nWords );
+        Vec_IntForEachEntry( p->vDivs, iObj, i )
+        {
+            pTruth0 = Gia_OrchTruth( p, iObj );
+            if ( Gia_OrchTruthImply(pTruth, pTruth0, 0, nWords) )
+                Impl[c][nImpl[c]++] = Abc_Var2Lit( 1 + i, 0 );
+            else if ( Gia_OrchTruthImply(pTruth, pTruth0, 1, nWords) )
+                Impl[c][nImpl[c]++] = Abc_Var2Lit( 1 + i, 1 );
+        }
+        if ( c ) Abc_TtNot( pTruth, nWords );
+    }
+    for ( c = 0; c < 2; c++ )
+    for ( i = 0; i < nImpl[c]; i++ )
+    for ( k = i + 1; k < nImpl[c]; k++ )
+    {
+        iLit0 = Impl[c][i], iLit1 = Impl[c][k];
+        pTruth0 = Gia_OrchTruth( p, Vec_IntEntry(p->vDivs, Abc_Lit2Var(iLit0) - 1) );
+        pTruth1 = Gia_OrchTruth( p, Vec_IntEntry(p->vDivs, Abc_Lit2Var(iLit1) - 1) );
+        Abc_TtAndCompl( p->pTemp, pTruth0, Abc_LitIsCompl(iLit0), pTruth1, Abc_LitIsCompl(iLit1), nWords );
+        if ( c ? !Abc_TtOpposite(p->pTemp, pTruth, nWords) : !Abc_TtEqual(p->pTemp, pTruth, nWords) )
+            continue;
+        Vec_IntFill( pTemp->vGates, 1, iLit0 );
+        Vec_IntPush( pTemp->vGates, iLit1 );
+        pTemp->iRoot = Abc_Var2Lit( nIns + 1, c );
+        if ( Gia_OrchRsTry(p, pProg, &fFound) )
+            return;
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Caches the candidates of the windows.]
+
+  Description [The signature of the window is the structure of its cone
+  over the leaves, the references of the cone nodes, and the levels of
+  the leaves and the required level of the root relative to the lowest
+  leaf, and the order of the object IDs of the window, which decides
+  the small cuts. All candidates derived for the window are stored, in
+  the order of derivation, with their inputs given as the truth table
+  slots of the window. When the same window is seen again, each
+  candidate is checked against the function of the root and evaluated
+  in the current AIG instead of being derived, and the one selected is
+  the one the derivation would select, so the cache does not change
+  the result.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Gia_OrchSlotLit( Gia_Orch_t * p, int iLit )
+{
+    return Abc_Var2Lit( Vec_IntEntry(p->vSlot, Abc_Lit2Var(iLit)), Abc_LitIsCompl(iLit) );
+}
+static inline int Gia_OrchSlotObj( Gia_Orch_t * p, int iSlot )
+{
+    return iSlot ? Gia_OrchWinObj( p, iSlot - 1 ) : 0;
+}
+static void Gia_OrchCacheKey( Gia_Orch_t * p )
+{
+    int i, iObj, LevelMin = ABC_INFINITY;
+    Vec_IntForEachEntry( p->vLeaves, iObj, i )
+        LevelMin = Abc_MinInt( LevelMin, Gia_OrchLevel(p, iObj) );
+    // the order of the object IDs decides the order of the leaves of the small cuts
+    Vec_IntClear( p->vCacheIds );
+    Vec_IntAppend( p->vCacheIds, p->vLeaves );
+    Vec_IntAppend( p->vCacheIds, p->vCone );
+    Vec_IntSort( p->vCacheIds, 0 );
+    Vec_IntClear( p->vCacheKey );
+    Vec_IntPushTwo( p->vCacheKey, GIA_ORCH_CACHE_VER, p->nCutMax );
+    Vec_IntPush( p->vCacheKey, p->fUpdateLevel );
+    Vec_IntForEachEntry( p->vCacheIds, iObj, i )
+        Vec_IntPush( p->vCacheKey, Vec_IntEntry(p->vSlot, iObj) );
+    Vec_IntPushTwo( p->vCacheKey, Vec_IntSize(p->vLeaves), Vec_IntSize(p->vCone) );
+    Vec_IntForEachEntry( p->vLeaves, iObj, i )
+        Vec_IntPush( p->vCacheKey, Gia_OrchLevel(p, iObj) - LevelMin );
+    Vec_IntForEachEntry( p->vCone, iObj, i )
+    {
+        Vec_IntPushTwo( p->vCacheKey, Gia_OrchSlotLit(p, Gia_OrchFaninLit(p, iObj, 0)), Gia_OrchSlotLit(p, Gia_OrchFaninLit(p, iObj, 1)) );
+        Vec_IntPush( p->vCacheKey, Gia_OrchRefs(p, iObj) );
+    }
+    Vec_IntPush( p->vCacheKey, Vec_IntSize(p->vSide) );
+    Vec_IntForEachEntry( p->vSide, iObj, i )
+        Vec_IntPushTwo( p->vCacheKey, Gia_OrchSlotLit(p, Gia_OrchFaninLit(p, iObj, 0)), Gia_OrchSlotLit(p, Gia_OrchFaninLit(p, iObj, 1)) );
+    Vec_IntPush( p->vCacheKey, Vec_IntEntry(p->vRequired, p->iRoot) - LevelMin );
+}
+static void Gia_OrchCacheStart( Gia_Orch_t * p )
+{
+    int Op;
+    for ( Op = 0; Op < GIA_ORCH_OPS; Op++ )
+        Vec_IntFill( p->vCacheCands[Op], 1, 0 );
+}
+static void Gia_OrchCacheAdd( Gia_Orch_t * p, int Op, Gia_OrchProg_t * pProg )
+{
+    Vec_Int_t * vCands = p->vCacheCands[Op];
+    int i, iLit;
+    if ( p->pCache == NULL || pProg->iRoot < 0 )
+        return;
+    Vec_IntAddToEntry( vCands, 0, 1 );
+    Vec_IntPush( vCands, Vec_IntSize(pProg->vIns) );
+    Vec_IntForEachEntry( pProg->vIns, iLit, i )
+        Vec_IntPush( vCands, Gia_OrchSlotLit(p, iLit) );
+    Vec_IntPush( vCands, Vec_IntSize(pProg->vGates) );
+    Vec_IntAppend( vCands, pProg->vGates );
+    Vec_IntPush( vCands, pProg->iRoot );
+}
+static void Gia_OrchCacheSave( Gia_Orch_t * p, Vec_Int_t * vData )
+{
+    int Op;
+    Vec_IntClear( vData );
+    for ( Op = 0; Op < GIA_ORCH_OPS; Op++ )
+        Vec_IntAppend( vData, p->vCacheCands[Op] );
+}
+// returns 1 if the candidate is restored and 0 if the data is wrong
+static int Gia_OrchCacheProg( Gia_Orch_t * p, Gia_OrchProg_t * pProg, Vec_Int_t * vData, int * pk )
+{
+    int i, nIns, nGates, iLit, nSlots = 1 + Vec_IntSize(p->vLeaves) + Vec_IntSize(p->vCone) + Vec_IntSize(p->vSide);
+    Vec_IntClear( pProg->vIns );
+    Vec_IntClear( pProg->vGates );
+    pProg->iRoot = -1;
+    if ( *pk >= Vec_IntSize(vData) )
+        return 0;
+    nIns = Vec_IntEntry( vData, (*pk)++ );
+    if ( nIns < 0 || nIns > GIA_ORCH_DIV_MAX || *pk + nIns >= Vec_IntSize(vData) )
+        return 0;
+    for ( i = 0; i < nIns; i++ )
+    {
+        iLit = Vec_IntEntry( vData, (*pk)++ );
+        if ( iLit < 0 || Abc_Lit2Var(iLit) >= nSlots )
+            return 0;
+        Vec_IntPush( pProg->vIns, Abc_Var2Lit(Gia_OrchSlotObj(p, Abc_Lit2Var(iLit)), Abc_LitIsCompl(iLit)) );
+    }
+    nGates = Vec_IntEntry( vData, (*pk)++ );
+    if ( nGates < 0 || (nGates & 1) || *pk + nGates >= Vec_IntSize(vData) )
+        return 0;
+    for ( i = 0; i < nGates; i++ )
+    {
+        iLit = Vec_IntEntry( vData, (*pk)++ );
+        if ( iLit < 0 || Abc_Lit2Var(iLit) > nIns + i/2 )
+            return 0;
+        Vec_IntPush( pProg->vGates, iLit );
+    }
+    pProg->iRoot = Vec_IntEntry( vData, (*pk)++ );
+    if ( pProg->iRoot < 0 || Abc_Lit2Var(pProg->iRoot) > nIns + nGates/2 )
+        return 0;
+    return 1;
+}
+static int Gia_OrchProgCheck( Gia_Orch_t * p, Gia_OrchProg_t * pProg, word * pTruth )
+{
+    int i, iLit, iLit0, iLit1, nWords = p->nWords, nIns = Vec_IntSize(pProg->vIns);
+    word * pSims;
+    Vec_WrdFill( p->vCacheSims, nWords * (1 + nIns + Vec_IntSize(pProg->vGates) / 2), 0 );
+    pSims = Vec_WrdArray( p->vCacheSims );
+    Vec_IntForEachEntry( pProg->vIns, iLit, i )
+        Abc_TtCopy( pSims + nWords * (1 + i), Gia_OrchTruth(p, Abc_Lit2Var(iLit)), nWords, Abc_LitIsCompl(iLit) );
+    for ( i = 0; i + 1 < Vec_IntSize(pProg->vGates); i += 2 )
+    {
+        iLit0 = Vec_IntEntry( pProg->vGates, i );
+        iLit1 = Vec_IntEntry( pProg->vGates, i+1 );
+        Abc_TtAndCompl( pSims + nWords * (1 + nIns + i/2), pSims + nWords * Abc_Lit2Var(iLit0), Abc_LitIsCompl(iLit0),
+            pSims + nWords * Abc_Lit2Var(iLit1), Abc_LitIsCompl(iLit1), nWords );
+    }
+    if ( Abc_LitIsCompl(pProg->iRoot) )
+        return Abc_TtOpposite( pTruth, pSims + nWords * Abc_Lit2Var(pProg->iRoot), nWords );
+    return Abc_TtEqual( pTruth, pSims + nWords * Abc_Lit2Var(pProg->iRoot), nWords );
+}
+static int Gia_OrchProgMffc( Gia_Orch_t * p, Gia_OrchProg_t * pProg )
+{
+    int i, iLit, nIns = 0, pIns[GIA_ORCH_DIV_MAX];
+    Vec_IntForEachEntry( pProg->vIns, iLit, i )
+        if ( Abc_Lit2Var(iLit) > 0 )
+            pIns[nIns++] = Abc_Lit2Var(iLit);
+    return Gia_OrchMffc( p, p->iRoot, pIns, nIns );
+}
+static int Gia_OrchCacheLookup( Gia_Orch_t * p, int * fValid, int * piEntry )
+{
+    Gia_OrchProg_t * pProg, * pTemp = &p->ProgTemp, Temp;
+    word * pTruth = Gia_OrchTruth( p, p->iRoot );
+    Vec_Int_t * vData;
+    int Op, c, nCands, k = 0, nEntries = Hsh_VecSize( p->pCache );
+    Gia_OrchCacheKey( p );
+    *piEntry = Hsh_VecManAdd( p->pCache, p->vCacheKey );
+    if ( *piEntry == nEntries )
+        Vec_WecPushLevel( p->vCacheData );
+    vData = Vec_WecEntry( p->vCacheData, *piEntry );
+    if ( Vec_IntSize(vData) == 0 )
+        return 0;
+    // the candidates are evaluated in the order of derivation, so the choice is the same
+    for ( Op = 0; Op < GIA_ORCH_OPS; Op++ )
+    {
+        pProg = &p->Progs[Op];
+        Vec_IntClear( pProg->vIns );
+        Vec_IntClear( pProg->vGates );
+        pProg->iRoot = -1;
+        fValid[Op] = 0;
+        if ( k >= Vec_IntSize(vData) || (nCands = Vec_IntEntry(vData, k++)) < 0 )
+            return 0;
+        for ( c = 0; c < nCands; c++ )
+        {
+            if ( !Gia_OrchCacheProg(p, pTemp, vData, &k) || !Gia_OrchProgCheck(p, pTemp, pTruth) )
+                return 0;
+            if ( Op == GIA_ORCH_RW )
+            {
+                p->nMffc = Gia_OrchProgMffc( p, pTemp );
+                Gia_OrchProgUpdate( p, pProg, &fValid[Op] );
+            }
+            else if ( !fValid[Op] )
+            {
+                p->nMffc = Gia_OrchProgMffc( p, pTemp );
+                if ( !Gia_OrchProgEval(p, pTemp) )
+                    continue;
+                Temp = *pProg, *pProg = *pTemp, *pTemp = Temp;
+                fValid[Op] = 1;
+            }
+        }
+    }
+    p->nCacheHits++;
+    return 1;
+}
+static void Gia_OrchCacheRead( Gia_Orch_t * p, char * pFileName )
+{
+    FILE * pFile = fopen( pFileName, "rb" );
+    Vec_Int_t * vData = Vec_IntAlloc( 100 );
+    int i, nEntries, iEntry, Value;
+    if ( pFile == NULL )
+        return;
+    while ( fscanf(pFile, "%d", &nEntries) == 1 )
+    {
+        Vec_IntClear( p->vCacheKey );
+        for ( i = 0; i < nEntries && fscanf(pFile, "%d", &Value) == 1; i++ )
+            Vec_IntPush( p->vCacheKey, Value );
+        if ( fscanf(pFile, "%d", &nEntries) != 1 )
+            break;
+        Vec_IntClear( vData );
+        for ( i = 0; i < nEntries && fscanf(pFile, "%d", &Value) == 1; i++ )
+            Vec_IntPush( vData, Value );
+        iEntry = Hsh_VecManAdd( p->pCache, p->vCacheKey );
+        if ( iEntry == Vec_WecSize(p->vCacheData) )
+            Vec_WecPushLevel( p->vCacheData );
+        Vec_IntAppend( Vec_WecEntry(p->vCacheData, iEntry), vData );
+    }
+    Vec_IntFree( vData );
+    fclose( pFile );
+}
+static void Gia_OrchCacheWrite( Gia_Orch_t * p, char * pFileName )
+{
+    FILE * pFile = fopen( pFileName, "wb" );
+    Vec_Int_t * vKey, * vData;
+    int i, k, Value;
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open cache file \"%s\" for writing.\n", pFileName );
+        return;
+    }
+    Vec_WecForEachLevel( p->vCacheData, vData, i )
+    {
+        if ( Vec_IntSize(vData) == 0 )
+            continue;
+        vKey = Hsh_VecReadEntry( p->pCache, i );
+        fprintf( pFile, "%d", Vec_IntSize(vKey) );
+        Vec_IntForEachEntry( vKey, Value, k )
+            fprintf( pFile, " %d", Value );
+        fprintf( pFile, "  %d", Vec_IntSize(vData) );
+        Vec_IntForEachEntry( vData, Value, k )
+            fprintf( pFile, " %d", Value );
+        fprintf( pFile, "\n" );
+    }
+    fclose( pFile );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Resynthesizes one node.]
+
+  Description [Computes one cut, evaluates the three operators on its
+  truth table, and applies the selected one. If vPolicy gives the order
+  of the operators for this node, the first operator accepted in this
+  order is applied, as in Abc_NtkOrchSA(). Otherwise, the operator with
+  the largest gain is applied, as in Abc_NtkOrchLocal(). If the gains
+  were precomputed for the original AIG, a node with no accepted gain
+  is skipped without evaluation, as long as none of the objects of its
+  cut has changed since then. Returns the operator applied, or -1.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Gia_OrchAcceptGain( Gia_Orch_t * p, int Op, int Gain )
+{
+    if ( Gain < 0 )
+        return 0;
+    if ( Op == GIA_ORCH_RW )
+        return Gain > 0 || (Gain == 0 && p->fUseZerosRw);
+    if ( Op == GIA_ORCH_RF )
+        return Gain > 0 || (Gain == 0 && p->fUseZerosRf);
+    return Gain > 0;
+}
+static int Gia_OrchAccept( Gia_Orch_t * p, int Op, int fValid )
+{
+    return Gia_OrchAcceptGain( p, Op, fValid ? p->Progs[Op].Gain : -1 );
+}
+static int Gia_OrchIsClean( Gia_Orch_t * p, int iRoot )
+{
+    int i, iObj;
+    if ( Gia_OrchIsDirty(p, iRoot) )
+        return 0;
+    Vec_IntForEachEntry( p->vLeaves, iObj, i )
+        if ( Gia_OrchIsDirty(p, iObj) )
+            return 0;
+    Vec_IntForEachEntry( p->vCone, iObj, i )
+        if ( Gia_OrchIsDirty(p, iObj) )
+            return 0;
+    Vec_IntForEachEntry( p->vSide, iObj, i )
+        if ( Gia_OrchIsDirty(p, iObj) )
+            return 0;
+    return 1;
+}
+static void Gia_OrchNodeCut( Gia_Orch_t * p, int iRoot )
+{
+    int Level = Gia_OrchObjLevel( p, iRoot );
+    abctime clk = Abc_Clock();
+    p->iRoot = iRoot;
+    if ( Gia_OrchLevel(p, iRoot) != Level )
+        Gia_OrchSetDirty( p, iRoot );
+    Vec_IntWriteEntry( p->vLevel, iRoot, Level );
+    Gia_OrchFindCut( p, iRoot );
+    Gia_OrchComputeTruths( p, iRoot );
+    p->timeCut += Abc_Clock() - clk;
+}
+static void Gia_OrchNodeEval( Gia_Orch_t * p, int * fValid )
+{
+    word * pTruth = Gia_OrchTruth( p, p->iRoot );
+    abctime clk = Abc_Clock();
+    int iEntry = -1;
+    p->nNodesTried++;
+    if ( p->pCache && Gia_OrchCacheLookup(p, fValid, &iEntry) )
+    {
+        p->timeEval[GIA_ORCH_RW] += Abc_Clock() - clk;
+        return;
+    }
+    if ( iEntry >= 0 )
+        Gia_OrchCacheStart( p );
+    p->nMffc = Gia_OrchMffc( p, p->iRoot, Vec_IntArray(p->vLeaves), Vec_IntSize(p->vLeaves) );
+    fValid[GIA_ORCH_RW] = Gia_OrchDeriveRw( p, &p->Progs[GIA_ORCH_RW], pTruth );
+    p->timeEval[GIA_ORCH_RW] += Abc_Clock() - clk;
+    clk = Abc_Clock();
+    Gia_OrchDeriveRs( p, &p->Progs[GIA_ORCH_RS], pTruth );
+    fValid[GIA_ORCH_RS] = p->Progs[GIA_ORCH_RS].iRoot >= 0 && Gia_OrchProgEval( p, &p->Progs[GIA_ORCH_RS] );
+    p->timeEval[GIA_ORCH_RS] += Abc_Clock() - clk;
+    clk = Abc_Clock();
+    Gia_OrchDeriveRf( p, &p->Progs[GIA_ORCH_RF], pTruth );
+    fValid[GIA_ORCH_RF] = Gia_OrchProgEval( p, &p->Progs[GIA_ORCH_RF] );
+    p->timeEval[GIA_ORCH_RF] += Abc_Clock() - clk;
+    if ( iEntry >= 0 )
+        Gia_OrchCacheSave( p, Vec_WecEntry(p->vCacheData, iEntry) );
+}
+static int Gia_OrchNode( Gia_Orch_t * p, int iRoot, int Policy, Vec_Wec_t * vGains )
+{
+    int fValid[GIA_ORCH_OPS], i, Op, Gain, OpBest = -1, GainBest = -1;
+    abctime clk;
+    Gia_OrchNodeCut( p, iRoot );
+    if ( vGains && Gia_OrchIsClean(p, iRoot) )
+    {
+        for ( Op = 0; Op < GIA_ORCH_OPS; Op++ )
+            if ( Gia_OrchAcceptGain(p, Op, Vec_IntEntry(Vec_WecEntry(vGains, Op), iRoot)) )
+                break;
+        if ( Op == GIA_ORCH_OPS )
+        {
+            p->nNodesReused++;
+            return -1;
+        }
+    }
+    Gia_OrchNodeEval( p, fValid );
+    // select the operator
+    for ( i = 0; i < GIA_ORCH_OPS; i++ )
+    {
+        Op = Policy >= 0 ? s_OrchOrders[Policy][i] : i;
+        if ( !Gia_OrchAccept(p, Op, fValid[Op]) )
+            continue;
+        Gain = p->Progs[Op].Gain;
+        if ( Policy >= 0 )
+        {
+            OpBest = Op, GainBest = Gain;
+            break;
+        }
+        // the ties are broken in the order rw, rs, rf
+        if ( GainBest < Gain || (GainBest == Gain && OpBest > GIA_ORCH_RS && Op == GIA_ORCH_RS) )
+            OpBest = Op, GainBest = Gain;
+    }
+    if ( OpBest == -1 )
+        return -1;
+    clk = Abc_Clock();
+    Gia_OrchProgApply( p, &p->Progs[OpBest] );
+    p->timeUpdate += Abc_Clock() - clk;
+    p->nOps[OpBest]++;
+    p->nGains[OpBest] += GainBest;
+    return OpBest;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the resulting AIG.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Gia_OrchRebuild_rec( Gia_Orch_t * p, Gia_Man_t * pNew, Vec_Int_t * vCopy, int iObj )
+{
+    int iLit0, iLit1;
+    if ( Vec_IntEntry(vCopy, iObj) >= 0 )
+        return Vec_IntEntry(vCopy, iObj);
+    assert( Gia_OrchIsAnd(p, iObj) );
+    iLit0 = Gia_OrchFaninLit( p, iObj, 0 );
+    iLit1 = Gia_OrchFaninLit( p, iObj, 1 );
+    iLit0 = Abc_LitNotCond( Gia_OrchRebuild_rec(p, pNew, vCopy, Abc_Lit2Var(iLit0)), Abc_LitIsCompl(iLit0) );
+    iLit1 = Abc_LitNotCond( Gia_OrchRebuild_rec(p, pNew, vCopy, Abc_Lit2Var(iLit1)), Abc_LitIsCompl(iLit1) );
+    Vec_IntWriteEntry( vCopy, iObj, Gia_ManHashAnd(pNew, iLit0, iLit1) );
+    return Vec_IntEntry(vCopy, iObj);
+}
+static Gia_Man_t * Gia_OrchRebuild( Gia_Orch_t * p, Gia_Man_t * pOld )
+{
+    Gia_Man_t * pNew;
+    Gia_Obj_t * pObj;
+    Vec_Int_t * vCopy = Vec_IntStartFull( Gia_ManObjNum(p->pGia) );
+    int i, iLit;
+    pNew = Gia_ManStart( Gia_ManObjNum(pOld) );
+    pNew->pName = Abc_UtilStrsav( pOld->pName );
+    pNew->pSpec = Abc_UtilStrsav( pOld->pSpec );
+    Vec_IntWriteEntry( vCopy, 0, 0 );
+    Gia_ManForEachCi( p->pGia, pObj, i )
+        Vec_IntWriteEntry( vCopy, Gia_ObjId(p->pGia, pObj), Gia_ManAppendCi(pNew) );
+    Gia_ManHashAlloc( pNew );
+    Gia_ManForEachCo( p->pGia, pObj, i )
+    {
+        iLit = Gia_OrchResolve( p, Gia_ObjFaninLit0p(p->pGia, pObj) );
+        iLit = Abc_LitNotCond( Gia_OrchRebuild_rec(p, pNew, vCopy, Abc_Lit2Var(iLit)), Abc_LitIsCompl(iLit) );
+        Gia_ManAppendCo( pNew, iLit );
+    }
+    Gia_ManHashStop( pNew );
+    Gia_ManSetRegNum( pNew, Gia_ManRegNum(pOld) );
+    Vec_IntFree( vCopy );
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the gains of the operators for the original AIG.]
+
+  Description [Evaluates the three operators at each node without
+  changing the AIG. Returns three arrays (rw, rs, rf) with the gain of
+  each operator for each object, -1 if the operator has no candidate,
+  and -99 for the objects that are not evaluated. The objects are split
+  into chunks given to the shares in turn, and each share evaluates
+  its nodes with its own copy of the manager as one parallel task.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_OrchGainsRange( Gia_Orch_t * p, Vec_Wec_t * vGains, int iThread, int nThreads )
+{
+    int fValid[GIA_ORCH_OPS], i, k, Op, nObjs = Vec_IntSize( Vec_WecEntry(vGains, 0) );
+    for ( k = iThread * GIA_ORCH_CHUNK; k < nObjs; k += nThreads * GIA_ORCH_CHUNK )
+    for ( i = Abc_MaxInt(k, 1); i < Abc_MinInt(k + GIA_ORCH_CHUNK, nObjs); i++ )
+    {
+        if ( !Gia_OrchIsAnd(p, i) || Gia_OrchRefs(p, i) == 0 || Gia_OrchRefs(p, i) > 1000 )
+            continue;
+        Gia_OrchNodeCut( p, i );
+        Gia_OrchNodeEval( p, fValid );
+        for ( Op = 0; Op < GIA_ORCH_OPS; Op++ )
+            Vec_IntWriteEntry( Vec_WecEntry(vGains, Op), i, fValid[Op] ? p->Progs[Op].Gain : -1 );
+    }
+}
+
+typedef struct Gia_OrchShares_t_
+{
+    Gia_Orch_t ** pMans;
+    Vec_Wec_t *   vGains;
+    int           nShares;
+} Gia_OrchShares_t;
+
+static void Gia_OrchGainsShare( void * pArg, int iShare )
+{
+    Gia_OrchShares_t * p = (Gia_OrchShares_t *)pArg;
+    // the library is per-thread
+    Dar_LibPrepare( GIA_ORCH_STRUCTS );
+    Gia_OrchGainsRange( p->pMans[iShare], p->vGains, iShare, p->nShares );
+}
+
+Vec_Wec_t * Gia_ManOrchGains( Gia_Man_t * pGia, int nCutMax, int fUpdateLevel, int nProcs, int fVerbose )
+{
+    Gia_OrchShares_t Shares;
+    Vec_Wec_t * vGains = Vec_WecStart( GIA_ORCH_OPS );
+    int i, Op;
+    abctime clk = Abc_Clock();
+    nProcs = Abc_MaxInt( nProcs, 1 );
+    for ( Op = 0; Op < GIA_ORCH_OPS; Op++ )
+        Vec_IntFill( Vec_WecEntry(vGains, Op), Gia_ManObjNum(pGia), -99 );
+    // the managers are prepared before the tasks start
+    Shares.pMans   = ABC_ALLOC( Gia_Orch_t *, nProcs );
+    Shares.vGains  = vGains;
+    Shares.nShares = nProcs;
+    for ( i = 0; i < nProcs; i++ )
+        Shares.pMans[i] = Gia_OrchStart( pGia, nCutMax, fUpdateLevel, 1, 1 );
+    Util_TaskParallelFor( nProcs, nProcs, Gia_OrchGainsShare, &Shares );
+    for ( i = 0; i < nProcs; i++ )
+        Gia_OrchStop( Shares.pMans[i] );
+    ABC_FREE( Shares.pMans );
+    if ( fVerbose )
+    {
+        printf( "Computed the gains of %d objects using %d threads.  ", Gia_ManObjNum(pGia), nProcs );
+        ABC_PRT( "Time", Abc_Clock() - clk );
+    }
+    return vGains;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps the objects into the IDs of the legacy network.]
+
+  Description [The files of Abc_NtkOrchSA() are indexed by the object IDs
+  of the network. When the network is read from an AIGER file by "read"
+  (Io_ReadAiger()), possibly followed by "strash", it has the constant,
+  the PIs, the POs, the latches each followed by its input and output,
+  and the AND nodes in the order of the file, which is also the order of
+  the AIG read by "&r". The objects without a counterpart are mapped to -1.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Gia_ManOrchNtkIds( Gia_Man_t * p )
+{
+    Vec_Int_t * vIds = Vec_IntStartFull( Gia_ManObjNum(p) );
+    Gia_Obj_t * pObj, * pObjRi, * pObjRo;
+    int i, nPis = Gia_ManPiNum(p), nPos = Gia_ManPoNum(p);
+    int iNtkId = 1 + nPis + nPos + 3 * Gia_ManRegNum(p);
+    Vec_IntWriteEntry( vIds, 0, 0 );
+    Gia_ManForEachPi( p, pObj, i )
+        Vec_IntWriteEntry( vIds, Gia_ObjId(p, pObj), 1 + i );
+    Gia_ManForEachPo( p, pObj, i )
+        Vec_IntWriteEntry( vIds, Gia_ObjId(p, pObj), 1 + nPis + i );
+    Gia_ManForEachRiRo( p, pObjRi, pObjRo, i )
+    {
+        Vec_IntWriteEntry( vIds, Gia_ObjId(p, pObjRi), 1 + nPis + nPos + 3 * i + 1 );
+        Vec_IntWriteEntry( vIds, Gia_ObjId(p, pObjRo), 1 + nPis + nPos + 3 * i + 2 );
+    }
+    Gia_ManForEachAnd( p, pObj, i )
+        Vec_IntWriteEntry( vIds, i, iNtkId++ );
+    return vIds;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads and writes the orchestration files.]
+
+  Description [Both files have one integer per line for each object ID
+  of the original AIG, or for each object ID of the legacy network if
+  vNtkIds is given (see Gia_ManOrchNtkIds()). The policy file gives the
+  order of the operators (0 to 5, as in Abc_NtkOrchSA()), or -1 for the
+  greedy selection. The decision file records the operator applied (0
+  for rw, 2 for rs, 3 for rf) or -1. The gain file has the gains of rw,
+  rs and rf on each line, as computed by Gia_ManOrchGains().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Gia_ManOrchReadPolicy( char * pFileName, int nObjs, Vec_Int_t * vNtkIds )
+{
+    Vec_Int_t * vPolicy, * vFile;
+    FILE * pFile = fopen( pFileName, "rb" );
+    int i, Value, nLines = vNtkIds ? Vec_IntFindMax(vNtkIds) + 1 : nObjs;
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open policy file \"%s\".\n", pFileName );
+        return NULL;
+    }
+    vFile = Vec_IntAlloc( nLines );
+    while ( Vec_IntSize(vFile) < nLines && fscanf(pFile, "%d", &Value) == 1 )
+        Vec_IntPush( vFile, (Value >= 0 && Value < 6) ? Value : -1 );
+    Vec_IntFillExtra( vFile, nLines, -1 );
+    fclose( pFile );
+    if ( vNtkIds == NULL )
+        return vFile;
+    vPolicy = Vec_IntStartFull( nObjs );
+    Vec_IntForEachEntry( vNtkIds, Value, i )
+        if ( Value >= 0 )
+            Vec_IntWriteEntry( vPolicy, i, Vec_IntEntry(vFile, Value) );
+    Vec_IntFree( vFile );
+    return vPolicy;
+}
+void Gia_ManOrchWriteDecisions( char * pFileName, Vec_Int_t * vDecisions, Vec_Int_t * vNtkIds )
+{
+    FILE * pFile = fopen( pFileName, "wb" );
+    Vec_Int_t * vFile = vDecisions;
+    int i, Value;
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open decision file \"%s\" for writing.\n", pFileName );
+        return;
+    }
+    if ( vNtkIds )
+    {
+        vFile = Vec_IntStartFull( Vec_IntFindMax(vNtkIds) + 1 );
+        Vec_IntForEachEntry( vNtkIds, Value, i )
+            if ( Value >= 0 )
+                Vec_IntWriteEntry( vFile, Value, Vec_IntEntry(vDecisions, i) );
+    }
+    Vec_IntForEachEntry( vFile, Value, i )
+        fprintf( pFile, "%d\n", Value );
+    if ( vFile != vDecisions )
+        Vec_IntFree( vFile );
+    fclose( pFile );
+}
+void Gia_ManOrchWriteGains( char * pFileName, Vec_Wec_t * vGains )
+{
+    FILE * pFile = fopen( pFileName, "wb" );
+    int i;
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open gain file \"%s\" for writing.\n", pFileName );
+        return;
+    }
+    for ( i = 0; i < Vec_IntSize(Vec_WecEntry(vGains, 0)); i++ )
+        fprintf( pFile, "%d %d %d\n", Vec_WecEntryEntry(vGains, GIA_ORCH_RW, i), Vec_WecEntryEntry(vGains, GIA_ORCH_RS, i), Vec_WecEntryEntry(vGains, GIA_ORCH_RF, i) );
+    fclose( pFile );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Orchestrates rewriting, resubstitution and refactoring.]
+
+  Description [Visits the AND nodes of the AIG in a topological order
+  and resynthesizes each of them with one of the three operators, while
+  the AIG is updated in place. The nodes with more than 1000 fanouts are
+  skipped. If vGains is given, it has the gains of the operators for
+  the original AIG, computed by Gia_ManOrchGains(). If pCacheFile is
+  given, the candidates of the windows are read from this file, if it
+  exists, and written back to it with the new windows at the end. If
+  fNtkIds is set, the policy and decision files are indexed by the IDs
+  of the legacy network, as in Abc_NtkOrchSA().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t * Gia_ManOrchestrate( Gia_Man_t * pGia, int nCutMax, int fUpdateLevel, int fUseZerosRw, int fUseZerosRf, Vec_Wec_t * vGains, char * pPolicyFile, char * pDecisionFile, char * pCacheFile, int fNtkIds, int fVerbose )
+{
+    Gia_Man_t * pNew;
+    Gia_Orch_t * p;
+    Vec_Int_t * vPolicy = NULL, * vDecisions, * vNtkIds = fNtkIds ? Gia_ManOrchNtkIds(pGia) : NULL;
+    int i, Op, nCached = 0, nObjs = Gia_ManObjNum(pGia);
+    abctime clk = Abc_Clock();
+    assert( nCutMax >= 2 && nCutMax < 16 );
+    if ( pPolicyFile && (vPolicy = Gia_ManOrchReadPolicy(pPolicyFile, nObjs, vNtkIds)) == NULL )
+    {
+        Vec_IntFreeP( &vNtkIds );
+        return NULL;
+    }
+    vDecisions = Vec_IntStartFull( nObjs );
+    Dar_LibPrepare( GIA_ORCH_STRUCTS );
+    p = Gia_OrchStart( pGia, nCutMax, fUpdateLevel, fUseZerosRw, fUseZerosRf );
+    if ( pCacheFile )
+    {
+        p->pCache     = Hsh_VecManStart( 1000 );
+        p->vCacheData = Vec_WecAlloc( 1000 );
+        p->vCacheKey  = Vec_IntAlloc( 100 );
+        p->vCacheIds  = Vec_IntAlloc( 100 );
+        p->vCacheSims = Vec_WrdAlloc( 100 );
+        for ( i = 0; i < GIA_ORCH_OPS; i++ )
+            p->vCacheCands[i] = Vec_IntAlloc( 100 );
+        Gia_OrchCacheRead( p, pCacheFile );
+        nCached = Vec_WecSize( p->vCacheData );
+    }
+    for ( i = 1; i < nObjs; i++ )
+    {
+        if ( !Gia_OrchIsAnd(p, i) || Vec_IntEntry(p->vRepl, i) >= 0 || Gia_OrchRefs(p, i) == 0 || Gia_OrchRefs(p, i) > 1000 )
+            continue;
+        Op = Gia_OrchNode( p, i, vPolicy ? Vec_IntEntry(vPolicy, i) : -1, vGains );
+        if ( Op >= 0 )
+            Vec_IntWriteEntry( vDecisions, i, s_OrchCodes[Op] );
+    }
+    pNew = Gia_OrchRebuild( p, pGia );
+    if ( pDecisionFile )
+        Gia_ManOrchWriteDecisions( pDecisionFile, vDecisions, vNtkIds );
+    if ( pCacheFile )
+        Gia_OrchCacheWrite( p, pCacheFile );
+    if ( fVerbose )
+    {
+        printf( "Nodes tried = %d.  Reused = %d.  ", p->nNodesTried, p->nNodesReused );
+        for ( i = 0; i < GIA_ORCH_OPS; i++ )
+            printf( "%s = %d (gain %d)  ", s_OrchNames[i], p->nOps[i], p->nGains[i] );
+        printf( "\n" );
+        if ( pCacheFile )
+            printf( "Cached windows: %d -> %d.  Hits = %d.\n", nCached, Vec_WecSize(p->vCacheData), p->nCacheHits );
+        printf( "AND nodes: %d -> %d.  Levels: %d -> %d.\n",
+            Gia_ManAndNum(pGia), Gia_ManAndNum(pNew), Gia_ManLevelNum(pGia), Gia_ManLevelNum(pNew) );
+        ABC_PRTP( "Cuts    ", p->timeCut,                   Abc_Clock() - clk );
+        for ( i = 0; i < GIA_ORCH_OPS; i++ )
+        {
+            printf( "Eval %s  ", s_OrchNames[i] );
+            ABC_PRTP( "", p->timeEval[i],                    Abc_Clock() - clk );
+        }
+        ABC_PRTP( "Update  ", p->timeUpdate,                Abc_Clock() - clk );
+        ABC_PRTP( "TOTAL   ", Abc_Clock() - clk,            Abc_Clock() - clk );
+    }
+    Gia_OrchStop( p );
+    Vec_IntFreeP( &vPolicy );
+    Vec_IntFreeP( &vNtkIds );
+    Vec_IntFree( vDecisions );
+    return pNew;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
@@ -0,0 +1,460 @@
+/**CFile****************************************************************
+
+  FileName    [giaReorder.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Scalable AIG package.]
+
+  Synopsis    [Renumbering the nodes for the locality of fanins.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: giaReorder.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "gia.h"
+#include "misc/tim/tim.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// The engines going over the nodes in the order of IDs (simulation, cut
+// enumeration, CNF generation) touch the fanins of each node. When the
+// fanins have close IDs, they are likely to be in the cache. The node order
+// produced by the synthesis commands follows the history of the network
+// rather than its structure, so the reordering below renumbers the nodes
+// in a topological order that keeps the fanins close to their fanouts.
+//
+// GIA_REORDER_DFS     - DFS from the COs visiting the deeper fanin first
+// GIA_REORDER_CLUSTER - the same DFS, but each node is immediately followed
+//                       by those of its fanouts whose fanins are ready
+// GIA_REORDER_LEVEL   - levels in the increasing order; the nodes of one
+//                       level are sorted by the position of their last fanin
+//
+// All orders start from the COs, so the dangling nodes (those not in the TFI
+// of the COs) are dropped, together with their names, LUTs, cells and their
+// membership in the equivalence classes. The number of AND nodes decreases
+// by the number of dangling nodes.
+
+// the states of the nodes during the ordering
+#define GIA_REO_NEW   0
+#define GIA_REO_OPEN  1
+#define GIA_REO_DONE  2
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the average distance between a node and its fanin.]
+
+  Description [This is the measure of locality that the reordering improves.
+  Only the fanins that are nodes are counted, because the CIs come first
+  in any order.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+double Gia_ManReorderFaninDist( Gia_Man_t * p )
+{
+    Gia_Obj_t * pObj; int i;
+    word Total = 0, nFanins = 0;
+    Gia_ManForEachAnd( p, pObj, i )
+    {
+        if ( Gia_ObjIsAnd(Gia_ObjFanin0(pObj)) )
+            Total += Gia_ObjDiff0(pObj), nFanins++;
+        if ( Gia_ObjIsAnd(Gia_ObjFanin1(pObj)) )
+            Total += Gia_ObjDiff1(pObj), nFanins++;
+    }
+    return nFanins ? (double)Total / nFanins : 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Orders the nodes.]
+
+  Description [Returns the nodes in the TFI of the COs in a topological
+  order. The deeper fanin is visited first, so that the shallower one,
+  which is typically smaller, is placed right before the node. With
+  fCluster, each node is followed by those fanouts that become ready.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Gia_ManReorderIsDone( Gia_Man_t * p, char * pMark, int iObj )
+{
+    return !Gia_ObjIsAnd(Gia_ManObj(p, iObj)) || pMark[iObj] == GIA_REO_DONE;
+}
+static inline int Gia_ManReorderIsReady( Gia_Man_t * p, char * pMark, int iObj )
+{
+    Gia_Obj_t * pObj = Gia_ManObj( p, iObj );
+    if ( !Gia_ObjIsAnd(pObj) || pMark[iObj] != GIA_REO_NEW )
+        return 0;
+    if ( !Gia_ManReorderIsDone(p, pMark, Gia_ObjFaninId0(pObj, iObj)) || !Gia_ManReorderIsDone(p, pMark, Gia_ObjFaninId1(pObj, iObj)) )
+        return 0;
+    return !Gia_ObjIsMuxId(p, iObj) || Gia_ManReorderIsDone(p, pMark, Gia_ObjFaninId2(p, iObj));
+}
+static void Gia_ManReorderCluster( Gia_Man_t * p, char * pMark, int iObj, Vec_Int_t * vOrder, Vec_Int_t * vQueue )
+{
+    int i, iFan;
+    Vec_IntClear( vQueue );
+    Vec_IntPush( vQueue, iObj );
+    while ( Vec_IntSize(vQueue) )
+    {
+        iObj = Vec_IntPop( vQueue );
+        Gia_ObjForEachFanoutStaticId( p, iObj, iFan, i )
+        {
+            if ( !Gia_ManReorderIsReady(p, pMark, iFan) )
+                continue;
+            pMark[iFan] = GIA_REO_DONE;
+            Vec_IntPush( vOrder, iFan );
+            Vec_IntPush( vQueue, iFan );
+        }
+    }
+}
+Vec_Int_t * Gia_ManReorderDfs( Gia_Man_t * p, int fCluster )
+{
+    Vec_Int_t * vOrder = Vec_IntAlloc( Gia_ManAndNum(p) );
+    Vec_Int_t * vStack = Vec_IntAlloc( 1000 );
+    Vec_Int_t * vQueue = Vec_IntAlloc( 100 );
+    char * pMark = Gia_ManColLeaseStr( p, "ReorderMark", 0 );
+    int i, iFan0, iFan1, fStopFans = 0;
+    Gia_Obj_t * pObj;
+    Gia_ManLevelNum( p );
+    if ( fCluster && p->vFanoutNums == NULL )
+        Gia_ManStaticFanoutStart( p ), fStopFans = 1;
+    Gia_ManForEachCo( p, pObj, i )
+    {
+        Vec_IntPush( vStack, Gia_ObjFaninId0p(p, pObj) );
+        while ( Vec_IntSize(vStack) )
+        {
+            int iObj = Vec_IntEntryLast( vStack );
+            pObj = Gia_ManObj( p, iObj );
+            if ( !Gia_ObjIsAnd(pObj) || pMark[iObj] == GIA_REO_DONE )
+            {
+                Vec_IntPop( vStack );
+                continue;
+            }
+            if ( pMark[iObj] == GIA_REO_OPEN )
+            {
+                Vec_IntPop( vStack );
+                pMark[iObj] = GIA_REO_DONE;
+                Vec_IntPush( vOrder, iObj );
+                if ( fCluster )
+                    Gia_ManReorderCluster( p, pMark, iObj, vOrder, vQueue );
+                continue;
+            }
+            pMark[iObj] = GIA_REO_OPEN;
+            // the fanin pushed last is visited first
+            if ( Gia_ObjIsMuxId(p, iObj) && pMark[Gia_ObjFaninId2(p, iObj)] == GIA_REO_NEW )
+                Vec_IntPush( vStack, Gia_ObjFaninId2(p, iObj) );
+            iFan0 = Gia_ObjFaninId0( pObj, iObj );
+            iFan1 = Gia_ObjFaninId1( pObj, iObj );
+            if ( Gia_ObjLevelId(p, iFan0) > Gia_ObjLevelId(p, iFan1) )
+                ABC_SWAP( int, iFan0, iFan1 );
+            if ( pMark[iFan0] == GIA_REO_NEW )
+                Vec_IntPush( vStack, iFan0 );
+            if ( pMark[iFan1] == GIA_REO_NEW )
+                Vec_IntPush( vStack, iFan1 );
+        }
+    }
+    if ( fStopFans )
+        Gia_ManStaticFanoutStop( p );
+    Gia_ManColRelease( p, pMark );
+    Vec_IntFree( vStack );
+    Vec_IntFree( vQueue );
+    return vOrder;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Orders the nodes by level.]
+
+  Description [Within each level, the nodes are sorted by the new position
+  of their last fanin, so that the nodes sharing the fanins are adjacent.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Gia_ManReorderLevel( Gia_Man_t * p )
+{
+    Vec_Int_t * vDfs = Gia_ManReorderDfs( p, 0 );
+    Vec_Int_t * vOrder = Vec_IntAlloc( Vec_IntSize(vDfs) );
+    Vec_Wec_t * vLevels = Vec_WecStart( Gia_ManLevelNum(p) + 1 );
+    Vec_Wrd_t * vKeys = Vec_WrdAlloc( 1000 );
+    int * pPos = Gia_ManColLeaseInt( p, "ReorderPos", 0 );
+    Vec_Int_t * vLevel;
+    Gia_Obj_t * pObj;
+    int i, k, iObj, iPos;
+    word Key;
+    Gia_ManForEachCi( p, pObj, i )
+        pPos[Gia_ObjId(p, pObj)] = 1 + i;
+    Vec_IntForEachEntry( vDfs, iObj, i )
+        Vec_WecPush( vLevels, Gia_ObjLevelId(p, iObj), iObj );
+    iPos = 1 + Gia_ManCiNum(p);
+    Vec_WecForEachLevel( vLevels, vLevel, i )
+    {
+        Vec_WrdClear( vKeys );
+        Vec_IntForEachEntry( vLevel, iObj, k )
+        {
+            pObj = Gia_ManObj( p, iObj );
+            Key  = Abc_MaxInt( pPos[Gia_ObjFaninId0(pObj, iObj)], pPos[Gia_ObjFaninId1(pObj, iObj)] );
+            if ( Gia_ObjIsMuxId(p, iObj) )
+                Key = Abc_MaxInt( (int)Key, pPos[Gia_ObjFaninId2(p, iObj)] );
+            Vec_WrdPush( vKeys, (Key << 32) | (word)iObj );
+        }
+        Vec_WrdSort( vKeys, 0 );
+        Vec_WrdForEachEntry( vKeys, Key, k )
+        {
+            iObj = (int)(Key & 0xFFFFFFFF);
+            pPos[iObj] = iPos++;
+            Vec_IntPush( vOrder, iObj );
+        }
+    }
+    assert( Vec_IntSize(vOrder) == Vec_IntSize(vDfs) );
+    Gia_ManColRelease( p, pPos );
+    Vec_WrdFree( vKeys );
+    Vec_WecFree( vLevels );
+    Vec_IntFree( vDfs );
+    return vOrder;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Transfers the data attached to the objects.]
+
+  Description [Assumes that pObj->Value of each object of p is the literal
+  of its copy in pNew (or ~0 if the object is not copied).]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Gia_ManReorderId( Gia_Man_t * p, int iObj )
+{
+    unsigned Value = Gia_ManObj(p, iObj)->Value;
+    return Value == ~0 ? -1 : Abc_Lit2Var( Value );
+}
+static Vec_Int_t * Gia_ManReorderEdges( Gia_Man_t * pNew, Gia_Man_t * p, Vec_Int_t * vEdge )
+{
+    Vec_Int_t * vEdgeNew = Vec_IntStart( Gia_ManObjNum(pNew) );
+    int i, iNext, iObjNew, iNextNew;
+    Vec_IntForEachEntry( vEdge, iNext, i )
+    {
+        if ( iNext == 0 || (iObjNew = Gia_ManReorderId(p, i)) < 0 || (iNextNew = Gia_ManReorderId(p, iNext)) < 0 )
+            continue;
+        Vec_IntWriteEntry( vEdgeNew, iObjNew, iNextNew );
+    }
+    return vEdgeNew;
+}
+static Vec_Int_t * Gia_ManReorderCells( Gia_Man_t * pNew, Gia_Man_t * p )
+{
+    Vec_Int_t * vCells = Vec_IntAlloc( Vec_IntSize(p->vCellMapping) );
+    int iLit, iLitNew, iFanLit, k;
+    Vec_IntFill( vCells, 2 * Gia_ManObjNum(pNew), 0 );
+    for ( iLit = 0; iLit < 2 * Gia_ManObjNum(p); iLit++ )
+    {
+        int Entry = Vec_IntEntry( p->vCellMapping, iLit );
+        if ( Entry == 0 || Gia_ManReorderId(p, Abc_Lit2Var(iLit)) < 0 )
+            continue;
+        iLitNew = Abc_LitNotCond( Gia_ManObj(p, Abc_Lit2Var(iLit))->Value, Abc_LitIsCompl(iLit) );
+        if ( Entry < 0 ) // inverter or buffer
+        {
+            Vec_IntWriteEntry( vCells, iLitNew, Entry );
+            continue;
+        }
+        Vec_IntWriteEntry( vCells, iLitNew, Vec_IntSize(vCells) );
+        Vec_IntPush( vCells, Gia_ObjCellSize(p, iLit) );
+        Gia_CellForEachFanin( p, iLit, iFanLit, k )
+            Vec_IntPush( vCells, Abc_LitNotCond(Gia_ManObj(p, Abc_Lit2Var(iFanLit))->Value, Abc_LitIsCompl(iFanLit)) );
+        Vec_IntPush( vCells, Gia_ObjCellId(p, iLit) );
+    }
+    return vCells;
+}
+static void Gia_ManReorderEquivs( Gia_Man_t * pNew, Gia_Man_t * p )
+{
+    // the representative in pNew is the class member with the smallest new ID
+    Vec_Int_t * vMin = Vec_IntStartFull( Gia_ManObjNum(p) );
+    int i, iRepr, iObjNew, iReprNew, iMin;
+    pNew->pReprs = ABC_CALLOC( Gia_Rpr_t, Gia_ManObjNum(pNew) );
+    for ( i = 0; i < Gia_ManObjNum(pNew); i++ )
+        Gia_ObjSetRepr( pNew, i, GIA_VOID );
+    for ( i = 1; i < Gia_ManObjNum(p); i++ )
+    {
+        if ( (iRepr = Gia_ObjRepr(p, i)) == GIA_VOID || iRepr == 0 )
+            continue;
+        if ( (iObjNew = Gia_ManReorderId(p, i)) < 0 )
+            continue;
+        iMin = Vec_IntEntry( vMin, iRepr );
+        if ( iMin == -1 && (iMin = Gia_ManReorderId(p, iRepr)) == -1 )
+            iMin = iObjNew;
+        Vec_IntWriteEntry( vMin, iRepr, Abc_MinInt(iMin, iObjNew) );
+    }
+    for ( i = 1; i < Gia_ManObjNum(p); i++ )
+    {
+        if ( (iObjNew = Gia_ManReorderId(p, i)) < 0 )
+            continue;
+        iRepr = Gia_ObjRepr(p, i);
+        if ( iRepr == GIA_VOID && Vec_IntEntry(vMin, i) >= 0 ) // class head
+            iReprNew = Vec_IntEntry( vMin, i );
+        else if ( iRepr == 0 )
+            iReprNew = 0;
+        else if ( iRepr != GIA_VOID )
+            iReprNew = Vec_IntEntry( vMin, iRepr );
+        else
+            continue;
+        if ( iReprNew != iObjNew )
+            Gia_ObjSetRepr( pNew, iObjNew, iReprNew );
+        pNew->pReprs[iObjNew].fProved = p->pReprs[i].fProved;
+        pNew->pReprs[iObjNew].fFailed = p->pReprs[i].fFailed;
+    }
+    pNew->pNexts = Gia_ManDeriveNexts( pNew );
+    Vec_IntFree( vMin );
+}
+static void Gia_ManReorderTransfer( Gia_Man_t * pNew, Gia_Man_t * p )
+{
+    Gia_ManTransferMapping( pNew, p );
+    Gia_ManTransferPacking( pNew, p );
+    if ( p->vCellMapping )
+        pNew->vCellMapping = Gia_ManReorderCells( pNew, p );
+    if ( p->vEdge1 )
+        pNew->vEdge1 = Gia_ManReorderEdges( pNew, p, p->vEdge1 );
+    if ( p->vEdge2 )
+        pNew->vEdge2 = Gia_ManReorderEdges( pNew, p, p->vEdge2 );
+    if ( p->pReprs )
+        Gia_ManReorderEquivs( pNew, p );
+    if ( p->vNamesNode )
+    {
+        char * pName; int i, iObjNew;
+        pNew->vNamesNode = Vec_PtrStart( Gia_ManObjNum(pNew) );
+        Vec_PtrForEachEntry( char *, p->vNamesNode, pName, i )
+            if ( pName && i < Gia_ManObjNum(p) && (iObjNew = Gia_ManReorderId(p, i)) >= 0 && Vec_PtrEntry(pNew->vNamesNode, iObjNew) == NULL )
+                Vec_PtrWriteEntry( pNew->vNamesNode, iObjNew, Abc_UtilStrsav(pName) );
+    }
+    // the data attached to the CIs and COs, whose order does not change
+    if ( p->vNamesIn )
+        pNew->vNamesIn = Vec_PtrDupStr( p->vNamesIn );
+    if ( p->vNamesOut )
+        pNew->vNamesOut = Vec_PtrDupStr( p->vNamesOut );
+    if ( p->pManTime )
+        pNew->pManTime = Tim_ManDup( (Tim_Man_t *)p->pManTime, 0 );
+    if ( p->pAigExtra )
+        pNew->pAigExtra = Gia_ManDup( p->pAigExtra );
+    pNew->nAnd2Delay = p->nAnd2Delay;
+    pNew->And2Delay  = p->And2Delay;
+    pNew->DefInArrs  = p->DefInArrs;
+    pNew->DefOutReqs = p->DefOutReqs;
+    pNew->vCiArrs    = p->vCiArrs    ? Vec_IntDup( p->vCiArrs )    : NULL;
+    pNew->vCoReqs    = p->vCoReqs    ? Vec_IntDup( p->vCoReqs )    : NULL;
+    pNew->vCoArrs    = p->vCoArrs    ? Vec_IntDup( p->vCoArrs )    : NULL;
+    pNew->vCoAttrs   = p->vCoAttrs   ? Vec_IntDup( p->vCoAttrs )   : NULL;
+    pNew->vInArrs    = p->vInArrs    ? Vec_FltDup( p->vInArrs )    : NULL;
+    pNew->vOutReqs   = p->vOutReqs   ? Vec_FltDup( p->vOutReqs )   : NULL;
+    pNew->vRegClasses= p->vRegClasses? Vec_IntDup( p->vRegClasses ): NULL;
+    pNew->vRegInits  = p->vRegInits  ? Vec_IntDup( p->vRegInits )  : NULL;
+    pNew->vFlopClasses=p->vFlopClasses?Vec_IntDup( p->vFlopClasses): NULL;
+    pNew->vConfigs   = p->vConfigs   ? Vec_IntDup( p->vConfigs )   : NULL;
+    pNew->pCellStr   = p->pCellStr   ? Abc_UtilStrsav( p->pCellStr ) : NULL;
+    if ( p->pCexSeq )
+        pNew->pCexSeq = Abc_CexDup( p->pCexSeq, Gia_ManRegNum(p) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Renumbers the nodes for the locality of fanins.]
+
+  Description [The CIs and COs keep their order. The dangling nodes, not in
+  the TFI of the COs, are removed. The mapping, the cells, the edges, the 
+  equivalences, the names and the timing information are transferred for
+  the remaining nodes; a class left with one member is removed. Returns NULL
+  for the AIGs with choices, which constrain the order of the nodes.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t * Gia_ManReorder( Gia_Man_t * p, int Type, int fVerbose )
+{
+    Gia_Man_t * pNew;
+    Gia_Obj_t * pObj;
+    Vec_Int_t * vOrder;
+    abctime clk = Abc_Clock();
+    int i;
+    if ( p->pSibls )
+    {
+        printf( "Reordering of the AIG with choices is not supported.\n" );
+        return NULL;
+    }
+    if ( Type == GIA_REORDER_DFS )
+        vOrder = Gia_ManReorderDfs( p, 0 );
+    else if ( Type == GIA_REORDER_CLUSTER )
+        vOrder = Gia_ManReorderDfs( p, 1 );
+    else if ( Type == GIA_REORDER_LEVEL )
+        vOrder = Gia_ManReorderLevel( p );
+    else
+    {
+        printf( "Unknown ordering type %d.\n", Type );
+        return NULL;
+    }
+    pNew = Gia_ManStart( Gia_ManObjNum(p) );
+    pNew->pName = Abc_UtilStrsav( p->pName );
+    pNew->pSpec = Abc_UtilStrsav( p->pSpec );
+    pNew->fGiaSimple = p->fGiaSimple;
+    if ( p->pMuxes )
+        pNew->pMuxes = ABC_CALLOC( unsigned, pNew->nObjsAlloc );
+    Gia_ManFillValue( p );
+    Gia_ManConst0(p)->Value = 0;
+    Gia_ManForEachCi( p, pObj, i )
+        pObj->Value = Gia_ManAppendCi( pNew );
+    Gia_ManForEachObjVec( vOrder, p, pObj, i )
+    {
+        if ( Gia_ObjIsBuf(pObj) )
+            pObj->Value = Gia_ManAppendBuf( pNew, Gia_ObjFanin0Copy(pObj) );
+        else if ( Gia_ObjIsMux(p, pObj) )
+            pObj->Value = Gia_ManAppendMux( pNew, Gia_ObjFanin2Copy(p, pObj), Gia_ObjFanin1Copy(pObj), Gia_ObjFanin0Copy(pObj) );
+        else if ( Gia_ObjIsXor(pObj) )
+            pObj->Value = Gia_ManAppendXorReal( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+        else
+            pObj->Value = Gia_ManAppendAnd( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+    }
+    Gia_ManForEachCo( p, pObj, i )
+        pObj->Value = Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(pObj) );
+    Gia_ManSetRegNum( pNew, Gia_ManRegNum(p) );
+    pNew->nConstrs = p->nConstrs;
+    Gia_ManReorderTransfer( pNew, p );
+    if ( fVerbose )
+    {
+        printf( "Reordered %d nodes (%d removed).  Average fanin distance: %.2f -> %.2f.  ",
+            Vec_IntSize(vOrder), Gia_ManAndNum(p) - Vec_IntSize(vOrder), Gia_ManReorderFaninDist(p), Gia_ManReorderFaninDist(pNew) );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    Vec_IntFree( vOrder );
+    return pNew;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
@@ -1533,7 +1533,7 @@ Vec_Int_t * Gia_ManResubOne( Vec_Ptr_t * vDivs, int nWords, int nLimit, int nDiv
   SeeAlso     []
 
 ***********************************************************************/
-static Gia_ResbMan_t * s_pResbMan = NULL;
+static ABC_THREAD_LOCAL Gia_ResbMan_t * s_pResbMan = NULL;
 
 void Abc_ResubPrepareManager( int nWords )
 {
@@ -0,0 +1,517 @@
+/**CFile****************************************************************
+
+  FileName    [giaSnap.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Scalable AIG package.]
+
+  Synopsis    [Native snapshot of the AIG with the attached data.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: giaSnap.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "gia.h"
+#include "misc/tim/tim.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// The snapshot is the header followed by the sections. Each section is
+// the tag, the item size, the byte count, and the raw data padded to 8 bytes.
+// The arrays are written as they are kept in memory, so the snapshot is only
+// portable between the binaries with the same layout of Gia_Obj_t and the
+// same byte order (both are checked when reading). The unknown sections
+// are skipped, which allows for adding new ones without changing the version.
+
+#define GIA_SNAP_MAGIC    "GIASNAP"
+#define GIA_SNAP_VERSION  1
+
+typedef struct Gia_SnapHead_t_ Gia_SnapHead_t;
+struct Gia_SnapHead_t_
+{
+    char           Magic[8];      // GIA_SNAP_MAGIC
+    int            Version;       // GIA_SNAP_VERSION
+    int            ObjSize;       // sizeof(Gia_Obj_t)
+    unsigned       Endian;        // 0x01020304 in the byte order of the writer
+    int            nObjs;         // the number of objects
+    int            nRegs;         // the number of flops
+    int            nConstrs;      // the number of constraints
+    int            nLevels;       // the number of levels (if vLevels is saved)
+    int            fGiaSimple;    // simple mode
+};
+
+typedef struct Gia_SnapSec_t_ Gia_SnapSec_t;
+struct Gia_SnapSec_t_
+{
+    int            Tag;           // the section type
+    int            ItemSize;      // the size of one entry in bytes
+    word           nBytes;        // the size of the data in bytes
+};
+
+enum {
+    GIA_SNAP_OBJS = 1,            // the object array
+    GIA_SNAP_CIS,                 // the CI IDs
+    GIA_SNAP_COS,                 // the CO IDs
+    GIA_SNAP_MUXES,               // the MUX control literals
+    GIA_SNAP_MAPPING,             // vMapping
+    GIA_SNAP_CELLS,               // vCellMapping
+    GIA_SNAP_REPRS,               // pReprs
+    GIA_SNAP_NEXTS,               // pNexts
+    GIA_SNAP_SIBLS,               // pSibls
+    GIA_SNAP_LEVELS,              // vLevels
+    GIA_SNAP_TIMING,              // the timing manager as saved by Tim_ManSave()
+    GIA_SNAP_FLOPCLS,             // vFlopClasses
+    GIA_SNAP_REGINITS,            // vRegInits
+    GIA_SNAP_NAMESIN,             // the input names (zero-terminated strings)
+    GIA_SNAP_NAMESOUT,            // the output names
+    GIA_SNAP_NAMESNODE,           // the node names
+    GIA_SNAP_NAME,                // the network name
+    GIA_SNAP_SPEC                 // the spec name
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Writes one section.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Gia_SnapWriteSection( FILE * pFile, int Tag, int ItemSize, void * pData, word nBytes )
+{
+    static char Zeros[8] = {0};
+    Gia_SnapSec_t Sec;
+    Sec.Tag      = Tag;
+    Sec.ItemSize = ItemSize;
+    Sec.nBytes   = nBytes;
+    fwrite( &Sec, sizeof(Gia_SnapSec_t), 1, pFile );
+    if ( nBytes )
+        fwrite( pData, (size_t)nBytes, 1, pFile );
+    if ( nBytes % 8 )
+        fwrite( Zeros, (size_t)(8 - nBytes % 8), 1, pFile );
+}
+static void Gia_SnapWriteVecInt( FILE * pFile, int Tag, Vec_Int_t * vVec )
+{
+    if ( vVec )
+        Gia_SnapWriteSection( pFile, Tag, sizeof(int), Vec_IntArray(vVec), (word)sizeof(int) * Vec_IntSize(vVec) );
+}
+static void Gia_SnapWriteNames( FILE * pFile, int Tag, Vec_Ptr_t * vNames )
+{
+    Vec_Str_t * vStr;
+    char * pName; int i;
+    if ( vNames == NULL )
+        return;
+    vStr = Vec_StrAlloc( 1000 );
+    Vec_PtrForEachEntry( char *, vNames, pName, i )
+        Vec_StrPrintStr( vStr, pName ), Vec_StrPush( vStr, 0 );
+    Gia_SnapWriteSection( pFile, Tag, Vec_PtrSize(vNames), Vec_StrArray(vStr), Vec_StrSize(vStr) );
+    Vec_StrFree( vStr );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the snapshot of the AIG.]
+
+  Description [Writes the object array and the attached data (mapping,
+  cell mapping, equivalences, choices, levels, timing, flop classes,
+  initial state and names) as they are in memory.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_ManSnapWrite( Gia_Man_t * p, char * pFileName, int fVerbose )
+{
+    abctime clk = Abc_Clock();
+    Gia_SnapHead_t Head;
+    FILE * pFile;
+    word nBytes;
+    int nObjs = Gia_ManObjNum(p);
+    pFile = fopen( pFileName, "wb" );
+    if ( pFile == NULL )
+    {
+        printf( "Gia_ManSnapWrite(): Cannot open the output file \"%s\".\n", pFileName );
+        return 0;
+    }
+    memset( &Head, 0, sizeof(Gia_SnapHead_t) );
+    memcpy( Head.Magic, GIA_SNAP_MAGIC, strlen(GIA_SNAP_MAGIC) );
+    Head.Version    = GIA_SNAP_VERSION;
+    Head.ObjSize    = sizeof(Gia_Obj_t);
+    Head.Endian     = 0x01020304;
+    Head.nObjs      = nObjs;
+    Head.nRegs      = p->nRegs;
+    Head.nConstrs   = p->nConstrs;
+    Head.nLevels    = p->nLevels;
+    Head.fGiaSimple = p->fGiaSimple;
+    fwrite( &Head, sizeof(Gia_SnapHead_t), 1, pFile );
+    // the structure
+    Gia_SnapWriteSection( pFile, GIA_SNAP_OBJS, sizeof(Gia_Obj_t), p->pObjs, (word)sizeof(Gia_Obj_t) * nObjs );
+    Gia_SnapWriteVecInt( pFile, GIA_SNAP_CIS, p->vCis );
+    Gia_SnapWriteVecInt( pFile, GIA_SNAP_COS, p->vCos );
+    if ( p->pMuxes )
+        Gia_SnapWriteSection( pFile, GIA_SNAP_MUXES, sizeof(unsigned), p->pMuxes, (word)sizeof(unsigned) * nObjs );
+    // the attached data
+    Gia_SnapWriteVecInt( pFile, GIA_SNAP_MAPPING, p->vMapping );
+    Gia_SnapWriteVecInt( pFile, GIA_SNAP_CELLS, p->vCellMapping );
+    if ( p->pReprs )
+        Gia_SnapWriteSection( pFile, GIA_SNAP_REPRS, sizeof(Gia_Rpr_t), p->pReprs, (word)sizeof(Gia_Rpr_t) * nObjs );
+    if ( p->pNexts )
+        Gia_SnapWriteSection( pFile, GIA_SNAP_NEXTS, sizeof(int), p->pNexts, (word)sizeof(int) * nObjs );
+    if ( p->pSibls )
+        Gia_SnapWriteSection( pFile, GIA_SNAP_SIBLS, sizeof(int), p->pSibls, (word)sizeof(int) * nObjs );
+    if ( p->vLevels && Vec_IntSize(p->vLevels) >= nObjs )
+        Gia_SnapWriteSection( pFile, GIA_SNAP_LEVELS, sizeof(int), Vec_IntArray(p->vLevels), (word)sizeof(int) * nObjs );
+    if ( p->pManTime )
+    {
+        Vec_Str_t * vStr = Tim_ManSave( (Tim_Man_t *)p->pManTime, 0 );
+        Gia_SnapWriteSection( pFile, GIA_SNAP_TIMING, 1, Vec_StrArray(vStr), Vec_StrSize(vStr) );
+        Vec_StrFree( vStr );
+    }
+    Gia_SnapWriteVecInt( pFile, GIA_SNAP_FLOPCLS, p->vFlopClasses );
+    Gia_SnapWriteVecInt( pFile, GIA_SNAP_REGINITS, p->vRegInits );
+    Gia_SnapWriteNames( pFile, GIA_SNAP_NAMESIN, p->vNamesIn );
+    Gia_SnapWriteNames( pFile, GIA_SNAP_NAMESOUT, p->vNamesOut );
+    Gia_SnapWriteNames( pFile, GIA_SNAP_NAMESNODE, p->vNamesNode );
+    if ( p->pName )
+        Gia_SnapWriteSection( pFile, GIA_SNAP_NAME, 1, p->pName, strlen(p->pName) + 1 );
+    if ( p->pSpec )
+        Gia_SnapWriteSection( pFile, GIA_SNAP_SPEC, 1, p->pSpec, strlen(p->pSpec) + 1 );
+    nBytes = (word)ftell( pFile );
+    fclose( pFile );
+    if ( fVerbose )
+    {
+        printf( "Written snapshot with %d objects (%.2f MB).  ", nObjs, 1.0*nBytes/(1<<20) );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the buffer starts with the snapshot header.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Gia_ManSnapIsSnapshot( char * pContents, size_t nSize )
+{
+    return nSize >= sizeof(Gia_SnapHead_t) && !strncmp( pContents, GIA_SNAP_MAGIC, 8 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks the size of one section.]
+
+  Description [Returns the error message, or NULL if the section is
+  well-formed. The arrays with one entry per object should have exactly
+  nObjs entries, the other arrays should have whole entries, and the
+  strings should be zero-terminated inside the section.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static char * Gia_SnapCheckSection( Gia_SnapSec_t * pSec, char * pData, int nObjs )
+{
+    switch ( pSec->Tag )
+    {
+    case GIA_SNAP_OBJS:
+        return pSec->nBytes == (word)sizeof(Gia_Obj_t) * nObjs ? NULL : "the object array has a wrong size";
+    case GIA_SNAP_MUXES:
+    case GIA_SNAP_NEXTS:
+    case GIA_SNAP_SIBLS:
+    case GIA_SNAP_LEVELS:
+        return pSec->nBytes == (word)sizeof(int) * nObjs ? NULL : "a per-object array has a wrong size";
+    case GIA_SNAP_REPRS:
+        return pSec->nBytes == (word)sizeof(Gia_Rpr_t) * nObjs ? NULL : "the representative array has a wrong size";
+    case GIA_SNAP_CIS:
+    case GIA_SNAP_COS:
+    case GIA_SNAP_MAPPING:
+    case GIA_SNAP_CELLS:
+    case GIA_SNAP_FLOPCLS:
+    case GIA_SNAP_REGINITS:
+        return pSec->nBytes % sizeof(int) == 0 && pSec->nBytes / sizeof(int) < (word)0x7FFFFFFF ? NULL : "an integer array has a wrong size";
+    case GIA_SNAP_TIMING:
+        return pSec->nBytes < (word)0x7FFFFFFF ? NULL : "the timing manager is too large";
+    case GIA_SNAP_NAMESIN:
+    case GIA_SNAP_NAMESOUT:
+    case GIA_SNAP_NAMESNODE:
+        return pSec->ItemSize >= 0 && (pSec->nBytes == 0 || pData[pSec->nBytes-1] == 0) ? NULL : "a name list is not terminated";
+    case GIA_SNAP_NAME:
+    case GIA_SNAP_SPEC:
+        return pSec->nBytes > 0 && pData[pSec->nBytes-1] == 0 ? NULL : "a name is not terminated";
+    default:
+        return NULL;
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks the structure of the loaded manager.]
+
+  Description [Returns the error message, or NULL if the fanins point
+  to the preceding objects and the CI/CO arrays agree with the objects.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static char * Gia_SnapCheckMan( Gia_Man_t * p )
+{
+    Gia_Obj_t * pObj;
+    int i, iObj;
+    if ( Gia_ManCiNum(p) + Gia_ManCoNum(p) >= p->nObjs || p->nRegs > Gia_ManCiNum(p) || p->nRegs > Gia_ManCoNum(p) )
+        return "the numbers of CIs, COs, and flops disagree";
+    pObj = Gia_ManConst0(p);
+    if ( pObj->fTerm || pObj->iDiff0 != GIA_NONE || pObj->iDiff1 != GIA_NONE )
+        return "the constant object is corrupted";
+    Vec_IntForEachEntry( p->vCis, iObj, i )
+        if ( iObj <= 0 || iObj >= p->nObjs || !Gia_ObjIsCi(Gia_ManObj(p, iObj)) || Gia_ObjCioId(Gia_ManObj(p, iObj)) != i )
+            return "the CI array does not match the objects";
+    Vec_IntForEachEntry( p->vCos, iObj, i )
+        if ( iObj <= 0 || iObj >= p->nObjs || !Gia_ObjIsCo(Gia_ManObj(p, iObj)) || Gia_ObjCioId(Gia_ManObj(p, iObj)) != i )
+            return "the CO array does not match the objects";
+    Gia_ManForEachObj1( p, pObj, i )
+    {
+        if ( Gia_ObjIsCi(pObj) )
+        {
+            if ( Gia_ObjCioId(pObj) >= Gia_ManCiNum(p) || Vec_IntEntry(p->vCis, Gia_ObjCioId(pObj)) != i )
+                return "a CI is not in the CI array";
+            continue;
+        }
+        if ( pObj->iDiff0 == 0 || pObj->iDiff0 > (unsigned)i )
+            return "a fanin does not precede its fanout";
+        if ( Gia_ObjIsCo(pObj) )
+        {
+            if ( Gia_ObjCioId(pObj) >= Gia_ManCoNum(p) || Vec_IntEntry(p->vCos, Gia_ObjCioId(pObj)) != i )
+                return "a CO is not in the CO array";
+            continue;
+        }
+        if ( pObj->iDiff1 == 0 || pObj->iDiff1 > (unsigned)i )
+            return "a fanin does not precede its fanout";
+        if ( p->pMuxes && p->pMuxes[i] && Abc_Lit2Var(p->pMuxes[i]) >= i )
+            return "a MUX control does not precede its fanout";
+    }
+    for ( i = 0; i < p->nObjs; i++ )
+    {
+        if ( p->pReprs && p->pReprs[i].iRepr != GIA_VOID && (int)p->pReprs[i].iRepr >= p->nObjs )
+            return "a representative is out of range";
+        if ( (p->pNexts && (p->pNexts[i] < 0 || p->pNexts[i] >= p->nObjs)) || (p->pSibls && (p->pSibls[i] < 0 || p->pSibls[i] >= p->nObjs)) )
+            return "an equivalence class is out of range";
+    }
+    if ( p->vMapping && Vec_IntSize(p->vMapping) < p->nObjs )
+        return "the mapping is shorter than the object array";
+    for ( i = 0; p->vMapping && i < p->nObjs; i++ )
+        if ( Vec_IntEntry(p->vMapping, i) && (Vec_IntEntry(p->vMapping, i) < p->nObjs || Vec_IntEntry(p->vMapping, i) >= Vec_IntSize(p->vMapping)) )
+            return "the mapping is out of range";
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the snapshot from the memory buffer.]
+
+  Description [The buffer is typically the file mapped into memory.
+  The arrays are copied into the manager as they are, without decoding.
+  Each section is checked against the number of objects and the end of
+  the buffer, and the structure is checked after loading. If a check
+  fails, the partially loaded manager is freed and NULL is returned.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Vec_Ptr_t * Gia_SnapReadNames( char * pData, int nNames, word nBytes )
+{
+    Vec_Ptr_t * vNames = Vec_PtrAlloc( nNames );
+    char * pCur = pData, * pEnd = pData + nBytes;
+    while ( pCur < pEnd && Vec_PtrSize(vNames) < nNames )
+    {
+        Vec_PtrPush( vNames, Abc_UtilStrsav(pCur) );
+        pCur += strlen(pCur) + 1;
+    }
+    return vNames;
+}
+static void * Gia_SnapReadArray( char * pData, word nBytes )
+{
+    void * pArray = ABC_ALLOC( char, Abc_MaxWord(nBytes, 1) );
+    memcpy( pArray, pData, (size_t)nBytes );
+    return pArray;
+}
+static Vec_Int_t * Gia_SnapReadVecInt( char * pData, word nBytes )
+{
+    return Vec_IntAllocArrayCopy( (int *)pData, (int)(nBytes / sizeof(int)) );
+}
+Gia_Man_t * Gia_ManSnapReadFromMemory( char * pContents, size_t nSize )
+{
+    Gia_Man_t * p;
+    Gia_SnapHead_t * pHead = (Gia_SnapHead_t *)pContents;
+    char * pCur = pContents + sizeof(Gia_SnapHead_t), * pEnd = pContents + nSize;
+    char * pError = NULL;
+    unsigned uSeen = 0;
+    if ( !Gia_ManSnapIsSnapshot(pContents, nSize) )
+    {
+        printf( "Gia_ManSnapRead(): The file is not a GIA snapshot.\n" );
+        return NULL;
+    }
+    if ( pHead->Version != GIA_SNAP_VERSION )
+    {
+        printf( "Gia_ManSnapRead(): The snapshot version (%d) differs from the current one (%d).\n", pHead->Version, GIA_SNAP_VERSION );
+        return NULL;
+    }
+    if ( pHead->ObjSize != (int)sizeof(Gia_Obj_t) || pHead->Endian != 0x01020304 )
+    {
+        printf( "Gia_ManSnapRead(): The snapshot was written by a binary with a different object layout or byte order.\n" );
+        printf( "The snapshots of the wide build (ABC_USE_WIDE_GIA, up to 2^30 objects) are read only by the wide build.\n" );
+        return NULL;
+    }
+    if ( pHead->nObjs < 1 || pHead->nObjs >= GIA_MAX_OBJS || (word)sizeof(Gia_Obj_t) * pHead->nObjs > (word)nSize ||
+         pHead->nRegs < 0 || pHead->nConstrs < 0 || pHead->nLevels < 0 )
+    {
+        printf( "Gia_ManSnapRead(): The snapshot header is corrupted.\n" );
+        return NULL;
+    }
+    p = Gia_ManStart( pHead->nObjs );
+    p->nObjs      = pHead->nObjs;
+    p->nRegs      = pHead->nRegs;
+    p->nConstrs   = pHead->nConstrs;
+    p->fGiaSimple = pHead->fGiaSimple;
+    while ( pError == NULL && pCur < pEnd )
+    {
+        Gia_SnapSec_t * pSec = (Gia_SnapSec_t *)pCur;
+        char * pData = pCur + sizeof(Gia_SnapSec_t);
+        if ( (size_t)(pEnd - pCur) < sizeof(Gia_SnapSec_t) || pSec->nBytes > (word)(pEnd - pData) )
+        {
+            pError = "the snapshot is truncated";
+            break;
+        }
+        pCur = pData + Abc_MinWord( (pSec->nBytes + 7) & ~(word)7, (word)(pEnd - pData) );
+        if ( (pError = Gia_SnapCheckSection(pSec, pData, p->nObjs)) )
+            break;
+        if ( pSec->Tag > 0 && pSec->Tag < 32 )
+        {
+            if ( uSeen & (1 << pSec->Tag) )
+            {
+                pError = "a section is repeated";
+                break;
+            }
+            uSeen |= 1 << pSec->Tag;
+        }
+        switch ( pSec->Tag )
+        {
+        case GIA_SNAP_OBJS:
+            memcpy( p->pObjs, pData, (size_t)pSec->nBytes );
+            break;
+        case GIA_SNAP_CIS:
+            Vec_IntFree( p->vCis );
+            p->vCis = Gia_SnapReadVecInt( pData, pSec->nBytes );
+            break;
+        case GIA_SNAP_COS:
+            Vec_IntFree( p->vCos );
+            p->vCos = Gia_SnapReadVecInt( pData, pSec->nBytes );
+            break;
+        case GIA_SNAP_MUXES:
+            p->pMuxes = ABC_CALLOC( unsigned, p->nObjsAlloc );
+            memcpy( p->pMuxes, pData, (size_t)pSec->nBytes );
+            break;
+        case GIA_SNAP_MAPPING:
+            p->vMapping = Gia_SnapReadVecInt( pData, pSec->nBytes );
+            break;
+        case GIA_SNAP_CELLS:
+            p->vCellMapping = Gia_SnapReadVecInt( pData, pSec->nBytes );
+            break;
+        case GIA_SNAP_REPRS:
+            p->pReprs = (Gia_Rpr_t *)Gia_SnapReadArray( pData, pSec->nBytes );
+            break;
+        case GIA_SNAP_NEXTS:
+            p->pNexts = (int *)Gia_SnapReadArray( pData, pSec->nBytes );
+            break;
+        case GIA_SNAP_SIBLS:
+            p->pSibls = (int *)Gia_SnapReadArray( pData, pSec->nBytes );
+            break;
+        case GIA_SNAP_LEVELS:
+            p->vLevels = Gia_SnapReadVecInt( pData, pSec->nBytes );
+            p->nLevels = pHead->nLevels;
+            break;
+        case GIA_SNAP_TIMING:
+        {
+            Vec_Str_t * vStr = Vec_StrAllocArrayCopy( pData, (int)pSec->nBytes );
+            p->pManTime = Tim_ManLoad( vStr, 0 );
+            Vec_StrFree( vStr );
+            break;
+        }
+        case GIA_SNAP_FLOPCLS:
+            p->vFlopClasses = Gia_SnapReadVecInt( pData, pSec->nBytes );
+            break;
+        case GIA_SNAP_REGINITS:
+            p->vRegInits = Gia_SnapReadVecInt( pData, pSec->nBytes );
+            break;
+        case GIA_SNAP_NAMESIN:
+            p->vNamesIn = Gia_SnapReadNames( pData, pSec->ItemSize, pSec->nBytes );
+            break;
+        case GIA_SNAP_NAMESOUT:
+            p->vNamesOut = Gia_SnapReadNames( pData, pSec->ItemSize, pSec->nBytes );
+            break;
+        case GIA_SNAP_NAMESNODE:
+            p->vNamesNode = Gia_SnapReadNames( pData, pSec->ItemSize, pSec->nBytes );
+            break;
+        case GIA_SNAP_NAME:
+            ABC_FREE( p->pName );
+            p->pName = Abc_UtilStrsav( pData );
+            break;
+        case GIA_SNAP_SPEC:
+            ABC_FREE( p->pSpec );
+            p->pSpec = Abc_UtilStrsav( pData );
+            break;
+        default: // written by a newer binary
+            break;
+        }
+    }
+    if ( pError == NULL && !(uSeen & (1 << GIA_SNAP_OBJS)) )
+        pError = "the object array is missing";
+    if ( pError == NULL )
+        pError = Gia_SnapCheckMan( p );
+    if ( pError )
+    {
+        printf( "Gia_ManSnapRead(): The snapshot is corrupted (%s).\n", pError );
+        Gia_ManStop( p );
+        return NULL;
+    }
+    Gia_ManCleanMark01( p );
+    return p;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
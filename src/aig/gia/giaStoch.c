@@ -28,15 +28,7 @@
 #include <unistd.h>
 #endif
 
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#endif
-
-#endif
+#include "misc/util/utilTask.h"
 
 
 ABC_NAMESPACE_IMPL_START
@@ -60,24 +52,40 @@ ABC_NAMESPACE_IMPL_START
   SeeAlso     []
 
 ***********************************************************************/
-Gia_Man_t * Gia_StochProcessOne( Gia_Man_t * p, char * pScript, int Rand, int TimeSecs )
+Gia_Man_t * Gia_StochRunScript( Gia_Man_t * p, char * pScript, char * FileName, int fSkipStrash )
 {
-    Gia_Man_t * pNew;
-    char FileName[100], Command[1000];
-    sprintf( FileName, "%06x.aig", Rand );
+    Gia_Man_t * pNew = NULL;
+    char * pFileOut = ABC_ALLOC( char, strlen(FileName) + 2 );
+    char * pCommand = ABC_ALLOC( char, strlen(pScript) + 2 * strlen(FileName) + 100 );
+    FILE * pFile;
+    // the result goes to another file, so that a failed script leaves no result
+    sprintf( pFileOut, "o%s", FileName );
     Gia_AigerWrite( p, FileName, 0, 0, 0 );
-    sprintf( Command, "./abc -q \"&read %s; %s; &write %s\"", FileName, pScript, FileName );
-    if ( system( (char *)Command ) )    
+    sprintf( pCommand, "./abc -q \"&read %s; %s; &write %s\"", FileName, pScript, pFileOut );
+    if ( system( pCommand ) )    
     {
         fprintf( stderr, "The following command has returned non-zero exit status:\n" );
-        fprintf( stderr, "\"%s\"\n", (char *)Command );
+        fprintf( stderr, "\"%s\"\n", pCommand );
         fprintf( stderr, "Sorry for the inconvenience.\n" );
         fflush( stdout );
-        unlink( FileName );
-        return Gia_ManDup(p);
     }    
-    pNew = Gia_AigerRead( FileName, 0, 0, 0 );
+    else if ( (pFile = fopen( pFileOut, "rb" )) )
+    {
+        fclose( pFile );
+        pNew = Gia_AigerRead( pFileOut, 0, fSkipStrash, 0 );
+    }
     unlink( FileName );
+    unlink( pFileOut );
+    ABC_FREE( pFileOut );
+    ABC_FREE( pCommand );
+    return pNew;
+}
+Gia_Man_t * Gia_StochProcessOne( Gia_Man_t * p, char * pScript, int Rand, int TimeSecs )
+{
+    Gia_Man_t * pNew;
+    char FileName[100];
+    sprintf( FileName, "%06x.aig", Rand );
+    pNew = Gia_StochRunScript( p, pScript, FileName, 0 );
     if ( pNew && Gia_ManAndNum(pNew) < Gia_ManAndNum(p) )
         return pNew;
     Gia_ManStopP( &pNew );
@@ -110,107 +118,155 @@ void Gia_StochProcessArray( Vec_Ptr_t * vGias, char * pScript, int TimeSecs, int
   SeeAlso     []
 
 ***********************************************************************/
-#ifndef ABC_USE_PTHREADS
-
-void Gia_StochProcess( Vec_Ptr_t * vGias, char * pScript, int nProcs, int TimeSecs, int fVerbose )
-{
-    Gia_StochProcessArray( vGias, pScript, TimeSecs, fVerbose );
-}
-
-#else // pthreads are used
-
-
-#define PAR_THR_MAX 100
-typedef struct Gia_StochThData_t_
+typedef struct Gia_StochTask_t_
 {
     Vec_Ptr_t *  vGias;
     char *       pScript;
-    int          Index;
-    int          Rand;
+    int *        pRands;
     int          nTimeOut;
-    int          fWorking;
-} Gia_StochThData_t;
+} Gia_StochTask_t;
 
-void * Gia_StochWorkerThread( void * pArg )
+void Gia_StochProcessItem( void * pArg, int Index )
 {
-    Gia_StochThData_t * pThData = (Gia_StochThData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
-    Gia_Man_t * pGia, * pNew;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->Index == -1 )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        pGia = (Gia_Man_t *)Vec_PtrEntry( pThData->vGias, pThData->Index );
-        pNew = Gia_StochProcessOne( pGia, pThData->pScript, pThData->Rand, pThData->nTimeOut );
-        Gia_ManStop( pGia );
-        Vec_PtrWriteEntry( pThData->vGias, pThData->Index, pNew );
-        pThData->fWorking = 0;
-    }
-    assert( 0 );
-    return NULL;
+    Gia_StochTask_t * p = (Gia_StochTask_t *)pArg;
+    Gia_Man_t * pGia = (Gia_Man_t *)Vec_PtrEntry( p->vGias, Index );
+    Gia_Man_t * pNew = Gia_StochProcessOne( pGia, p->pScript, p->pRands[Index], p->nTimeOut );
+    Gia_ManStop( pGia );
+    Vec_PtrWriteEntry( p->vGias, Index, pNew );
 }
 
 void Gia_StochProcess( Vec_Ptr_t * vGias, char * pScript, int nProcs, int TimeSecs, int fVerbose )
 {
-    Gia_StochThData_t ThData[PAR_THR_MAX];
-    pthread_t WorkerThread[PAR_THR_MAX];
-    int i, k, status;
+    Gia_StochTask_t Task;
+    int k;
     if ( fVerbose )
         printf( "Running concurrent synthesis with %d processes.\n", nProcs );
     fflush( stdout );
     if ( nProcs < 2 )
         return Gia_StochProcessArray( vGias, pScript, TimeSecs, fVerbose );
-    // subtract manager thread
-    nProcs--;
-    assert( nProcs >= 1 && nProcs <= PAR_THR_MAX );
-    // start threads
+    // the seeds are assigned to the parts, so the result does not depend on scheduling
+    Task.vGias    = vGias;
+    Task.pScript  = pScript;
+    Task.pRands   = ABC_ALLOC( int, Vec_PtrSize(vGias) );
+    Task.nTimeOut = TimeSecs;
     Abc_Random(1);
-    for ( i = 0; i < nProcs; i++ )
+    for ( k = 0; k < Vec_PtrSize(vGias); k++ )
+        Task.pRands[k] = Abc_Random(0) % 0x1000000;
+    Util_TaskParallelFor( nProcs, Vec_PtrSize(vGias), Gia_StochProcessItem, &Task );
+    ABC_FREE( Task.pRands );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs alternative scripts concurrently and keeps the best result.]
+
+  Description [Each script is applied to a copy of the AIG in a new frame
+  (Abc_FrameNew), which has its own networks and settings. The scripts run
+  as parallel tasks (up to the global thread limit). Metric 0 (area) compares the
+  number of LUTs if the result is mapped and the number of AND nodes
+  otherwise; metric 1 (delay) compares the LUT level or the AIG level.
+  The other metric breaks ties, then the order of the scripts.
+  The results are not compared if some of them are mapped and others
+  are not, because LUTs and AND nodes are different units.
+  Returns NULL if none of the scripts succeeded (pBest is set to -1)
+  or if the results are mixed (pBest is set to -2); otherwise, pBest
+  is set to the index of the chosen script.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Gia_StochFork_t_
+{
+    Gia_Man_t *  p;
+    Vec_Ptr_t *  vScripts;
+    Gia_Man_t ** pRes;
+} Gia_StochFork_t;
+
+void Gia_StochForkItem( void * pArg, int i )
+{
+    extern Gia_Man_t * Gia_ManDupWithMapping( Gia_Man_t * pGia );
+    Gia_StochFork_t * p = (Gia_StochFork_t *)pArg;
+    Abc_Frame_t * pFrame = Abc_FrameNew();
+    Abc_Frame_t * pOld = Abc_FrameMakeCurrent( pFrame );
+    Abc_FrameUpdateGia( pFrame, Gia_ManDupWithMapping(p->p) );
+    if ( Cmd_CommandExecute( pFrame, (char *)Vec_PtrEntry(p->vScripts, i) ) == 0 )
+        p->pRes[i] = Abc_FrameGetGia( pFrame );
+    Abc_FrameMakeCurrent( pOld );
+    Abc_FrameDelete( pFrame );
+    if ( p->pRes[i] == NULL )
+        return;
+    ABC_FREE( p->pRes[i]->pName );
+    ABC_FREE( p->pRes[i]->pSpec );
+    p->pRes[i]->pName = Abc_UtilStrsav( p->p->pName );
+    p->pRes[i]->pSpec = Abc_UtilStrsav( p->p->pSpec );
+}
+static inline int Gia_StochForkArea( Gia_Man_t * p )
+{
+    return Gia_ManHasMapping(p) ? Gia_ManLutNum(p) : Gia_ManAndNum(p);
+}
+static inline int Gia_StochForkDelay( Gia_Man_t * p )
+{
+    return Gia_ManHasMapping(p) ? Gia_ManLutLevel(p, NULL) : Gia_ManLevelNum(p);
+}
+Gia_Man_t * Gia_StochFork( Gia_Man_t * p, Vec_Ptr_t * vScripts, int Metric, int * pBest, int fVerbose )
+{
+    Gia_StochFork_t Fork;
+    Gia_Man_t * pNew;
+    int i, Cost[2], CostBest[2] = {0}, nMapped[2] = {0}, iBest = -1;
+    abctime clk = Abc_Clock();
+    Fork.p        = p;
+    Fork.vScripts = vScripts;
+    Fork.pRes     = ABC_CALLOC( Gia_Man_t *, Vec_PtrSize(vScripts) );
+    Util_TaskParallelFor( Vec_PtrSize(vScripts), Vec_PtrSize(vScripts), Gia_StochForkItem, &Fork );
+    // LUT counts and AND counts are not compared
+    for ( i = 0; i < Vec_PtrSize(vScripts); i++ )
+        if ( Fork.pRes[i] )
+            nMapped[Gia_ManHasMapping(Fork.pRes[i]) ? 1 : 0]++;
+    for ( i = 0; i < Vec_PtrSize(vScripts) && nMapped[0] && nMapped[1]; i++ )
     {
-        ThData[i].vGias    = vGias;
-        ThData[i].pScript  = pScript;
-        ThData[i].Index    = -1;
-        ThData[i].Rand     = Abc_Random(0) % 0x1000000;
-        ThData[i].nTimeOut = TimeSecs;
-        ThData[i].fWorking = 0;
-        status = pthread_create( WorkerThread + i, NULL, Gia_StochWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+        if ( fVerbose && Fork.pRes[i] )
+            printf( "Script %2d : %s  \"%s\"\n", i, Gia_ManHasMapping(Fork.pRes[i]) ? "mapped" : "not mapped", (char *)Vec_PtrEntry(vScripts, i) );
+        Gia_ManStopP( &Fork.pRes[i] );
     }
-    // look at the threads
-    for ( k = 0; k < Vec_PtrSize(vGias); k++ )
+    for ( i = 0; i < Vec_PtrSize(vScripts); i++ )
     {
-        for ( i = 0; i < nProcs; i++ )
+        if ( (pNew = Fork.pRes[i]) == NULL )
         {
-            if ( ThData[i].fWorking )
-                continue;
-            ThData[i].Index = k;
-            ThData[i].fWorking = 1;   
-            break;
+            if ( fVerbose && !(nMapped[0] && nMapped[1]) )
+                printf( "Script %2d failed: \"%s\"\n", i, (char *)Vec_PtrEntry(vScripts, i) );
+            continue;
+        }
+        Cost[Metric]   = Metric ? Gia_StochForkDelay(pNew) : Gia_StochForkArea(pNew);
+        Cost[!Metric]  = Metric ? Gia_StochForkArea(pNew)  : Gia_StochForkDelay(pNew);
+        if ( fVerbose )
+            printf( "Script %2d : %s = %6d  %s = %6d  \"%s\"\n", i,
+                Gia_ManHasMapping(pNew) ? "luts" : "ands", Gia_StochForkArea(pNew),
+                Gia_ManHasMapping(pNew) ? "llev" : "lev ", Gia_StochForkDelay(pNew),
+                (char *)Vec_PtrEntry(vScripts, i) );
+        if ( iBest == -1 || Cost[Metric] < CostBest[Metric] || (Cost[Metric] == CostBest[Metric] && Cost[!Metric] < CostBest[!Metric]) )
+        {
+            iBest = i;
+            CostBest[0] = Cost[0];
+            CostBest[1] = Cost[1];
         }
-        if ( i == nProcs )
-            k--;
     }
-    // wait till threads finish
-    for ( i = 0; i < nProcs; i++ )
-        if ( ThData[i].fWorking )
-            i = -1;
-    // stop threads
-    for ( i = 0; i < nProcs; i++ )
+    for ( i = 0; i < Vec_PtrSize(vScripts); i++ )
+        if ( i != iBest )
+            Gia_ManStopP( &Fork.pRes[i] );
+    pNew = iBest >= 0 ? Fork.pRes[iBest] : NULL;
+    ABC_FREE( Fork.pRes );
+    if ( pBest )
+        *pBest = (nMapped[0] && nMapped[1]) ? -2 : iBest;
+    if ( fVerbose && iBest >= 0 )
     {
-        assert( !ThData[i].fWorking );
-        // stop
-        ThData[i].Index = -1;
-        ThData[i].fWorking = 1;
+        printf( "Selected script %d out of %d by %s.  ", iBest, Vec_PtrSize(vScripts), Metric ? "delay" : "area" );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
     }
+    return pNew;
 }
 
-#endif // pthreads are used
-
 
 /**Function*************************************************************
 
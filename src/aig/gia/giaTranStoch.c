@@ -45,6 +45,8 @@
 
 #endif
 
+#include "misc/util/utilTask.h"
+
 ABC_NAMESPACE_IMPL_START
 
 extern Abc_Ntk_t * Abc_NtkFromAigPhase( Aig_Man_t * pMan );
@@ -116,11 +118,10 @@ struct Gia_ManTranStochParam {
   Gia_Man_t * pExdc;
   int nVerbose;
 
-#ifdef ABC_USE_PTHREADS
   int nSp;
   int nIte;
-  Gia_Man_t * pRes;
   int fWorking;
+#ifdef ABC_USE_PTHREADS
   pthread_mutex_t * mutex;
 #endif
 };
@@ -237,26 +238,25 @@ Gia_Man_t * Gia_ManTranStochOpt3( Gia_ManTranStochParam * p ) {
   return pBest;
 }
 
-#ifdef ABC_USE_PTHREADS
-void * Gia_ManTranStochWorkerThread( void * pArg ) {
-  Gia_ManTranStochParam * p = (Gia_ManTranStochParam *)pArg;
-  volatile int * pPlace = &p->fWorking;
-  while ( 1 ) {
-    while ( *pPlace == 0 );
-    assert( p->fWorking );
-    if ( p->pStart == NULL ) {
-      pthread_exit( NULL );
-      assert( 0 );
-      return NULL;
-    }
-    p->nSeed = 1234 * (p->nIte + p->nSeedBase);
-    p->pRes = Gia_ManTranStochOpt2( p );
-    p->fWorking = 0;
-  }
-  assert( 0 );
-  return NULL;
+// one restart from one starting point, run as a parallel task
+typedef struct Gia_ManTranStochTask_t_ {
+  Gia_ManTranStochParam * p;
+  Vec_Ptr_t * vpStarts;
+  Gia_Man_t ** ppRes;
+  int j;
+} Gia_ManTranStochTask_t;
+
+void Gia_ManTranStochItem( void * pArg, int iItem ) {
+  Gia_ManTranStochTask_t * pTask = (Gia_ManTranStochTask_t *)pArg;
+  Gia_ManTranStochParam Par = *pTask->p;
+  int k = iItem / ( Par.nRestarts + 1 );
+  Par.nSp = pTask->j + k;
+  Par.nIte = iItem % ( Par.nRestarts + 1 );
+  Par.pStart = (Gia_Man_t *)Vec_PtrEntry( pTask->vpStarts, k );
+  Par.fWorking = 1;
+  Par.nSeed = 1234 * ( Par.nIte + Par.nSeedBase );
+  pTask->ppRes[iItem] = Gia_ManTranStochOpt2( &Par );
 }
-#endif
 
 Gia_Man_t * Gia_ManTranStoch( Gia_Man_t * pGia, int nRestarts, int nHops, int nSeedBase, int fMspf, int fMerge, int fResetHop, int fZeroCostHop, int fRefactor, int fTruth, int fSingle, int fOriginalOnly, int fNewLine, Gia_Man_t * pExdc, int nThreads, int nVerbose ) {
   int i, j = 0;
@@ -275,9 +275,7 @@ Gia_Man_t * Gia_ManTranStoch( Gia_Man_t * pGia, int nRestarts, int nHops, int nS
   p->fNewLine = fNewLine;
   p->pExdc = pExdc;
   p->nVerbose = nVerbose;
-#ifdef ABC_USE_PTHREADS
   p->fWorking = 0;
-#endif
   // setup start points
   vpStarts = Vec_PtrAlloc( 4 );
   Vec_PtrPush( vpStarts, Gia_ManDup( pGia ) );
@@ -347,76 +345,34 @@ Gia_Man_t * Gia_ManTranStoch( Gia_Man_t * pGia, int nRestarts, int nHops, int nS
       Gia_ManStop( pStart );
     }
   } else {
+    // the restarts run as parallel tasks (up to the global thread limit)
+    // and are compared in a fixed order, so the result does not depend on scheduling
+#ifdef ABC_USE_PTHREADS
+    static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+    Gia_ManTranStochTask_t Task;
+    int nItems = Vec_PtrSize( vpStarts ) * ( p->nRestarts + 1 );
 #ifdef ABC_USE_PTHREADS
-    static pthread_mutex_t mutex;
-    int k, status, nIte, fAssigned, fWorking;
-    Gia_ManTranStochParam ThData[100];
-    pthread_t WorkerThread[100];
-    p->pRes = NULL;
     p->mutex = &mutex;
+#endif
     if ( p->nVerbose )
       p->nVerbose--;
-    for ( i = 0; i < nThreads; i++ ) {
-      ThData[i] = *p;
-      status = pthread_create( WorkerThread + i, NULL, Gia_ManTranStochWorkerThread, (void *)(ThData + i) );
-      assert( status == 0 );
-    }
-    Vec_PtrForEachEntry( Gia_Man_t *, vpStarts, pStart, k ) {
-      for ( nIte = 0; nIte <= p->nRestarts; nIte++ ) {
-        fAssigned = 0;
-        while ( !fAssigned ) {
-          for ( i = 0; i < nThreads; i++ ) {
-            if ( ThData[i].fWorking )
-              continue;
-            if ( ThData[i].pRes != NULL ) {
-              if( nVerbose )
-                printf( "*sp %d res %4d        : #nodes = %5d\n", ThData[i].nSp, ThData[i].nIte, Gia_ManAndNum( ThData[i].pRes ) );
-              if ( Gia_ManAndNum( pBest ) > Gia_ManAndNum( ThData[i].pRes ) ) {
-                Gia_ManStop( pBest );
-                pBest = ThData[i].pRes;
-              } else {
-                Gia_ManStop( ThData[i].pRes );
-              }
-              ThData[i].pRes = NULL;
-            }
-            ThData[i].nSp = j + k;
-            ThData[i].nIte = nIte;
-            ThData[i].pStart = pStart;
-            ThData[i].fWorking = 1;
-            fAssigned = 1;
-            break;
-          }
-        }
-      }
-    }
-    fWorking = 1;
-    while ( fWorking ) {
-      fWorking = 0;
-      for ( i = 0; i < nThreads; i++ ) {
-        if( ThData[i].fWorking ) {
-          fWorking = 1;
-          continue;
-        }
-        if ( ThData[i].pRes != NULL ) {
-          if( nVerbose )
-            printf( "*sp %d res %4d        : #nodes = %5d\n", ThData[i].nSp, ThData[i].nIte, Gia_ManAndNum( ThData[i].pRes ) );
-          if ( Gia_ManAndNum( pBest ) > Gia_ManAndNum( ThData[i].pRes ) ) {
-            Gia_ManStop( pBest );
-            pBest = ThData[i].pRes;
-          } else {
-            Gia_ManStop( ThData[i].pRes );
-          }
-          ThData[i].pRes = NULL;
-        }
+    Task.p = p;
+    Task.vpStarts = vpStarts;
+    Task.ppRes = ABC_CALLOC( Gia_Man_t *, nItems );
+    Task.j = j;
+    Util_TaskParallelFor( nThreads, nItems, Gia_ManTranStochItem, &Task );
+    for ( i = 0; i < nItems; i++ ) {
+      if( nVerbose )
+        printf( "*sp %d res %4d        : #nodes = %5d\n", j + i / ( p->nRestarts + 1 ), i % ( p->nRestarts + 1 ), Gia_ManAndNum( Task.ppRes[i] ) );
+      if ( Gia_ManAndNum( pBest ) > Gia_ManAndNum( Task.ppRes[i] ) ) {
+        Gia_ManStop( pBest );
+        pBest = Task.ppRes[i];
+      } else {
+        Gia_ManStop( Task.ppRes[i] );
       }
     }
-    for ( i = 0; i < nThreads; i++ ) {
-      ThData[i].pStart = NULL;
-      ThData[i].fWorking = 1;
-    }
-#else
-    printf( "ERROR: pthread is off" );
-#endif
+    ABC_FREE( Task.ppRes );
     Vec_PtrForEachEntry( Gia_Man_t *, vpStarts, pStart, i )
       Gia_ManStop( pStart );
   }
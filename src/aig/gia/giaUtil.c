@@ -48,8 +48,8 @@ ABC_NAMESPACE_IMPL_START
 ***********************************************************************/
 unsigned Gia_ManRandom( int fReset )
 {
-    static unsigned int m_z = NUMBER1;
-    static unsigned int m_w = NUMBER2;
+    static ABC_THREAD_LOCAL unsigned int m_z = NUMBER1;
+    static ABC_THREAD_LOCAL unsigned int m_w = NUMBER2;
     if ( fReset )
     {
         m_z = NUMBER1;
@@ -809,7 +809,7 @@ Vec_Int_t * Gia_ManBfsForCrossCut( Gia_Man_t * p )
     return vNodes;
 }
 
-void Gia_ManDfsForCrossCut_rec( Gia_Man_t * p, Gia_Obj_t * pObj, Vec_Int_t * vNodes )
+void Gia_ManDfsForCrossCut_rec( Gia_Man_t * p, Gia_Obj_t * pObj, Vec_Int_t * vNodes, int * pRefs )
 {
     if ( Gia_ObjIsTravIdCurrent(p, pObj) )
         return;
@@ -821,37 +821,36 @@ void Gia_ManDfsForCrossCut_rec( Gia_Man_t * p, Gia_Obj_t * pObj, Vec_Int_t * vNo
     }
     if ( Gia_ObjIsCo(pObj) )
     {
-        Gia_ObjFanin0(pObj)->Value++;
-        Gia_ManDfsForCrossCut_rec( p, Gia_ObjFanin0(pObj), vNodes );
+        pRefs[Gia_ObjFaninId0p(p, pObj)]++;
+        Gia_ManDfsForCrossCut_rec( p, Gia_ObjFanin0(pObj), vNodes, pRefs );
         Vec_IntPush( vNodes, Gia_ObjId(p, pObj) );
         return;
     }
     assert( Gia_ObjIsAnd(pObj) );
-    Gia_ObjFanin0(pObj)->Value++;
-    Gia_ObjFanin1(pObj)->Value++;
-    Gia_ManDfsForCrossCut_rec( p, Gia_ObjFanin0(pObj), vNodes );
-    Gia_ManDfsForCrossCut_rec( p, Gia_ObjFanin1(pObj), vNodes );
+    pRefs[Gia_ObjFaninId0p(p, pObj)]++;
+    pRefs[Gia_ObjFaninId1p(p, pObj)]++;
+    Gia_ManDfsForCrossCut_rec( p, Gia_ObjFanin0(pObj), vNodes, pRefs );
+    Gia_ManDfsForCrossCut_rec( p, Gia_ObjFanin1(pObj), vNodes, pRefs );
     Vec_IntPush( vNodes, Gia_ObjId(p, pObj) );
 }
-Vec_Int_t * Gia_ManDfsForCrossCut( Gia_Man_t * p, int fReverse )
+Vec_Int_t * Gia_ManDfsForCrossCut( Gia_Man_t * p, int fReverse, int * pRefs )
 {
     Vec_Int_t * vNodes;
     Gia_Obj_t * pObj;
     int i;
-    Gia_ManCleanValue( p );
     vNodes = Vec_IntAlloc( Gia_ManObjNum(p) );
     Gia_ManIncrementTravId( p );
     if ( fReverse )
     {
         Gia_ManForEachCoReverse( p, pObj, i )
             if ( !Gia_ObjIsConst0(Gia_ObjFanin0(pObj)) )
-                Gia_ManDfsForCrossCut_rec( p, pObj, vNodes );
+                Gia_ManDfsForCrossCut_rec( p, pObj, vNodes, pRefs );
     }
     else
     {
         Gia_ManForEachCo( p, pObj, i )
             if ( !Gia_ObjIsConst0(Gia_ObjFanin0(pObj)) )
-                Gia_ManDfsForCrossCut_rec( p, pObj, vNodes );
+                Gia_ManDfsForCrossCut_rec( p, pObj, vNodes, pRefs );
     }
     return vNodes;
 }
@@ -860,30 +859,34 @@ int Gia_ManCrossCut( Gia_Man_t * p, int fReverse )
     Vec_Int_t * vNodes;
     Gia_Obj_t * pObj;
     int i, nCutCur = 0, nCutMax = 0;
-    vNodes = Gia_ManDfsForCrossCut( p, fReverse );
+    // the fanout counters are kept in a column, so that pObj->Value is not changed;
+    // the counters return to zero at the end, so the column is not cleaned again
+    int * pRefs = Gia_ManColLeaseInt( p, "CrossCutRefs", -1 );
+    vNodes = Gia_ManDfsForCrossCut( p, fReverse, pRefs );
     //vNodes = Gia_ManBfsForCrossCut( p );
     Gia_ManForEachObjVec( vNodes, p, pObj, i )
     {
-        if ( pObj->Value )
+        if ( pRefs[Gia_ObjId(p, pObj)] )
             nCutCur++;
         if ( nCutMax < nCutCur )
             nCutMax = nCutCur;
         if ( Gia_ObjIsAnd(pObj) )
         {
-            if ( --Gia_ObjFanin0(pObj)->Value == 0 )
+            if ( --pRefs[Gia_ObjFaninId0p(p, pObj)] == 0 )
                 nCutCur--;
-            if ( --Gia_ObjFanin1(pObj)->Value == 0 )
+            if ( --pRefs[Gia_ObjFaninId1p(p, pObj)] == 0 )
                 nCutCur--;
         }
         else if ( Gia_ObjIsCo(pObj) )
         {
-            if ( --Gia_ObjFanin0(pObj)->Value == 0 )
+            if ( --pRefs[Gia_ObjFaninId0p(p, pObj)] == 0 )
                 nCutCur--;
         }
     }
     Vec_IntFree( vNodes );
     Gia_ManForEachObj( p, pObj, i )
-        assert( pObj->Value == 0 );
+        assert( pRefs[i] == 0 );
+    Gia_ManColRelease( p, pRefs );
     return nCutMax;
 }
 
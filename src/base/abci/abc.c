@@ -420,6 +420,7 @@ static int Abc_CommandAbc9Add1Hot            ( Abc_Frame_t * pAbc, int argc, cha
 static int Abc_CommandAbc9Cof                ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Trim               ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Dfs                ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int Abc_CommandAbc9Reorder            ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Sim                ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Sim2               ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Sim3               ( Abc_Frame_t * pAbc, int argc, char ** argv );
@@ -443,6 +444,7 @@ static int Abc_CommandAbc9Retime             ( Abc_Frame_t * pAbc, int argc, cha
 static int Abc_CommandAbc9Enable             ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Dc2                ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Dsd                ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int Abc_CommandAbc9Orchestrate        ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Bidec              ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Shrink             ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandAbc9Fx                 ( Abc_Frame_t * pAbc, int argc, char ** argv );
@@ -1184,6 +1186,7 @@ void Abc_Init( Abc_Frame_t * pAbc )
     Cmd_CommandAdd( pAbc, "ABC9",         "&cof",          Abc_CommandAbc9Cof,          0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&trim",         Abc_CommandAbc9Trim,         0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&dfs",          Abc_CommandAbc9Dfs,          0 );
+    Cmd_CommandAdd( pAbc, "ABC9",         "&reorder",      Abc_CommandAbc9Reorder,      0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&sim",          Abc_CommandAbc9Sim,          0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&sim2",         Abc_CommandAbc9Sim2,         0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&sim3",         Abc_CommandAbc9Sim3,         0 );
@@ -1206,6 +1209,7 @@ void Abc_Init( Abc_Frame_t * pAbc )
     Cmd_CommandAdd( pAbc, "ABC9",         "&retime",       Abc_CommandAbc9Retime,       0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&enable",       Abc_CommandAbc9Enable,       0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&dc2",          Abc_CommandAbc9Dc2,          0 );
+    Cmd_CommandAdd( pAbc, "ABC9",         "&orchestrate",  Abc_CommandAbc9Orchestrate,  0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&dsd",          Abc_CommandAbc9Dsd,          0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&bidec",        Abc_CommandAbc9Bidec,        0 );
     Cmd_CommandAdd( pAbc, "ABC9",         "&shrink",       Abc_CommandAbc9Shrink,       0 );
@@ -1403,6 +1407,10 @@ void Abc_End( Abc_Frame_t * pAbc )
 {
     extern Abc_Frame_t * Abc_FrameGetGlobalFrame();
     Abc_FrameClearDesign();
+    // the process-wide state is released with the frame of the process
+    // (the per-thread state of other threads by Abc_FrameThreadStop)
+    if ( !pAbc->fThreadFrame )
+    {
     Cnf_ManFree();
     {
         extern int Abc_NtkCompareAndSaveBest( Abc_Ntk_t * pNtk );
@@ -1424,13 +1432,14 @@ void Abc_End( Abc_Frame_t * pAbc )
         extern void Sdm_ManQuit();
         Sdm_ManQuit();
     }
+    }
     Abc_NtkFraigStoreClean();
     Gia_ManStopP( &pAbc->pGia );
     Gia_ManStopP( &pAbc->pGia2 );
     Gia_ManStopP( &pAbc->pGiaBest );
     Gia_ManStopP( &pAbc->pGiaBest2 );
     Gia_ManStopP( &pAbc->pGiaSaved );
-    if ( Abc_NtkRecIsRunning3() )
+    if ( !pAbc->fThreadFrame && Abc_NtkRecIsRunning3() )
         Abc_NtkRecStop3();
 }
 
@@ -30683,7 +30692,7 @@ int Abc_CommandAbc9Read( Abc_Frame_t * pAbc, int argc, char ** argv )
 //        Abc3_ReadShowHie( FileName, fSkipStrash );
     else
     {
-        pAig = Gia_AigerRead( FileName, fGiaSimple, fSkipStrash, 0 );
+        pAig = Gia_AigerReadFile( FileName, fGiaSimple, fSkipStrash, 0, fVerbose );
         if ( fDetectXors )
         {
             Gia_Man_t * pTemp;
@@ -31768,12 +31777,16 @@ int Abc_CommandAbc9Write( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fMiniAig = 0;
     int fMiniLut = 0;
     int fWriteNewLine = 0;
+    int fSnapshot = 0;
     int fVerbose = 0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "upbmlnvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "upbmlnzvh" ) ) != EOF )
     {
         switch ( c )
         {
+        case 'z':
+            fSnapshot ^= 1;
+            break;
         case 'u':
             fUnique ^= 1;
             break;
@@ -31826,12 +31839,14 @@ int Abc_CommandAbc9Write( Abc_Frame_t * pAbc, int argc, char ** argv )
         Gia_ManWriteMiniAig( pAbc->pGia, pFileName );
     else if ( fMiniLut )
         Gia_ManWriteMiniLut( pAbc->pGia, pFileName );
+    else if ( fSnapshot )
+        Gia_ManSnapWrite( pAbc->pGia, pFileName, fVerbose );
     else
         Gia_AigerWrite( pAbc->pGia, pFileName, 0, 0, fWriteNewLine );
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: &w [-upbmlnvh] <file>\n" );
+    Abc_Print( -2, "usage: &w [-upbmlnzvh] <file>\n" );
     Abc_Print( -2, "\t         writes the current AIG into the AIGER file\n" );
     Abc_Print( -2, "\t-u     : toggle writing canonical AIG structure [default = %s]\n", fUnique? "yes" : "no" );
     Abc_Print( -2, "\t-p     : toggle writing Verilog with 'and' and 'not' [default = %s]\n", fVerilog? "yes" : "no" );
@@ -31839,6 +31854,7 @@ usage:
     Abc_Print( -2, "\t-m     : toggle writing MiniAIG rather than AIGER [default = %s]\n", fMiniAig? "yes" : "no" );
     Abc_Print( -2, "\t-l     : toggle writing MiniLUT rather than AIGER [default = %s]\n", fMiniLut? "yes" : "no" );
     Abc_Print( -2, "\t-n     : toggle writing \'\\n\' after \'c\' in the AIGER file [default = %s]\n", fWriteNewLine? "yes": "no" );
+    Abc_Print( -2, "\t-z     : toggle writing the native GIA snapshot read back by &r [default = %s]\n", fSnapshot? "yes": "no" );
     Abc_Print( -2, "\t-v     : toggle verbose output [default = %s]\n", fVerbose? "yes": "no" );
     Abc_Print( -2, "\t-h     : print the command usage\n");
     Abc_Print( -2, "\t<file> : the file name\n");
@@ -33329,6 +33345,76 @@ usage:
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    []
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_CommandAbc9Reorder( Abc_Frame_t * pAbc, int argc, char ** argv )
+{
+    Gia_Man_t * pTemp;
+    int c;
+    int Type     = GIA_REORDER_CLUSTER;
+    int fVerbose = 0;
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "Ovh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+        case 'O':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-O\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            Type = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( Type < 0 || Type > 2 )
+                goto usage;
+            break;
+        case 'v':
+            fVerbose ^= 1;
+            break;
+        case 'h':
+            goto usage;
+        default:
+            goto usage;
+        }
+    }
+    if ( pAbc->pGia == NULL )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Reorder(): There is no AIG.\n" );
+        return 1;
+    }
+    pTemp = Gia_ManReorder( pAbc->pGia, Type, fVerbose );
+    if ( pTemp == NULL )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Reorder(): Reordering has failed.\n" );
+        return 1;
+    }
+    Abc_FrameUpdateGia( pAbc, pTemp );
+    return 0;
+
+usage:
+    Abc_Print( -2, "usage: &reorder [-O num] [-vh]\n" );
+    Abc_Print( -2, "\t        renumbers the nodes to place the fanins close to their fanouts\n" );
+    Abc_Print( -2, "\t        (the mapping, equivalences, names and timing are preserved;\n" );
+    Abc_Print( -2, "\t        the dangling nodes, not in the TFI of the COs, are removed)\n" );
+    Abc_Print( -2, "\t-O num : the node order [default = %d]\n", Type );
+    Abc_Print( -2, "\t         0 = DFS visiting the deeper fanin first\n" );
+    Abc_Print( -2, "\t         1 = DFS followed by the fanouts whose fanins are ready\n" );
+    Abc_Print( -2, "\t         2 = levels sorted by the position of the last fanin\n" );
+    Abc_Print( -2, "\t-v     : toggle printing verbose information [default = %s]\n", fVerbose? "yes": "no" );
+    Abc_Print( -2, "\t-h     : print the command usage\n");
+    return 1;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -35610,6 +35696,144 @@ usage:
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    []
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_CommandAbc9Orchestrate( Abc_Frame_t * pAbc, int argc, char ** argv )
+{
+    Gia_Man_t * pTemp;
+    Vec_Wec_t * vGains = NULL;
+    char * pPolicyFile = NULL, * pDecisionFile = NULL, * pGainFile = NULL, * pCacheFile = NULL;
+    int c, nCutMax = 10, nProcs = 1, fUpdateLevel = 1, fUseZerosRw = 1, fUseZerosRf = 1, fNtkIds = 0, fVerbose = 0;
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "KTPDGCLlzZvh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+        case 'K':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-K\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nCutMax = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nCutMax < 4 || nCutMax > 12 )
+                goto usage;
+            break;
+        case 'T':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-T\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nProcs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nProcs < 1 )
+                goto usage;
+            break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pPolicyFile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'D':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-D\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pDecisionFile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'G':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-G\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pGainFile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'C':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-C\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pCacheFile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'L':
+            fNtkIds ^= 1;
+            break;
+        case 'l':
+            fUpdateLevel ^= 1;
+            break;
+        case 'z':
+            fUseZerosRw ^= 1;
+            break;
+        case 'Z':
+            fUseZerosRf ^= 1;
+            break;
+        case 'v':
+            fVerbose ^= 1;
+            break;
+        case 'h':
+            goto usage;
+        default:
+            goto usage;
+        }
+    }
+    if ( pAbc->pGia == NULL )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Orchestrate(): There is no AIG.\n" );
+        return 1;
+    }
+    if ( nProcs > 1 || pGainFile )
+        vGains = Gia_ManOrchGains( pAbc->pGia, nCutMax, fUpdateLevel, nProcs, fVerbose );
+    if ( pGainFile )
+        Gia_ManOrchWriteGains( pGainFile, vGains );
+    pTemp = Gia_ManOrchestrate( pAbc->pGia, nCutMax, fUpdateLevel, fUseZerosRw, fUseZerosRf, vGains, pPolicyFile, pDecisionFile, pCacheFile, fNtkIds, fVerbose );
+    Vec_WecFreeP( &vGains );
+    if ( pTemp == NULL )
+    {
+        Abc_Print( -1, "Abc_CommandAbc9Orchestrate(): Orchestration has failed.\n" );
+        return 1;
+    }
+    Abc_FrameUpdateGia( pAbc, pTemp );
+    return 0;
+
+usage:
+    Abc_Print( -2, "usage: &orchestrate [-KT num] [-P file] [-D file] [-G file] [-C file] [-LlzZvh]\n" );
+    Abc_Print( -2, "\t         orchestrates rewriting, resubstitution and refactoring of each node\n" );
+    Abc_Print( -2, "\t-K num : the max cut size shared by the operators (4 <= num <= 12) [default = %d]\n", nCutMax );
+    Abc_Print( -2, "\t-T num : the number of threads precomputing the gains (1 = no precomputation) [default = %d]\n", nProcs );
+    Abc_Print( -2, "\t-P file: the policy file with the operator order (0-5) per object [default = greedy]\n" );
+    Abc_Print( -2, "\t-D file: the decision file with the operator applied (0/2/3) per object [default = none]\n" );
+    Abc_Print( -2, "\t-G file: the gain file with the precomputed gains of rw/rs/rf per object [default = none]\n" );
+    Abc_Print( -2, "\t-C file: the cache file with the candidates of the windows seen before [default = none]\n" );
+    Abc_Print( -2, "\t-L     : toggle indexing -P and -D files by the object IDs of the network read by \"read\" [default = %s]\n", fNtkIds? "yes": "no" );
+    Abc_Print( -2, "\t-l     : toggle preserving the number of levels [default = %s]\n", fUpdateLevel? "yes": "no" );
+    Abc_Print( -2, "\t-z     : toggle using zero-cost rewrites [default = %s]\n", fUseZerosRw? "yes": "no" );
+    Abc_Print( -2, "\t-Z     : toggle using zero-cost refactors [default = %s]\n", fUseZerosRf? "yes": "no" );
+    Abc_Print( -2, "\t-v     : toggle printing verbose information [default = %s]\n", fVerbose? "yes": "no" );
+    Abc_Print( -2, "\t-h     : print the command usage\n");
+    return 1;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -38869,7 +39093,7 @@ int Abc_CommandAbc9FdRw( Abc_Frame_t * pAbc, int argc, char ** argv )
     int c, nArgcNew, fNdMin = 0, fFI = 0, fShort = 0, fNormLv = 0;
     Cec_ManFdSetDefaultParams( pPars );
     Extra_UtilGetoptReset(); // for comman line parsing
-    while ( ( c = Extra_UtilGetopt( argc, argv, "CEGPNFSgailmnpstcxvwHh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "CEGPNFSjBRYgailmnpstcxebfkouqvwHh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -38945,6 +39169,48 @@ int Abc_CommandAbc9FdRw( Abc_Frame_t * pAbc, int argc, char ** argv )
             readStatName = argv[globalUtilOptind];
             globalUtilOptind++;
             break;
+        case 'Y':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-Y\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pPars->pProfile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'j':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-j\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nThreads = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nThreads < 0 )
+                goto usage;
+            break;
+        case 'B':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-B\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nBatch = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nBatch < 0 )
+                goto usage;
+            break;
+        case 'R':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-R\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            pPars->nRounds = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nRounds < 0 )
+                goto usage;
+            break;
         case 'g':
             pPars->GType ^= 1;
             break;
@@ -38978,6 +39244,27 @@ int Abc_CommandAbc9FdRw( Abc_Frame_t * pAbc, int argc, char ** argv )
         case 'x':
             pPars->fInc ^= 1;
             break;
+        case 'e':
+            pPars->fTrace ^= 1;
+            break;
+        case 'q':
+            pPars->fItpMin ^= 1;
+            break;
+        case 'b':
+            pPars->fBench ^= 1;
+            break;
+        case 'f':
+            pPars->fSim ^= 1;
+            break;
+        case 'k':
+            pPars->fKeepStat ^= 1;
+            break;
+        case 'o':
+            pPars->fBinStat ^= 1;
+            break;
+        case 'u':
+            pPars->fCache ^= 1;
+            break;
         case 'v':
             pPars->fVerbose ^= 1;
             break;
@@ -38992,6 +39279,12 @@ int Abc_CommandAbc9FdRw( Abc_Frame_t * pAbc, int argc, char ** argv )
             goto usage;
         }
     }
+    // the threads and the batches solve the queries with the one-shot engine only
+    if ( (pPars->nThreads > 0 || pPars->nBatch > 1) && (pPars->fInc || pPars->fBench) )
+    {
+        Abc_Print( 1, "Switches \"-j\" and \"-B\" use the one-shot sat solver; turning off the incremental solver (-x)%s.\n", pPars->fBench ? " and the solver comparison (-b)" : "" );
+        pPars->fInc = pPars->fBench = 0;
+    }
     pArgvNew = argv + globalUtilOptind;
     nArgcNew = argc - globalUtilOptind;
 
@@ -39077,7 +39370,7 @@ int Abc_CommandAbc9FdRw( Abc_Frame_t * pAbc, int argc, char ** argv )
     
     return 0;
 usage:
-    Abc_Print( -2, "usage: &fdrw [-CT num] [-nmdasxytvwh]\n" );
+    Abc_Print( -2, "usage: &fdrw [-CTjBR num] [-Y file] [-nmdasxebfkouqytvwh]\n" );
     Abc_Print( -2, "\t         new combinational equivalence checker\n" );
     Abc_Print( -2, "\t-C num    : the max number of conflicts at a node [default = %d]\n", pPars->nBTLimit );
     Abc_Print( -2, "\t-E num    : cost evaluation type [default = %d]\n", pPars->costType );
@@ -39085,6 +39378,10 @@ usage:
     Abc_Print( -2, "\t-N num    : the singal node to rewrite, no specified means all nodes are checked\n" );
     Abc_Print( -2, "\t-F pwd    : the input file of to-rewrite nodes\n" );
     Abc_Print( -2, "\t-S pwd    : the input file of status\n" );
+    Abc_Print( -2, "\t-Y pwd    : write the time of each phase to <pwd>.json and the time of each query to <pwd>.csv\n" );
+    Abc_Print( -2, "\t-j num    : the number of threads to solve the nodes with the one-shot engine (turns off -x and -b), 0 for the sequential sweep [default = %d]\n", pPars->nThreads );
+    Abc_Print( -2, "\t-B num    : the max number of nodes with similar G solved on one CNF as in -j (turns off -x and -b); the learned clauses shared by the same G may decide queries that reach -C alone; 0 or 1 for one solver per node [default = %d]\n", pPars->nBatch );
+    Abc_Print( -2, "\t-R num    : the number of rounds of -F -14/-15 in one process, with the schedule of the scripts [default = %d]\n", pPars->nRounds );
     Abc_Print( -2, "\t-a        : toggle using abstract circuit for level computation [default = %s]\n", pPars->fAbs? "yes":"no");
     Abc_Print( -2, "\t-i        : toggle using abstract circuit for interpoation computation [default = %s]\n", pPars->fAbsItp? "yes":"no");
     Abc_Print( -2, "\t-G num    : setting candidate of G [default = %d]\n", pPars->GType >> 1);
@@ -39097,6 +39394,13 @@ usage:
     Abc_Print( -2, "\t-t        : toggle to trim patch before replacement [default = %s]\n", pPars->fTrim? "yes":"no");
     Abc_Print( -2, "\t-c        : toggle to do synthesis (cec) after rewriting [default = %s]\n", pPars->fSyn? "yes":"no");
     Abc_Print( -2, "\t-x        : toggle to use incremental sat solver [default = %s]\n", pPars->fInc ? "yes":"no");
+    Abc_Print( -2, "\t-e        : toggle to replay the proof trace of satoko for the interpolants of the non-incremental queries [default = %s]\n", pPars->fTrace ? "yes":"no");
+    Abc_Print( -2, "\t-b        : toggle to run both sat solvers and print the time of each query [default = %s]\n", pPars->fBench ? "yes":"no");
+    Abc_Print( -2, "\t-f        : toggle to use simulation to find SAT nodes before calling sat solver [default = %s]\n", pPars->fSim ? "yes":"no");
+    Abc_Print( -2, "\t-k        : toggle to keep the status of the unchanged nodes after replacement [default = %s]\n", pPars->fKeepStat ? "yes":"no");
+    Abc_Print( -2, "\t-o        : toggle to write the status checkpoints in the binary format (reading detects the format) [default = %s]\n", pPars->fBinStat ? "yes":"no");
+    Abc_Print( -2, "\t-u        : toggle to reuse the answers of the structurally identical queries [default = %s]\n", pPars->fCache ? "yes":"no");
+    Abc_Print( -2, "\t-q        : toggle to minimize the patches on the values of G (chains, SAT sweeping, support) instead of the trim of -t [default = %s]\n", pPars->fItpMin ? "yes":"no");
     Abc_Print( -2, "\t-v        : toggle verbose output [default = %s]\n", pPars->fVerbose? "yes":"no");
     Abc_Print( -2, "\t-w        : toggle to output circuits while computation [default = %s]\n", pPars->fGetCkts? "yes":"no");
     Abc_Print( -2, "\t-h        : print the command usage\n");
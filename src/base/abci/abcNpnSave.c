@@ -20,6 +20,7 @@
 
 #include "base/abc/abc.h"
 #include "aig/aig/aig.h"
+#include "misc/util/utilTask.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -60,6 +61,7 @@ static word Truth[8] = {
     ABC_CONST(0xFFFFFFFFFFFFFFFF)
 };
 
+// the table is shared by the threads and is used under Util_TaskGlobalLock()
 static Npn_Man_t * pNpnMan = NULL;
 
 ////////////////////////////////////////////////////////////////////////
@@ -648,11 +650,13 @@ void Npn_ManStop( Npn_Man_t * p )
 ***********************************************************************/
 void Npn_ManClean()
 {
+    Util_TaskGlobalLock();
     if ( pNpnMan != NULL )
     {
         Npn_ManStop( pNpnMan );
         pNpnMan = NULL;
     }
+    Util_TaskGlobalUnlock();
 }
 
 /**Function*************************************************************
@@ -669,6 +673,7 @@ void Npn_ManClean()
 void Npn_ManLoad( char * pFileName )
 {
 //    Npn_TruthPermute_rec( "012345", 0, 5 );
+    Util_TaskGlobalLock();
     if ( pNpnMan != NULL )
     {
         Abc_Print( 1, "Removing old table with %d entries.\n", pNpnMan->nEntries );
@@ -676,6 +681,7 @@ void Npn_ManLoad( char * pFileName )
     }
     pNpnMan = Npn_ManStart( pFileName );
     Abc_Print( 1, "Created new table with %d entries from file \"%s\".\n", pNpnMan->nEntries, pFileName );
+    Util_TaskGlobalUnlock();
 }
 
 /**Function*************************************************************
@@ -691,13 +697,15 @@ void Npn_ManLoad( char * pFileName )
 ***********************************************************************/
 void Npn_ManSave( char * pFileName )
 {
+    Util_TaskGlobalLock();
     if ( pNpnMan == NULL )
-    {
         Abc_Print( 1, "There is no table with entries.\n" );
-        return;
+    else
+    {
+        Npn_ManWrite( pNpnMan, pFileName );
+        Abc_Print( 1, "Dumped table with %d entries from file \"%s\".\n", pNpnMan->nEntries, pFileName );
     }
-    Npn_ManWrite( pNpnMan, pFileName );
-    Abc_Print( 1, "Dumped table with %d entries from file \"%s\".\n", pNpnMan->nEntries, pFileName );
+    Util_TaskGlobalUnlock();
 }
 
 /**Function*************************************************************
@@ -715,20 +723,23 @@ void Npn_ManSaveOne( unsigned * puTruth, int nVars )
 {
     word uTruth = (((word)puTruth[1]) << 32) | (word)puTruth[0];
     assert( nVars >= 0 && nVars <= 6 );
+    Util_TaskGlobalLock();
     if ( pNpnMan == NULL )
     {
         Abc_Print( 1, "Creating new table with 0 entries.\n" );
         pNpnMan = Npn_ManStart( NULL );
     }
     // skip truth tables that do not depend on some vars
-    if ( !Npn_TruthIsMinBase( uTruth ) )
-        return;
-    // extend truth table to look like 6-input
-    uTruth = Npn_TruthPadWord( uTruth, nVars );
-    // semi(!)-NPN-canonize the truth table
-    uTruth = Npn_TruthCanon( uTruth, 6, NULL );
-    // add to storage
-    Npn_ManAdd( pNpnMan, uTruth );
+    if ( Npn_TruthIsMinBase( uTruth ) )
+    {
+        // extend truth table to look like 6-input
+        uTruth = Npn_TruthPadWord( uTruth, nVars );
+        // semi(!)-NPN-canonize the truth table
+        uTruth = Npn_TruthCanon( uTruth, 6, NULL );
+        // add to storage
+        Npn_ManAdd( pNpnMan, uTruth );
+    }
+    Util_TaskGlobalUnlock();
 }
 
 ////////////////////////////////////////////////////////////////////////
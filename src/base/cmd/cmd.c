@@ -28,6 +28,7 @@
 #include "base/main/mainInt.h"
 #include "cmdInt.h"
 #include "misc/util/utilSignal.h"
+#include "misc/util/utilTask.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -49,6 +50,8 @@ static int CmdCommandUnsetVariable ( Abc_Frame_t * pAbc, int argc, char ** argv
 static int CmdCommandUndo          ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int CmdCommandRecall        ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int CmdCommandEmpty         ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int CmdCommandThreads       ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int CmdCommandFork          ( Abc_Frame_t * pAbc, int argc, char ** argv );
 #if defined(WIN32) && !defined(__cplusplus)
 static int CmdCommandScanDir       ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int CmdCommandRenameFiles   ( Abc_Frame_t * pAbc, int argc, char ** argv );
@@ -99,6 +102,8 @@ void Cmd_Init( Abc_Frame_t * pAbc )
     Cmd_CommandAdd( pAbc, "Basic", "undo",          CmdCommandUndo,            0 );
     Cmd_CommandAdd( pAbc, "Basic", "recall",        CmdCommandRecall,          0 );
     Cmd_CommandAdd( pAbc, "Basic", "empty",         CmdCommandEmpty,           0 );
+    Cmd_CommandAdd( pAbc, "Basic", "threads",       CmdCommandThreads,         0 );
+    Cmd_CommandAdd( pAbc, "Basic", "fork",          CmdCommandFork,            0 );
 #if defined(WIN32) && !defined(__cplusplus)
     Cmd_CommandAdd( pAbc, "Basic", "scandir",       CmdCommandScanDir,         0 );
     Cmd_CommandAdd( pAbc, "Basic", "renamefiles",   CmdCommandRenameFiles,     0 );
@@ -131,7 +136,8 @@ void Cmd_End( Abc_Frame_t * pAbc )
 {
     st__generator * gen;
     char * pKey, * pValue;
-    Cmd_HistoryWrite( pAbc, ABC_INFINITY );
+    if ( !pAbc->fThreadFrame )
+        Cmd_HistoryWrite( pAbc, ABC_INFINITY );
 
 //    st__free_table( pAbc->tCommands, (void (*)()) 0, CmdCommandFree );
 //    st__free_table( pAbc->tAliases,  (void (*)()) 0, CmdCommandAliasFree );
@@ -1089,6 +1095,152 @@ usage:
     return 1;
 }
 
+/**Function********************************************************************
+
+  Synopsis    [Sets the global limit on the number of threads.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int CmdCommandThreads( Abc_Frame_t * pAbc, int argc, char **argv )
+{
+    int c, nThreads = Util_TaskThreadLimit();
+
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "jh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+            case 'j':
+                if ( globalUtilOptind >= argc )
+                {
+                    fprintf( pAbc->Err, "Command line switch \"-j\" should be followed by an integer.\n" );
+                    goto usage;
+                }
+                nThreads = atoi(argv[globalUtilOptind]);
+                globalUtilOptind++;
+                if ( nThreads < 0 )
+                    goto usage;
+                break;
+            case 'h':
+                goto usage;
+            default:
+                goto usage;
+        }
+    }
+
+    Util_TaskSetThreadLimit( nThreads );
+    if ( nThreads )
+        fprintf( pAbc->Out, "The parallel engines use at most %d threads (%d are now running).\n", nThreads, Util_TaskThreadsUsed() );
+    else
+        fprintf( pAbc->Out, "The number of threads used by the parallel engines is not limited.\n" );
+    return 0;
+usage:
+
+    fprintf( pAbc->Err, "usage: threads [-j num] [-h]\n" );
+    fprintf( pAbc->Err, "         sets the global limit on the number of threads\n" );
+    fprintf( pAbc->Err, "         shared by all the multi-threaded engines\n" );
+    fprintf( pAbc->Err, "   -j num : the max number of threads (0 = no limit) [default = %d]\n", Util_TaskThreadLimit() );
+    fprintf( pAbc->Err, "   -h     : print the command usage\n");
+    return 1;
+}
+
+/**Function********************************************************************
+
+  Synopsis    [Runs alternative scripts concurrently on the current AIG.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int CmdCommandFork( Abc_Frame_t * pAbc, int argc, char **argv )
+{
+    extern Gia_Man_t * Gia_StochFork( Gia_Man_t * p, Vec_Ptr_t * vScripts, int Metric, int * pBest, int fVerbose );
+    Vec_Ptr_t * vScripts;
+    Gia_Man_t * pNew;
+    int c, i, iBest, Metric = 0, fVerbose = 0;
+
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "vh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+            case 'v':
+                fVerbose ^= 1;
+                break;
+            case 'h':
+                goto usage;
+            default:
+                goto usage;
+        }
+    }
+    vScripts = Vec_PtrAlloc( argc );
+    for ( i = globalUtilOptind; i < argc; i++ )
+    {
+        if ( strcmp(argv[i], "join") )
+        {
+            Vec_PtrPush( vScripts, argv[i] );
+            continue;
+        }
+        if ( i + 1 < argc && !strcmp(argv[i+1], "best=area") )
+            Metric = 0, i++;
+        else if ( i + 1 < argc && !strcmp(argv[i+1], "best=delay") )
+            Metric = 1, i++;
+        if ( i + 1 < argc )
+        {
+            fprintf( pAbc->Err, "Cannot parse \"%s\" after \"join\".\n", argv[i+1] );
+            Vec_PtrFree( vScripts );
+            goto usage;
+        }
+    }
+    if ( Vec_PtrSize(vScripts) == 0 )
+    {
+        Vec_PtrFree( vScripts );
+        goto usage;
+    }
+    if ( pAbc->pGia == NULL )
+    {
+        fprintf( pAbc->Err, "There is no current AIG.\n" );
+        Vec_PtrFree( vScripts );
+        return 1;
+    }
+    pNew = Gia_StochFork( pAbc->pGia, vScripts, Metric, &iBest, fVerbose );
+    Vec_PtrFree( vScripts );
+    if ( pNew == NULL && iBest == -2 )
+    {
+        fprintf( pAbc->Err, "Some scripts returned a mapped AIG and others did not; the results are not compared.\n" );
+        return 1;
+    }
+    if ( pNew == NULL )
+    {
+        fprintf( pAbc->Err, "None of the scripts succeeded.\n" );
+        return 1;
+    }
+    Abc_FrameUpdateGia( pAbc, pNew );
+    return 0;
+usage:
+
+    fprintf( pAbc->Err, "usage: fork [-vh] {script} {script} ... [join [best=area|best=delay]]\n" );
+    fprintf( pAbc->Err, "         applies the scripts to copies of the current AIG concurrently\n" );
+    fprintf( pAbc->Err, "         (each in a separate frame with its own state)\n" );
+    fprintf( pAbc->Err, "         and keeps the best result: area compares the number of LUTs\n" );
+    fprintf( pAbc->Err, "         (or AND nodes if not mapped), delay compares the levels\n" );
+    fprintf( pAbc->Err, "         (all results should be mapped or all should be unmapped)\n" );
+    fprintf( pAbc->Err, "         the scripts are given in braces or quotes; the number of\n" );
+    fprintf( pAbc->Err, "         concurrent scripts is bounded by the \"threads\" limit\n" );
+    fprintf( pAbc->Err, "   -v     : toggle printing verbose information [default = %s]\n", fVerbose? "yes": "no" );
+    fprintf( pAbc->Err, "   -h     : print the command usage\n");
+    fprintf( pAbc->Err, "   script : the script to run, for example, {&st; &synch2; &if -K 6; &mfs}\n");
+    return 1;
+}
+
 
 #if 0
 
@@ -199,6 +199,28 @@ const char * CmdSplitLine( Abc_Frame_t * pAbc, const char *sCommand, int *argc,
             p++;
         }
 
+        // the token in braces is taken verbatim (the sub-scripts of "fork")
+        if ( *p == '{' && Vec_PtrSize(vArgs) > 0 && !strcmp((char *)Vec_PtrEntry(vArgs, 0), "fork") )
+        {
+            int depth = 0;
+            for ( start = ++p; *p != '\0'; p++ )
+            {
+                if ( *p == '{' )
+                    depth++;
+                else if ( *p == '}' && depth-- == 0 )
+                    break;
+            }
+            if ( *p != '}' )
+                ( void ) fprintf( pAbc->Err, "** cmd warning: ignoring unbalanced brace ...\n" );
+            new_arg = ABC_ALLOC( char, p - start + 1 );
+            strncpy( new_arg, start, p - start );
+            new_arg[p - start] = '\0';
+            Vec_PtrPush( vArgs, new_arg );
+            if ( *p == '}' )
+                p++;
+            continue;
+        }
+
         // skip until end of this token 
         single_quote = double_quote = 0;
         for ( start = p; ( c = *p ) != '\0'; p++ )
@@ -69,6 +69,13 @@ extern ABC_DLL void   Abc_Stop();
 extern ABC_DLL Abc_Frame_t * Abc_FrameGetGlobalFrame();
 extern ABC_DLL int   Cmd_CommandExecute( Abc_Frame_t * pAbc, const char * pCommandLine );
 
+// procedures to run independent frameworks in several threads
+// (a thread makes a frame current before executing commands in it)
+extern ABC_DLL Abc_Frame_t * Abc_FrameNew();
+extern ABC_DLL void   Abc_FrameDelete( Abc_Frame_t * pAbc );
+extern ABC_DLL Abc_Frame_t * Abc_FrameMakeCurrent( Abc_Frame_t * pAbc );
+extern ABC_DLL void   Abc_FrameThreadStop();
+
 // procedures to input/output 'mini AIG'
 extern ABC_DLL void   Abc_NtkInputMiniAig( Abc_Frame_t * pAbc, void * pMiniAig );
 extern ABC_DLL void * Abc_NtkOutputMiniAig( Abc_Frame_t * pAbc );
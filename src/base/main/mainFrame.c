@@ -23,6 +23,7 @@
 #include "bool/dec/dec.h"
 #include "map/if/if.h"
 #include "aig/miniaig/ndr.h"
+#include "misc/util/utilTask.h"
 
 #ifdef ABC_USE_CUDD
 #include "bdd/extrab/extraBdd.h"
@@ -35,7 +36,11 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-static Abc_Frame_t * s_GlobalFrame = NULL;
+static Abc_Frame_t * s_GlobalFrame = NULL;                  // the frame of the process
+static ABC_THREAD_LOCAL Abc_Frame_t * s_ThreadFrame = NULL; // the frame of this thread (if any)
+
+// the frame used by the calling thread
+static inline Abc_Frame_t * Abc_FrameCur() { return s_ThreadFrame ? s_ThreadFrame : s_GlobalFrame; }
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -52,77 +57,77 @@ static Abc_Frame_t * s_GlobalFrame = NULL;
   SeeAlso     []
 
 ***********************************************************************/
-Vec_Ptr_t * Abc_FrameReadStore()                             { return s_GlobalFrame->vStore;       } 
-int         Abc_FrameReadStoreSize()                         { return Vec_PtrSize(s_GlobalFrame->vStore); }
-void *      Abc_FrameReadLibLut()                            { return s_GlobalFrame->pLibLut;      } 
-void *      Abc_FrameReadLibBox()                            { return s_GlobalFrame->pLibBox;      } 
-void *      Abc_FrameReadLibGen()                            { return s_GlobalFrame->pLibGen;      } 
-void *      Abc_FrameReadLibGen2()                           { return s_GlobalFrame->pLibGen2;     } 
-void *      Abc_FrameReadLibSuper()                          { return s_GlobalFrame->pLibSuper;    } 
-void *      Abc_FrameReadLibScl()                            { return s_GlobalFrame->pLibScl;      } 
+Vec_Ptr_t * Abc_FrameReadStore()                             { return Abc_FrameCur()->vStore;       } 
+int         Abc_FrameReadStoreSize()                         { return Vec_PtrSize(Abc_FrameCur()->vStore); }
+void *      Abc_FrameReadLibLut()                            { return Abc_FrameCur()->pLibLut;      } 
+void *      Abc_FrameReadLibBox()                            { return Abc_FrameCur()->pLibBox;      } 
+void *      Abc_FrameReadLibGen()                            { return Abc_FrameCur()->pLibGen;      } 
+void *      Abc_FrameReadLibGen2()                           { return Abc_FrameCur()->pLibGen2;     } 
+void *      Abc_FrameReadLibSuper()                          { return Abc_FrameCur()->pLibSuper;    } 
+void *      Abc_FrameReadLibScl()                            { return Abc_FrameCur()->pLibScl;      } 
 #ifdef ABC_USE_CUDD
-void *      Abc_FrameReadManDd()                             { if ( s_GlobalFrame->dd == NULL )      s_GlobalFrame->dd = Cudd_Init( 0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0 );  return s_GlobalFrame->dd;      } 
+void *      Abc_FrameReadManDd()                             { if ( Abc_FrameCur()->dd == NULL )      Abc_FrameCur()->dd = Cudd_Init( 0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0 );  return Abc_FrameCur()->dd;      } 
 #endif
-void *      Abc_FrameReadManDec()                            { if ( s_GlobalFrame->pManDec == NULL ) s_GlobalFrame->pManDec = Dec_ManStart();                                        return s_GlobalFrame->pManDec; } 
-void *      Abc_FrameReadManDsd()                            { return s_GlobalFrame->pManDsd;      } 
-void *      Abc_FrameReadManDsd2()                           { return s_GlobalFrame->pManDsd2;     }
-char *      Abc_FrameReadFlag( char * pFlag )                { return Cmd_FlagReadByName( s_GlobalFrame, pFlag );   }
-Vec_Ptr_t * Abc_FrameReadSignalNames()                       { return s_GlobalFrame->vSignalNames; }
-char *      Abc_FrameReadSpecName()                          { return s_GlobalFrame->pSpecName;    }
-
-int         Abc_FrameReadBmcFrames( Abc_Frame_t * p )        { return s_GlobalFrame->nFrames;      }               
-int         Abc_FrameReadProbStatus( Abc_Frame_t * p )       { return s_GlobalFrame->Status;       }               
-void *      Abc_FrameReadCex( Abc_Frame_t * p )              { return s_GlobalFrame->pCex;         }        
-Vec_Ptr_t * Abc_FrameReadCexVec( Abc_Frame_t * p )           { return s_GlobalFrame->vCexVec;      }        
-Vec_Int_t * Abc_FrameReadStatusVec( Abc_Frame_t * p )        { return s_GlobalFrame->vStatuses;    }        
-Vec_Ptr_t * Abc_FrameReadPoEquivs( Abc_Frame_t * p )         { return s_GlobalFrame->vPoEquivs;    }        
-Vec_Int_t * Abc_FrameReadPoStatuses( Abc_Frame_t * p )       { return s_GlobalFrame->vStatuses;    }        
-Vec_Int_t * Abc_FrameReadObjIds( Abc_Frame_t * p )           { return s_GlobalFrame->vAbcObjIds;   }        
-Abc_Nam_t * Abc_FrameReadJsonStrs( Abc_Frame_t * p )         { return s_GlobalFrame->pJsonStrs;    }     
-Vec_Wec_t * Abc_FrameReadJsonObjs( Abc_Frame_t * p )         { return s_GlobalFrame->vJsonObjs;    }   
+void *      Abc_FrameReadManDec()                            { if ( Abc_FrameCur()->pManDec == NULL ) Abc_FrameCur()->pManDec = Dec_ManStart();                                        return Abc_FrameCur()->pManDec; } 
+void *      Abc_FrameReadManDsd()                            { return Abc_FrameCur()->pManDsd;      } 
+void *      Abc_FrameReadManDsd2()                           { return Abc_FrameCur()->pManDsd2;     }
+char *      Abc_FrameReadFlag( char * pFlag )                { return Cmd_FlagReadByName( Abc_FrameCur(), pFlag );   }
+Vec_Ptr_t * Abc_FrameReadSignalNames()                       { return Abc_FrameCur()->vSignalNames; }
+char *      Abc_FrameReadSpecName()                          { return Abc_FrameCur()->pSpecName;    }
+
+int         Abc_FrameReadBmcFrames( Abc_Frame_t * p )        { return Abc_FrameCur()->nFrames;      }               
+int         Abc_FrameReadProbStatus( Abc_Frame_t * p )       { return Abc_FrameCur()->Status;       }               
+void *      Abc_FrameReadCex( Abc_Frame_t * p )              { return Abc_FrameCur()->pCex;         }        
+Vec_Ptr_t * Abc_FrameReadCexVec( Abc_Frame_t * p )           { return Abc_FrameCur()->vCexVec;      }        
+Vec_Int_t * Abc_FrameReadStatusVec( Abc_Frame_t * p )        { return Abc_FrameCur()->vStatuses;    }        
+Vec_Ptr_t * Abc_FrameReadPoEquivs( Abc_Frame_t * p )         { return Abc_FrameCur()->vPoEquivs;    }        
+Vec_Int_t * Abc_FrameReadPoStatuses( Abc_Frame_t * p )       { return Abc_FrameCur()->vStatuses;    }        
+Vec_Int_t * Abc_FrameReadObjIds( Abc_Frame_t * p )           { return Abc_FrameCur()->vAbcObjIds;   }        
+Abc_Nam_t * Abc_FrameReadJsonStrs( Abc_Frame_t * p )         { return Abc_FrameCur()->pJsonStrs;    }     
+Vec_Wec_t * Abc_FrameReadJsonObjs( Abc_Frame_t * p )         { return Abc_FrameCur()->vJsonObjs;    }   
        
-int         Abc_FrameReadCexPiNum( Abc_Frame_t * p )         { return s_GlobalFrame->pCex->nPis;   }               
-int         Abc_FrameReadCexRegNum( Abc_Frame_t * p )        { return s_GlobalFrame->pCex->nRegs;  }               
-int         Abc_FrameReadCexPo( Abc_Frame_t * p )            { return s_GlobalFrame->pCex->iPo;    }               
-int         Abc_FrameReadCexFrame( Abc_Frame_t * p )         { return s_GlobalFrame->pCex->iFrame; }               
-
-void        Abc_FrameInputNdr( Abc_Frame_t * pAbc, void * pData ) { Ndr_Delete(s_GlobalFrame->pNdr); s_GlobalFrame->pNdr = pData;                        }
-void *      Abc_FrameOutputNdr( Abc_Frame_t * pAbc )         { void * pData = s_GlobalFrame->pNdr; s_GlobalFrame->pNdr = NULL; return pData;             }  
-int *       Abc_FrameOutputNdrArray( Abc_Frame_t * pAbc )    { int * pArray = s_GlobalFrame->pNdrArray; s_GlobalFrame->pNdrArray = NULL; return pArray;  }
-
-void        Abc_FrameSetLibLut( void * pLib )                { s_GlobalFrame->pLibLut   = pLib;    } 
-void        Abc_FrameSetLibBox( void * pLib )                { s_GlobalFrame->pLibBox   = pLib;    } 
-void        Abc_FrameSetLibGen( void * pLib )                { s_GlobalFrame->pLibGen   = pLib;    } 
-void        Abc_FrameSetLibGen2( void * pLib )               { s_GlobalFrame->pLibGen2  = pLib;    } 
-void        Abc_FrameSetLibSuper( void * pLib )              { s_GlobalFrame->pLibSuper = pLib;    } 
-void        Abc_FrameSetFlag( char * pFlag, char * pValue )  { Cmd_FlagUpdateValue( s_GlobalFrame, pFlag, pValue );               } 
-void        Abc_FrameSetCex( Abc_Cex_t * pCex )              { ABC_FREE( s_GlobalFrame->pCex ); s_GlobalFrame->pCex = pCex;       }
-void        Abc_FrameSetNFrames( int nFrames )               { ABC_FREE( s_GlobalFrame->pCex ); s_GlobalFrame->nFrames = nFrames; }
-void        Abc_FrameSetStatus( int Status )                 { ABC_FREE( s_GlobalFrame->pCex ); s_GlobalFrame->Status = Status;   }
-void        Abc_FrameSetManDsd( void * pMan )                { if (s_GlobalFrame->pManDsd  && s_GlobalFrame->pManDsd  != pMan) If_DsdManFree((If_DsdMan_t *)s_GlobalFrame->pManDsd,  0); s_GlobalFrame->pManDsd = pMan;  }
-void        Abc_FrameSetManDsd2( void * pMan )               { if (s_GlobalFrame->pManDsd2 && s_GlobalFrame->pManDsd2 != pMan) If_DsdManFree((If_DsdMan_t *)s_GlobalFrame->pManDsd2, 0); s_GlobalFrame->pManDsd2 = pMan; }
-void        Abc_FrameSetInv( Vec_Int_t * vInv )              { Vec_IntFreeP(&s_GlobalFrame->pAbcWlcInv); s_GlobalFrame->pAbcWlcInv = vInv; }
-void        Abc_FrameSetJsonStrs( Abc_Nam_t * pStrs )        { Abc_NamDeref( s_GlobalFrame->pJsonStrs ); s_GlobalFrame->pJsonStrs = pStrs; }
-void        Abc_FrameSetJsonObjs( Vec_Wec_t * vObjs )        { Vec_WecFreeP(&s_GlobalFrame->vJsonObjs ); s_GlobalFrame->vJsonObjs = vObjs; }
-void        Abc_FrameSetSignalNames( Vec_Ptr_t * vNames )    { if ( s_GlobalFrame->vSignalNames ) Vec_PtrFreeFree( s_GlobalFrame->vSignalNames ); s_GlobalFrame->vSignalNames = vNames; }
-void        Abc_FrameSetSpecName( char * pFileName )         { ABC_FREE( s_GlobalFrame->pSpecName ); s_GlobalFrame->pSpecName = pFileName; }
-
-int         Abc_FrameIsBatchMode()                           { return s_GlobalFrame ? s_GlobalFrame->fBatchMode : 0;              } 
-void        Abc_FrameSetBatchMode( int Mode )                { if ( s_GlobalFrame ) s_GlobalFrame->fBatchMode = Mode;             } 
-
-int         Abc_FrameIsBridgeMode()                          { return s_GlobalFrame ? s_GlobalFrame->fBridgeMode : 0;             } 
-void        Abc_FrameSetBridgeMode()                         { if ( s_GlobalFrame ) s_GlobalFrame->fBridgeMode = 1;               } 
-
-char *      Abc_FrameReadDrivingCell()                       { return s_GlobalFrame->pDrivingCell;    }              
-float       Abc_FrameReadMaxLoad()                           { return s_GlobalFrame->MaxLoad;         }      
-void        Abc_FrameSetDrivingCell( char * pName )          { ABC_FREE(s_GlobalFrame->pDrivingCell); s_GlobalFrame->pDrivingCell   = pName; }      
-void        Abc_FrameSetMaxLoad( float Load )                { s_GlobalFrame->MaxLoad = Load;         }      
+int         Abc_FrameReadCexPiNum( Abc_Frame_t * p )         { return Abc_FrameCur()->pCex->nPis;   }               
+int         Abc_FrameReadCexRegNum( Abc_Frame_t * p )        { return Abc_FrameCur()->pCex->nRegs;  }               
+int         Abc_FrameReadCexPo( Abc_Frame_t * p )            { return Abc_FrameCur()->pCex->iPo;    }               
+int         Abc_FrameReadCexFrame( Abc_Frame_t * p )         { return Abc_FrameCur()->pCex->iFrame; }               
+
+void        Abc_FrameInputNdr( Abc_Frame_t * pAbc, void * pData ) { Ndr_Delete(Abc_FrameCur()->pNdr); Abc_FrameCur()->pNdr = pData;                        }
+void *      Abc_FrameOutputNdr( Abc_Frame_t * pAbc )         { void * pData = Abc_FrameCur()->pNdr; Abc_FrameCur()->pNdr = NULL; return pData;             }  
+int *       Abc_FrameOutputNdrArray( Abc_Frame_t * pAbc )    { int * pArray = Abc_FrameCur()->pNdrArray; Abc_FrameCur()->pNdrArray = NULL; return pArray;  }
+
+void        Abc_FrameSetLibLut( void * pLib )                { Abc_FrameCur()->pLibLut   = pLib;    } 
+void        Abc_FrameSetLibBox( void * pLib )                { Abc_FrameCur()->pLibBox   = pLib;    } 
+void        Abc_FrameSetLibGen( void * pLib )                { Abc_FrameCur()->pLibGen   = pLib;    } 
+void        Abc_FrameSetLibGen2( void * pLib )               { Abc_FrameCur()->pLibGen2  = pLib;    } 
+void        Abc_FrameSetLibSuper( void * pLib )              { Abc_FrameCur()->pLibSuper = pLib;    } 
+void        Abc_FrameSetFlag( char * pFlag, char * pValue )  { Cmd_FlagUpdateValue( Abc_FrameCur(), pFlag, pValue );              } 
+void        Abc_FrameSetCex( Abc_Cex_t * pCex )              { ABC_FREE( Abc_FrameCur()->pCex ); Abc_FrameCur()->pCex = pCex;       }
+void        Abc_FrameSetNFrames( int nFrames )               { ABC_FREE( Abc_FrameCur()->pCex ); Abc_FrameCur()->nFrames = nFrames; }
+void        Abc_FrameSetStatus( int Status )                 { ABC_FREE( Abc_FrameCur()->pCex ); Abc_FrameCur()->Status = Status;   }
+void        Abc_FrameSetManDsd( void * pMan )                { if (Abc_FrameCur()->pManDsd  && Abc_FrameCur()->pManDsd  != pMan) If_DsdManFree((If_DsdMan_t *)Abc_FrameCur()->pManDsd,  0); Abc_FrameCur()->pManDsd = pMan;  }
+void        Abc_FrameSetManDsd2( void * pMan )               { if (Abc_FrameCur()->pManDsd2 && Abc_FrameCur()->pManDsd2 != pMan) If_DsdManFree((If_DsdMan_t *)Abc_FrameCur()->pManDsd2, 0); Abc_FrameCur()->pManDsd2 = pMan; }
+void        Abc_FrameSetInv( Vec_Int_t * vInv )              { Vec_IntFreeP(&Abc_FrameCur()->pAbcWlcInv); Abc_FrameCur()->pAbcWlcInv = vInv; }
+void        Abc_FrameSetJsonStrs( Abc_Nam_t * pStrs )        { Abc_NamDeref( Abc_FrameCur()->pJsonStrs ); Abc_FrameCur()->pJsonStrs = pStrs; }
+void        Abc_FrameSetJsonObjs( Vec_Wec_t * vObjs )        { Vec_WecFreeP(&Abc_FrameCur()->vJsonObjs ); Abc_FrameCur()->vJsonObjs = vObjs; }
+void        Abc_FrameSetSignalNames( Vec_Ptr_t * vNames )    { if ( Abc_FrameCur()->vSignalNames ) Vec_PtrFreeFree( Abc_FrameCur()->vSignalNames ); Abc_FrameCur()->vSignalNames = vNames; }
+void        Abc_FrameSetSpecName( char * pFileName )         { ABC_FREE( Abc_FrameCur()->pSpecName ); Abc_FrameCur()->pSpecName = pFileName; }
+
+int         Abc_FrameIsBatchMode()                           { return Abc_FrameCur() ? Abc_FrameCur()->fBatchMode : 0;              } 
+void        Abc_FrameSetBatchMode( int Mode )                { if ( Abc_FrameCur() ) Abc_FrameCur()->fBatchMode = Mode;             } 
+
+int         Abc_FrameIsBridgeMode()                          { return Abc_FrameCur() ? Abc_FrameCur()->fBridgeMode : 0;             } 
+void        Abc_FrameSetBridgeMode()                         { if ( Abc_FrameCur() ) Abc_FrameCur()->fBridgeMode = 1;               } 
+
+char *      Abc_FrameReadDrivingCell()                       { return Abc_FrameCur()->pDrivingCell;    }              
+float       Abc_FrameReadMaxLoad()                           { return Abc_FrameCur()->MaxLoad;         }      
+void        Abc_FrameSetDrivingCell( char * pName )          { ABC_FREE(Abc_FrameCur()->pDrivingCell); Abc_FrameCur()->pDrivingCell   = pName; }      
+void        Abc_FrameSetMaxLoad( float Load )                { Abc_FrameCur()->MaxLoad = Load;         }      
 
 int *       Abc_FrameReadArrayMapping( Abc_Frame_t * pAbc )  { return pAbc->pArray;                                            }
-void        Abc_FrameSetArrayMapping( int * p )              { ABC_FREE( s_GlobalFrame->pArray ); s_GlobalFrame->pArray = p;   }      
+void        Abc_FrameSetArrayMapping( int * p )              { ABC_FREE( Abc_FrameCur()->pArray ); Abc_FrameCur()->pArray = p;   }      
 
 int *       Abc_FrameReadBoxes( Abc_Frame_t * pAbc )         { return pAbc->pBoxes;                                            }
-void        Abc_FrameSetBoxes( int * p )                     { ABC_FREE( s_GlobalFrame->pBoxes ); s_GlobalFrame->pBoxes = p;   }      
+void        Abc_FrameSetBoxes( int * p )                     { ABC_FREE( Abc_FrameCur()->pBoxes ); Abc_FrameCur()->pBoxes = p;   }      
 
 /**Function*************************************************************
 
@@ -208,7 +213,8 @@ void Abc_FrameDeallocate( Abc_Frame_t * p )
 //    extern void Ivy_TruthManStop();
 //    Abc_HManStop();
 //    undefine_cube_size();
-    Rwt_ManGlobalStop();
+    if ( !p->fThreadFrame )
+        Rwt_ManGlobalStop();
 //    Ivy_TruthManStop();
     if ( p->vAbcObjIds)  Vec_IntFree( p->vAbcObjIds );
     if ( p->vCexVec   )  Vec_PtrFreeFree( p->vCexVec );
@@ -244,10 +250,10 @@ void Abc_FrameDeallocate( Abc_Frame_t * p )
     ABC_FREE( p->pCex2 );
     ABC_FREE( p->pCex );
     Vec_IntFreeP( &p->pAbcWlcInv );
-    Abc_NamDeref( s_GlobalFrame->pJsonStrs );
-    Vec_WecFreeP( &s_GlobalFrame->vJsonObjs );  
-    Ndr_Delete( s_GlobalFrame->pNdr );
-    ABC_FREE( s_GlobalFrame->pNdrArray );
+    Abc_NamDeref( p->pJsonStrs );
+    Vec_WecFreeP( &p->vJsonObjs );  
+    Ndr_Delete( p->pNdr );
+    ABC_FREE( p->pNdrArray );
 
     Gia_ManStopP( &p->pGiaMiniAig );
     Gia_ManStopP( &p->pGiaMiniLut );
@@ -257,8 +263,11 @@ void Abc_FrameDeallocate( Abc_Frame_t * p )
     ABC_FREE( p->pBoxes );
     
 
+    if ( s_GlobalFrame == p )
+        s_GlobalFrame = NULL;
+    if ( s_ThreadFrame == p )
+        s_ThreadFrame = NULL;
     ABC_FREE( p );
-    s_GlobalFrame = NULL;
 }
 
 
@@ -641,6 +650,8 @@ void Abc_FrameSetGlobalFrame( Abc_Frame_t * p )
 ***********************************************************************/
 Abc_Frame_t * Abc_FrameGetGlobalFrame()
 {
+    if ( s_ThreadFrame )
+        return s_ThreadFrame;
     if ( s_GlobalFrame == 0 )
     {
         // start the framework
@@ -664,7 +675,78 @@ Abc_Frame_t * Abc_FrameGetGlobalFrame()
 ***********************************************************************/
 Abc_Frame_t * Abc_FrameReadGlobalFrame()
 {
-    return s_GlobalFrame;
+    return Abc_FrameCur();
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Creates an independent frame.]
+
+  Description [The frame has its own networks, libraries, command tables,
+  and variables. It is used by the thread that makes it current with
+  Abc_FrameMakeCurrent(); several threads can execute commands at the
+  same time, each in its own frame. The frame is in the batch mode and
+  does not record the history.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Frame_t * Abc_FrameNew()
+{
+    Abc_Frame_t * p = Abc_FrameAllocate(), * pOld;
+    p->fThreadFrame = 1;
+    p->fBatchMode   = 1;
+    pOld = Abc_FrameMakeCurrent( p );
+    Abc_FrameInit( p );
+    Abc_FrameMakeCurrent( pOld );
+    return p;
+}
+void Abc_FrameDelete( Abc_Frame_t * p )
+{
+    Abc_Frame_t * pOld = Abc_FrameMakeCurrent( p );
+    assert( p->fThreadFrame );
+    Abc_FrameEnd( p );
+    Abc_FrameDeallocate( p );
+    Abc_FrameMakeCurrent( pOld == p ? NULL : pOld );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Makes the frame current in this thread.]
+
+  Description [Returns the frame that was current before. When NULL is
+  given, the thread returns to the frame of the process.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Frame_t * Abc_FrameMakeCurrent( Abc_Frame_t * p )
+{
+    Abc_Frame_t * pOld = s_ThreadFrame;
+    s_ThreadFrame = p;
+    return pOld;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Releases the per-thread state of the packages.]
+
+  Description [Should be called by a thread, other than the one that
+  started ABC, before it exits, after deleting its frames.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_FrameThreadStop()
+{
+    Util_TaskThreadExit();
+    s_ThreadFrame = NULL;
 }
 
 /**Function*************************************************************
@@ -76,6 +76,7 @@ struct Abc_Frame_t_
     int             fAutoexac;     // marks the autoexec mode
     int             fBatchMode;    // batch mode flag
     int             fBridgeMode;   // bridge mode flag
+    int             fThreadFrame;  // the frame was created by Abc_FrameNew()
     // save/load
     Abc_Ntk_t *     pNtkBest;        // the current network
     float           nBestNtkArea;   // best area
@@ -128,7 +128,7 @@ void Abc_UtilsPrintUsage( Abc_Frame_t * pAbc, char * ProgName )
 {
     fprintf( pAbc->Err, "\n" );
     fprintf( pAbc->Err,
-             "usage: %s [-c cmd] [-q cmd] [-C cmd] [-Q cmd] [-f script] [-h] [-o file] [-s] [-t type] [-T type] [-x] [-b] [file]\n",
+             "usage: %s [-c cmd] [-q cmd] [-C cmd] [-Q cmd] [-f script] [-h] [-j num] [-o file] [-s] [-t type] [-T type] [-x] [-b] [file]\n",
              ProgName);
     fprintf( pAbc->Err, "    -c cmd\texecute commands `cmd'\n");
     fprintf( pAbc->Err, "    -q cmd\texecute commands `cmd' quietly\n");
@@ -137,6 +137,7 @@ void Abc_UtilsPrintUsage( Abc_Frame_t * pAbc, char * ProgName )
     fprintf( pAbc->Err, "    -F script\texecute commands from a script file and echo commands\n");
     fprintf( pAbc->Err, "    -f script\texecute commands from a script file\n");
     fprintf( pAbc->Err, "    -h\t\tprint the command usage\n");
+    fprintf( pAbc->Err, "    -j num\tlimit the number of threads used by the parallel engines (0 = no limit)\n");
     fprintf( pAbc->Err, "    -o file\tspecify output filename to store the result\n");
     fprintf( pAbc->Err, "    -s\t\tdo not read any initialization file\n");
     fprintf( pAbc->Err, "    -t type\tspecify input type (blif_mv (default), blif_mvs, blif, or none)\n");
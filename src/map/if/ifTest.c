@@ -20,17 +20,7 @@
 
 #include "if.h"
 #include "aig/gia/gia.h"
-
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilTask.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -38,12 +28,6 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-#ifndef ABC_USE_PTHREADS
-
-// do nothing
-
-#else // pthreads are used
-
 static inline word * Gia_ParTestObj( Gia_Man_t * p, int Id )         { return (word *)p->pData + Id * p->iData; }
 static inline void   Gia_ParTestAlloc( Gia_Man_t * p, int nWords )   { assert( !p->pData ); p->pData = (unsigned *)ABC_ALLOC(word, Gia_ManObjNum(p) * nWords); p->iData = nWords; }
 static inline void   Gia_ParTestFree( Gia_Man_t * p )                { ABC_FREE( p->pData ); p->iData = 0; }
@@ -210,35 +194,21 @@ typedef struct Par_ThData_t_
 {
     Gia_Man_t * p;
     int         Id;
-    int         Status;
 } Par_ThData_t;
-void * Gia_ParWorkerThread( void * pArg )
+void * Gia_ParWorkerTask( void * pArg )
 {
     Par_ThData_t * pThData = (Par_ThData_t *)pArg;
-    volatile int * pPlace = &pThData->Status;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->Status == 1 );
-        if ( pThData->Id == -1 )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        assert( pThData->Id >= 0 );
-        Gia_ParTestSimulateObj( pThData->p, pThData->Id );
-        pThData->Status = 0;
-    }
-    assert( 0 );
+    assert( pThData->Id >= 0 );
+    Gia_ParTestSimulateObj( pThData->p, pThData->Id );
     return NULL;
 }
 void Gia_ParTestSimulate2( Gia_Man_t * p, int nWords, int nProcs )
 {
-    pthread_t WorkerThread[PAR_THR_MAX];
+    Util_TaskMan_t * pMan;
+    Util_Task_t * pTasks[PAR_THR_MAX] = {NULL};
     Par_ThData_t ThData[PAR_THR_MAX];
     Vec_Int_t * vStack, * vFanins;
-    int i, k, iFan, status, nCountFanins;
+    int i, k, iFan, nCountFanins;
     assert( nProcs <= PAR_THR_MAX );
     Gia_ManRandom( 1 );
     Gia_ParTestAlloc( p, nWords );
@@ -251,40 +221,37 @@ void Gia_ParTestSimulate2( Gia_Man_t * p, int nWords, int nProcs )
     Gia_ManStaticFanoutStart( p );
     vFanins = Gia_ManCreateFaninCounts( p );
     nCountFanins = Vec_IntSum(vFanins);
-    // start the threads
+    // one node per slot (the manager is extra)
+    pMan = Util_TaskManStart( nProcs + 1 );
     for ( i = 0; i < nProcs; i++ )
     {
         ThData[i].p = p;
         ThData[i].Id = -1;
-        ThData[i].Status = 0;
-        status = pthread_create( WorkerThread + i, NULL, Gia_ParWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
     }
-    while ( nCountFanins > 0 || Vec_IntSize(vStack) > 0 )
+    while ( 1 )
     {
-        for ( i = 0; i < nProcs; i++ )
+        for ( i = 0; i < nProcs && Vec_IntSize(vStack) > 0; i++ )
         {
-            if ( ThData[i].Status )
+            if ( pTasks[i] )
                 continue;
-            assert( ThData[i].Status == 0 );
-            if ( ThData[i].Id >= 0 )
-            {
-                Gia_ObjForEachFanoutStaticId( p, ThData[i].Id, iFan, k )
-                {
-                    assert( Vec_IntEntry(vFanins, iFan) > 0 );
-                    if ( Vec_IntAddToEntry(vFanins, iFan, -1) == 0 )
-                        Vec_IntPush( vStack, iFan );
-                    assert( nCountFanins > 0 );
-                    nCountFanins--;
-                }
-                ThData[i].Id = -1;
-            }
-            if ( Vec_IntSize(vStack) > 0 )
-            {
-                ThData[i].Id = Vec_IntPop( vStack );
-                ThData[i].Status = 1;
-            }
+            ThData[i].Id = Vec_IntPop( vStack );
+            pTasks[i] = Util_TaskSpawn( pMan, Gia_ParWorkerTask, ThData + i );
         }
+        if ( (i = Util_TaskWaitAny( pTasks, nProcs )) < 0 )
+            break;
+        Util_TaskFree( pTasks[i] );
+        pTasks[i] = NULL;
+        Gia_ObjForEachFanoutStaticId( p, ThData[i].Id, iFan, k )
+        {
+            assert( Vec_IntEntry(vFanins, iFan) > 0 );
+            if ( Vec_IntAddToEntry(vFanins, iFan, -1) == 0 )
+                Vec_IntPush( vStack, iFan );
+            assert( nCountFanins > 0 );
+            nCountFanins--;
+        }
+        ThData[i].Id = -1;
     }
+    Util_TaskManStop( pMan );
     Vec_IntForEachEntry( vFanins, iFan, k )
         if ( iFan != 0 )
         {
@@ -292,21 +259,6 @@ void Gia_ParTestSimulate2( Gia_Man_t * p, int nWords, int nProcs )
             Gia_ObjPrint( p, Gia_ManObj(p, k) );
         }
 //    assert( Vec_IntSum(vFanins) == 0 );
-    // stop the threads
-    while ( 1 )
-    {
-        for ( i = 0; i < nProcs; i++ )
-            if ( ThData[i].Status )
-                break;
-        if ( i == nProcs )
-            break;
-    }
-    for ( i = 0; i < nProcs; i++ )
-    {
-        assert( ThData[i].Status == 0 );
-        ThData[i].Id = -1;
-        ThData[i].Status = 1;
-    }
     Gia_ManStaticFanoutStop( p );
     Vec_IntFree( vStack );
     Vec_IntFree( vFanins );
@@ -345,8 +297,6 @@ void Gia_ParTest( Gia_Man_t * p, int nWords, int nProcs )
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
 
-#endif // pthreads are used
-
 
 ABC_NAMESPACE_IMPL_END
 
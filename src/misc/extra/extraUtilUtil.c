@@ -41,10 +41,12 @@ ABC_NAMESPACE_IMPL_START
  *  Purpose: get option letter from argv.
  */
 
-const char * globalUtilOptarg;        // Global argument pointer (util_optarg)
-int    globalUtilOptind = 0;    // Global argv index (util_optind)
+// the parsing state is kept by each thread, so that the commands
+// of the frames running in different threads parse their own options
+ABC_THREAD_LOCAL const char * globalUtilOptarg;        // Global argument pointer (util_optarg)
+ABC_THREAD_LOCAL int    globalUtilOptind = 0;    // Global argv index (util_optind)
 
-static const char *pScanStr;
+static ABC_THREAD_LOCAL const char *pScanStr;
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
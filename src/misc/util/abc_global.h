@@ -65,6 +65,17 @@
 #endif
 #endif
 
+// storage class of the hidden state that is kept separately by each thread
+#if !defined(ABC_THREAD_LOCAL)
+#if defined(_MSC_VER)
+#define ABC_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define ABC_THREAD_LOCAL __thread
+#else
+#define ABC_THREAD_LOCAL
+#endif
+#endif
+
 /*
 #ifdef __cplusplus
 #error "C++ code"
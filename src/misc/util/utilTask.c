@@ -0,0 +1,638 @@
+/**CFile****************************************************************
+
+  FileName    [utilTask.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Task-parallel runtime.]
+
+  Synopsis    [Work-stealing scheduler shared by the multi-threaded engines.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - October 17, 2026.]
+
+  Revision    [$Id: utilTask.c,v 1.00 2026/10/17 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "abc_global.h"
+#include "utilTask.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// Each worker owns a deque of tasks.  The tasks spawned by a worker go
+// to the tail of its deque and are taken back from the tail (LIFO), while
+// idle workers steal from the head of the other deques (FIFO).  The tasks
+// spawned by the threads outside of the pool go to the extra deque.
+// The tasks are coarse (a script, a solver run, a partition), so all the
+// deques are protected by one lock, and the idle threads sleep on one
+// condition variable instead of spinning.  A thread waiting for a future
+// executes the queued tasks, which makes nested parallelism deadlock-free.
+
+typedef struct Util_TaskDeq_t_ Util_TaskDeq_t;
+struct Util_TaskDeq_t_
+{
+    int              nCap;
+    int              iHead;
+    int              iTail;
+    Util_Task_t **   pArray;
+};
+
+typedef struct Util_TaskWorker_t_ Util_TaskWorker_t;
+struct Util_TaskWorker_t_
+{
+    Util_TaskMan_t * p;
+    int              iWorker;
+};
+
+struct Util_Task_t_
+{
+    Util_TaskMan_t * pMan;
+    Util_TaskFunc_t  pFunc;
+    void *           pArg;
+    void *           pRes;
+    int              Status;      // 0 = queued; 1 = running; 2 = done
+};
+
+struct Util_TaskMan_t_
+{
+    int              nWorkers;    // the number of worker threads
+    int              nQueued;     // the number of queued tasks
+    Util_TaskDeq_t * pDeqs;       // the deques of the workers and the external deque
+    Util_TaskWorker_t * pWorkers; // the worker descriptors
+    volatile int     fStop;       // the pool is being stopped
+    volatile int     fCancel;     // the remaining tasks are cancelled
+    abctime          TimeToStop;  // the time budget
+#ifdef ABC_USE_PTHREADS
+    pthread_t *      pThreads;
+    pthread_mutex_t  Mutex;
+    pthread_cond_t   Cond;
+#endif
+};
+
+// the global limit on the number of threads (0 = no limit)
+static int s_nThreadLimit = 0;
+static int s_nThreadsUsed = 0;
+
+// the procedures releasing the per-thread state of this thread
+#define UTIL_TASK_EXIT_MAX 16
+static ABC_THREAD_LOCAL Util_TaskExit_t s_pExitFuncs[UTIL_TASK_EXIT_MAX];
+static ABC_THREAD_LOCAL int             s_nExitFuncs = 0;
+
+#ifdef ABC_USE_PTHREADS
+static pthread_mutex_t s_TaskMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t s_InitMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t  s_TaskOnce  = PTHREAD_ONCE_INIT;
+static pthread_key_t   s_TaskKey;
+static void Util_TaskKeyStart() { pthread_key_create( &s_TaskKey, NULL ); }
+#define UTIL_TASK_LOCK(p)      pthread_mutex_lock( &(p)->Mutex )
+#define UTIL_TASK_UNLOCK(p)    pthread_mutex_unlock( &(p)->Mutex )
+#define UTIL_TASK_SLEEP(p)     pthread_cond_wait( &(p)->Cond, &(p)->Mutex )
+#define UTIL_TASK_WAKE(p)      pthread_cond_broadcast( &(p)->Cond )
+#else
+#define UTIL_TASK_LOCK(p)
+#define UTIL_TASK_UNLOCK(p)
+#define UTIL_TASK_SLEEP(p)     assert( 0 )
+#define UTIL_TASK_WAKE(p)
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Sets the global limit on the number of threads.]
+
+  Description [The limit (the -j option of the binary and the command
+  "threads") bounds the total number of threads used by all pools,
+  including the threads that start them. Zero means no limit.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_TaskSetThreadLimit( int nThreads )
+{
+    s_nThreadLimit = Abc_MaxInt( nThreads, 0 );
+}
+int Util_TaskThreadLimit()
+{
+    return s_nThreadLimit;
+}
+int Util_TaskThreadsUsed()
+{
+    return s_nThreadsUsed;
+}
+static int Util_TaskReserveThreads( int nWorkers )
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &s_TaskMutex );
+    if ( s_nThreadLimit > 0 )
+        nWorkers = Abc_MaxInt( 0, Abc_MinInt(nWorkers, s_nThreadLimit - 1 - s_nThreadsUsed) );
+    s_nThreadsUsed += nWorkers;
+    pthread_mutex_unlock( &s_TaskMutex );
+    return nWorkers;
+#else
+    return 0;
+#endif
+}
+static void Util_TaskReleaseThreads( int nWorkers )
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &s_TaskMutex );
+    s_nThreadsUsed -= nWorkers;
+    assert( s_nThreadsUsed >= 0 );
+    pthread_mutex_unlock( &s_TaskMutex );
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Serializes the lazy set-up of the process-wide tables.]
+
+  Description [The packages sharing read-only tables among the frames
+  of different threads build them under this lock.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_TaskGlobalLock()
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_lock( &s_InitMutex );
+#endif
+}
+void Util_TaskGlobalUnlock()
+{
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_unlock( &s_InitMutex );
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Releasing the per-thread state.]
+
+  Description [A package that keeps its state in thread-local storage
+  registers the procedure releasing it when the state is created in
+  a thread. The workers of the pools call Util_TaskThreadExit() before
+  exiting; other threads call it when they are done with ABC.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_TaskAtThreadExit( Util_TaskExit_t pFunc )
+{
+    int i;
+    for ( i = 0; i < s_nExitFuncs; i++ )
+        if ( s_pExitFuncs[i] == pFunc )
+            return;
+    assert( s_nExitFuncs < UTIL_TASK_EXIT_MAX );
+    s_pExitFuncs[s_nExitFuncs++] = pFunc;
+}
+void Util_TaskThreadExit()
+{
+    while ( s_nExitFuncs > 0 )
+        s_pExitFuncs[--s_nExitFuncs]();
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Deque manipulation.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Util_TaskDeqSize( Util_TaskDeq_t * q )
+{
+    return q->iTail - q->iHead;
+}
+static inline void Util_TaskDeqPush( Util_TaskDeq_t * q, Util_Task_t * pTask )
+{
+    if ( q->iTail == q->nCap )
+    {
+        if ( q->iHead > 0 )
+        {
+            memmove( q->pArray, q->pArray + q->iHead, sizeof(Util_Task_t *) * Util_TaskDeqSize(q) );
+            q->iTail -= q->iHead;
+            q->iHead = 0;
+        }
+        else
+        {
+            q->nCap = q->nCap ? 2 * q->nCap : 16;
+            q->pArray = ABC_REALLOC( Util_Task_t *, q->pArray, q->nCap );
+        }
+    }
+    q->pArray[q->iTail++] = pTask;
+}
+static inline Util_Task_t * Util_TaskDeqPop( Util_TaskDeq_t * q, int fHead )
+{
+    Util_Task_t * pTask = fHead ? q->pArray[q->iHead++] : q->pArray[--q->iTail];
+    if ( q->iHead == q->iTail )
+        q->iHead = q->iTail = 0;
+    return pTask;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the deque of the current thread in this pool.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Util_TaskManOwnDeq( Util_TaskMan_t * p )
+{
+#ifdef ABC_USE_PTHREADS
+    Util_TaskWorker_t * pWorker = (Util_TaskWorker_t *)pthread_getspecific( s_TaskKey );
+    if ( pWorker && pWorker->p == p )
+        return pWorker->iWorker;
+#endif
+    return p->nWorkers;
+}
+Util_TaskMan_t * Util_TaskManCurrent()
+{
+#ifdef ABC_USE_PTHREADS
+    Util_TaskWorker_t * pWorker;
+    pthread_once( &s_TaskOnce, Util_TaskKeyStart );
+    pWorker = (Util_TaskWorker_t *)pthread_getspecific( s_TaskKey );
+    return pWorker ? pWorker->p : NULL;
+#else
+    return NULL;
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Takes the next task, stealing it if the own deque is empty.]
+
+  Description [Should be called with the lock held.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Util_Task_t * Util_TaskManGrab( Util_TaskMan_t * p, int iOwn )
+{
+    int k, nDeqs = p->nWorkers + 1;
+    if ( p->nQueued == 0 )
+        return NULL;
+    p->nQueued--;
+    if ( Util_TaskDeqSize(p->pDeqs + iOwn) > 0 )
+        return Util_TaskDeqPop( p->pDeqs + iOwn, 0 );
+    for ( k = 1; k < nDeqs; k++ )
+        if ( Util_TaskDeqSize(p->pDeqs + (iOwn + k) % nDeqs) > 0 )
+            return Util_TaskDeqPop( p->pDeqs + (iOwn + k) % nDeqs, 1 );
+    assert( 0 );
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Executes one task.]
+
+  Description [Should be called with the lock held. Releases the lock
+  while the task is running. The tasks of a cancelled pool are completed
+  without running them; their result is NULL. A thread outside of the
+  pool that helps by running a task becomes its member for the duration
+  of the task, so that the nested tasks are spawned into the same pool.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Util_TaskManRun( Util_TaskMan_t * p, Util_Task_t * pTask )
+{
+#ifdef ABC_USE_PTHREADS
+    void * pOld = pthread_getspecific( s_TaskKey );
+    if ( pOld == NULL || ((Util_TaskWorker_t *)pOld)->p != p )
+        pthread_setspecific( s_TaskKey, p->pWorkers + p->nWorkers );
+#endif
+    assert( pTask->Status == 0 );
+    pTask->Status = 1;
+    UTIL_TASK_UNLOCK( p );
+    if ( !Util_TaskManIsStopped(p) )
+        pTask->pRes = pTask->pFunc( pTask->pArg );
+    UTIL_TASK_LOCK( p );
+#ifdef ABC_USE_PTHREADS
+    pthread_setspecific( s_TaskKey, pOld );
+#endif
+    pTask->Status = 2;
+    UTIL_TASK_WAKE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starting and stopping the pool.]
+
+  Description [The pool runs up to nThreads tasks concurrently: the
+  calling thread helps while waiting, so nThreads-1 workers are started,
+  subject to the global limit. When no workers are available (the limit
+  is reached or pthreads are not used), the tasks are executed by the
+  threads waiting for them.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+static void * Util_TaskWorkerThread( void * pArg )
+{
+    Util_TaskWorker_t * pWorker = (Util_TaskWorker_t *)pArg;
+    Util_TaskMan_t * p = pWorker->p;
+    Util_Task_t * pTask;
+    pthread_setspecific( s_TaskKey, pWorker );
+    UTIL_TASK_LOCK( p );
+    while ( 1 )
+    {
+        if ( (pTask = Util_TaskManGrab(p, pWorker->iWorker)) )
+            Util_TaskManRun( p, pTask );
+        else if ( p->fStop )
+            break;
+        else
+            UTIL_TASK_SLEEP( p );
+    }
+    UTIL_TASK_UNLOCK( p );
+    Util_TaskThreadExit();
+    return NULL;
+}
+#endif
+Util_TaskMan_t * Util_TaskManStart( int nThreads )
+{
+    Util_TaskMan_t * p = ABC_CALLOC( Util_TaskMan_t, 1 );
+    int i, status = 0;
+    p->nWorkers = Util_TaskReserveThreads( Abc_MaxInt(nThreads, 1) - 1 );
+    p->pDeqs    = ABC_CALLOC( Util_TaskDeq_t, p->nWorkers + 1 );
+    p->pWorkers = ABC_CALLOC( Util_TaskWorker_t, p->nWorkers + 1 );
+    for ( i = 0; i <= p->nWorkers; i++ )
+        p->pWorkers[i].p = p, p->pWorkers[i].iWorker = i;
+#ifdef ABC_USE_PTHREADS
+    pthread_once( &s_TaskOnce, Util_TaskKeyStart );
+    pthread_mutex_init( &p->Mutex, NULL );
+    pthread_cond_init( &p->Cond, NULL );
+    p->pThreads = ABC_CALLOC( pthread_t, p->nWorkers + 1 );
+    for ( i = 0; i < p->nWorkers; i++ )
+    {
+        status = pthread_create( p->pThreads + i, NULL, Util_TaskWorkerThread, (void *)(p->pWorkers + i) );
+        assert( status == 0 );
+    }
+#endif
+    (void)status;
+    return p;
+}
+void Util_TaskManStop( Util_TaskMan_t * p )
+{
+    int i;
+    // the workers finish the queued tasks before exiting
+    UTIL_TASK_LOCK( p );
+    p->fStop = 1;
+    UTIL_TASK_WAKE( p );
+    UTIL_TASK_UNLOCK( p );
+#ifdef ABC_USE_PTHREADS
+    for ( i = 0; i < p->nWorkers; i++ )
+        pthread_join( p->pThreads[i], NULL );
+    pthread_mutex_destroy( &p->Mutex );
+    pthread_cond_destroy( &p->Cond );
+    ABC_FREE( p->pThreads );
+#endif
+    assert( p->nQueued == 0 );
+    Util_TaskReleaseThreads( p->nWorkers );
+    for ( i = 0; i <= p->nWorkers; i++ )
+        ABC_FREE( p->pDeqs[i].pArray );
+    ABC_FREE( p->pDeqs );
+    ABC_FREE( p->pWorkers );
+    ABC_FREE( p );
+}
+int Util_TaskManThreadNum( Util_TaskMan_t * p )
+{
+    return p->nWorkers + 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Cancellation and time budget.]
+
+  Description [The tasks that are not started after cancellation or
+  after the time budget is exhausted are skipped. The running tasks
+  are expected to poll Util_TaskManIsStopped() and return early.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_TaskManSetTimeLimit( Util_TaskMan_t * p, int nSeconds )
+{
+    p->TimeToStop = nSeconds > 0 ? Abc_Clock() + (abctime)nSeconds * CLOCKS_PER_SEC : 0;
+}
+void Util_TaskManCancel( Util_TaskMan_t * p )
+{
+    p->fCancel = 1;
+}
+int Util_TaskManIsStopped( Util_TaskMan_t * p )
+{
+    if ( p->fCancel )
+        return 1;
+    if ( p->TimeToStop && Abc_Clock() > p->TimeToStop )
+        p->fCancel = 1;
+    return p->fCancel;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Spawns a task and returns its future.]
+
+  Description [The task spawned by a worker goes to its own deque;
+  the task spawned by another thread goes to the external deque.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Util_Task_t * Util_TaskSpawn( Util_TaskMan_t * p, Util_TaskFunc_t pFunc, void * pArg )
+{
+    Util_Task_t * pTask = ABC_CALLOC( Util_Task_t, 1 );
+    pTask->pMan  = p;
+    pTask->pFunc = pFunc;
+    pTask->pArg  = pArg;
+    UTIL_TASK_LOCK( p );
+    Util_TaskDeqPush( p->pDeqs + Util_TaskManOwnDeq(p), pTask );
+    p->nQueued++;
+    UTIL_TASK_WAKE( p );
+    UTIL_TASK_UNLOCK( p );
+    return pTask;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Waits for the futures.]
+
+  Description [While the result is not ready, the waiting thread executes
+  the queued tasks of the same pool or sleeps if there are none.
+  Util_TaskWaitAny() returns the index of a completed task among the
+  given ones (the NULL entries are skipped) or -1 if there are none.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Util_TaskIsDone( Util_Task_t * pTask )
+{
+    return pTask->Status == 2;
+}
+void * Util_TaskWait( Util_Task_t * pTask )
+{
+    Util_TaskMan_t * p = pTask->pMan;
+    Util_Task_t * pNext;
+    int iOwn = Util_TaskManOwnDeq( p );
+    UTIL_TASK_LOCK( p );
+    while ( pTask->Status != 2 )
+    {
+        if ( (pNext = Util_TaskManGrab(p, iOwn)) )
+            Util_TaskManRun( p, pNext );
+        else
+            UTIL_TASK_SLEEP( p );
+    }
+    UTIL_TASK_UNLOCK( p );
+    return pTask->pRes;
+}
+int Util_TaskWaitAny( Util_Task_t ** ppTasks, int nTasks )
+{
+    Util_TaskMan_t * p = NULL;
+    Util_Task_t * pNext;
+    int i, iOwn, iDone = -1;
+    for ( i = 0; i < nTasks; i++ )
+        if ( ppTasks[i] )
+            p = ppTasks[i]->pMan;
+    if ( p == NULL )
+        return -1;
+    iOwn = Util_TaskManOwnDeq( p );
+    UTIL_TASK_LOCK( p );
+    while ( 1 )
+    {
+        for ( i = 0; i < nTasks; i++ )
+            if ( ppTasks[i] && ppTasks[i]->Status == 2 )
+                break;
+        if ( i < nTasks )
+        {
+            iDone = i;
+            break;
+        }
+        if ( (pNext = Util_TaskManGrab(p, iOwn)) )
+            Util_TaskManRun( p, pNext );
+        else
+            UTIL_TASK_SLEEP( p );
+    }
+    UTIL_TASK_UNLOCK( p );
+    return iDone;
+}
+void Util_TaskFree( Util_Task_t * pTask )
+{
+    Util_TaskWait( pTask );
+    ABC_FREE( pTask );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the loop body for each item on nThreads threads.]
+
+  Description [Inside a task, the items are spawned into the current pool
+  (nested parallelism); otherwise a temporary pool is started.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Util_TaskItem_t_ Util_TaskItem_t;
+struct Util_TaskItem_t_
+{
+    Util_TaskLoop_t  pFunc;
+    void *           pArg;
+    int              iItem;
+};
+static void * Util_TaskItemRun( void * pArg )
+{
+    Util_TaskItem_t * pItem = (Util_TaskItem_t *)pArg;
+    pItem->pFunc( pItem->pArg, pItem->iItem );
+    return NULL;
+}
+void Util_TaskParallelFor( int nThreads, int nItems, Util_TaskLoop_t pFunc, void * pArg )
+{
+    Util_TaskMan_t * p;
+    Util_TaskItem_t * pItems;
+    Util_Task_t ** ppTasks;
+    int i, fOwn;
+    if ( nThreads < 2 || nItems < 2 )
+    {
+        for ( i = 0; i < nItems; i++ )
+            pFunc( pArg, i );
+        return;
+    }
+    p = Util_TaskManCurrent();
+    fOwn = (p == NULL);
+    if ( fOwn )
+        p = Util_TaskManStart( Abc_MinInt(nThreads, nItems) );
+    pItems  = ABC_CALLOC( Util_TaskItem_t, nItems );
+    ppTasks = ABC_CALLOC( Util_Task_t *, nItems );
+    // spawn in the reverse order, so that the owner takes the first item
+    for ( i = nItems - 1; i >= 0; i-- )
+    {
+        pItems[i].pFunc = pFunc;
+        pItems[i].pArg  = pArg;
+        pItems[i].iItem = i;
+        ppTasks[i] = Util_TaskSpawn( p, Util_TaskItemRun, pItems + i );
+    }
+    for ( i = 0; i < nItems; i++ )
+        Util_TaskFree( ppTasks[i] );
+    ABC_FREE( ppTasks );
+    ABC_FREE( pItems );
+    if ( fOwn )
+        Util_TaskManStop( p );
+}
+
+ABC_NAMESPACE_IMPL_END
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,84 @@
+/**CFile****************************************************************
+
+  FileName    [utilTask.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Task-parallel runtime.]
+
+  Synopsis    [Work-stealing scheduler shared by the multi-threaded engines.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - October 17, 2026.]
+
+  Revision    [$Id: utilTask.h,v 1.00 2026/10/17 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#ifndef ABC__misc__util__utilTask_h
+#define ABC__misc__util__utilTask_h
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+// the task body: takes the user argument and returns the result of the future
+typedef void * (*Util_TaskFunc_t)( void * pArg );
+// the body of a parallel loop: takes the user argument and the item index
+typedef void   (*Util_TaskLoop_t)( void * pArg, int iItem );
+// the procedure releasing the per-thread state of a package
+typedef void   (*Util_TaskExit_t)();
+
+typedef struct Util_TaskMan_t_  Util_TaskMan_t;   // the scheduler (a pool of workers)
+typedef struct Util_Task_t_     Util_Task_t;      // the future of one spawned task
+
+////////////////////////////////////////////////////////////////////////
+///                      MACRO DEFINITIONS                           ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== utilTask.c ==========================================================*/
+extern void             Util_TaskSetThreadLimit( int nThreads );
+extern int              Util_TaskThreadLimit();
+extern int              Util_TaskThreadsUsed();
+extern Util_TaskMan_t * Util_TaskManStart( int nThreads );
+extern void             Util_TaskManStop( Util_TaskMan_t * p );
+extern Util_TaskMan_t * Util_TaskManCurrent();
+extern int              Util_TaskManThreadNum( Util_TaskMan_t * p );
+extern void             Util_TaskManSetTimeLimit( Util_TaskMan_t * p, int nSeconds );
+extern void             Util_TaskManCancel( Util_TaskMan_t * p );
+extern int              Util_TaskManIsStopped( Util_TaskMan_t * p );
+extern Util_Task_t *    Util_TaskSpawn( Util_TaskMan_t * p, Util_TaskFunc_t pFunc, void * pArg );
+extern int              Util_TaskIsDone( Util_Task_t * pTask );
+extern void *           Util_TaskWait( Util_Task_t * pTask );
+extern int              Util_TaskWaitAny( Util_Task_t ** ppTasks, int nTasks );
+extern void             Util_TaskFree( Util_Task_t * pTask );
+extern void             Util_TaskParallelFor( int nThreads, int nItems, Util_TaskLoop_t pFunc, void * pArg );
+extern void             Util_TaskGlobalLock();
+extern void             Util_TaskGlobalUnlock();
+extern void             Util_TaskAtThreadExit( Util_TaskExit_t pFunc );
+extern void             Util_TaskThreadExit();
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
@@ -85,6 +85,7 @@ extern void            Dar_LibStart();
 extern void            Dar_LibStop();
 extern void            Dar_LibPrepare( int nSubgraphs );
 extern int             Dar_LibReturnClass( unsigned uTruth );
+extern int             Dar_LibStructs( unsigned uTruth, Vec_Int_t * vStructs );
 /*=== darBalance.c ========================================================*/
 extern Aig_Man_t *     Dar_ManBalance( Aig_Man_t * p, int fUpdateLevel );
 extern Aig_Man_t *     Dar_ManBalanceXor( Aig_Man_t * pAig, int fExor, int fUpdateLevel, int fVerbose );
@@ -21,6 +21,7 @@
 #include "darInt.h"
 #include "aig/gia/gia.h"
 #include "dar.h"
+#include "misc/util/utilTask.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -105,7 +106,20 @@ struct Dar_Lib_t_ // library
     unsigned char *  pMap;
 };
 
-static Dar_Lib_t * s_DarLib = NULL;
+// the library keeps the data of the current evaluation, so each thread
+// has its own copy; the threads other than the one that started ABC
+// create it on demand and release it when they exit
+static ABC_THREAD_LOCAL Dar_Lib_t * s_DarLib = NULL;
+
+Dar_Lib_t * Dar_LibRead();
+void Dar_LibStop();
+static inline void Dar_LibCheck()
+{
+    if ( s_DarLib != NULL )
+        return;
+    s_DarLib = Dar_LibRead();
+    Util_TaskAtThreadExit( Dar_LibStop );
+}
 
 static inline Dar_LibObj_t * Dar_LibObj( Dar_Lib_t * p, int Id )    { return p->pObjs + Id; }
 static inline int            Dar_LibObjTruth( Dar_LibObj_t * pObj ) { return pObj->Num < (0xFFFF & ~pObj->Num) ? pObj->Num : (0xFFFF & ~pObj->Num); }
@@ -193,6 +207,7 @@ void Dar_LibFree( Dar_Lib_t * p )
 ***********************************************************************/
 int Dar_LibReturnClass( unsigned uTruth )
 {
+    Dar_LibCheck();
     return s_DarLib->pMap[uTruth & 0xffff];
 }
 
@@ -212,6 +227,7 @@ void Dar_LibReturnCanonicals( unsigned * pCanons )
 {
     int Visits[222] = {0};
     int i, k;
+    Dar_LibCheck();
     // find canonical truth tables
     for ( i = k = 0; i < (1<<16); i++ )
         if ( !Visits[s_DarLib->pMap[i]] )
@@ -477,8 +493,10 @@ void Dar_LibSetup0_rec( Dar_Lib_t * p, Dar_LibObj_t * pObj, int Class, int fColl
 ***********************************************************************/
 void Dar_LibPrepare( int nSubgraphs )
 {
-    Dar_Lib_t * p = s_DarLib;
+    Dar_Lib_t * p;
     int i, k, nNodes0Total;
+    Dar_LibCheck();
+    p = s_DarLib;
     if ( p->nSubgraphs == nSubgraphs )
         return;
 
@@ -593,10 +611,8 @@ Dar_Lib_t * Dar_LibRead()
 void Dar_LibStart()
 {
 //    abctime clk = Abc_Clock();
-    if ( s_DarLib != NULL )
-        return;
-    assert( s_DarLib == NULL );
-    s_DarLib = Dar_LibRead();
+    // the library of a thread other than the one that started ABC is released when it exits
+    Dar_LibCheck();
 //    printf( "The 4-input library started with %d nodes and %d subgraphs. ", s_DarLib->nObjs - 4, s_DarLib->nSubgrTotal );
 //    ABC_PRT( "Time", Abc_Clock() - clk );
 }
@@ -614,7 +630,8 @@ void Dar_LibStart()
 ***********************************************************************/
 void Dar_LibStop()
 {
-    assert( s_DarLib != NULL );
+    if ( s_DarLib == NULL )
+        return;
     Dar_LibFree( s_DarLib );
     s_DarLib = NULL;
 }
@@ -710,6 +727,7 @@ int Dar_LibCutMatch( Dar_Man_t * p, Dar_Cut_t * pCut )
     char * pPerm;
     int i;
     assert( pCut->nLeaves == 4 );
+    Dar_LibCheck();
     // get the fanin permutation
     uPhase = s_DarLib->pPhases[pCut->uTruth];
     pPerm = s_DarLib->pPerms4[ (int)s_DarLib->pPerms[pCut->uTruth] ];
@@ -1328,10 +1346,73 @@ int Dar2_LibBuildBest( Gia_Man_t * p, Vec_Int_t * vLeavesBest2, int OutBest )
 ***********************************************************************/
 int Dar_LibEvalBuild( Gia_Man_t * p, Vec_Int_t * vCutLits, unsigned uTruth, int fKeepLevel, Vec_Int_t * vLeavesBest2 )
 {
-    int OutBest = Dar2_LibEval( p, vCutLits, uTruth, fKeepLevel, vLeavesBest2 );
+    int OutBest;
+    Dar_LibCheck();
+    OutBest = Dar2_LibEval( p, vCutLits, uTruth, fKeepLevel, vLeavesBest2 );
     return Dar2_LibBuildBest( p, vLeavesBest2, OutBest );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns the library structures of the 4-input function.]
+
+  Description [Writes the structures into vStructs, each as the number
+  of gates, followed by the gates as pairs of literals, followed by the
+  literal of the output. Literal 0 and 1 are constants, vars 1 to 4 are
+  the cut leaves in the order of the truth table variables, and var 5+k
+  is the k-th gate of the structure. The output implements the function
+  or its complement. Returns the number of structures.]
+               
+  SideEffects [Uses the data of the library objects, as the evaluation;
+  the library is per thread.]
+
+  SeeAlso     []
+
+***********************************************************************/
+int Dar_LibStructs_rec( Dar_LibObj_t * pObj, int Out, Vec_Int_t * vStructs, int iStart )
+{
+    Dar_LibDat_t * pData = s_DarLib->pDatas + pObj->Num;
+    int iLit0, iLit1;
+    if ( pObj->fTerm || pData->TravId == Out )
+        return pData->iGunc;
+    iLit0 = Abc_LitNotCond( Dar_LibStructs_rec(Dar_LibObj(s_DarLib, pObj->Fan0), Out, vStructs, iStart), pObj->fCompl0 );
+    iLit1 = Abc_LitNotCond( Dar_LibStructs_rec(Dar_LibObj(s_DarLib, pObj->Fan1), Out, vStructs, iStart), pObj->fCompl1 );
+    pData->iGunc  = Abc_Var2Lit( 5 + Vec_IntEntry(vStructs, iStart), 0 );
+    pData->TravId = Out;
+    Vec_IntAddToEntry( vStructs, iStart, 1 );
+    Vec_IntPushTwo( vStructs, iLit0, iLit1 );
+    return pData->iGunc;
+}
+int Dar_LibStructs( unsigned uTruth, Vec_Int_t * vStructs )
+{
+    Dar_LibObj_t * pObj;
+    unsigned uPhase;
+    char * pPerm;
+    int i, iStart, iLit, Out, Class;
+    assert( (uTruth >> 16) == 0 );
+    Dar_LibCheck();
+    uPhase = s_DarLib->pPhases[uTruth];
+    pPerm  = s_DarLib->pPerms4[ (int)s_DarLib->pPerms[uTruth] ];
+    Class  = s_DarLib->pMap[uTruth];
+    for ( i = 0; i < 4; i++ )
+        s_DarLib->pDatas[i].iGunc = Abc_Var2Lit( 1 + (int)pPerm[i], (uPhase >> i) & 1 );
+    for ( i = 0; i < s_DarLib->nNodes0[Class]; i++ )
+    {
+        pObj = Dar_LibObj(s_DarLib, s_DarLib->pNodes0[Class][i]);
+        pObj->Num = 4 + i;
+        s_DarLib->pDatas[pObj->Num].TravId = 0xFFFF;
+    }
+    Vec_IntClear( vStructs );
+    for ( Out = 0; Out < s_DarLib->nSubgr0[Class]; Out++ )
+    {
+        iStart = Vec_IntSize( vStructs );
+        Vec_IntPush( vStructs, 0 );
+        iLit = Dar_LibStructs_rec( Dar_LibObj(s_DarLib, s_DarLib->pSubgr0[Class][Out]), Out, vStructs, iStart );
+        Vec_IntPush( vStructs, iLit );
+    }
+    return s_DarLib->nSubgr0[Class];
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -400,7 +400,7 @@ void Dau_DsdCheckStructOne( word * pTruth, int nVars, int nLeaves )
 ***********************************************************************/
 static inline word ** Dss_ManTtElems()
 {
-    static word TtElems[DAU_MAX_VAR+1][DAU_MAX_WORD], * pTtElems[DAU_MAX_VAR+1] = {NULL};
+    static ABC_THREAD_LOCAL word TtElems[DAU_MAX_VAR+1][DAU_MAX_WORD], * pTtElems[DAU_MAX_VAR+1] = {NULL};
     if ( pTtElems[0] == NULL )
     {
         int v;
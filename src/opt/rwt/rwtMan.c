@@ -20,6 +20,7 @@
 
 #include "rwt.h"
 #include "bool/deco/deco.h"
+#include "misc/util/utilTask.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -50,8 +51,10 @@ static unsigned char *  s_pMap = NULL;
 ***********************************************************************/
 void Rwt_ManGlobalStart()
 { 
+    Util_TaskGlobalLock();
     if ( s_puCanons == NULL )
         Extra_Truth4VarNPN( &s_puCanons, &s_pPhases, &s_pPerms, &s_pMap );
+    Util_TaskGlobalUnlock();
 }
 
 /**Function*************************************************************
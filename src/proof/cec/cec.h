@@ -125,6 +125,17 @@ struct Cec_ParFd_t_
     int             fTrim;          // do trim on patch
     int             fSyn;           // do synthesis on circuit
     int             fInc;           // use incremental sat solver
+    int             fItpMin;        // minimize the patches with the values of G as the care set instead of the resynthesis
+    int             fTrace;         // compute the interpolants of the one-shot queries by replaying the proof trace of satoko
+    int             fBench;         // run both sat engines and report the time of each query
+    int             fSim;           // use simulation to disprove the dependency before calling sat
+    int             fKeepStat;      // keep the status of the unchanged nodes when the circuit is updated
+    int             fBinStat;       // write the status checkpoints in the binary format
+    int             fCache;         // reuse the answers of the structurally identical queries
+    char *          pProfile;       // the file name (without extension) of the profile, NULL for none
+    int             nThreads;       // the number of threads to solve a batch of nodes (0 = sequential sweep)
+    int             nBatch;         // the max number of queries with similar G solved on one CNF (0 or 1 = one solver per query)
+    int             nRounds;        // the number of rounds of -14/-15 in one process (0 = one round by the scripts)
     float           coefPatch;      // the ratio for limit size of patch
     FILE*           pMerge;         // the file to print output
 };
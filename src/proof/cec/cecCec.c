@@ -447,6 +447,221 @@ int Cec_ManVerify( Gia_Man_t * pInit, Cec_ParCec_t * pPars )
     return RetValue;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [One round of the bottom-up rewriting.]
+
+  Description [Cec_ManFdRoundLevel (-F -14,ckt,minLv,maxLv,ratio) solves
+  the nodes of circuit ckt with the level of pAbs in [minLv, maxLv] and
+  replaces those whose patch is smaller than ratio * (TFI + 5).
+  Cec_ManFdRoundGreedy (-F -15,ckt) keeps the single replacement that
+  does not make the merge frontier worse. Both return the synthesized
+  circuit, or NULL if nothing is replaced; *pnRw is the number of
+  replaced nodes.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t* Cec_ManFdRoundLevel( Cec_ManFd_t* pMan, int rwCkt, int minLv, int maxLv, int ratio, int* pnRw ) {
+    Gia_Man_t *pTemp = NULL, *pTemp2, *pPatch;
+    Gia_Obj_t *pObj;
+    Vec_Int_t *vIntBuff, *vIntBuff1, *vRw, *vTFISize;
+    Vec_Wec_t *vWecBuff;
+    int i, j, nid, nidAbs, buf, nLevels, nPatch, nTFI;
+
+    vRw = Vec_IntAlloc( 100 );
+    vTFISize = Cec_ManTFISize( pMan->pAbs );
+    nLevels = Gia_ManLevelNum( pMan->pAbs );
+    Gia_ManForEachAnd( pMan->pAbs, pObj, i ) {
+        if (Gia_ObjLevel( pMan->pAbs, pObj ) < minLv) continue;
+        if (Gia_ObjLevel( pMan->pAbs, pObj ) > maxLv) continue;
+        nid = Cec_ManFdMapIdSingle( pMan, i, 0 );
+        if (Gia_ObjColors( pMan->pGia, nid ) != rwCkt) continue;
+        Cec_ManFdShrinkSimple( pMan, nid, 0 );
+        if (Vec_IntEntry( pMan->vStat, nid ) <= 0) continue;
+        // drop the lowest support levels one by one while the node stays UNSAT
+        vWecBuff = Vec_WecStart( nLevels );
+        Vec_IntForEachEntry( Vec_WecEntry( pMan->vGSupport, nid ), buf, j ) {
+            // the support nodes outside of pAbs have no level there; they are kept at level 0 and never dropped
+            nidAbs = Cec_ManFdMapIdSingle( pMan, buf, 1 );
+            Vec_WecPush( vWecBuff, nidAbs < 0 ? 0 : Gia_ObjLevelId( pMan->pAbs, nidAbs ), buf );
+        }
+        for (buf = 1; buf < nLevels; buf++) {
+            vIntBuff = Vec_IntDup( Vec_WecEntry( vWecBuff, 0 ) );
+            Vec_WecForEachLevel( vWecBuff, vIntBuff1, j ) {
+                if (j < buf) continue;
+                else Vec_IntAppend( vIntBuff, vIntBuff1 );
+            }
+            pPatch = Cec_ManFdSolve( pMan, nid, vIntBuff, 0 );
+            if (pPatch != NULL && pPatch != CEC_FD_PATCH_UNSOLVE) {
+                Cec_ManFdUpdateStat( pMan, nid, vIntBuff, pPatch, 0 );
+                Vec_IntFree( vIntBuff );
+            } else {
+                Vec_IntFree( vIntBuff );
+                break;
+            }
+        }
+        Vec_WecFree( vWecBuff );
+
+        nPatch = Gia_ManAndNum( (Gia_Man_t*) Vec_PtrEntry( pMan->vVeryStat, nid ) );
+        nTFI = Vec_IntEntry( vTFISize, i );
+        if (pMan->pPars->fVerbose) printf("size of circuit is %d, TFI is %d\n", nPatch, nTFI);
+        if (ratio == -1 || nPatch < ratio * (nTFI + 5)) Vec_IntPush( vRw, nid );
+    }
+
+    // skip the nodes in the TFI of another replaced node
+    Gia_ManFillValue( pMan->pGia );
+    Vec_IntForEachEntry( vRw, nid, i ) {
+        pObj = Gia_ManObj(pMan->pGia, nid);
+        if (Gia_ObjValue( pObj) != -1) continue;
+        Cec_ManSubcircuit( pMan->pGia, Gia_ManObj(pMan->pGia, nid), 0, 0, 1, 0 );
+        Gia_ObjSetValue( pObj, -1 );
+    }
+    Vec_IntForEachEntry( vRw, nid, i ) {
+        pObj = Gia_ManObj(pMan->pGia, nid);
+        if (Gia_ObjValue( pObj ) == -1) continue;
+        else Vec_IntWriteEntry( vRw, i, -1 );
+    }
+    Vec_IntRemoveAll( vRw, -1, 0 );
+    *pnRw = Vec_IntSize( vRw );
+    if (Vec_IntSize( vRw ) > 0) {
+        pTemp = Cec_ManFdReplaceMulti( pMan, vRw );
+        pTemp = Cec_ManFdSimpSyn( pMan, pTemp2 = pTemp, 1, 0, -1);
+        Gia_ManStop( pTemp2 );
+        pTemp = Cec_ManFdFraigSyn( pMan, pTemp2 = pTemp, pMan->pPars->nBTLimit );
+        Gia_ManStop( pTemp2 );
+    }
+    Vec_IntFree( vTFISize );
+    Vec_IntFree( vRw );
+    return pTemp;
+}
+Gia_Man_t* Cec_ManFdRoundGreedy( Cec_ManFd_t* pMan, int rwCkt, int* pnRw ) {
+    Gia_Man_t *pOut = NULL, *pTemp, *pTemp2;
+    Gia_Obj_t *pObj;
+    Vec_Int_t *vMerge1, *vMerge2, *vCnt1, *vCnt2, *vCnt3, *vCnt4;
+    int i, nid, buf3, buf4, buf5;
+
+    vMerge1 = Vec_IntAlloc( 100 );
+    vMerge2 = Vec_IntAlloc( 100 );
+    Cec_ManMergeAnal( pMan->pGia, vMerge1, vMerge2, 1 );
+    vCnt1 = Vec_IntDup( vMerge1 );
+    vCnt2 = Vec_IntDup( vMerge2 );
+    *pnRw = 0;
+    Gia_ManForEachAnd( pMan->pAbs, pObj, i ) {
+        nid = Cec_ManFdMapIdSingle( pMan, i, 0 );
+        if (Gia_ObjColors( pMan->pGia, nid ) != rwCkt) continue;
+        Cec_ManFdShrink( pMan, nid );
+        if (Vec_IntEntry( pMan->vStat, nid ) <= 0) continue;
+
+        pTemp = Cec_ManFdReplaceOne( pMan, nid );
+        pTemp = Cec_ManFdSimpSyn( pMan, pTemp2 = pTemp, 1, 0, -1);
+        Gia_ManStop( pTemp2 );
+        pTemp = Cec_ManFdFraigSyn( pMan, pTemp2 = pTemp, pMan->pPars->nBTLimit );
+        Gia_ManStop( pTemp2 );
+        vCnt3 = Vec_IntAlloc( 100 );
+        vCnt4 = Vec_IntAlloc( 100 );
+        Cec_ManMergeAnal( pTemp, vCnt3, vCnt4, 1 );
+        if (pMan->pPars->fVerbose) {
+            Vec_IntPrint(vCnt1);
+            Vec_IntPrint(vCnt2);
+        }
+        // the merge frontier of the rewritten circuit should not be worse
+        if (rwCkt == 1) {
+            buf3 = Cec_ManMergeChangeCompare( vCnt3, vMerge1, 0 );
+            buf4 = Cec_ManMergeChangeCompare( vCnt4, vCnt2, 0 );
+            buf5 = Cec_ManMergeChangeCompare( vCnt3, vCnt1, 0 );
+        } else {
+            buf3 = Cec_ManMergeChangeCompare( vCnt4, vMerge2, 0 );
+            buf4 = Cec_ManMergeChangeCompare( vCnt3, vCnt1, 0 );
+            buf5 = Cec_ManMergeChangeCompare( vCnt4, vCnt2, 0 );
+        }
+        if (pMan->pPars->fVerbose) printf("buf3 = %d, buf4 = %d, buf5 = %d\n", buf3, buf4, buf5);
+        if (buf3 > Vec_IntSize(rwCkt == 1 ? vMerge1 : vMerge2) + 2 || buf4 > 0 || (buf4 == 0 && buf5 > 0)) {
+            Vec_IntFree( vCnt3 );
+            Vec_IntFree( vCnt4 );
+            Gia_ManStop( pTemp );
+            continue;
+        }
+        Vec_IntFree( vCnt1 );
+        Vec_IntFree( vCnt2 );
+        vCnt1 = vCnt3;
+        vCnt2 = vCnt4;
+        if (pOut) Gia_ManStop( pOut );
+        pOut = pTemp;
+        *pnRw += 1;
+        if (pMan->pPars->fVerbose) {
+            Vec_IntPrint(vCnt1);
+            Vec_IntPrint(vCnt2);
+        }
+    }
+    Vec_IntFree( vMerge1 );
+    Vec_IntFree( vMerge2 );
+    Vec_IntFree( vCnt1 );
+    Vec_IntFree( vCnt2 );
+    return pOut;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Iterative bottom-up rewriting in one process.]
+
+  Description [Runs pPars->nRounds rounds of -14 or -15 given by vCoef.
+  The result of each round is matched to the current circuit and the
+  manager is updated in place, so the learned clauses, the status of the
+  unchanged nodes and the simulation patterns are kept between rounds.
+  The coefficients follow the schedule of the experiment scripts: the
+  rewritten circuit alternates, and for -14 the level window moves up
+  by one after both circuits are done. The iteration stops when a whole
+  cycle (two rounds, one for each circuit) does not reduce the number of
+  AND nodes, or, for -14, when the window is above pAbs.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t* Cec_ManFdRewriteRounds( Cec_ManFd_t* pMan, Vec_Int_t* vCoef ) {
+    Gia_Man_t *pNew, *pInit = pMan->pGia, *pPrev;
+    Vec_Int_t *vCoefCur = Vec_IntDup( vCoef );
+    int r, nRw, nAnd, nAndPrev = -1, fLevel = (Vec_IntEntry(vCoef, 0) == -14);
+    abctime clk, clkTotal = Abc_Clock();
+    assert( Vec_IntEntry(vCoef, 0) == -14 || Vec_IntEntry(vCoef, 0) == -15 );
+    assert( Vec_IntSize(vCoef) >= (fLevel ? 5 : 2) );
+    for ( r = 0; r < pMan->pPars->nRounds; r++ ) {
+        if (fLevel && Vec_IntEntry(vCoefCur, 2) > Gia_ManLevelNum(pMan->pAbs)) break;
+        clk = Abc_Clock();
+        nAnd = Gia_ManAndNum( pMan->pGia );
+        if (fLevel)
+            pNew = Cec_ManFdRoundLevel( pMan, Vec_IntEntry(vCoefCur, 1), Vec_IntEntry(vCoefCur, 2), Vec_IntEntry(vCoefCur, 3), Vec_IntEntry(vCoefCur, 4), &nRw );
+        else
+            pNew = Cec_ManFdRoundGreedy( pMan, Vec_IntEntry(vCoefCur, 1), &nRw );
+        printf( "round %3d : ckt %d", r, Vec_IntEntry(vCoefCur, 1) );
+        if (fLevel) printf( "  level [%d, %d]", Vec_IntEntry(vCoefCur, 2), Vec_IntEntry(vCoefCur, 3) );
+        printf( "  replaced = %4d  and = %7d -> %7d  ", nRw, nAnd, pNew ? Gia_ManAndNum(pNew) : nAnd );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+        // the next coefficients
+        if (fLevel && Vec_IntEntry(vCoefCur, 1) == 2) {
+            Vec_IntAddToEntry( vCoefCur, 2, 1 );
+            Vec_IntAddToEntry( vCoefCur, 3, 1 );
+        }
+        Vec_IntWriteEntry( vCoefCur, 1, Vec_IntEntry(vCoefCur, 1) == 1 ? 2 : 1 );
+        if (pNew != NULL) {
+            Cec_ManMatch( pNew, pMan->pGia );
+            pPrev = pMan->pGia;
+            Cec_ManFdUpdate( pMan, pNew );
+            if (pPrev != pInit) Gia_ManStop( pPrev );
+        }
+        // stop when this round and the previous one did not reduce the AND count
+        if (nAndPrev >= 0 && Gia_ManAndNum( pMan->pGia ) >= nAndPrev) break;
+        nAndPrev = nAnd;
+    }
+    Abc_PrintTime( 1, "Total time of the rounds", Abc_Clock() - clkTotal );
+    Vec_IntFree( vCoefCur );
+    return pMan->pGia == pInit ? NULL : pMan->pGia;
+}
+
 /**Function*************************************************************
 
   Synopsis    [CEC engine with Affine.]
@@ -465,21 +680,28 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
     Vec_Int_t *vUnsat, *vMerge, *vSolved;
     Vec_Int_t *vIntBuff, *vIntBuff1, *vIntBuff2, *vIntBuff3, *vIntBuff4, *vIntBuff5, *vIntBuff6;
     Vec_Int_t *vCnt, *vCntInit1, *vCntInit2, *vCnt1, *vCnt2, *vCnt3, *vCnt4, *vCnt5, *vCnt6, *vChange;
-    Vec_Wec_t *vWecBuff;
     Vec_Flt_t *vCost;
+    Vec_Wec_t *vSupp;
     Gia_Man_t *pOut, *pTemp, *pTemp2, *pItp;
     Gia_Obj_t *pObj, *pObj1, *pObj2, *pObjbuf;
     int i, j, k, flag, buf, buf1, buf2, buf3, buf4, buf5, buf6, cnt1, cnt2, nodeId, nid, nid2, fFdnid = 3;
     int frac, up, bot, rwCkt, frtMin;
-    int** dist;
     float cost_buf, cost_buf1, cost_buf2, cost_buf3, cost_buf4;
     char* str = ABC_ALLOC(char, 100);
 
     // Cec_ManFd_t* pMan = 0;
+    Cec_ParFd_t ParsBuf;
     Cec_ManFd_t* pMan_buf;
     Cec_ManFd_t* pMan = Cec_ManFdStart( p, pPars, pStat );
     Cec_ManFdPrintPars( pMan );
 
+    if (pPars->nRounds > 0 && vRwNd != NULL && (Vec_IntEntry(vRwNd, 0) == -14 || Vec_IntEntry(vRwNd, 0) == -15)) {
+        pOut = Cec_ManFdRewriteRounds( pMan, vRwNd );
+        if (pOut) Gia_AigerWrite( pOut, "replaced.aig", 0, 0, 0 );
+        Cec_ManFdStop( pMan, 2 );
+        return pOut;
+    }
+
     if (vRwNd != NULL) {
         assert( Vec_IntSize(vRwNd) > 0 );
         Vec_IntForEachEntry( vRwNd, nodeId, i ) {
@@ -547,7 +769,7 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                     if (vMerge) Vec_IntFree( vMerge );
                     
                     
-                    pOut = Cec_ManFraigSyn_naive( pTemp, 10000 );
+                    pOut = Cec_ManFdFraigSyn( pMan, pTemp, 10000 );
                     
                     Cec_ManMatch( pOut, pMan->pGia );
                     Cec_ManFdUpdate( pMan, pOut );
@@ -572,7 +794,16 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                     Cec_ManFdStop( pMan, 2 );
                     return 0;
                 } else if (nodeId == -5) {
-                    // same as cec
+                    // same as cec; with -B, the first queries of the two outputs (full support) are solved ahead together
+                    vIntBuff = Vec_IntAlloc( 2 );
+                    vSupp = Vec_WecAlloc( 2 );
+                    Vec_IntPush( vIntBuff, Gia_ObjId( pMan->pGia, pMan->pObj1 ) );
+                    Vec_IntPush( vIntBuff, Gia_ObjId( pMan->pGia, pMan->pObj2 ) );
+                    Vec_IntForEachEntry( vIntBuff, nid, i )
+                        Vec_IntAppend( Vec_WecPushLevel( vSupp ), Vec_WecEntry( pMan->vGSupport, nid ) );
+                    Cec_ManFdSolveAhead( pMan, vIntBuff, vSupp );
+                    Vec_WecFree( vSupp );
+                    Vec_IntFree( vIntBuff );
                     nid = Gia_ObjId( pMan->pGia, pMan->pObj1 );
                     Cec_ManFdCleanOneUnknown( pMan, nid );
                     Cec_ManFdShrink( pMan, nid );
@@ -584,7 +815,8 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                     Cec_ManFdStop( pMan, 2 );
                     return 0;
                 } else if (nodeId == -6) {
-                    // find the two nodes that have largest MFFC (top down devide-and-conquer), might have some bug
+                    // find the two nodes that have largest MFFC (top down devide-and-conquer), might have some bug;
+                    // each step issues one query that depends on the previous replacement, so -B does not apply
                     vIntBuff = Vec_IntDup( vRwNd );
                     Vec_IntRemove( vIntBuff, -6 );
                     pOut = Cec_ManSyn( p, vIntBuff );
@@ -792,7 +1024,7 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                         if (nid < buf) continue;
                         vIntBuff5 = Cec_ManGetTFO( pMan->pGia, Vec_IntItoV(nid), -1, 0 );
                         pItp = (Gia_Man_t*) Vec_PtrEntry( pMan->vVeryStat, nid );
-                        pItp = Cec_ManSimpSyn( pTemp2 = pItp, 1, 0, -1 );
+                        pItp = Cec_ManFdSimpSyn( pMan, pTemp2 = pItp, 1, 0, -1 );
                         Cec_ManFdUpdateStat( pMan, nid, 0, pItp, 0 );
                         Cec_ManFdCleanSupport( pMan, nid ); // pItp is stopped
                         pItp = (Gia_Man_t*) Vec_PtrEntry( pMan->vVeryStat, nid );
@@ -818,7 +1050,10 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                         
                         vIntBuff = Vec_IntAlloc( Gia_ManObjNum(pTemp) );
                         Cec_ManGiaMapId( pTemp, vIntBuff ); // pTemp --> pGia
-                        pMan_buf = Cec_ManFdStart( pTemp, pMan->pPars, NULL );
+                        // the helper manager is not profiled, so that it does not overwrite the profile of pMan
+                        ParsBuf = *pMan->pPars;
+                        ParsBuf.pProfile = NULL;
+                        pMan_buf = Cec_ManFdStart( pTemp, &ParsBuf, NULL );
                         Cec_ManFdCleanUnknown( pMan_buf, 3 );
                         Vec_IntRemapArray( vIntBuff, pMan_buf->vConf, vIntBuff4 = Vec_IntAlloc( Vec_IntSize(pMan->vConf) ), Vec_IntSize(pMan->vConf) );
                         Vec_IntReplace( vIntBuff4, 0, -1 );
@@ -920,8 +1155,8 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                         nid = Gia_ObjId(pMan->pGia, pObj);
                         if (Gia_ObjColors(pMan->pGia, nid) == 1 || Gia_ObjColors(pMan->pGia, nid) == 2) {
                             if (Vec_IntSize(Vec_WecEntry(pMan->vGSupport, nid)) == 0) continue;
-                            pItp = Cec_ManFdGetFd( pMan, nid, 0, 0 );
-                            if (pItp == NULL || pItp == 1) continue;
+                            pItp = Cec_ManFdSolve( pMan, nid, 0, 0 );
+                            if (pItp == NULL || pItp == CEC_FD_PATCH_UNSOLVE) continue;
                             Vec_IntPush( vCnt1, Cec_ManFdMapIdSingle( pMan, nid, 1 ) );
                             printf("nid: %d\n", nid);
                             printf("size of itp: %d\n", Gia_ManAndNum(pItp));
@@ -970,7 +1205,7 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                             Vec_IntFree( vIntBuff1 );
                             Gia_SelfDefShow( pItp, "fd_replaced_surrounding.dot", NULL, NULL, NULL );
                             buf2 = Gia_ManAndNum(pItp);
-                            pItp = Cec_ManSimpSyn( pTemp2 = pItp, 1, 0, -1 );
+                            pItp = Cec_ManFdSimpSyn( pMan, pTemp2 = pItp, 1, 0, -1 );
                             Gia_ManStop( pTemp2 );
                             buf = Gia_ManAndNum(pItp);
                             printf("syn ratio with patch: %f\n", (float)buf / (float)buf2);
@@ -998,7 +1233,7 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                             Gia_SelfDefShow( pItp, "fd_origin_surrounding.dot", NULL, NULL, NULL );
                             Vec_IntFree( vIntBuff1 );
                             buf2 = Gia_ManAndNum(pItp);
-                            pItp = Cec_ManSimpSyn( pTemp2 = pItp, 1, 0, -1 );
+                            pItp = Cec_ManFdSimpSyn( pMan, pTemp2 = pItp, 1, 0, -1 );
                             Gia_ManStop( pTemp2 );
                             buf = Gia_ManAndNum(pItp);
                             printf("syn ratio without patch: %f\n", (float)buf / (float)buf2);
@@ -1238,7 +1473,7 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                     pTemp = Cec_ManPartSyn( pTemp2 = pTemp, 0, vMerge, -1, 1 );
                     Gia_ManStop( pTemp2 );
                     Vec_IntFree( vMerge );
-                    pTemp = Cec_ManFraigSyn_naive( pTemp2 = pTemp, pMan->pPars->nBTLimit );
+                    pTemp = Cec_ManFdFraigSyn( pMan, pTemp2 = pTemp, pMan->pPars->nBTLimit );
                     Gia_ManStop( pTemp2 );
                     printf("Gia size: %d\n", Gia_ManObjNum(pTemp));
 
@@ -1247,7 +1482,7 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                     pTemp = Cec_ManPartSyn( pTemp2 = pTemp, 0, vIntBuff, -1, 0 );
                     Gia_ManStop( pTemp2 );
                     Vec_IntFree( vIntBuff );
-                    pOut = Cec_ManFraigSyn_naive( pTemp, 10000 );
+                    pOut = Cec_ManFdFraigSyn( pMan, pTemp, 10000 );
                     Gia_AigerWrite( pOut, "final.aig", 0, 0, 0 );
                     return pOut;
 
@@ -1403,146 +1638,12 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                     // return pOut;
 
                 } else if (nodeId == -14) {
-                    // vIntBuff = Vec_IntAlloc( 100 );
-                    vIntBuff2 = Vec_IntAlloc( 100 );
-                    vIntBuff3 = Cec_ManTFISize( pMan->pAbs );
-                    rwCkt = Vec_IntEntry( vRwNd, 1 );
-                    buf1 = Vec_IntEntry( vRwNd, 2 );
-                    buf2 = Vec_IntEntry( vRwNd, 3 );
-                    buf4 = Vec_IntEntry( vRwNd, 4 );
-                    buf3 = Gia_ManLevelNum(pMan->pAbs);
-                    
-                    Gia_ManForEachAnd( pMan->pAbs, pObj, i ) {
-                        if (Gia_ObjLevel( pMan->pAbs, pObj ) < buf1) continue;
-                        if (Gia_ObjLevel( pMan->pAbs, pObj ) > buf2) continue;
-                        nid = Cec_ManFdMapIdSingle( pMan, i, 0 );
-                        if (Gia_ObjColors( pMan->pGia, nid ) != rwCkt) continue;
-                        Cec_ManFdShrinkSimple( pMan, nid, 0 );
-                        if (Vec_IntEntry( pMan->vStat, nid ) > 0) {
-                            vWecBuff = Vec_WecStart( buf3 );
-                            Vec_IntForEachEntry( Vec_WecEntry( pMan->vGSupport, nid), buf, j ) {
-                                Vec_WecPush( vWecBuff, Gia_ObjLevelId( pMan->pAbs, Cec_ManFdMapIdSingle( pMan, buf, 1 ) ), buf );
-                            }
-                            
-                            for (buf = 1; buf < buf3; buf++) {
-                                vIntBuff = Vec_IntDup( Vec_WecEntry( vWecBuff, 0 ) );
-                                Vec_WecForEachLevel( vWecBuff, vIntBuff1, j ) {
-                                    if (j < buf) continue;
-                                    else Vec_IntAppend( vIntBuff, vIntBuff1 );
-                                }
-                                pTemp = Cec_ManFdGetFd( pMan, nid, vIntBuff, 0 );
-                                if (pTemp != NULL && pTemp != 1) {
-                                    Cec_ManFdUpdateStat( pMan, nid, vIntBuff, pTemp, 0 );
-                                } else break;
-                                Vec_IntFree( vIntBuff );
-                            }
-
-                            buf6 = Gia_ManAndNum( (Gia_Man_t*) Vec_PtrEntry( pMan->vVeryStat, nid ) );
-                            buf5 = Vec_IntEntry( vIntBuff3, i );
-                            printf("size of circuit is %d, TFI is %d\n", buf6, buf5);
-                            if (buf4 == -1 || buf6 < buf4 * (buf5 + 5)) Vec_IntPush( vIntBuff2, nid );
-                        }
-                        
-                    }
-
-                    Gia_ManFillValue( pMan->pGia );
-                    Vec_IntForEachEntry( vIntBuff2, nid, i ) {
-                        pObj = Gia_ManObj(pMan->pGia, nid);
-                        if (Gia_ObjValue( pObj) != -1) continue;
-                        Cec_ManSubcircuit( pMan->pGia, Gia_ManObj(pMan->pGia, nid), 0, 0, 1, 0 );
-                        Gia_ObjSetValue( pObj, -1 );
-                    }
-                    Vec_IntForEachEntry( vIntBuff2, nid, i ) {
-                        pObj = Gia_ManObj(pMan->pGia, nid);
-                        if (Gia_ObjValue( pObj ) == -1) continue;
-                        else Vec_IntWriteEntry( vIntBuff2, i, -1 );
-                    }
-                    Vec_IntRemoveAll( vIntBuff2, -1, 0 );
-                    if (Vec_IntSize( vIntBuff2 ) > 0) {
-                        pTemp = Cec_ManFdReplaceMulti( pMan, vIntBuff2 );
-                        pTemp = Cec_ManSimpSyn( pTemp2 = pTemp, 1, 0, -1);
-                        Gia_ManStop( pTemp2 );
-                        pTemp = Cec_ManFraigSyn_naive( pTemp2 = pTemp, pMan->pPars->nBTLimit );
-                        Gia_ManStop( pTemp2 );
-                        Gia_AigerWrite( pTemp, "replaced.aig", 0, 0, 0 );
-                    }
-                    
+                    pTemp = Cec_ManFdRoundLevel( pMan, Vec_IntEntry(vRwNd, 1), Vec_IntEntry(vRwNd, 2), Vec_IntEntry(vRwNd, 3), Vec_IntEntry(vRwNd, 4), &buf );
+                    if (pTemp) Gia_AigerWrite( pTemp, "replaced.aig", 0, 0, 0 );
                     return 0;
                 } else if (nodeId == -15) {
-                    vIntBuff2 = Vec_IntAlloc( 100 );
-                    vIntBuff3 = Cec_ManTFISize( pMan->pAbs );
-                    rwCkt = Vec_IntEntry( vRwNd, 1 );
-                    
-                    vIntBuff4 = Vec_IntAlloc( 100 );
-                    vIntBuff5 = Vec_IntAlloc( 100 );
-                    vCnt1 = Vec_IntAlloc( 100 );
-                    vCnt2 = Vec_IntAlloc( 100 );
-                    vCnt3 = Vec_IntAlloc( 100 );
-                    vCnt4 = Vec_IntAlloc( 100 );
-                    
-                    Cec_ManMergeAnal( pMan->pGia, vIntBuff4, vIntBuff5, 1 );
-                    vCnt1 = Vec_IntDup( vIntBuff4 );
-                    vCnt2 = Vec_IntDup( vIntBuff5 );
-                    pOut = NULL;
-                    // Vec_IntFill( vCnt1, Vec_IntSize(vIntBuff4), 0 );
-                    // Vec_IntFill( vCnt2, Vec_IntSize(vIntBuff5), 0 );
-                    buf1 = 0; buf2 = 0; 
-                    Gia_ManForEachAnd( pMan->pAbs, pObj, i ) {
-                        nid = Cec_ManFdMapIdSingle( pMan, i, 0 );
-                        if (Gia_ObjColors( pMan->pGia, nid ) != rwCkt) continue;
-                        Cec_ManFdShrink( pMan, nid );
-                        if (Vec_IntEntry( pMan->vStat, nid ) > 0) {
-
-                            pTemp = Cec_ManFdReplaceOne( pMan, nid );
-                            pTemp = Cec_ManSimpSyn( pTemp2 = pTemp, 1, 0, -1);
-                            Gia_ManStop( pTemp2 );
-                            pTemp = Cec_ManFraigSyn_naive( pTemp2 = pTemp, pMan->pPars->nBTLimit );
-                            Gia_ManStop( pTemp2 );
-                            // Vec_IntClear( vCnt3 );
-                            // Vec_IntClear( vCnt4 );
-                            vCnt3 = Vec_IntAlloc( 100 );
-                            vCnt4 = Vec_IntAlloc( 100 );
-                            Cec_ManMergeAnal( pTemp, vCnt3, vCnt4, 1 );
-                            // Vec_IntPrint( vIntBuff4 );
-                            // Vec_IntPrint( vIntBuff5 );
-                            Vec_IntPrint(vCnt1);
-                            Vec_IntPrint(vCnt2);
-                            if (rwCkt == 1) {
-                                // buf3 = Cec_ManMergeChangeCompare( vCnt4, vIntBuff5, 0 );
-                                buf3 = Cec_ManMergeChangeCompare( vCnt3, vIntBuff4, 0 );
-                                buf4 = Cec_ManMergeChangeCompare( vCnt4, vCnt2, 0 );
-                                buf5 = Cec_ManMergeChangeCompare( vCnt3, vCnt1, 0 );
-                                printf("buf3 = %d, buf4 = %d, buf5 = %d\n", buf3, buf4, buf5);
-                                if (buf3 > Vec_IntSize(vIntBuff4) + 2) continue;
-                                if (buf4 > 0) continue;
-                                if (buf4 == 0 && buf5 > 0) continue;
-                                Vec_IntFree( vCnt1 );
-                                Vec_IntFree( vCnt2 );
-                                vCnt1 = vCnt3;
-                                vCnt2 = vCnt4;
-                                pOut = Gia_ManDup( pTemp );
-                            } else {
-                                buf3 = Cec_ManMergeChangeCompare( vCnt4, vIntBuff5, 0 );
-                                buf4 = Cec_ManMergeChangeCompare( vCnt3, vCnt1, 0 );
-                                buf5 = Cec_ManMergeChangeCompare( vCnt4, vCnt2, 0 );
-                                printf("buf3 = %d, buf4 = %d, buf5 = %d\n", buf3, buf4, buf5);
-                                if (buf3 > Vec_IntSize(vIntBuff5) + 2) continue;
-                                if (buf4 > 0) continue;
-                                if (buf4 == 0 && buf5 > 0) continue;
-                                Vec_IntFree( vCnt1 );
-                                Vec_IntFree( vCnt2 );
-                                vCnt1 = vCnt3;
-                                vCnt2 = vCnt4;
-                                pOut = Gia_ManDup( pTemp );
-                            }
-                            Vec_IntPrint(vCnt1);
-                            Vec_IntPrint(vCnt2);
-                            Gia_ManStop( pTemp );
-                        }
-                    }
-
+                    pOut = Cec_ManFdRoundGreedy( pMan, Vec_IntEntry(vRwNd, 1), &buf );
                     if (pOut) Gia_AigerWrite( pOut, "replaced.aig", 0, 0, 0 );
-                    
                     return 0;
                 } else if (nodeId == -16) {
                     vIntBuff = Vec_IntDup( vRwNd );
@@ -1643,16 +1744,15 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                             printf("nid = %d\n", nid);
                             if (nid == -1) continue;
                             // rewrite
-                            buf1 = pMan->dist_short[Cec_ManFdGetPO( pMan, nid, 0, 1 )][nid];
+                            buf1 = Cec_ManDistEntry(pMan->dist_short, Cec_ManFdGetPO( pMan, nid, 0, 1 ), nid);
 
                             buf5 = -1;
-                            Vec_IntForEachEntry( Vec_WecEntry( pMan->vMergeSupport, nid ), buf, k ) {
+                            Cec_ManFdForEachMergeSupp( pMan, nid, k ) {
                                 // nid2 might not be in pAbs
-                                if (buf != 1) continue;
                                 nid2 = Vec_IntEntry( pMan->vMerge, k );
-                                buf2 = pMan->dist_short[Cec_ManFdGetPO( pMan, nid, 0, 0 )][nid2];
+                                buf2 = Cec_ManDistEntry(pMan->dist_short, Cec_ManFdGetPO( pMan, nid, 0, 0 ), nid2);
                                 assert(buf2 > 0);
-                                buf2 += pMan->dist_short[nid][nid2];
+                                buf2 += Cec_ManDistEntry(pMan->dist_short, nid, nid2);
                                 if (buf5 == -1 || buf2 < buf5) {
                                     buf5 = buf2;
                                 }
@@ -1664,13 +1764,13 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                             buf = -1;
                             Vec_IntForEachEntry( Vec_WecEntry( pMan->vGSupport, nid ), nid2, k ) {
                                 // nid2 might not be in pAbs
-                                buf2 = pMan->dist_short[Cec_ManFdGetPO( pMan, nid, 0, 0 )][nid2];
+                                buf2 = Cec_ManDistEntry(pMan->dist_short, Cec_ManFdGetPO( pMan, nid, 0, 0 ), nid2);
                                 assert(buf2 > 0);
                                 buf2 += Gia_ObjValue(Gia_ManCi(pTemp, k));
                                 if (buf2 < buf5) {
                                     buf5 = buf2;
                                     buf = nid2;
-                                    printf("decrease to %d, %d, %d by nid2 = %d\n", buf1, pMan->dist_short[Cec_ManFdGetPO( pMan, nid, 0, 0 )][nid2], Gia_ObjValue(Gia_ManCi(pTemp, k)), nid2);
+                                    printf("decrease to %d, %d, %d by nid2 = %d\n", buf1, Cec_ManDistEntry(pMan->dist_short, Cec_ManFdGetPO( pMan, nid, 0, 0 ), nid2), Gia_ObjValue(Gia_ManCi(pTemp, k)), nid2);
                                 }
                             }
                             if (buf == -1) continue;
@@ -1869,6 +1969,7 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
     } else {
         printf("check RW at once\n");
         vIntBuff2 = Vec_IntAlloc( 1 );
+        vIntBuff3 = Vec_IntAlloc( 100 ); // the nodes to clean, solved in one batch
         Gia_ManForEachObj( pMan->pGia, pObj, i ) {
             nid = Gia_ObjId(pMan->pGia, pObj);
             if (Gia_ObjColors(pMan->pGia, nid) == 1 || Gia_ObjColors(pMan->pGia, nid) == 2) {
@@ -1879,12 +1980,12 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                         if (Vec_IntFind( pMan->vMerge, nid2 ) == -1) continue;
                         Vec_IntRemove( vIntBuff, nid2 );
                         Vec_IntClear( vIntBuff2 );
-                        pTemp = Cec_ManFdGetFd( pMan, nid, vIntBuff, vIntBuff2 );
+                        pTemp = Cec_ManFdSolve( pMan, nid, vIntBuff, vIntBuff2 );
                         buf = Vec_IntEntry(vIntBuff2, 0);
                         if (pTemp == NULL) {
                             printf("remove nid: %d______SAT (conf: %d)\n", nid2, buf);
                         }
-                        else if (pTemp == 1) printf("remove nid: %d______UNSOLVE\n", nid2);
+                        else if (pTemp == CEC_FD_PATCH_UNSOLVE) printf("remove nid: %d______UNSOLVE\n", nid2);
                         else {
                             printf("remove nid: %d______UNSAT (conf: %d)\n", nid2, Vec_IntEntry(vIntBuff2, 0));
                             if (buf < Vec_IntEntry(pMan->vConf, nid) || Vec_IntEntry(pMan->vStat, nid) <= 0) {
@@ -1897,11 +1998,13 @@ Gia_Man_t* Cec_ManFdRewrite( Gia_Man_t * p, Cec_ParFd_t * pPars, Vec_Int_t* vRwN
                         Vec_IntPush( vIntBuff, nid2 );
                     }
                 } else {
-                    Cec_ManFdCleanOneUnknown( pMan, nid );
+                    Vec_IntPush( vIntBuff3, nid );
                 }
                 // Cec_ManFdShrink( pMan, nid );
             }
         }
+        Cec_ManFdCleanUnknownBatch( pMan, vIntBuff3 );
+        Vec_IntFree( vIntBuff3 );
         Cec_ManFdIncreIter( pMan );
         if (pPars->fVerbose) Cec_ManFdReport( pMan );
         sprintf(str, "runstat.log");
@@ -119,7 +119,18 @@ void Cec_ManFdSetDefaultParams( Cec_ParFd_t * p )
     p->fTrim          =       1;
     p->fSyn           =       0;
     p->fLocalShrink   =       0;
-    p->fInc           =       0;
+    p->fInc           =       1;
+    p->fTrace         =       0;
+    p->fItpMin        =       0;
+    p->fBench         =       0;
+    p->fSim           =       1;
+    p->fKeepStat      =       1;
+    p->fBinStat       =       1;
+    p->fCache         =       1;
+    p->pProfile       =       NULL;
+    p->nThreads       =       0;
+    p->nBatch         =       0;
+    p->nRounds        =       0;
     p->coefPatch      =       0.0;
     p->pMerge         =       NULL;
 }  
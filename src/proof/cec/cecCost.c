@@ -0,0 +1,213 @@
+/**CFile****************************************************************
+
+  FileName    [cecCost.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Combinational equivalence checking.]
+
+  Synopsis    [Path lengths for the cost of the FD patches.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: cecCost.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "cecInt.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Starts and stops the scratch arrays of the evaluator.]
+
+  Description [The arrays grow to the largest AIG seen and are reused,
+  so that evaluating a patch does not allocate.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Cec_CostMan_t * Cec_CostManStart()
+{
+    Cec_CostMan_t * p = ABC_CALLOC( Cec_CostMan_t, 1 );
+    p->vDist   = Vec_IntAlloc( 1000 );
+    p->vOrder  = Vec_IntAlloc( 1000 );
+    p->vSupp   = Vec_IntAlloc( 100 );
+    p->vCiDist = Vec_IntAlloc( 100 );
+    return p;
+}
+void Cec_CostManStop( Cec_CostMan_t * p )
+{
+    if ( p == NULL )
+        return;
+    Vec_IntFree( p->vDist );
+    Vec_IntFree( p->vOrder );
+    Vec_IntFree( p->vSupp );
+    Vec_IntFree( p->vCiDist );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the distance of the cone objects to the root.]
+
+  Description [Fills vDist[i] with the longest (fMax) or the shortest
+  path from object i to iRoot, for the objects of the TFI of iRoot whose
+  IDs are not below iLimit; the other entries are -1. The objects are
+  visited once in the reverse DFS order, so the cost is linear in the
+  size of the cone. As in Cec_ManDist(), the paths do not go below an
+  object marked by fMark0 other than the root. The entries are reset by
+  Cec_CostConeClean().]
+
+  SideEffects [Uses the traversal IDs of p.]
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Cec_CostCone_rec( Gia_Man_t * p, int iObj, int iRoot, int iLimit, Vec_Int_t * vOrder )
+{
+    Gia_Obj_t * pObj = Gia_ManObj( p, iObj );
+    if ( iObj < iLimit || Gia_ObjIsTravIdCurrentId(p, iObj) )
+        return;
+    Gia_ObjSetTravIdCurrentId( p, iObj );
+    if ( Gia_ObjIsAnd(pObj) && (iObj == iRoot || !pObj->fMark0) )
+    {
+        Cec_CostCone_rec( p, Gia_ObjFaninId0(pObj, iObj), iRoot, iLimit, vOrder );
+        Cec_CostCone_rec( p, Gia_ObjFaninId1(pObj, iObj), iRoot, iLimit, vOrder );
+    }
+    Vec_IntPush( vOrder, iObj );
+}
+static inline void Cec_CostConeUpdate( Vec_Int_t * vDist, int iObj, int Dist, int fMax )
+{
+    int Old = Vec_IntEntry( vDist, iObj );
+    if ( Old == -1 || (fMax ? Dist > Old : Dist < Old) )
+        Vec_IntWriteEntry( vDist, iObj, Dist );
+}
+void Cec_CostConeDist( Cec_CostMan_t * p, Gia_Man_t * pGia, int iRoot, int iLimit, int fMax )
+{
+    Gia_Obj_t * pObj;
+    int i, iObj, Dist;
+    Vec_IntFillExtra( p->vDist, Gia_ManObjNum(pGia), -1 );
+    Vec_IntClear( p->vOrder );
+    Gia_ManIncrementTravId( pGia );
+    Cec_CostCone_rec( pGia, iRoot, iRoot, iLimit, p->vOrder );
+    Vec_IntWriteEntry( p->vDist, iRoot, 0 );
+    Vec_IntForEachEntryReverse( p->vOrder, iObj, i )
+    {
+        pObj = Gia_ManObj( pGia, iObj );
+        Dist = Vec_IntEntry( p->vDist, iObj );
+        if ( Dist < 0 || !Gia_ObjIsAnd(pObj) || (iObj != iRoot && pObj->fMark0) )
+            continue;
+        if ( Gia_ObjFaninId0(pObj, iObj) >= iLimit )
+            Cec_CostConeUpdate( p->vDist, Gia_ObjFaninId0(pObj, iObj), Dist + 1, fMax );
+        if ( Gia_ObjFaninId1(pObj, iObj) >= iLimit )
+            Cec_CostConeUpdate( p->vDist, Gia_ObjFaninId1(pObj, iObj), Dist + 1, fMax );
+    }
+}
+void Cec_CostConeClean( Cec_CostMan_t * p )
+{
+    int i, iObj;
+    Vec_IntForEachEntry( p->vOrder, iObj, i )
+        Vec_IntWriteEntry( p->vDist, iObj, -1 );
+    Vec_IntClear( p->vOrder );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the distance of each CI of a patch to its CO.]
+
+  Description [Returns the array with the longest (fMax) or the shortest
+  path from each CI to the driver of the first CO, or -1 if the CI is
+  not in its TFI. This is the column of the CO driver in
+  Cec_ManDist( pPatch, fMax ), without building the table.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Cec_CostCiDist( Cec_CostMan_t * p, Gia_Man_t * pPatch, int fMax )
+{
+    Gia_Obj_t * pObj;
+    int i;
+    Cec_CostConeDist( p, pPatch, Gia_ManCoDriverId(pPatch, 0), 0, fMax );
+    Vec_IntClear( p->vCiDist );
+    Gia_ManForEachCi( pPatch, pObj, i )
+        Vec_IntPush( p->vCiDist, Vec_IntEntry(p->vDist, Gia_ObjId(pPatch, pObj)) );
+    Cec_CostConeClean( p );
+    return p->vCiDist;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the MFFC cost of each AND node.]
+
+  Description [fCost is 0 for the size of the MFFC, 1 for the longest
+  path to its leaves, and 2 for the shortest path to its leaves. The
+  paths are computed in the cone of each node above its lowest leaf,
+  instead of the whole distance table. Returns -1 for the other objects
+  and for the driver of the only CO.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Cec_ManGetMFFCost( Gia_Man_t * pGia, int fCost )
+{
+    Cec_CostMan_t * p = Cec_CostManStart();
+    Vec_Int_t * vCost = Vec_IntStartFull( Gia_ManObjNum(pGia) );
+    Gia_Obj_t * pObj;
+    int i, k, iLeaf, iLimit, Dist, Cost;
+    assert( fCost >= 0 && fCost <= 2 );
+    if ( pGia->pRefs == NULL )
+        Gia_ManCreateRefs( pGia );
+    Gia_ManForEachAnd( pGia, pObj, i )
+    {
+        if ( i == Gia_ManCoDriverId(pGia, 0) && Gia_ManCoNum(pGia) == 1 )
+            continue;
+        Cost = Gia_NodeMffcSizeSupp( pGia, pObj, p->vSupp );
+        if ( fCost == 0 )
+        {
+            Vec_IntWriteEntry( vCost, i, Cost );
+            continue;
+        }
+        iLimit = Vec_IntSize(p->vSupp) ? Vec_IntFindMin(p->vSupp) : i;
+        Cec_CostConeDist( p, pGia, i, iLimit, fCost == 1 );
+        // the same order and update as the scan of the table rows
+        Cost = -1;
+        Vec_IntForEachEntry( p->vSupp, iLeaf, k )
+        {
+            Dist = Vec_IntEntry( p->vDist, iLeaf );
+            if ( Cost == -1 || (fCost == 1 ? Cost < Dist : Cost > Dist) )
+                Cost = Dist;
+        }
+        Cec_CostConeClean( p );
+        Vec_IntWriteEntry( vCost, i, Cost );
+    }
+    Cec_CostManStop( p );
+    return vCost;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
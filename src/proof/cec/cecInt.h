@@ -30,6 +30,8 @@
 #include "sat/bsat/satSolver2.h" // Added
 #include "sat/glucose2/AbcGlucose2.h"
 #include "misc/bar/bar.h"
+#include "misc/util/utilTruth.h"
+#include "misc/vec/vecHsh.h"
 #include "aig/gia/gia.h"
 #include "aig/gia/giaAig.h"
 #include "cec.h"
@@ -189,6 +191,42 @@ struct Cec_ManAff_t_
 #define CEC_FD_COVER -6
 #define CEC_FD_TRIVIAL -7
 #define CEC_FD_UNSHRINKABLE -8
+
+// the values of a patch pointer that are not patches, CEC_FD_PATCH_UNSOLVE and CEC_FD_PATCH_HUGE, are in satSolver2.h
+
+// sparse path-length table, only the pairs (i, j) with j in the TFI of i are stored
+typedef struct Cec_ManDist_t_ Cec_ManDist_t;
+struct Cec_ManDist_t_
+{
+    int              nObjs;          // the number of objects in the AIG
+    int              fMax;           // 1 for the longest paths, 0 for the shortest paths
+    int **           pRows;          // pRows[i] = {nPairs, ids[nPairs], dists[nPairs]}, ids are increasing
+    word             nPairs;         // the total number of stored pairs
+    int              fBlock;         // 1 if some paths were blocked by fMark0
+};
+
+// the scratch arrays of the patch cost evaluator (cecCost.c)
+typedef struct Cec_CostMan_t_ Cec_CostMan_t;
+struct Cec_CostMan_t_
+{
+    Vec_Int_t *      vDist;          // the distance of each object to the current root, or -1
+    Vec_Int_t *      vOrder;         // the DFS order of the current cone
+    Vec_Int_t *      vSupp;          // the leaves of the current MFFC
+    Vec_Int_t *      vCiDist;        // the distance of each CI of the patch to its CO
+};
+
+// the phases of the profiler of &fdrw (-Y); the times are inclusive, e.g. a replacement includes its cleanup
+typedef enum { 
+    CEC_FD_PROF_DIST = 0,           // distance tables of pGia and pAbs
+    CEC_FD_PROF_MERGE,              // merge frontier and its support
+    CEC_FD_PROF_ABS,                // abstraction pAbs
+    CEC_FD_PROF_ITP,                // FD queries (simulation, cache, SAT and interpolation)
+    CEC_FD_PROF_SYN,                // Cec_ManSimpSyn and fraiging of the patches and circuits
+    CEC_FD_PROF_COST,               // Cec_ManFdRawCost
+    CEC_FD_PROF_REPLACE,            // replacement of the nodes by the patches
+    CEC_FD_PROF_NUM
+} Cec_FdProf_t;
+
 typedef struct Cec_ManFd_t_ Cec_ManFd_t;
 struct Cec_ManFd_t_
 {
@@ -198,8 +236,8 @@ struct Cec_ManFd_t_
     Gia_Obj_t *      pObj1;
     Gia_Obj_t *      pObj2;
     int              fPhase;         // 1 if we add XOR on pObj1, pObj2 to get pGia 
-    int**            dist_long;      // dist[j][i], j > i
-    int**            dist_short;    // dist[j][i], j > i
+    Cec_ManDist_t *  dist_long;      // dist[j][i], j > i
+    Cec_ManDist_t *  dist_short;     // dist[j][i], j > i
     Vec_Int_t *      vMerge;         // merge frontier
     Vec_Int_t *      vNodeInit;     // merge frontier in the begin
     
@@ -208,13 +246,13 @@ struct Cec_ManFd_t_
     Gia_Obj_t *      pObjAbs2;           
     Vec_Int_t *      vAbsMap;            // map from pGia to pAbs
     Vec_Int_t *      vGiaMap;            // map from pAbs to pGia 
-    int**            dist_long_abs;
-    int**            dist_short_abs;
+    Cec_ManDist_t *  dist_long_abs;
+    Cec_ManDist_t *  dist_short_abs;
     
-    Vec_Wec_t *      vMergeSupport;      // support vMerge for each node in pGia (set as binary form)
+    Vec_Wrd_t *      vMergeSupp;         // support vMerge for each node in pGia (bit j is vMerge[j], nMergeWords per node)
+    int              nMergeWords;        // the number of words in the support of a node
     Vec_Wec_t *      vGSupport;          // support G for each node in pGia
     
-    Vec_Wec_t *      vCuts;           // cuts on pAbs for each node
     // Vec_Int_t *      vLevel;          // level for each node in pGia
     Vec_Int_t *      vLevel1;          // level for each node in ckt1
     Vec_Int_t *      vLevel2;          // level for each node in ckt2
@@ -231,6 +269,32 @@ struct Cec_ManFd_t_
     Vec_Ptr_t *      vVeryStat;      // Info store as Gia_Man_t*, UNSAT: patch
     Vec_Int_t *      vConf;          // conflict that is required
     int              iter;
+    abctime          clkInc;         // benchmark: time of the incremental engine
+    abctime          clkItp;         // benchmark: time of the non-incremental engine
+    int              nBench;         // benchmark: the number of queries
+    Vec_Wrd_t *      vSimsPi;        // simulation patterns of the CIs (random ones and the SAT counter-examples)
+    Vec_Wrd_t *      vSims;          // simulation info of the objects in pGia under vSimsPi
+    int              nSimWords;      // the number of words per object
+    int              nSimPats;       // the number of patterns in use
+    int              nSimQueries;    // the number of queries checked by simulation
+    int              nSimRefuted;    // the number of queries proved SAT by simulation
+    Hsh_VecMan_t *   pCache;         // the canonical keys of the solved queries (kept across the updates)
+    Vec_Ptr_t *      vCachePatch;    // the answer of each key: NULL (SAT), 1 (UNSOLVE) or the patch
+    Vec_Int_t *      vCacheLimit;    // the conflict limit of the answer, -1 if the key has no answer yet
+    Vec_Int_t *      vCacheKey;      // the key of the current query
+    Vec_Int_t *      vCacheHash;     // the structural hash of the objects (scratch)
+    Vec_Int_t *      vCacheLocal;    // the local id of the objects in the key (scratch)
+    int              nCacheQueries;  // the number of queries looked up in the cache
+    int              nCacheHits;     // the number of queries answered by the cache
+    abctime          clkStart;       // profiler: the time when the manager is started
+    abctime          clkProf[CEC_FD_PROF_NUM];    // profiler: the time of each phase
+    int              nProfCalls[CEC_FD_PROF_NUM]; // profiler: the calls of each phase
+    word             nProfConfs[CEC_FD_PROF_NUM]; // profiler: the conflicts of each phase
+    double           MemProf[CEC_FD_PROF_NUM];    // profiler: the peak memory of the process (MB) after each phase
+    Vec_Int_t *      vProfQuery;     // profiler: node, |G|, result and conflicts of each query (only with -Y)
+    Vec_Wrd_t *      vProfTime;      // profiler: the time of each query (only with -Y)
+    Vec_Wrd_t *      vItpMin;        // the AND nodes before and after, and the time of each stage of Int2_ManMinimize()
+    Cec_CostMan_t *  pCost;          // the scratch arrays of the patch cost
 
 };
 ////////////////////////////////////////////////////////////////////////
@@ -265,9 +329,12 @@ extern void                 Cec_ManFraStop( Cec_ManFra_t * p );
 /*=== cecMan.c (currently) ===============================================*/
 // compute gia information
 extern void                 Cec_ManSetColor( Gia_Man_t * pGia, Gia_Obj_t * pObj1, Gia_Obj_t * pObj2);
-extern int**                Cec_ManDist( Gia_Man_t* pGia, int fMax );
+extern Cec_ManDist_t*       Cec_ManDist( Gia_Man_t* pGia, int fMax );
+extern Cec_ManDist_t*       Cec_ManDistUpdate( Gia_Man_t* pGia, int fMax, Cec_ManDist_t* pOld, Vec_Int_t* vNew2Old );
+extern void                 Cec_ManDistFree( Cec_ManDist_t* p );
+extern double               Cec_ManDistMemory( Cec_ManDist_t* p );
 extern void                 Cec_ManDistEasy( Gia_Man_t* pGia, Vec_Int_t* vFI, int nidFo, int fMax );
-extern Vec_Wec_t*           Cec_ManDistAnalyze( Gia_Man_t* pGia, Vec_Int_t* targets, Vec_Int_t* vFI, Vec_Int_t* vFO, int** dist_long, int** dist_short);
+extern Vec_Wec_t*           Cec_ManDistAnalyze( Gia_Man_t* pGia, Vec_Int_t* targets, Vec_Int_t* vFI, Vec_Int_t* vFO, Cec_ManDist_t* dist_long, Cec_ManDist_t* dist_short);
 extern Vec_Int_t*           Cec_ManGetFIO( Gia_Man_t* pGia, Vec_Int_t* targets, int fPickFO );
 extern void                 Cec_ManMatch( Gia_Man_t* pGia, Gia_Man_t* pRef );
 extern void                 Cec_ManGetCuts( Gia_Man_t* pGia, Gia_Obj_t* t, Gia_Obj_t* s, Vec_Int_t* vCare, Vec_Wec_t* vCuts );
@@ -296,13 +363,35 @@ extern void                 Cec_ManShowValNode( Gia_Man_t* pGia, char* pFileName
 // functional dependency setting
 extern void                 Cec_ManFdDumpStat( Cec_ManFd_t* pMan, char* pFileName );
 extern void                 Cec_ManFdReadStat( Cec_ManFd_t* pMan, char* pFileName, int fClear );
+extern void                 Cec_ManFdDumpStatBin( Cec_ManFd_t* pMan, char* pFileName );
+extern int                  Cec_ManFdReadStatBin( Cec_ManFd_t* pMan, unsigned char* pContents, int nSize, int fClear );
+extern char *               Cec_ManFdStatMap( char* pFileName, int* pnSize );
+extern void                 Cec_ManFdStatUnmap( char* pContents, int nSize );
+extern unsigned             Cec_ManFdGiaHash( Gia_Man_t* p );
+extern void                 Cec_ManFdProfAdd( Cec_ManFd_t* pMan, int Phase, abctime clk, int nConfs );
+extern void                 Cec_ManFdProfQuery( Cec_ManFd_t* pMan, int nid, int nSupp, Gia_Man_t* pPatch, int nConfs, abctime clk );
+extern void                 Cec_ManFdProfWrite( Cec_ManFd_t* pMan, char* pFileName );
+extern Gia_Man_t*           Cec_ManFdSimpSyn( Cec_ManFd_t* pMan, Gia_Man_t* pGia, int fSat, int fVerbose, int nRuns );
+extern Gia_Man_t*           Cec_ManFdFraigSyn( Cec_ManFd_t* pMan, Gia_Man_t* pGia, int nConflict );
+extern Gia_Man_t*           Cec_ManFdQueryMiter( Gia_Man_t* pGia, int f, Vec_Int_t* vG );
+extern Gia_Man_t*           Cec_ManFdQueryMiterMulti( Gia_Man_t* pGia, Vec_Int_t* vF, Vec_Int_t* vG );
+extern Gia_Man_t*           Cec_ManFdMinPatch( Cec_ManFd_t* pMan, Vec_Int_t* vFdSupport, Gia_Man_t* pPatch );
+extern void                 Cec_ManFdCacheStart( Cec_ManFd_t* pMan );
+extern void                 Cec_ManFdCacheStop( Cec_ManFd_t* pMan );
+extern int                  Cec_ManFdCacheFind( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport );
+extern int                  Cec_ManFdCacheGet( Cec_ManFd_t* pMan, int iEntry, Gia_Man_t** ppPatch );
+extern void                 Cec_ManFdCacheSet( Cec_ManFd_t* pMan, int iEntry, Gia_Man_t* pPatch, int nConf );
 extern void                 Cec_ManFdAddClause( Cec_ManFd_t* pMan, sat_solver2* p );
 extern void                 Cec_ManFdPrepareSolver( Cec_ManFd_t* pMan );
 extern Cec_ManFd_t*         Cec_ManFdStart( Gia_Man_t* pGia, Cec_ParFd_t* pPars, char* pFileName );
 extern void                 Cec_ManFdUpdate( Cec_ManFd_t* pMan, Gia_Man_t* p );
 extern void                 Cec_ManFdStop( Cec_ManFd_t* pMan, int fAll );
 // functional dependency computation
-extern Gia_Man_t*           Cec_ManFdGetFd_Inc( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSupportGlobal );
+extern void                 Cec_ManFdSimStart( Cec_ManFd_t* pMan );
+extern void                 Cec_ManFdSimAddCex( Cec_ManFd_t* pMan );
+extern int                  Cec_ManFdSimRefute( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport );
+extern Gia_Man_t*           Cec_ManFdGetFd_Inc( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSupportGlobal, Vec_Int_t* stat );
+extern Gia_Man_t*           Cec_ManFdSolve( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSupportGlobal, Vec_Int_t* stat );
 extern Gia_Man_t*           Cec_ManFdGetFd( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSupportGlobal, Vec_Int_t* stat );
 extern float                Cec_ManFdRawCost( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_Man_t* patch );
 // functional dependency update status
@@ -310,10 +399,13 @@ extern void                 Cec_ManFdUpdateStatForce( Cec_ManFd_t* pMan, int nid
 extern int                  Cec_ManFdUpdateStat( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_Man_t* patch, int fStrict );
 extern void                 Cec_ManFdCleanOneUnknown( Cec_ManFd_t* pMan, int nid );
 extern void                 Cec_ManFdCleanUnknown( Cec_ManFd_t* pMan, int fGetColor );
+extern void                 Cec_ManFdCleanUnknownBatch( Cec_ManFd_t* pMan, Vec_Int_t* vCand );
+extern void                 Cec_ManFdSolveAhead( Cec_ManFd_t* pMan, Vec_Int_t* vNid, Vec_Wec_t* vSupp );
 extern void                 Cec_ManFdTraverseUnknown( Cec_ManFd_t* pMan, int fColor );
 extern Vec_Int_t*           Cec_ManFdTraverseUnknownFrt( Cec_ManFd_t* pMan, int fColor, int nRange, int fType, Vec_Flt_t* vCoef );
 extern void                 Cec_ManFdTraverseUnknownLevelTest( Cec_ManFd_t* pMan, int lv_min, int lv_max, int lv_lim, int fColor );
 extern void                 Cec_ManFdShrink( Cec_ManFd_t* pMan, int nid );
+extern void                 Cec_ManFdShrinkFirstQuery( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vSupp );
 extern void                 Cec_ManFdShrinkSimple( Cec_ManFd_t* pMan, int nid, int fClean );
 extern void                 Cec_ManFdShrinkLevelTest( Cec_ManFd_t* pMan, int nid, int lv_lim );
 extern void                 Cec_ManFdCleanSupport( Cec_ManFd_t* pMan, int nid );
@@ -328,6 +420,33 @@ extern void                 Cec_ManFdPlot( Cec_ManFd_t* pMan, int fAbs, int fVec
 extern void                 Cec_ManFdReport( Cec_ManFd_t* pMan );
 
 
+// dist from node j to node i, -1 if j is not in the TFI of i
+static inline int           Cec_ManDistEntry( Cec_ManDist_t * p, int i, int j ) {
+    int * pRow = p->pRows[i];
+    int * pIds = pRow + 1;
+    int iBeg = 0, iEnd = pRow[0] - 1, iMid;
+    if ( j > i ) return -1;
+    if ( j == i ) return 0;
+    while ( iBeg <= iEnd ) {
+        iMid = (iBeg + iEnd) >> 1;
+        if ( pIds[iMid] == j ) return pIds[pRow[0] + iMid];
+        if ( pIds[iMid] < j ) iBeg = iMid + 1;
+        else iEnd = iMid - 1;
+    }
+    return -1;
+}
+static inline int           Cec_ManDistRowSize( Cec_ManDist_t * p, int i )         { return p->pRows[i][0];                    }
+static inline int           Cec_ManDistRowId( Cec_ManDist_t * p, int i, int k )    { return p->pRows[i][1 + k];                }
+static inline int           Cec_ManDistRowDist( Cec_ManDist_t * p, int i, int k )  { return p->pRows[i][1 + p->pRows[i][0] + k]; }
+
+// merge frontier support of node nid in pGia, empty for the shared nodes and the non-AND nodes
+static inline word *        Cec_ManFdMergeSupp( Cec_ManFd_t * p, int nid )                       { return Vec_WrdEntryP( p->vMergeSupp, nid * p->nMergeWords );                     }
+static inline int           Cec_ManFdMergeSuppHas( Cec_ManFd_t * p, int nid, int j )             { return Abc_TtGetBit( Cec_ManFdMergeSupp(p, nid), j );                            }
+static inline int           Cec_ManFdMergeSuppNum( Cec_ManFd_t * p, int nid )                    { return Abc_TtCountOnesVec( Cec_ManFdMergeSupp(p, nid), p->nMergeWords );         }
+static inline int           Cec_ManFdMergeSuppContain( Cec_ManFd_t * p, int nidBig, int nidSmall ) { return Abc_TtImply( Cec_ManFdMergeSupp(p, nidSmall), Cec_ManFdMergeSupp(p, nidBig), p->nMergeWords ); }
+#define Cec_ManFdForEachMergeSupp( p, nid, j ) \
+    for ( j = 0; j < Vec_IntSize((p)->vMerge); j++ ) if ( !Cec_ManFdMergeSuppHas(p, nid, j) ) {} else
+
 static inline Vec_Wec_t*    Cec_ManCutReform( Vec_Int_t * vCut ) {
     int buf, dummy, flag, entry;
     Vec_Wec_t* v_cuts = Vec_WecStart( 1 );
@@ -620,50 +739,6 @@ static inline Vec_Int_t*    Cec_ManGetSibling( Gia_Man_t* pGia_in, Vec_Int_t* vN
     Vec_IntFree( vTFO );
     return vSibling;
 }
-// 0 -- size, 1 -- level, 2 -- dist
-static inline Vec_Int_t*    Cec_ManGetMFFCost( Gia_Man_t* pGia, int fCost ) {
-  int nid, nidSup, buf1, buf2, i, j;
-  int** dist;
-  Vec_Int_t* vCost = Vec_IntStart( Gia_ManObjNum(pGia) );
-  Vec_Int_t* vSup = Vec_IntAlloc( 100 );
-  Gia_Obj_t* pObjbuf;
-  if (pGia->pRefs == 0) Gia_ManCreateRefs( pGia );
-  dist = Cec_ManDist(pGia, fCost & 1);
-  Vec_IntFill( vCost, Gia_ManObjNum(pGia), -1 );
-  Gia_ManForEachAnd( pGia, pObjbuf, i ) {
-      nid = Gia_ObjId( pGia, pObjbuf );
-      if ((nid == Gia_ManCoDriverId(pGia, 0)) && (Gia_ManCoNum(pGia) == 1)) continue;
-      buf2 = Gia_NodeMffcSizeSupp( pGia, pObjbuf, vSup );
-      switch (fCost) {
-          case 0: // size
-              Vec_IntWriteEntry( vCost, nid, buf2 );
-              break;
-          case 1: // level
-              buf2 = -1;
-              Vec_IntForEachEntry( vSup, nidSup, j ) {
-                  if ( buf2 == -1 || buf2 < dist[nid][nidSup] ) {
-                      buf2 = dist[nid][nidSup];
-                  }
-              }
-              Vec_IntWriteEntry( vCost, nid, buf2 );
-              break;
-          case 2: // dist
-              buf2 = -1;
-              Vec_IntForEachEntry( vSup, nidSup, j ) {
-                  if ( buf2 == -1 || buf2 > dist[nid][nidSup] ) {
-                      buf2 = dist[nid][nidSup];
-                  }
-              }
-              Vec_IntWriteEntry( vCost, nid, buf2 );
-              break;
-          default:
-              assert(0);
-      }
-  }
-  for (i = 0; i < Gia_ManObjNum(pGia); i++) ABC_FREE( dist[i] );
-  ABC_FREE( dist );
-  return vCost;
-}
 // contain vFO itself
 static inline int           Cec_ManMFFCMul( Gia_Man_t* pGia, Vec_Int_t* vFO, Vec_Int_t* vMFFC ) {
     int i, entry;
@@ -1174,6 +1249,9 @@ static inline void          Cec_ManFdMapObj( Cec_ManFd_t* pMan, Vec_Ptr_t* vIn,
   }
 
 }
+static inline char*         Cec_ManFdResultName( Gia_Man_t* pFdPatch ) {
+  return pFdPatch == NULL ? "SAT" : pFdPatch == CEC_FD_PATCH_UNSOLVE ? "UNSOLVE" : pFdPatch == CEC_FD_PATCH_HUGE ? "HUGE" : "UNSAT";
+}
 static inline Vec_Int_t*    Cec_ManFdUnsatId( Cec_ManFd_t* pMan, int level, int fHuge ) {
   int stat, nid, i, j;
   Vec_Wec_t* ordUnsat = Vec_WecStart( 1 );
@@ -1291,6 +1369,13 @@ static inline int           Cec_ManFdGetPO( Cec_ManFd_t* pMan, int nid, int fAbs
 }
 
 
+/*=== cecCost.c ============================================================*/
+extern Cec_CostMan_t *      Cec_CostManStart();
+extern void                 Cec_CostManStop( Cec_CostMan_t * p );
+extern void                 Cec_CostConeDist( Cec_CostMan_t * p, Gia_Man_t * pGia, int iRoot, int iLimit, int fMax );
+extern void                 Cec_CostConeClean( Cec_CostMan_t * p );
+extern Vec_Int_t *          Cec_CostCiDist( Cec_CostMan_t * p, Gia_Man_t * pPatch, int fMax );
+extern Vec_Int_t *          Cec_ManGetMFFCost( Gia_Man_t * pGia, int fCost );
 /*=== cecPat.c ============================================================*/
 extern void                 Cec_ManPatSavePattern( Cec_ManPat_t *  pPat, Cec_ManSat_t *  p, Gia_Obj_t * pObj );
 extern void                 Cec_ManPatSavePatternCSat( Cec_ManPat_t * pMan, Vec_Int_t * vPat );
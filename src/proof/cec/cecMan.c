@@ -19,9 +19,19 @@
 ***********************************************************************/
 
 #include "cecInt.h"
+#include "sat/cnf/cnf.h"
+#include "misc/util/utilTruth.h"
+#include "misc/util/utilTask.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 ABC_NAMESPACE_IMPL_START
-extern Vec_Wec_t * Gia_ManExploreCuts( Gia_Man_t * pGia, int nCutSize0, int nCuts0, int fVerbose0 );
 extern void Gia_WriteDotAigSimple( Gia_Man_t * p, char * pFileName, Vec_Int_t * vRwNd );
 extern void Gia_SelfDefShow( Gia_Man_t * p, char * pFileName, Vec_Int_t * vLabel0, Vec_Int_t * vLabel1, Vec_Wec_t* vRelate);
 
@@ -29,6 +39,9 @@ extern void Gia_SelfDefShow( Gia_Man_t * p, char * pFileName, Vec_Int_t * vLabel
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+static float      Cec_ManFdRawCost_int( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_Man_t* patch );
+static Gia_Man_t* Cec_ManFdReplaceMulti_int( Cec_ManFd_t* pMan, Vec_Int_t* vF );
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -331,82 +344,115 @@ void Cec_ManSetColor( Gia_Man_t * pGia, Gia_Obj_t * pObj1, Gia_Obj_t * pObj2 ){
 }
 
 // dist[i][j] = dist from node j to node i
-int** Cec_ManDist( Gia_Man_t* pGia, int fMax ) {
-    Gia_Obj_t *pObj, *pObj_child1, *pObj_child2, *pCo;
-    Vec_Ptr_t *vNodes;
-    int i, j, k, nid_cur, nid_child1, nid_child2, dist_cur, dist_child1, dist_child2;
+// each row keeps only the TFI of node i, so the memory is proportional to the number of connected pairs
+// rows are merged from the fanin rows in topological order; a fanin marked by fMark0 blocks the paths through it
+Cec_ManDist_t* Cec_ManDist( Gia_Man_t* pGia, int fMax ) {
+    return Cec_ManDistUpdate( pGia, fMax, NULL, NULL );
+}
+// same as Cec_ManDist, but the row of a node whose TFI is unchanged (vNew2Old[i] >= 0) is copied from pOld
+// with the ids renamed, so only the TFO of the modified cones is merged again
+Cec_ManDist_t* Cec_ManDistUpdate( Gia_Man_t* pGia, int fMax, Cec_ManDist_t* pOld, Vec_Int_t* vNew2Old ) {
+    Gia_Obj_t *pObj;
+    Cec_ManDist_t *p;
+    Vec_Int_t *vOld2New = NULL;
+    int pBlock[2][3], *pRows[2], *pRow, *pIds, *pDists;
+    int i, k, nid_cur, nid_child, n0, n1, k0, k1, nSize, id0, id1, dist_child1, dist_child2;
     int nObj = Gia_ManObjNum(pGia);
 
-    // Vec_Wec_t* dist = Vec_WecStart( nObj );
-    int **dist = ABC_ALLOC( int*, nObj );
-    // int (*dist)[nObj] = ABC_ALLOC( int, nObj*nObj );
-    for (i = 0; i < nObj; i++) {
-        // printf("alloc %d\n", i);
-        dist[i] = ABC_ALLOC( int, nObj );
-        for (j = 0; j < nObj; j++)
-            dist[i][j] = -1;
-    }
-        
+    p = ABC_CALLOC( Cec_ManDist_t, 1 );
+    p->nObjs = nObj;
+    p->fMax = fMax;
+    p->pRows = ABC_CALLOC( int*, nObj );
+    pIds = ABC_ALLOC( int, nObj );
+    pDists = ABC_ALLOC( int, nObj );
 
-    
-    // for (i = 0; i < nObj; i++) {
-    //     for (j = 0; j < nObj; j++)
-    //         printf("%d ", dist[i][j]);
-    //     printf("\n");
-    // }
+    // the old rows are reused only if neither table has blocked paths
+    Gia_ManForEachObj( pGia, pObj, i )
+        if ( pObj->fMark0 ) p->fBlock = 1;
+    if ( pOld && vNew2Old && pOld->fMax == fMax && !pOld->fBlock && !p->fBlock ) {
+        vOld2New = Vec_IntInvert( vNew2Old, -1 );
+        Vec_IntFillExtra( vOld2New, pOld->nObjs, -1 );
+    }
 
     Gia_ManForEachObj( pGia, pObj, i ) {
-        // Vec_WecWriteEntry( dist, nid_child1, nid_child1, 0 );
-        // dist[nid_child1][nid_child1] = 0;
-            nid_cur = Gia_ObjId(pGia, pObj);
-            // printf("%d\n",nid_cur);
-            dist[nid_cur][nid_cur] = 0;
-
-            // if( Gia_ObjIsAnd(pObj) == 0 ) continue;
-            // printf("%d\n", Gia_ObjId(pGia, pObj));
-            if ( Gia_ObjIsAnd(pObj) || Gia_ObjIsCo(pObj) ) {
-                // pObj_child1 = Gia_ObjFanin0(pObj);
-                nid_child1 = Gia_ObjId(pGia, Gia_ObjFanin0(pObj));
-            } else {
-                nid_child1 = -1;
+        nid_cur = Gia_ObjId(pGia, pObj);
+        // reuse the old row if the renamed ids are still increasing
+        if ( vOld2New && Vec_IntEntry(vNew2Old, nid_cur) >= 0 && Vec_IntEntry(vNew2Old, nid_cur) < pOld->nObjs ) {
+            pRow = pOld->pRows[Vec_IntEntry(vNew2Old, nid_cur)];
+            nSize = pRow ? pRow[0] : nObj + 1;
+            for (k = 0; nSize <= nObj && k < nSize; k++) {
+                pIds[k] = Vec_IntEntry( vOld2New, pRow[1 + k] );
+                if ( pIds[k] < 0 || (k > 0 && pIds[k] <= pIds[k-1]) ) break;
             }
-            
-            // dist[nid_cur][nid_child1] = 1;
-            if ( Gia_ObjIsAnd(pObj) ) {
-                nid_child2 = Gia_ObjId(pGia, Gia_ObjFanin1(pObj));
-            } else {
-                nid_child2 = -1;
+            if ( nSize <= nObj && k == nSize && pIds[nSize-1] == nid_cur ) {
+                p->pRows[nid_cur] = ABC_ALLOC( int, 1 + 2 * nSize );
+                p->pRows[nid_cur][0] = nSize;
+                memcpy( p->pRows[nid_cur] + 1, pIds, sizeof(int) * nSize );
+                memcpy( p->pRows[nid_cur] + 1 + nSize, pRow + 1 + nSize, sizeof(int) * nSize );
+                p->nPairs += nSize;
+                continue;
             }
-            // dist[nid_cur][nid_child2] = 1;
-
-            for (k = 0; k < nid_cur; k++) {
-                dist_child1 = nid_child1 < 0 ? -1 : (Gia_ManObj(pGia, nid_child1)->fMark0 && k != nid_child1) ? -1 : dist[nid_child1][k];
-                dist_child2 = nid_child2 < 0 ? -1 : (Gia_ManObj(pGia, nid_child2)->fMark0 && k != nid_child2) ? -1 : dist[nid_child2][k];
-                if (dist_child1 == -1 && dist_child2 == -1) {
-                    dist[nid_cur][k] = -1;
-                }
-                else if (dist_child1 == -1 && dist_child2 != -1) {
-                    dist[nid_cur][k] = dist_child2 + 1;
-                }
-                else if (dist_child2 == -1 && dist_child1 != -1) {
-                    // printf("label2\n");
-                    dist[nid_cur][k] = dist_child1 + 1;
-                    // continue;
-                }
-                else {
-                    dist[nid_cur][k] = fMax ? Abc_MaxInt(dist_child1 + 1, dist_child2 + 1) : Abc_MinInt(dist_child1 + 1, dist_child2 + 1);
-                }
-
-                // if (dist_child1 == -1 || dist_child2 == -1) {
-                //     continue;
-                // }
-                // printf("%d %d\n", Vec_WecEntryEntry( dist, k, nid_child1 ), Vec_WecEntryEntry( dist, k, nid_child2 ));
+        }
+        // collect the fanin rows
+        for (k = 0; k < 2; k++) {
+            pRows[k] = NULL;
+            if ( k == 0 && !Gia_ObjIsAnd(pObj) && !Gia_ObjIsCo(pObj) ) continue;
+            if ( k == 1 && !Gia_ObjIsAnd(pObj) ) continue;
+            nid_child = k == 0 ? Gia_ObjFaninId0(pObj, nid_cur) : Gia_ObjFaninId1(pObj, nid_cur);
+            if ( Gia_ManObj(pGia, nid_child)->fMark0 ) { // only the fanin itself is reachable
+                pBlock[k][0] = 1;
+                pBlock[k][1] = nid_child;
+                pBlock[k][2] = 0;
+                pRows[k] = pBlock[k];
+            } else {
+                pRows[k] = p->pRows[nid_child];
             }
-        
-    }
-    
-    
-    return dist;
+        }
+        // merge the sorted fanin rows
+        n0 = pRows[0] ? pRows[0][0] : 0;
+        n1 = pRows[1] ? pRows[1][0] : 0;
+        nSize = k0 = k1 = 0;
+        while ( k0 < n0 || k1 < n1 ) {
+            id0 = k0 < n0 ? pRows[0][1 + k0] : nObj;
+            id1 = k1 < n1 ? pRows[1][1 + k1] : nObj;
+            dist_child1 = id0 <= id1 ? pRows[0][1 + n0 + k0] : -1;
+            dist_child2 = id1 <= id0 ? pRows[1][1 + n1 + k1] : -1;
+            pIds[nSize] = Abc_MinInt( id0, id1 );
+            if (dist_child1 == -1)
+                pDists[nSize] = dist_child2 + 1;
+            else if (dist_child2 == -1)
+                pDists[nSize] = dist_child1 + 1;
+            else
+                pDists[nSize] = fMax ? Abc_MaxInt(dist_child1 + 1, dist_child2 + 1) : Abc_MinInt(dist_child1 + 1, dist_child2 + 1);
+            nSize++;
+            k0 += (id0 <= id1);
+            k1 += (id1 <= id0);
+        }
+        pIds[nSize] = nid_cur;
+        pDists[nSize] = 0;
+        nSize++;
+        // store the row
+        pRow = p->pRows[nid_cur] = ABC_ALLOC( int, 1 + 2 * nSize );
+        pRow[0] = nSize;
+        memcpy( pRow + 1, pIds, sizeof(int) * nSize );
+        memcpy( pRow + 1 + nSize, pDists, sizeof(int) * nSize );
+        p->nPairs += nSize;
+    }
+    Vec_IntFreeP( &vOld2New );
+    ABC_FREE( pIds );
+    ABC_FREE( pDists );
+    return p;
+}
+void Cec_ManDistFree( Cec_ManDist_t* p ) {
+    int i;
+    if (p == NULL) return;
+    for (i = 0; i < p->nObjs; i++)
+        ABC_FREE( p->pRows[i] );
+    ABC_FREE( p->pRows );
+    ABC_FREE( p );
+}
+double Cec_ManDistMemory( Cec_ManDist_t* p ) {
+    return 1.0 * sizeof(Cec_ManDist_t) + 1.0 * sizeof(int*) * p->nObjs + 1.0 * sizeof(int) * (p->nObjs + 2 * p->nPairs);
 }
 
 void Cec_ManDistEasy( Gia_Man_t* pGia, Vec_Int_t* vFI, int nidFo, int fMax ) {
@@ -463,7 +509,7 @@ void Cec_ManDistEasy( Gia_Man_t* pGia, Vec_Int_t* vFI, int nidFo, int fMax ) {
     }
 
 }
-Vec_Wec_t* Cec_ManDistAnalyze( Gia_Man_t* pGia, Vec_Int_t* targets, Vec_Int_t* vFI, Vec_Int_t* vFO, int** dist_long, int** dist_short) {
+Vec_Wec_t* Cec_ManDistAnalyze( Gia_Man_t* pGia, Vec_Int_t* targets, Vec_Int_t* vFI, Vec_Int_t* vFO, Cec_ManDist_t* dist_long, Cec_ManDist_t* dist_short) {
     Vec_Wec_t* vAnal;
     Gia_Obj_t* pObjbuf;
     Vec_Int_t* vNdBuff, *vFIBuff, *vFOBuff;
@@ -499,9 +545,10 @@ Vec_Wec_t* Cec_ManDistAnalyze( Gia_Man_t* pGia, Vec_Int_t* targets, Vec_Int_t* v
             buf2 = Gia_ManObjNum(pGia);
             if (vFOBuff) {
                 Vec_IntForEachEntry( vFOBuff, nidbuf1, j ) {
-                    if (dist_long[nidbuf1][nidbuf] == -1) continue; // not connected
-                    if (buf1 < dist_long[nidbuf1][nidbuf]) buf1 = dist_long[nidbuf1][nidbuf];
-                    if (buf2 > dist_long[nidbuf1][nidbuf]) buf2 = dist_long[nidbuf1][nidbuf]; 
+                    buf = Cec_ManDistEntry(dist_long, nidbuf1, nidbuf);
+                    if (buf == -1) continue; // not connected
+                    if (buf1 < buf) buf1 = buf;
+                    if (buf2 > buf) buf2 = buf;
                 }
             }
             Vec_WecPush( vAnal, i, buf1 );
@@ -513,9 +560,10 @@ Vec_Wec_t* Cec_ManDistAnalyze( Gia_Man_t* pGia, Vec_Int_t* targets, Vec_Int_t* v
             buf2 = Gia_ManObjNum(pGia);
             if (vFIBuff) {
                 Vec_IntForEachEntry( vFIBuff, nidbuf2, j ) {
-                    if (dist_long[nidbuf][nidbuf2] == -1) continue;
-                    if (buf1 < dist_long[nidbuf][nidbuf2]) buf1 = dist_long[nidbuf][nidbuf2];
-                    if (buf2 > dist_long[nidbuf][nidbuf2]) buf2 = dist_long[nidbuf][nidbuf2]; 
+                    buf = Cec_ManDistEntry(dist_long, nidbuf, nidbuf2);
+                    if (buf == -1) continue;
+                    if (buf1 < buf) buf1 = buf;
+                    if (buf2 > buf) buf2 = buf;
                 }
             }
             
@@ -529,9 +577,10 @@ Vec_Wec_t* Cec_ManDistAnalyze( Gia_Man_t* pGia, Vec_Int_t* targets, Vec_Int_t* v
             buf1 = -1;
             buf2 = Gia_ManObjNum(pGia);
             Vec_IntForEachEntry( vFOBuff, nidbuf1, j ) {
-                if (dist_short[nidbuf1][nidbuf] == -1) continue; // not connected
-                if (buf1 < dist_short[nidbuf1][nidbuf]) buf1 = dist_short[nidbuf1][nidbuf];
-                if (buf2 > dist_short[nidbuf1][nidbuf]) buf2 = dist_short[nidbuf1][nidbuf]; 
+                buf = Cec_ManDistEntry(dist_short, nidbuf1, nidbuf);
+                if (buf == -1) continue; // not connected
+                if (buf1 < buf) buf1 = buf;
+                if (buf2 > buf) buf2 = buf;
             }
             Vec_WecPush( vAnal, i, buf1 );
             Vec_WecPush( vAnal, i, (buf2 == Gia_ManObjNum(pGia)) ? -1 : buf2 );
@@ -541,9 +590,10 @@ Vec_Wec_t* Cec_ManDistAnalyze( Gia_Man_t* pGia, Vec_Int_t* targets, Vec_Int_t* v
             buf1 = -1;
             buf2 = Gia_ManObjNum(pGia);
             Vec_IntForEachEntry( vFIBuff, nidbuf2, j ) {
-                if (dist_short[nidbuf][nidbuf2] == -1) continue;
-                if (buf1 < dist_short[nidbuf][nidbuf2]) buf1 = dist_short[nidbuf][nidbuf2];
-                if (buf2 > dist_short[nidbuf][nidbuf2]) buf2 = dist_short[nidbuf][nidbuf2]; 
+                buf = Cec_ManDistEntry(dist_short, nidbuf, nidbuf2);
+                if (buf == -1) continue;
+                if (buf1 < buf) buf1 = buf;
+                if (buf2 > buf) buf2 = buf;
             }
             
             Vec_WecPush( vAnal, i, buf1 );
@@ -1085,7 +1135,7 @@ Vec_Flt_t*           Cec_ManRecPathLen( Gia_Man_t* pGia_in, Vec_Int_t* vF, Vec_I
     int i, j, nid, nid1, nid2, lim;
     float distF, distG, distLocal, dist, distOpt;
     Gia_Man_t* pGia = Gia_ManDup( pGia_in );
-    int** vDist;
+    Cec_ManDist_t* vDist;
     Vec_Flt_t *vDistGlobal;
 
     Cec_ManLoadMark( pGia, vF, 0, 0 );
@@ -1105,17 +1155,17 @@ Vec_Flt_t*           Cec_ManRecPathLen( Gia_Man_t* pGia_in, Vec_Int_t* vF, Vec_I
     Vec_IntForEachEntry( vG, nid2, j ) {
         distOpt = -1;
         Vec_IntForEachEntry( vF, nid1, i ) {
-            // if (debug) printf("nid1 = %d, nid2 = %d, dist = %d\n", nid1, nid2, vDist[nid1][nid2]);
-            if (vDist[nid1][nid2] == -1) continue;
+            // if (debug) printf("nid1 = %d, nid2 = %d, dist = %d\n", nid1, nid2, Cec_ManDistEntry(vDist, nid1, nid2));
+            if (Cec_ManDistEntry(vDist, nid1, nid2) == -1) continue;
             nid = fDownward ? Abc_MinInt(nid1, nid2) - 1 : Gia_ManObjNum(pGia) - 1;
             lim = fDownward ? Abc_MaxInt(nid1, nid2) : -1;
             for (; nid > lim; nid--) {
-                if (fDownward == 0 && vDist[nid][nid1] <= 0 && vDist[nid][nid2] <= 0) continue;
-                if (fDownward == 1 && vDist[nid1][nid] <= 0 && vDist[nid2][nid] <= 0) continue;
+                if (fDownward == 0 && Cec_ManDistEntry(vDist, nid, nid1) <= 0 && Cec_ManDistEntry(vDist, nid, nid2) <= 0) continue;
+                if (fDownward == 1 && Cec_ManDistEntry(vDist, nid1, nid) <= 0 && Cec_ManDistEntry(vDist, nid2, nid) <= 0) continue;
                 
-                distF = fDownward ? 1.0 * vDist[nid1][nid] : 1.0 * vDist[nid][nid1];
-                distG = fDownward ? 1.0 * vDist[nid2][nid] : 1.0 * vDist[nid][nid2];
-                distLocal = 1.0 * vDist[nid1][nid2];
+                distF = fDownward ? 1.0 * Cec_ManDistEntry(vDist, nid1, nid) : 1.0 * Cec_ManDistEntry(vDist, nid, nid1);
+                distG = fDownward ? 1.0 * Cec_ManDistEntry(vDist, nid2, nid) : 1.0 * Cec_ManDistEntry(vDist, nid, nid2);
+                distLocal = 1.0 * Cec_ManDistEntry(vDist, nid1, nid2);
                 if (debug) {
                     printf("nid = %d, nid1 = %d, nid2 = %d\n", nid, nid1, nid2);
                     printf("distF = %f, distG = %f, distLocal = %f\n", distF, distG, distLocal);
@@ -1139,9 +1189,7 @@ Vec_Flt_t*           Cec_ManRecPathLen( Gia_Man_t* pGia_in, Vec_Int_t* vF, Vec_I
         Vec_FltWriteEntry( vDistGlobal, j, distOpt );
     }
 
-    for (i = 0; i < Gia_ManObjNum(pGia); i++) 
-        ABC_FREE( vDist[i] );
-    ABC_FREE( vDist );
+    Cec_ManDistFree( vDist );
     Gia_ManStop( pGia );
 
     return vDistGlobal;
@@ -1293,6 +1341,7 @@ void  Cec_ManMatch( Gia_Man_t* pGia, Gia_Man_t* pRef ) {
         pObj0 = Gia_ObjFanin0(pObj);
         pObj1 = Gia_ObjFanin1(pObj);
         pObjRef = Gia_ObjCopy( pRef, pObj );
+        if (!Gia_ObjIsAnd(pObjRef)) continue; // matched to a CI or constant
         pObjRef0 = NULL; // NULL is just as a flag
         if (Gia_ObjFaninC0(pObj) != Gia_ObjFaninC1(pObj)) {
             // match by complement
@@ -1416,9 +1465,9 @@ void  Cec_ManMatch( Gia_Man_t* pGia, Gia_Man_t* pRef ) {
             else Vec_IntPush( vIntBuff, Gia_ObjId( pGia, pObj ) );
         }
         Gia_SelfDefShow( pGia, "match_PO.dot", vIntBuff, 0, 0 );
+        Vec_IntFree( vIntBuff );
     }
     
-    Vec_IntFree( vIntBuff );
     Vec_IntFree( vRemain );
     Vec_WecFree( conf );
 
@@ -1635,49 +1684,65 @@ Gia_Man_t*  Cec_ManReplacePatch( Gia_Man_t* pGia, Gia_Man_t* pPatch, Vec_Int_t*
     Gia_ManStop( pGia_forCp );
     return pOut;
 }
-Gia_Man_t*  Cec_ManItp( Gia_Man_t* pGia, int f, Vec_Int_t* vG, int nBTLimit, int coef_check, Vec_Int_t* stat ) {
-    Gia_Man_t* pGia_forCp = Gia_ManDup( pGia );
-    Gia_Man_t *pFdMiter, *pFdPatch, *pTemp;
+// the miter of an FD query: the CIs of pGia and a CO for each node of vG followed by a CO for f (none if f < 0);
+// the Value fields of pGia are overwritten
+Gia_Man_t*  Cec_ManFdQueryMiter( Gia_Man_t* pGia, int f, Vec_Int_t* vG ) {
+    Gia_Man_t* pFdMiter = Gia_ManStart( Gia_ManObjNum(pGia) );
     Gia_Obj_t* pObjbuf;
     Vec_Ptr_t* vNdCone;
-    int i, j, nid, buf;
-    // for coef_check
-    int costOrg, costNew;
-    Vec_Int_t* vMerge = Vec_IntAlloc(100);
-    Vec_Int_t* vF = Vec_IntAlloc(1);
-    Vec_IntPush( vF, f );
-    Vec_Int_t* vFNew = Vec_IntAlloc(1);
-    Vec_Int_t* vGNew = Vec_IntAlloc( Vec_IntSize(vG) );
-    Vec_Int_t* vIntBuff;
-    Gia_Man_t* pNew;
-    pFdMiter = Gia_ManStart( Gia_ManObjNum(pGia_forCp) );
-    Gia_ManFillValue(pGia_forCp);
-    Gia_ManConst0(pGia_forCp)->Value = 0;
-    Gia_ManForEachCi( pGia_forCp, pObjbuf, j ) {
+    int j, nid, buf;
+    Gia_ManFillValue(pGia);
+    Gia_ManConst0(pGia)->Value = 0;
+    Gia_ManForEachCi( pGia, pObjbuf, j ) {
         Gia_ObjSetValue(pObjbuf, Gia_ManAppendCi( pFdMiter ));
     }
-    // printf("label1\n");
     Vec_IntForEachEntry( vG, nid, j ) {
         if (nid == -1) continue;
-        vNdCone = Cec_ManSubcircuit( pGia_forCp, Gia_ManObj(pGia_forCp, nid), 0, 0, 0, 1 );
-        if (Vec_PtrSize(vNdCone) == 0) buf = Gia_ManObj(pGia_forCp, nid)->Value;
+        vNdCone = Cec_ManSubcircuit( pGia, Gia_ManObj(pGia, nid), 0, 0, 0, 1 );
+        if (Vec_PtrSize(vNdCone) == 0) buf = Gia_ManObj(pGia, nid)->Value;
         else buf = Cec_ManPatch( pFdMiter, vNdCone );
         Gia_ManAppendCo( pFdMiter, buf );
         Vec_PtrFree( vNdCone );
     }
-    vNdCone = Cec_ManSubcircuit( pGia_forCp, Gia_ManObj(pGia_forCp, f), 0, 0, 0, 1 );
-    if (Vec_PtrSize(vNdCone) == 0) buf = Gia_ObjValue(Gia_ManObj(pGia_forCp, f)); // assert(0);
+    if (f < 0) return pFdMiter;
+    vNdCone = Cec_ManSubcircuit( pGia, Gia_ManObj(pGia, f), 0, 0, 0, 1 );
+    if (Vec_PtrSize(vNdCone) == 0) buf = Gia_ObjValue(Gia_ManObj(pGia, f)); // assert(0);
     else buf = Cec_ManPatch( pFdMiter, vNdCone );
     Gia_ManAppendCo( pFdMiter, buf );
     Vec_PtrFree( vNdCone );
-    pFdPatch = Int2_ManFdSimp( pFdMiter, nBTLimit, &buf );
+    return pFdMiter;
+}
+// pCnfMan is the CNF manager used by the query (NULL for the global one); the Value fields of pGia are overwritten
+// fTrace selects the engine that replays the proof trace of satoko instead of the interpolation of sat_solver2
+Gia_Man_t*  Cec_ManItpMan( Cnf_Man_t* pCnfMan, int fTrace, Gia_Man_t* pGia, int f, Vec_Int_t* vG, int nBTLimit, int coef_check, Vec_Int_t* stat ) {
+    Gia_Man_t* pGia_forCp = Gia_ManDup( pGia );
+    Gia_Man_t *pFdMiter, *pFdPatch, *pTemp;
+    int buf;
+    // for coef_check
+    int costOrg, costNew;
+    Vec_Int_t* vMerge = Vec_IntAlloc(100);
+    Vec_Int_t* vF = Vec_IntAlloc(1);
+    Vec_IntPush( vF, f );
+    Vec_Int_t* vFNew = Vec_IntAlloc(1);
+    Vec_Int_t* vGNew = Vec_IntAlloc( Vec_IntSize(vG) );
+    Vec_Int_t* vIntBuff;
+    Gia_Man_t* pNew;
+    pFdMiter = Cec_ManFdQueryMiter( pGia_forCp, f, vG );
+    pFdPatch = fTrace ? Int2_ManFdTraceMan( pCnfMan, pFdMiter, nBTLimit, &buf ) : Int2_ManFdSimpMan( pCnfMan, pFdMiter, nBTLimit, &buf );
     // printf("c\n");
     if (stat) {
         Vec_IntPush( stat, buf );
     }
     Gia_ManStop( pFdMiter );
     // printf("d\n");
-    if ( pFdPatch == NULL || pFdPatch == 1 ) return pFdPatch;
+    if ( pFdPatch == NULL || pFdPatch == CEC_FD_PATCH_UNSOLVE ) {
+        Gia_ManStop( pGia_forCp );
+        Vec_IntFree( vMerge );
+        Vec_IntFree( vF );
+        Vec_IntFree( vFNew );
+        Vec_IntFree( vGNew );
+        return pFdPatch;
+    }
      // get mapping
 
     pNew = Cec_ManReplacePatch( pGia_forCp, pFdPatch, vF, vG, 0, 1 );
@@ -1694,19 +1759,47 @@ Gia_Man_t*  Cec_ManItp( Gia_Man_t* pGia, int f, Vec_Int_t* vG, int nBTLimit, int
             vIntBuff = Cec_ManGetMFFCost( pNew, coef_check );
             costNew = Vec_IntFindMax( vIntBuff );
             Vec_IntFree( vIntBuff );
-            if (costNew > costOrg) pFdPatch = 2;
+            if (costNew > costOrg) pFdPatch = CEC_FD_PATCH_HUGE;
             break;
         default:
             break;
     }
     // if (pFdPatch != 2) Cec_ManLoadValue( pFdPatch, vIntBuff );
     Gia_ManStop( pNew );
+    Gia_ManStop( pGia_forCp );
     Vec_IntFree( vMerge );
     Vec_IntFree( vF );
     Vec_IntFree( vFNew );
     Vec_IntFree( vGNew );
     return pFdPatch;
 }
+Gia_Man_t*  Cec_ManItp( Gia_Man_t* pGia, int f, Vec_Int_t* vG, int nBTLimit, int coef_check, Vec_Int_t* stat ) {
+    return Cec_ManItpMan( NULL, 0, pGia, f, vG, nBTLimit, coef_check, stat );
+}
+// same as Cec_ManFdQueryMiter() with the COs of all nodes of vF after G
+Gia_Man_t*  Cec_ManFdQueryMiterMulti( Gia_Man_t* pGia, Vec_Int_t* vF, Vec_Int_t* vG ) {
+    Gia_Man_t* pFdMiter = Cec_ManFdQueryMiter( pGia, -1, vG );
+    Vec_Ptr_t* vNdCone;
+    int j, f, buf;
+    Vec_IntForEachEntry( vF, f, j ) {
+        vNdCone = Cec_ManSubcircuit( pGia, Gia_ManObj(pGia, f), 0, 0, 0, 1 );
+        if (Vec_PtrSize(vNdCone) == 0) buf = Gia_ObjValue(Gia_ManObj(pGia, f));
+        else buf = Cec_ManPatch( pFdMiter, vNdCone );
+        Gia_ManAppendCo( pFdMiter, buf );
+        Vec_PtrFree( vNdCone );
+    }
+    return pFdMiter;
+}
+// the queries of the nodes in vF solved on one CNF, one solver per support; vG is the union of their supports and entry k of vTargetG
+// lists the positions in vG of the support of node k (NULL if all nodes have the support vG); pushes the patch and 
+// the conflicts of each node
+void        Cec_ManItpBatchMan( Cnf_Man_t* pCnfMan, Gia_Man_t* pGia, Vec_Int_t* vF, Vec_Int_t* vG, Vec_Wec_t* vTargetG, int nBTLimit, Vec_Ptr_t* vPatch, Vec_Int_t* vConf ) {
+    Gia_Man_t* pGia_forCp = Gia_ManDup( pGia );
+    Gia_Man_t* pFdMiter = Cec_ManFdQueryMiterMulti( pGia_forCp, vF, vG );
+    Int2_ManFdBatchMan( pCnfMan, pFdMiter, Vec_IntSize(vF), vTargetG, nBTLimit, vPatch, vConf );
+    Gia_ManStop( pFdMiter );
+    Gia_ManStop( pGia_forCp );
+}
 int         Cec_ManCompPatch( Gia_Man_t* pOpt, Gia_Man_t* pNew, int coef_cost ) {
     // return 1 if pNew is better
     Gia_Obj_t* pObjbuf;
@@ -1828,7 +1921,7 @@ Gia_Man_t*  Cec_ManFuncDepReplace( Gia_Man_t* pGia, Vec_Int_t* vF, Vec_Int_t* vG
             vG_in = Vec_IntDup( vG_all );
             Vec_IntDrop( vG_in, j );
             pItp = Cec_ManItp( pGia, nid, vG_in, nBTLimit, coef_check, 0 );
-            if (pItp == NULL || pItp == 1 || pItp == 2) continue;
+            if (pItp == NULL || pItp == CEC_FD_PATCH_UNSOLVE || pItp == CEC_FD_PATCH_HUGE) continue;
             Vec_IntClear( vIntBuff );
             Vec_IntPush( vIntBuff, nid );
             // printf("label 1\n");
@@ -2329,7 +2422,7 @@ void Cec_ManFdSetLevel_abs( Cec_ManFd_t* pMan, int fCkt ) {
     // int fFI = Cec_ManFdGetLevelType( pMan, 2 );
     int ftype = Cec_ManFdGetLevelType( pMan, 0 );
     int ftype_below = ftype | (1 << CEC_FD_LEVELBITNDMM);
-    int** dict_below = Cec_ManFdGetLevelType( pMan, 1 ) ? pMan->dist_short : pMan->dist_long; // still consider dist defined by user, not short dict
+    Cec_ManDist_t* dict_below = Cec_ManFdGetLevelType( pMan, 1 ) ? pMan->dist_short : pMan->dist_long; // still consider dist defined by user, not short dict
     int nidPO = fCkt == 1 ? Gia_ObjId(pMan->pAbs, pMan->pObjAbs1) : Gia_ObjId(pMan->pAbs, pMan->pObjAbs2);
     int orgnid, nid_buff, int_buff, int_buff2, i, j;
     Vec_Int_t* vPO = Vec_IntStart( 1 );
@@ -2360,7 +2453,7 @@ void Cec_ManFdSetLevel_abs( Cec_ManFd_t* pMan, int fCkt ) {
         if (Vec_IntFind( vFrt, orgnid ) != -1 || int_buff == -1) continue;
         int_buff2 = -1; // pick min of level that have dist as int_buff from nid to nid_buff
         Vec_IntForEachEntry( vFrt, nid_buff, j ) {
-            if (dict_below[nid_buff][orgnid] == int_buff) {
+            if (Cec_ManDistEntry(dict_below, nid_buff, orgnid) == int_buff) {
                 assert(Vec_IntEntry(vLevel, nid_buff) != -1);
                 // printf("orgnid: %d nid_buff: %d int_buff: %d\n", orgnid, nid_buff, int_buff);
                 if (int_buff2 == -1 || Vec_IntEntry(vLevel, nid_buff) < int_buff2)
@@ -2427,9 +2520,9 @@ void Cec_ManFdSetCostTh( Cec_ManFd_t* pMan ) {
     float coef = pMan->pPars->coefPatch;
     float val, dist_buf, dist;
     Vec_Flt_t* vCostTh = pMan->vCostTh;
-    Vec_Int_t* vLevel, *vBuf;
+    Vec_Int_t* vLevel;
     Gia_Obj_t* pObjbuf, *pObjbuf2;
-    int i, j, nid, nidbuf, nidPO, color, cnt, dist_in, dist_out, dist_sup, check;
+    int i, j, nid, nidbuf, nidPO, color, cnt, dist_in, dist_out, dist_sup;
     Vec_FltFill( vCostTh, Vec_FltSize(vCostTh), -1.0 );
     switch (ftype)
     {
@@ -2472,8 +2565,8 @@ void Cec_ManFdSetCostTh( Cec_ManFd_t* pMan ) {
         Gia_ManForEachAnd( pMan->pAbs, pObjbuf, i ) {
             nid = Gia_ObjId(pMan->pAbs, pObjbuf);
             dist = 0.0;
-            for (j = 0; j < Gia_ManObjNum(pMan->pAbs); j++) {
-                if (pMan->dist_long_abs[nid][j] > dist) dist = 1.0 * pMan->dist_long_abs[nid][j];
+            for (j = 0; j < Cec_ManDistRowSize(pMan->dist_long_abs, nid); j++) {
+                if (Cec_ManDistRowDist(pMan->dist_long_abs, nid, j) > dist) dist = 1.0 * Cec_ManDistRowDist(pMan->dist_long_abs, nid, j);
             }
             Vec_FltWriteEntry( vCostTh, Cec_ManFdMapIdSingle(pMan, nid, 0), coef * dist );
         }
@@ -2487,28 +2580,26 @@ void Cec_ManFdSetCostTh( Cec_ManFd_t* pMan ) {
             // printf("nid: %d, pObjbuf2: %d\n", nid, Gia_ObjId(pMan->pGia, pObjbuf2));
             dist = -1.0;
             dist_out = Cec_ManFdGetLevelType(pMan, 1) ? 
-                        pMan->dist_short[nidPO][nid] :
-                        pMan->dist_long[nidPO][nid];
+                        Cec_ManDistEntry(pMan->dist_short, nidPO, nid) :
+                        Cec_ManDistEntry(pMan->dist_long, nidPO, nid);
             if (pMan->pPars->fVerbose) printf("nid: %d\n", nid);
-            Vec_IntForEachEntry( Vec_WecEntry( pMan->vMergeSupport, nid ), check, j ) {
-                if (check) {
-                    nidPO = Cec_ManFdGetPO( pMan, nid, 0, 0 );
-                    dist_in = Cec_ManFdGetLevelType(pMan, 1) ? 
-                        pMan->dist_short[nid][Vec_IntEntry( pMan->vMerge, j )] :
-                        pMan->dist_long[nid][Vec_IntEntry( pMan->vMerge, j )];
-                    dist_sup = Cec_ManFdGetLevelType(pMan, 1) ? 
-                        pMan->dist_short[nidPO][Vec_IntEntry( pMan->vMerge, j )] :
-                        pMan->dist_long[nidPO][Vec_IntEntry( pMan->vMerge, j )];
-                    if (pMan->pPars->fVerbose)
-                        printf("\tnidsup: %d, dist_in: %d, dist_out: %d, dist_sup: %d\n", Vec_IntEntry( pMan->vMerge, j ), dist_in, dist_out, dist_sup);
-                    val = coef * (dist_in + dist_out) + (1.0 - coef) * dist_sup;
-                    if (dist < 0) dist = val;
-                    else {
-                        if (Cec_ManFdGetLevelType(pMan, 3)) { // min
-                            dist = Abc_MinFloat( dist, val ); 
-                        } else { // max
-                            dist = Abc_MaxFloat( dist, val );
-                        }
+            Cec_ManFdForEachMergeSupp( pMan, nid, j ) {
+                nidPO = Cec_ManFdGetPO( pMan, nid, 0, 0 );
+                dist_in = Cec_ManFdGetLevelType(pMan, 1) ? 
+                    Cec_ManDistEntry(pMan->dist_short, nid, Vec_IntEntry( pMan->vMerge, j )) :
+                    Cec_ManDistEntry(pMan->dist_long, nid, Vec_IntEntry( pMan->vMerge, j ));
+                dist_sup = Cec_ManFdGetLevelType(pMan, 1) ? 
+                    Cec_ManDistEntry(pMan->dist_short, nidPO, Vec_IntEntry( pMan->vMerge, j )) :
+                    Cec_ManDistEntry(pMan->dist_long, nidPO, Vec_IntEntry( pMan->vMerge, j ));
+                if (pMan->pPars->fVerbose)
+                    printf("\tnidsup: %d, dist_in: %d, dist_out: %d, dist_sup: %d\n", Vec_IntEntry( pMan->vMerge, j ), dist_in, dist_out, dist_sup);
+                val = coef * (dist_in + dist_out) + (1.0 - coef) * dist_sup;
+                if (dist < 0) dist = val;
+                else {
+                    if (Cec_ManFdGetLevelType(pMan, 3)) { // min
+                        dist = Abc_MinFloat( dist, val ); 
+                    } else { // max
+                        dist = Abc_MaxFloat( dist, val );
                     }
                 }
             }
@@ -2528,30 +2619,28 @@ void Cec_ManFdSetCostTh( Cec_ManFd_t* pMan ) {
                         Vec_IntEntry( pMan->vLevel1, nid ) : 
                         Vec_IntEntry( pMan->vLevel2, nid );
             // dist_out = Cec_ManFdGetLevelType(pMan, 1) ? 
-            //             pMan->dist_short[nidPO][nid] :
-            //             pMan->dist_long[nidPO][nid];
+            //             Cec_ManDistEntry(pMan->dist_short, nidPO, nid) :
+            //             Cec_ManDistEntry(pMan->dist_long, nidPO, nid);
             val = 0.0;
             cnt = 0;
-            Vec_IntForEachEntry( Vec_WecEntry( pMan->vMergeSupport, nid ), check, j ) {
-                if (check) {
-                    nidPO = Cec_ManFdGetPO( pMan, nid, 0, 0 );
-                    dist_in = Cec_ManFdGetLevelType(pMan, 1) ? 
-                        pMan->dist_short[nid][Vec_IntEntry( pMan->vMerge, j )] :
-                        pMan->dist_long[nid][Vec_IntEntry( pMan->vMerge, j )];
-                    dist_sup = Gia_ObjColor( pMan->pGia, nid, 0 ) ? 
-                                Vec_IntEntry( pMan->vLevel2, Vec_IntEntry( pMan->vMerge, j ) ) : 
-                                Vec_IntEntry( pMan->vLevel1, Vec_IntEntry( pMan->vMerge, j ) );
-                    dist_buf = 1.0 * (dist_in + dist_out) * (dist_in + dist_out) + 1.0 * dist_sup * dist_sup;
-                    if (ftype == CEC_FD_COSTTWOPATHRMS) {
-                        val += dist_buf;
-                        cnt += 1;
-                    } else if (ftype == CEC_FD_COSTTWOPATHMAX) {
-                        if (val == 0.0 || dist_buf > val) val = dist_buf;
-                        cnt = 1;
-                    } else if (ftype == CEC_FD_COSTTWOPATHMIN) {
-                        if (val == 0.0 || dist_buf < val) val = dist_buf;
-                        cnt = 1;
-                    }
+            Cec_ManFdForEachMergeSupp( pMan, nid, j ) {
+                nidPO = Cec_ManFdGetPO( pMan, nid, 0, 0 );
+                dist_in = Cec_ManFdGetLevelType(pMan, 1) ? 
+                    Cec_ManDistEntry(pMan->dist_short, nid, Vec_IntEntry( pMan->vMerge, j )) :
+                    Cec_ManDistEntry(pMan->dist_long, nid, Vec_IntEntry( pMan->vMerge, j ));
+                dist_sup = Gia_ObjColor( pMan->pGia, nid, 0 ) ? 
+                            Vec_IntEntry( pMan->vLevel2, Vec_IntEntry( pMan->vMerge, j ) ) : 
+                            Vec_IntEntry( pMan->vLevel1, Vec_IntEntry( pMan->vMerge, j ) );
+                dist_buf = 1.0 * (dist_in + dist_out) * (dist_in + dist_out) + 1.0 * dist_sup * dist_sup;
+                if (ftype == CEC_FD_COSTTWOPATHRMS) {
+                    val += dist_buf;
+                    cnt += 1;
+                } else if (ftype == CEC_FD_COSTTWOPATHMAX) {
+                    if (val == 0.0 || dist_buf > val) val = dist_buf;
+                    cnt = 1;
+                } else if (ftype == CEC_FD_COSTTWOPATHMIN) {
+                    if (val == 0.0 || dist_buf < val) val = dist_buf;
+                    cnt = 1;
                 }
             }
             dist = coef * sqrt( val / cnt );
@@ -2562,8 +2651,7 @@ void Cec_ManFdSetCostTh( Cec_ManFd_t* pMan ) {
     case CEC_FD_COSTCINUM:
         Gia_ManForEachAnd( pMan->pAbs, pObjbuf, i ) {
             nid = Cec_ManFdMapIdSingle( pMan, Gia_ObjId(pMan->pAbs, pObjbuf), 0 );
-            vBuf = Vec_WecEntry( pMan->vMergeSupport, nid );
-            val = 1.0 * Vec_IntSum(vBuf);
+            val = 1.0 * Cec_ManFdMergeSuppNum( pMan, nid );
             Vec_FltWriteEntry( vCostTh, nid, coef * val );
         }
         break;
@@ -2576,23 +2664,21 @@ void Cec_ManFdSetCostTh( Cec_ManFd_t* pMan ) {
             // pObjbuf2 = (Gia_ObjColors( pMan->pGia, nid ) == 1) ? pMan->pObjAbs1 : pMan->pObjAbs2;
             val = 0.0;
             cnt = 0;
-            Vec_IntForEachEntry( Vec_WecEntry( pMan->vMergeSupport, nid ), check, j ) {
-                if (check) {
-                    nidbuf = Vec_IntEntry( pMan->vMerge, j );
-                    dist_sup = Cec_ManFdGetLevelType(pMan, 1) ? 
-                        pMan->dist_short_abs[nidPO][Cec_ManFdMapIdSingle(pMan, nidbuf, 1)] :
-                        pMan->dist_long_abs[nidPO][Cec_ManFdMapIdSingle(pMan, nidbuf, 1)];
-                    dist_buf = 1.0 * dist_sup * dist_sup;
-                    if (ftype == CEC_FD_COSTSUPRMS) {
-                        val += dist_buf;
-                        cnt += 1;
-                    } else if (ftype == CEC_FD_COSTSUPMAX) {
-                        if (val == 0.0 || dist_buf > val) val = dist_buf;
-                        cnt = 1;
-                    } else if (ftype == CEC_FD_COSTSUPMIN) {
-                        if (val == 0.0 || dist_buf < val) val = dist_buf;
-                        cnt = 1;
-                    }
+            Cec_ManFdForEachMergeSupp( pMan, nid, j ) {
+                nidbuf = Vec_IntEntry( pMan->vMerge, j );
+                dist_sup = Cec_ManFdGetLevelType(pMan, 1) ? 
+                    Cec_ManDistEntry(pMan->dist_short_abs, nidPO, Cec_ManFdMapIdSingle(pMan, nidbuf, 1)) :
+                    Cec_ManDistEntry(pMan->dist_long_abs, nidPO, Cec_ManFdMapIdSingle(pMan, nidbuf, 1));
+                dist_buf = 1.0 * dist_sup * dist_sup;
+                if (ftype == CEC_FD_COSTSUPRMS) {
+                    val += dist_buf;
+                    cnt += 1;
+                } else if (ftype == CEC_FD_COSTSUPMAX) {
+                    if (val == 0.0 || dist_buf > val) val = dist_buf;
+                    cnt = 1;
+                } else if (ftype == CEC_FD_COSTSUPMIN) {
+                    if (val == 0.0 || dist_buf < val) val = dist_buf;
+                    cnt = 1;
                 }
             }
             dist = coef * sqrt(val / cnt);
@@ -2603,30 +2689,48 @@ void Cec_ManFdSetCostTh( Cec_ManFd_t* pMan ) {
         break;
     }
 }
+// the merge support of a node is the merge nodes reached without passing another merge node or a CI
+// (the leaves of Cec_ManSubcircuit with vMerge as the boundary), OR-ed from the fanins in one topological pass
+void Cec_ManFdSetMergeSupp( Cec_ManFd_t* pMan ) {
+    Gia_Obj_t* pObj;
+    word* pSupp;
+    int i, nid;
+    pMan->nMergeWords = Abc_MaxInt( 1, Abc_Bit6WordNum(Vec_IntSize(pMan->vMerge)) );
+    pMan->vMergeSupp = Vec_WrdStart( Gia_ManObjNum(pMan->pGia) * pMan->nMergeWords );
+    Gia_ManFillValue( pMan->pGia );
+    Vec_IntForEachEntry( pMan->vMerge, nid, i )
+        Gia_ManObj( pMan->pGia, nid )->Value = i;
+    Gia_ManForEachObj( pMan->pGia, pObj, i ) {
+        pSupp = Cec_ManFdMergeSupp( pMan, i );
+        if ( ~pObj->Value )
+            Abc_TtSetBit( pSupp, pObj->Value );
+        else if ( Gia_ObjIsAnd(pObj) )
+            Abc_TtOr( pSupp, Cec_ManFdMergeSupp(pMan, Gia_ObjFaninId0(pObj, i)), Cec_ManFdMergeSupp(pMan, Gia_ObjFaninId1(pObj, i)), pMan->nMergeWords );
+    }
+    // only the nodes of one circuit keep the support
+    Gia_ManForEachObj( pMan->pGia, pObj, i )
+        if ( !Gia_ObjIsAnd(pObj) || Gia_ObjColors(pMan->pGia, i) == 3 )
+            Abc_TtClear( Cec_ManFdMergeSupp(pMan, i), pMan->nMergeWords );
+    Gia_ManFillValue( pMan->pGia );
+}
 void Cec_ManFdSetGSupportDefaultone( Cec_ManFd_t* pMan, int nid ) {
     Gia_Obj_t* pObjbuff;
-    int nidSupport, i, j, val;
+    int nidSupport, i, j;
     int colorSelf = Gia_ObjColors( pMan->pGia, nid );
     assert( colorSelf == 1 || colorSelf == 2 );
     int gType = pMan->pPars->GType >> 1;
     int maxLevel, minLevel;
-    Vec_Int_t *vIntBuff1, *vIntBuff2;
     Vec_Int_t *vLevel = (colorSelf == 1) ? pMan->vLevel2 : pMan->vLevel1;
     Vec_Int_t *vFdSupportBuff = Vec_WecEntry( pMan->vGSupport, nid );
-    Vec_Int_t *vNdcktSelf = Cec_ManGetColorNd( pMan->pGia, colorSelf );
     Vec_Int_t *vNdcktOth = Cec_ManGetColorNd( pMan->pGia, colorSelf ^ 3);
     Vec_Int_t *vNdcktShare = Cec_ManGetColorNd( pMan->pGia, 4 );
-    Vec_Wec_t *vSupport = pMan->vMergeSupport;
 
     // add merge frontier
-    vIntBuff1 = Vec_WecEntry( vSupport, nid ); // one-hot
     maxLevel = -1;
-    Vec_IntForEachEntry( vIntBuff1, val, j) {
-        if (val) {
-            // TODO deal with merge frontier that might not be in big SAT solver
-            maxLevel = Abc_MaxInt( maxLevel, Vec_IntEntry(vLevel, Vec_IntEntry(pMan->vMerge, j)) );
-            if (pMan->pPars->GType & 1) Vec_IntPush( vFdSupportBuff, Vec_IntEntry(pMan->vMerge, j) );
-        }
+    Cec_ManFdForEachMergeSupp( pMan, nid, j ) {
+        // TODO deal with merge frontier that might not be in big SAT solver
+        maxLevel = Abc_MaxInt( maxLevel, Vec_IntEntry(vLevel, Vec_IntEntry(pMan->vMerge, j)) );
+        if (pMan->pPars->GType & 1) Vec_IntPush( vFdSupportBuff, Vec_IntEntry(pMan->vMerge, j) );
     }
     minLevel = Vec_IntEntry((colorSelf == 1) ? pMan->vLevel1 : pMan->vLevel2, nid);
 
@@ -2642,9 +2746,7 @@ void Cec_ManFdSetGSupportDefaultone( Cec_ManFd_t* pMan, int nid ) {
             if (Vec_IntEntry(vLevel, nidSupport) > minLevel) // lower
                 Vec_IntPush( vFdSupportBuff, nidSupport );
         } else {
-            vIntBuff2 = Vec_WecEntry( vSupport, nidSupport );
-            assert( Vec_IntSize(vIntBuff2) > 0 );
-            if ( Vec_IntSize(vIntBuff2) > 0 && Vec_IntCheckSubset( vIntBuff1, vIntBuff2 ) ) 
+            if ( Cec_ManFdMergeSuppContain( pMan, nid, nidSupport ) ) 
                 Vec_IntPush( vFdSupportBuff, nidSupport );
         }
     }
@@ -2687,6 +2789,8 @@ void Cec_ManFdSetGSupportDefaultone( Cec_ManFd_t* pMan, int nid ) {
             }
         }
     }
+    Vec_IntFree( vNdcktOth );
+    Vec_IntFree( vNdcktShare );
 }
 void Cec_ManFdSetGSupportDefault( Cec_ManFd_t* pMan ) {
     // Gia_Obj_t* pObjbuff;
@@ -2698,7 +2802,6 @@ void Cec_ManFdSetGSupportDefault( Cec_ManFd_t* pMan ) {
     Vec_Int_t *vNdckt2 = Cec_ManGetColorNd( pMan->pGia, 2 );
     // Vec_Int_t *vNdckt3 = Cec_ManGetColorNd( pMan->pGia, 4 );
     // Vec_Int_t *vMerge = pMan->vMerge;
-    // Vec_Wec_t *vSupport = pMan->vMergeSupport;
 
     Vec_IntForEachEntry( vNdckt1, nid, i ) {
         Cec_ManFdSetGSupportDefaultone( pMan, nid );
@@ -2711,33 +2814,324 @@ void Cec_ManFdSetGSupportDefault( Cec_ManFd_t* pMan ) {
     
     
 }
-void Cec_ManFdReadStat( Cec_ManFd_t* pMan, char* pFileName, int fClear ) {
-    assert( pMan->dist_short );
-    Vec_Wec_t * vWecBuff;
-    Vec_Int_t * vIntBuff; 
-    Gia_Obj_t * pObj;
-    int nSize, i, val, iBuffer, stat;
-    FILE * pFile;
-    char *content, *buffer;
+// binary checkpoint of the status: "FDSTAT" + version byte + pad byte + 4-byte hash of pGia,
+// then the varint-encoded sections (see Cec_ManFdDumpStatBin)
+#define CEC_FD_STAT_MAGIC    "FDSTAT"
+#define CEC_FD_STAT_VERSION  2   // 2: the query cache is appended
+
+static inline void Cec_ManFdStatWriteInt( Vec_Str_t * vStr, int x )  { Gia_AigerWriteUnsigned( vStr, ((unsigned)x << 1) ^ (unsigned)(x >> 31) ); }
+// the readers return 0 if the number does not fit into the buffer or into 32 bits
+static inline int  Cec_ManFdStatReadUns( unsigned char ** ppPos, unsigned char * pEnd, unsigned * pX ) {
+    unsigned x = 0, ch;
+    int i;
+    for (i = 0; i < 5 && *ppPos < pEnd; i++) {
+        ch = *(*ppPos)++;
+        x |= (ch & 0x7f) << (7 * i);
+        if ((ch & 0x80) == 0) { *pX = x; return i < 4 || ch < 16; }
+    }
+    return 0;
+}
+static inline int  Cec_ManFdStatReadInt( unsigned char ** ppPos, unsigned char * pEnd, int * pX ) {
+    unsigned x;
+    if (!Cec_ManFdStatReadUns( ppPos, pEnd, &x )) return 0;
+    *pX = (int)(x >> 1) ^ -(int)(x & 1);
+    return 1;
+}
+static inline int  Cec_ManFdStatReadNum( unsigned char ** ppPos, unsigned char * pEnd, int nMax, int * pX ) {
+    unsigned x;
+    if (!Cec_ManFdStatReadUns( ppPos, pEnd, &x ) || x > (unsigned)nMax) return 0;
+    *pX = (int)x;
+    return 1;
+}
 
-    pFile = fopen( pFileName, "r" );
-    if ( pFile == NULL )
-    {
+unsigned Cec_ManFdGiaHash( Gia_Man_t* p ) {
+    Gia_Obj_t* pObj;
+    unsigned Hash = (unsigned)Gia_ManObjNum(p);
+    int i;
+    Gia_ManForEachObj1( p, pObj, i ) {
+        if (Gia_ObjIsAnd(pObj)) {
+            Hash = Hash * 0x9E3779B1 ^ (unsigned)Gia_ObjFaninLit0(pObj, i);
+            Hash = Hash * 0x9E3779B1 ^ (unsigned)Gia_ObjFaninLit1(pObj, i);
+        } else if (Gia_ObjIsCo(pObj))
+            Hash = Hash * 0x9E3779B1 ^ ((unsigned)Gia_ObjFaninLit0(pObj, i) | 0x80000000);
+        else
+            Hash = Hash * 0x9E3779B1 ^ ((unsigned)Gia_ObjCioId(pObj) | 0x40000000);
+    }
+    return Hash;
+}
+// maps the file into memory (read-only, the pages are private); NULL on failure
+char* Cec_ManFdStatMap( char* pFileName, int* pnSize ) {
+    char* pContents;
+#ifndef _WIN32
+    struct stat st;
+    int fd = open( pFileName, O_RDONLY );
+    if ( fd < 0 ) {
+        printf( "Cannot open file \"%s\" for reading.\n", pFileName );
+        return NULL;
+    }
+    if ( fstat( fd, &st ) != 0 || st.st_size == 0 ) {
+        printf( "The input file is empty.\n" );
+        close( fd );
+        return NULL;
+    }
+    *pnSize = (int)st.st_size;
+    pContents = (char*)mmap( NULL, *pnSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if ( pContents == MAP_FAILED ) {
+        printf( "Cannot map file \"%s\" into memory.\n", pFileName );
+        return NULL;
+    }
+#else
+    FILE* pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL ) {
         printf( "Cannot open file \"%s\" for reading.\n", pFileName );
         return NULL;
     }
     fseek( pFile, 0, SEEK_END );
-    nSize = ftell( pFile );
-    // fclose( pFile );
-    if ( nSize == 0 )
-    {
+    *pnSize = ftell( pFile );
+    if ( *pnSize == 0 ) {
         printf( "The input file is empty.\n" );
         fclose( pFile );
         return NULL;
     }
-    rewind(pFile);
-    content = ABC_ALLOC( char, nSize );
-    fread( content, nSize, 1, pFile );
+    rewind( pFile );
+    pContents = ABC_ALLOC( char, *pnSize );
+    fread( pContents, *pnSize, 1, pFile );
+    fclose( pFile );
+#endif
+    return pContents;
+}
+void Cec_ManFdStatUnmap( char* pContents, int nSize ) {
+#ifndef _WIN32
+    munmap( pContents, nSize );
+#else
+    ABC_FREE( pContents );
+#endif
+}
+// checks the patch as written by Gia_AigerWriteIntoMemoryStr() before it is given to the AIGER reader,
+// which assumes a well-formed file: "aig M I 0 O A", O <= 1 output literals, A binary AND nodes, "c"
+static int Cec_ManFdStatCheckAiger( unsigned char * pPos, unsigned char * pEnd ) {
+    unsigned Header[5], uLit, uLit0, uLit1, Delta0, Delta1, i;
+    word Num;
+    int k;
+    if (pEnd - pPos < 4 || strncmp( (char*)pPos, "aig ", 4 )) return 0;
+    pPos += 4;
+    for (k = 0; k < 5 + 1; k++) {
+        // the five numbers of the header and the output literal, if any
+        if (k == 5 && Header[3] == 0) break;
+        if (pPos == pEnd || *pPos < '0' || *pPos > '9') return 0;
+        for (Num = 0; pPos < pEnd && *pPos >= '0' && *pPos <= '9' && Num < (word)GIA_MAX_OBJS; pPos++)
+            Num = 10 * Num + (*pPos - '0');
+        if (Num >= (word)GIA_MAX_OBJS || pPos == pEnd || *pPos++ != (k < 4 ? ' ' : '\n')) return 0;
+        if (k < 5) Header[k] = (unsigned)Num;
+        else if (Num > 2 * (word)Header[0] + 1) return 0;
+    }
+    if (Header[0] >= (unsigned)GIA_MAX_OBJS || Header[0] != Header[1] + Header[4] || Header[2] != 0 || Header[3] > 1) return 0;
+    for (i = 0; i < Header[4]; i++) {
+        uLit = 2 * (Header[1] + 1 + i);
+        if (!Cec_ManFdStatReadUns( &pPos, pEnd, &Delta0 ) || !Cec_ManFdStatReadUns( &pPos, pEnd, &Delta1 )) return 0;
+        if (Delta0 == 0 || Delta0 > uLit) return 0;
+        uLit1 = uLit - Delta0;
+        if (Delta1 > uLit1) return 0;
+        uLit0 = uLit1 - Delta1;
+        if (Abc_Lit2Var(uLit0) == Abc_Lit2Var(uLit1)) return 0;
+    }
+    return pEnd - pPos == 1 && *pPos == 'c';
+}
+// reads one answer: 0/1/2 for SAT/UNSOLVE/HUGE, or 3 + size followed by the AIGER patch (at most one output)
+static int Cec_ManFdStatReadPatch( unsigned char ** ppPos, unsigned char * pEnd, Gia_Man_t ** ppPatch ) {
+    unsigned Code;
+    if (!Cec_ManFdStatReadUns( ppPos, pEnd, &Code )) return 0;
+    if (Code < 3) {
+        *ppPatch = Code == 0 ? NULL : Code == 1 ? CEC_FD_PATCH_UNSOLVE : CEC_FD_PATCH_HUGE;
+        return 1;
+    }
+    if ((word)(Code - 3) > (word)(pEnd - *ppPos)) return 0;
+    if (!Cec_ManFdStatCheckAiger( *ppPos, *ppPos + Code - 3 )) return 0;
+    *ppPatch = Gia_AigerReadFromMemory( (char*)*ppPos, Code - 3, 0, 1, 0 );
+    *ppPos += Code - 3;
+    if (*ppPatch == NULL) return 0;
+    if (Gia_ManCoNum(*ppPatch) > 1) {
+        Gia_ManStop( *ppPatch );
+        return 0;
+    }
+    return 1;
+}
+static void Cec_ManFdStatFreePatches( Vec_Ptr_t * vPatch ) {
+    Gia_Man_t* pPatch;
+    int i;
+    Vec_PtrForEachEntry( Gia_Man_t *, vPatch, pPatch, i )
+        if (pPatch != NULL && pPatch != CEC_FD_PATCH_UNSOLVE && pPatch != CEC_FD_PATCH_HUGE)
+            Gia_ManStop( pPatch );
+    Vec_PtrFree( vPatch );
+}
+// returns 0 if the checkpoint is broken or is for another AIG; a checkpoint of another AIG only adds its query cache;
+// the file is parsed completely before the manager is changed, so a broken checkpoint leaves the manager as it was
+int Cec_ManFdReadStatBin( Cec_ManFd_t* pMan, unsigned char* pContents, int nSize, int fClear ) {
+    unsigned char *pPos = pContents + 12, *pEnd = pContents + nSize;
+    Vec_Int_t *vNodeInit, *vStat, *vConf, *vCacheLimit, *vIntBuff;
+    Vec_Wec_t *vClauses, *vSupp, *vCacheKey;
+    Vec_Ptr_t *vPatch, *vCachePatch;
+    Gia_Man_t *pPatch;
+    unsigned Hash = 0;
+    char *pError = NULL;
+    int i, j, nid, nObjs, iter, nEntries, nLits, lit, stat, conf, fOther, nNodes = 0;
+    if ( nSize < 12 || pContents[6] < 1 || pContents[6] > CEC_FD_STAT_VERSION ) {
+        Abc_Print( -1, "The checkpoint has an unknown version (%d).\n", nSize < 12 ? -1 : pContents[6] );
+        return 0;
+    }
+    for (i = 0; i < 4; i++) Hash |= (unsigned)pContents[8 + i] << (8 * i);
+    if ( !Cec_ManFdStatReadNum( &pPos, pEnd, GIA_MAX_OBJS, &nObjs ) || !Cec_ManFdStatReadNum( &pPos, pEnd, 0x7FFFFFFF, &iter ) ) {
+        Abc_Print( -1, "The checkpoint is truncated in the header.\n" );
+        return 0;
+    }
+    fOther = nObjs != Gia_ManObjNum(pMan->pGia) || Hash != Cec_ManFdGiaHash(pMan->pGia);
+    vNodeInit   = Vec_IntAlloc( 100 );
+    vClauses    = Vec_WecAlloc( 100 );
+    vStat       = Vec_IntAlloc( 100 );
+    vConf       = Vec_IntAlloc( 100 );
+    vSupp       = Vec_WecAlloc( 100 );
+    vPatch      = Vec_PtrAlloc( 100 );
+    vCacheKey   = Vec_WecAlloc( 100 );
+    vCacheLimit = Vec_IntAlloc( 100 );
+    vCachePatch = Vec_PtrAlloc( 100 );
+    // initial merge frontier
+    if ( !Cec_ManFdStatReadNum( &pPos, pEnd, nSize, &nEntries ) )
+        pError = "the merge frontier";
+    for (i = 0; !pError && i < nEntries; i++) {
+        if ( !Cec_ManFdStatReadInt( &pPos, pEnd, &nid ) || nid < 0 || nid >= nObjs )
+            pError = "the merge frontier";
+        else
+            Vec_IntPush( vNodeInit, nid );
+    }
+    // learned clauses
+    if ( !pError && !Cec_ManFdStatReadNum( &pPos, pEnd, nSize, &nEntries ) )
+        pError = "the clauses";
+    for (i = 0; !pError && i < nEntries; i++) {
+        vIntBuff = Vec_WecPushLevel( vClauses );
+        if ( !Cec_ManFdStatReadNum( &pPos, pEnd, nSize, &nLits ) )
+            pError = "the clauses";
+        for (j = 0; !pError && j < nLits; j++) {
+            if ( !Cec_ManFdStatReadInt( &pPos, pEnd, &lit ) )
+                pError = "the clauses";
+            else
+                Vec_IntPush( vIntBuff, lit );
+        }
+    }
+    // status of the nodes (a file may end before this section)
+    for (nid = 0; !pError && nid < nObjs && pPos < pEnd; nid++) {
+        vIntBuff = Vec_WecPushLevel( vSupp );
+        if ( !Cec_ManFdStatReadInt( &pPos, pEnd, &stat ) || !Cec_ManFdStatReadInt( &pPos, pEnd, &conf ) ||
+             !Cec_ManFdStatReadNum( &pPos, pEnd, nSize, &nLits ) ) {
+            pError = "the status";
+            break;
+        }
+        for (j = 0; !pError && j < nLits; j++) {
+            if ( !Cec_ManFdStatReadUns( &pPos, pEnd, (unsigned *)&lit ) || lit < -1 || lit >= nObjs )
+                pError = "the status";
+            else
+                Vec_IntPush( vIntBuff, lit );
+        }
+        if ( !pError && !Cec_ManFdStatReadPatch( &pPos, pEnd, &pPatch ) )
+            pError = "the patches";
+        if ( pError ) break;
+        Vec_IntPush( vStat, stat );
+        Vec_IntPush( vConf, conf );
+        Vec_PtrPush( vPatch, pPatch );
+    }
+    nNodes = Vec_IntSize( vStat );
+    if ( !pError && nNodes > 0 && nNodes != nObjs )
+        pError = "the status";
+    // the query cache
+    if ( !pError && pContents[6] >= 2 && pPos < pEnd ) {
+        if ( !Cec_ManFdStatReadNum( &pPos, pEnd, nSize, &nEntries ) )
+            pError = "the query cache";
+        for (i = 0; !pError && i < nEntries; i++) {
+            vIntBuff = Vec_WecPushLevel( vCacheKey );
+            if ( !Cec_ManFdStatReadNum( &pPos, pEnd, nSize, &nLits ) )
+                pError = "the query cache";
+            for (j = 0; !pError && j < nLits; j++) {
+                if ( !Cec_ManFdStatReadInt( &pPos, pEnd, &lit ) )
+                    pError = "the query cache";
+                else
+                    Vec_IntPush( vIntBuff, lit );
+            }
+            if ( !pError && (!Cec_ManFdStatReadInt( &pPos, pEnd, &stat ) || !Cec_ManFdStatReadPatch( &pPos, pEnd, &pPatch )) )
+                pError = "the query cache";
+            if ( pError ) break;
+            Vec_IntPush( vCacheLimit, stat );
+            Vec_PtrPush( vCachePatch, pPatch );
+        }
+    }
+    if ( pError ) {
+        Abc_Print( -1, "The checkpoint is broken in %s; it is not loaded.\n", pError );
+        fOther = 1;
+        Vec_IntClear( vCacheLimit );
+    } else if ( fOther )
+        Abc_Print( 1, "The checkpoint is for another AIG (%d objects, hash %08x), the current one has %d objects (hash %08x).\n",
+            nObjs, Hash, Gia_ManObjNum(pMan->pGia), Cec_ManFdGiaHash(pMan->pGia) );
+    // commit the status
+    if ( !fOther ) {
+        if (fClear) {
+            Vec_IntClear( pMan->vNodeInit );
+            Vec_WecClear( pMan->vClauses );
+        }
+        Vec_IntAppend( pMan->vNodeInit, vNodeInit );
+        Vec_WecForEachLevel( vClauses, vIntBuff, i )
+            Vec_IntAppend( Vec_WecPushLevel( pMan->vClauses ), vIntBuff );
+        Vec_IntUniqify( pMan->vNodeInit );
+        Cec_ManFdPrepareSolver( pMan );
+        for (nid = 0; nid < nNodes; nid++) {
+            pPatch = (Gia_Man_t*) Vec_PtrEntry( pMan->vVeryStat, nid );
+            if (pPatch != NULL && pPatch != CEC_FD_PATCH_UNSOLVE && pPatch != CEC_FD_PATCH_HUGE) Gia_ManStop( pPatch );
+            Vec_IntWriteEntry( pMan->vStat, nid, Vec_IntEntry(vStat, nid) );
+            Vec_IntWriteEntry( pMan->vConf, nid, Vec_IntEntry(vConf, nid) );
+            Vec_IntClear( Vec_WecEntry(pMan->vGSupport, nid) );
+            Vec_IntAppend( Vec_WecEntry(pMan->vGSupport, nid), Vec_WecEntry(vSupp, nid) );
+            Vec_PtrWriteEntry( pMan->vVeryStat, nid, Vec_PtrEntry(vPatch, nid) );
+        }
+        Vec_PtrClear( vPatch );
+        pMan->iter = iter;
+    }
+    // commit the query cache
+    for (i = 0; pMan->pCache && i < Vec_IntSize(vCacheLimit); i++) {
+        nid = Hsh_VecManAdd( pMan->pCache, Vec_WecEntry(vCacheKey, i) );
+        if (nid == Vec_IntSize(pMan->vCacheLimit)) {
+            Vec_PtrPush( pMan->vCachePatch, NULL );
+            Vec_IntPush( pMan->vCacheLimit, -1 );
+        }
+        if (Vec_IntEntry(vCacheLimit, i) >= 0 && Vec_IntEntry(pMan->vCacheLimit, nid) < 0) {
+            Vec_PtrWriteEntry( pMan->vCachePatch, nid, Vec_PtrEntry(vCachePatch, i) );
+            Vec_IntWriteEntry( pMan->vCacheLimit, nid, Vec_IntEntry(vCacheLimit, i) );
+            Vec_PtrWriteEntry( vCachePatch, i, NULL );
+        }
+    }
+    Vec_IntFree( vNodeInit );
+    Vec_WecFree( vClauses );
+    Vec_IntFree( vStat );
+    Vec_IntFree( vConf );
+    Vec_WecFree( vSupp );
+    Cec_ManFdStatFreePatches( vPatch );
+    Vec_WecFree( vCacheKey );
+    Vec_IntFree( vCacheLimit );
+    Cec_ManFdStatFreePatches( vCachePatch );
+    return !fOther;
+}
+void Cec_ManFdReadStat( Cec_ManFd_t* pMan, char* pFileName, int fClear ) {
+    assert( pMan->dist_short );
+    Vec_Wec_t * vWecBuff;
+    Vec_Int_t * vIntBuff; 
+    Gia_Obj_t * pObj;
+    int nSize, i, val, iBuffer, stat;
+    char *content, *buffer;
+
+    content = Cec_ManFdStatMap( pFileName, &nSize );
+    if ( content == NULL ) return;
+    if ( nSize >= 8 && strncmp( content, CEC_FD_STAT_MAGIC, 6 ) == 0 ) {
+        Cec_ManFdReadStatBin( pMan, (unsigned char *)content, nSize, fClear );
+        Cec_ManFdStatUnmap( content, nSize );
+        return;
+    }
     if (fClear) {
         Vec_IntClear( pMan->vNodeInit );
         Vec_WecClear( pMan->vClauses );
@@ -2789,9 +3183,8 @@ void Cec_ManFdReadStat( Cec_ManFd_t* pMan, char* pFileName, int fClear ) {
         }
     }
 
-    ABC_FREE( content );
+    Cec_ManFdStatUnmap( content, nSize );
     ABC_FREE( buffer );
-    fclose( pFile );
 
     val = Vec_IntFindMin( pMan->vNodeInit );
     Vec_IntRemoveAll( pMan->vNodeInit, 0, -1 );
@@ -2810,10 +3203,84 @@ void Cec_ManFdReadStat( Cec_ManFd_t* pMan, char* pFileName, int fClear ) {
     Cec_ManFdPrepareSolver( pMan );
     
 }
+void Cec_ManFdDumpStatBin( Cec_ManFd_t* pMan, char* pFileName ) {
+    FILE* pFile;
+    Vec_Str_t *vStr, *vAig;
+    Vec_Int_t *vIntBuff;
+    Gia_Man_t *pPatch;
+    unsigned Hash = Cec_ManFdGiaHash( pMan->pGia );
+    int nid, stat, i, j;
+    pFile = fopen( pFileName, "wb" );
+    if ( pFile == NULL ) {
+        printf( "Cannot open file \"%s\" for writing.\n", pFileName );
+        return;
+    }
+    vStr = Vec_StrAlloc( 1 << 16 );
+    Vec_StrPushBuffer( vStr, CEC_FD_STAT_MAGIC, 6 );
+    Vec_StrPush( vStr, CEC_FD_STAT_VERSION );
+    Vec_StrPush( vStr, 0 );
+    for (i = 0; i < 4; i++) Vec_StrPush( vStr, (char)((Hash >> (8 * i)) & 0xFF) );
+    Gia_AigerWriteUnsigned( vStr, Gia_ManObjNum(pMan->pGia) );
+    Gia_AigerWriteUnsigned( vStr, pMan->iter );
+    // initial merge frontier
+    Gia_AigerWriteUnsigned( vStr, Vec_IntSize(pMan->vNodeInit) );
+    Vec_IntForEachEntry( pMan->vNodeInit, nid, i )
+        Cec_ManFdStatWriteInt( vStr, nid );
+    // learned clauses
+    Gia_AigerWriteUnsigned( vStr, Vec_WecSize(pMan->vClauses) );
+    Vec_WecForEachLevel( pMan->vClauses, vIntBuff, i ) {
+        Gia_AigerWriteUnsigned( vStr, Vec_IntSize(vIntBuff) );
+        Vec_IntForEachEntry( vIntBuff, nid, j )
+            Cec_ManFdStatWriteInt( vStr, nid );
+    }
+    // status of the nodes: stat, conf, G support, patch (0/1/2 for the flags, 3 + size for an AIGER patch)
+    Vec_IntForEachEntry( pMan->vStat, stat, nid ) {
+        Cec_ManFdStatWriteInt( vStr, stat );
+        Cec_ManFdStatWriteInt( vStr, Vec_IntEntry(pMan->vConf, nid) );
+        vIntBuff = Vec_WecEntry( pMan->vGSupport, nid );
+        Gia_AigerWriteUnsigned( vStr, Vec_IntSize(vIntBuff) );
+        Vec_IntForEachEntry( vIntBuff, i, j )
+            Gia_AigerWriteUnsigned( vStr, i );
+        pPatch = (Gia_Man_t*) Vec_PtrEntry( pMan->vVeryStat, nid );
+        if (pPatch == NULL || pPatch == CEC_FD_PATCH_UNSOLVE || pPatch == CEC_FD_PATCH_HUGE)
+            Gia_AigerWriteUnsigned( vStr, (unsigned)(ABC_PTRINT_T)pPatch );
+        else {
+            vAig = Gia_AigerWriteIntoMemoryStr( pPatch );
+            Gia_AigerWriteUnsigned( vStr, 3 + Vec_StrSize(vAig) );
+            Vec_StrPushBuffer( vStr, Vec_StrArray(vAig), Vec_StrSize(vAig) );
+            Vec_StrFree( vAig );
+        }
+    }
+    // the query cache: key, conflict limit, answer (as above)
+    Gia_AigerWriteUnsigned( vStr, pMan->pCache ? Hsh_VecSize(pMan->pCache) : 0 );
+    for (i = 0; pMan->pCache && i < Hsh_VecSize(pMan->pCache); i++) {
+        vIntBuff = Hsh_VecReadEntry( pMan->pCache, i );
+        Gia_AigerWriteUnsigned( vStr, Vec_IntSize(vIntBuff) );
+        Vec_IntForEachEntry( vIntBuff, nid, j )
+            Cec_ManFdStatWriteInt( vStr, nid );
+        Cec_ManFdStatWriteInt( vStr, Vec_IntEntry(pMan->vCacheLimit, i) );
+        pPatch = (Gia_Man_t*) Vec_PtrEntry( pMan->vCachePatch, i );
+        if (pPatch == NULL || pPatch == CEC_FD_PATCH_UNSOLVE || pPatch == CEC_FD_PATCH_HUGE)
+            Gia_AigerWriteUnsigned( vStr, (unsigned)(ABC_PTRINT_T)pPatch );
+        else {
+            vAig = Gia_AigerWriteIntoMemoryStr( pPatch );
+            Gia_AigerWriteUnsigned( vStr, 3 + Vec_StrSize(vAig) );
+            Vec_StrPushBuffer( vStr, Vec_StrArray(vAig), Vec_StrSize(vAig) );
+            Vec_StrFree( vAig );
+        }
+    }
+    fwrite( Vec_StrArray(vStr), 1, Vec_StrSize(vStr), pFile );
+    fclose( pFile );
+    Vec_StrFree( vStr );
+}
 void Cec_ManFdDumpStat( Cec_ManFd_t* pMan, char* pFileName ) {
     FILE* pFile;
     Vec_Int_t* vIntBuff;
     int nid, i, j;
+    if (pMan->pPars->fBinStat) {
+        Cec_ManFdDumpStatBin( pMan, pFileName );
+        return;
+    }
     pFile = fopen( pFileName, "w" );
     Vec_IntForEachEntry( pMan->vNodeInit, nid, i ) {
         if (i % 10 == 0) fprintf( pFile, "f ");
@@ -2831,24 +3298,35 @@ void Cec_ManFdDumpStat( Cec_ManFd_t* pMan, char* pFileName ) {
 
 }
 void Cec_ManFdAddClause( Cec_ManFd_t* pMan, sat_solver2* p ) {
-    int i, Cid;
+    int i, k, Cid, fPartA;
     Vec_Int_t* vIntBuff;
     sat_solver2* pSat = p ? p : pMan->pSat;
     int nClause = p ? 0 : pMan->nClauses;
+    // the units are added last, so that no clause is reduced at the top level
+    for (k = 0; k < 2; k++)
     for (i = nClause; i < Vec_WecSize(pMan->vClauses); i++) {
+        if ( (Vec_IntSize(Vec_WecEntry(pMan->vClauses, i)) == 1) != k ) continue;
         vIntBuff = Vec_IntDup(Vec_WecEntry(pMan->vClauses, i));
         // printf("add clause %d\n", i);
         // Vec_IntPrint(vIntBuff);
         Cec_ManFdMapLit( pMan, vIntBuff, 1 );
         // Vec_IntPrint(vIntBuff);
         if( Vec_IntFind( vIntBuff, -1 ) == -1 ) {
-            Cid = sat_solver2_addclause( pSat, Vec_IntArray(vIntBuff), Vec_IntLimit(vIntBuff), -1 );
-            if (Vec_IntFindMax( vIntBuff ) < 2 * (pMan->nVars + 1)) clause2_set_partA( pSat, Cid, 1 );
-            else clause2_set_partA( pSat, Cid, 0 );
+            // implied by the three copies, hence by copy A alone if only copy A is used,
+            // and by copy B with the buffers if copy A is not used; mixed clauses are dropped
+            if (Vec_IntFindMax( vIntBuff ) < 2 * pMan->nVars) fPartA = 1;
+            else if (Vec_IntFindMin( vIntBuff ) >= 2 * pMan->nVars) fPartA = 0;
+            else fPartA = -1;
+            if (fPartA >= 0) {
+                Cid = sat_solver2_addclause( pSat, Vec_IntArray(vIntBuff), Vec_IntLimit(vIntBuff), -1 );
+                clause2_set_partA( pSat, Cid, fPartA );
+            }
         }
             // sat_solver2_addclause( pSat, Vec_IntArray(vIntBuff), Vec_IntLimit(vIntBuff), -1 );
         Vec_IntFree( vIntBuff );
     }
+    // the solver is rolled back here after each query
+    sat_solver2_bookmark_units( pSat );
     if (p == NULL) pMan->nClauses = Vec_WecSize(pMan->vClauses);
 }
 void Cec_ManFdPrepareSolver( Cec_ManFd_t* pMan ) {
@@ -2901,17 +3379,134 @@ void Cec_ManFdPrepareSolver( Cec_ManFd_t* pMan ) {
     pMan->vVeryStat = Vec_PtrStart( Gia_ManObjNum(pMan->pGia) );
     Vec_PtrFill( pMan->vVeryStat, Vec_PtrSize(pMan->vVeryStat), NULL );
     pMan->iter = 1;
+
+    // simulation info (the patterns are kept when pGia is updated)
+    if (pMan->pPars->fSim) Cec_ManFdSimStart( pMan );
+}
+// vNew2Old[i] is the old node of the new node i if the TFI of i is structurally the same in both circuits, otherwise -1
+// vCand[i] is the old node proposed for the new node i (or -1); a CI is accepted if it has the same CI index (fSameCi)
+// or if it is any CI (the CIs of pAbs are the merge points and their index follows the order of vMerge)
+Vec_Int_t* Cec_ManFdMapStruct( Gia_Man_t* pOld, Gia_Man_t* p, Vec_Int_t* vCand, int fSameCi ) {
+    Vec_Int_t* vNew2Old = Vec_IntStartFull( Gia_ManObjNum(p) );
+    Gia_Obj_t *pObj, *pObjOld;
+    int i, iOld, iOld0, iOld1, lit0, lit1;
+    Gia_ManForEachObj( p, pObj, i ) {
+        iOld = Vec_IntEntry( vCand, i );
+        if (iOld < 0 || iOld >= Gia_ManObjNum(pOld)) continue;
+        pObjOld = Gia_ManObj( pOld, iOld );
+        if (Gia_ObjIsConst0(pObj)) {
+            if (iOld == 0) Vec_IntWriteEntry( vNew2Old, i, iOld );
+            continue;
+        }
+        if (Gia_ObjIsCi(pObj)) {
+            if (Gia_ObjIsCi(pObjOld) && (!fSameCi || Gia_ObjCioId(pObj) == Gia_ObjCioId(pObjOld))) Vec_IntWriteEntry( vNew2Old, i, iOld );
+            continue;
+        }
+        if (!Gia_ObjIsAnd(pObj) || !Gia_ObjIsAnd(pObjOld)) continue;
+        iOld0 = Vec_IntEntry( vNew2Old, Gia_ObjFaninId0(pObj, i) );
+        iOld1 = Vec_IntEntry( vNew2Old, Gia_ObjFaninId1(pObj, i) );
+        if (iOld0 < 0 || iOld1 < 0) continue;
+        lit0 = Abc_Var2Lit( iOld0, Gia_ObjFaninC0(pObj) );
+        lit1 = Abc_Var2Lit( iOld1, Gia_ObjFaninC1(pObj) );
+        if ((lit0 == Gia_ObjFaninLit0(pObjOld, iOld) && lit1 == Gia_ObjFaninLit1(pObjOld, iOld)) ||
+            (lit0 == Gia_ObjFaninLit1(pObjOld, iOld) && lit1 == Gia_ObjFaninLit0(pObjOld, iOld)))
+            Vec_IntWriteEntry( vNew2Old, i, iOld );
+    }
+    return vNew2Old;
+}
+// the Value of a new node is the literal of the old node it comes from (Cec_ManMatch)
+Vec_Int_t* Cec_ManFdMapUnchanged( Gia_Man_t* pOld, Gia_Man_t* p ) {
+    Vec_Int_t *vCand = Vec_IntStartFull( Gia_ManObjNum(p) ), *vNew2Old;
+    Gia_Obj_t *pObj;
+    int i;
+    Gia_ManForEachObj( p, pObj, i )
+        if (Gia_ObjValue(pObj) >= 0 && !Abc_LitIsCompl(pObj->Value))
+            Vec_IntWriteEntry( vCand, i, Abc_Lit2Var(pObj->Value) );
+    vNew2Old = Cec_ManFdMapStruct( pOld, p, vCand, 1 );
+    Vec_IntFree( vCand );
+    return vNew2Old;
+}
+// the same map for the abstractions: a node of pAbs is proposed the old abstraction node of the pGia node it comes from
+// (the CIs of pAbs are the merge points in the order of vMerge, the other nodes are found by vGiaMap)
+Vec_Int_t* Cec_ManFdMapUnchangedAbs( Cec_ManFd_t* pMan, Gia_Man_t* pAbsOld, Vec_Int_t* vAbsMapOld, Vec_Int_t* vMergeOld, Vec_Int_t* vNew2Old ) {
+    Vec_Int_t *vCand = Vec_IntStartFull( Gia_ManObjNum(pMan->pAbs) ), *vAbsNew2Old, *vMergePos;
+    int i, nid, nidOld;
+    Vec_IntForEachEntry( pMan->vGiaMap, nid, i ) {
+        if (nid < 0 || (nidOld = Vec_IntEntry(vNew2Old, nid)) < 0 || nidOld >= Vec_IntSize(vAbsMapOld)) continue;
+        Vec_IntWriteEntry( vCand, i, Vec_IntEntry(vAbsMapOld, nidOld) );
+    }
+    vMergePos = Vec_IntInvert( vMergeOld, -1 );
+    Vec_IntForEachEntry( pMan->vMerge, nid, i ) {
+        if ((nidOld = Vec_IntEntry(vNew2Old, nid)) < 0 || nidOld >= Vec_IntSize(vMergePos) || Vec_IntEntry(vMergePos, nidOld) < 0) continue;
+        Vec_IntWriteEntry( vCand, Gia_ManCiIdToId(pMan->pAbs, i), Gia_ManCiIdToId(pAbsOld, Vec_IntEntry(vMergePos, nidOld)) );
+    }
+    Vec_IntFree( vMergePos );
+    vAbsNew2Old = Cec_ManFdMapStruct( pAbsOld, pMan->pAbs, vCand, 0 );
+    Vec_IntFree( vCand );
+    return vAbsNew2Old;
 }
+// moves the results of the unchanged nodes to the status of the new circuit
+// UNSAT is kept if its support is unchanged, SAT/UNSOLVE only if the G candidates are the same
+// (with fAbsItp, SAT depends on the abstraction, which may change, so only UNSAT is kept)
+int Cec_ManFdKeepStat( Cec_ManFd_t* pMan, Vec_Int_t* vNew2Old, Vec_Int_t* vStatOld, Vec_Ptr_t* vVeryStatOld, Vec_Int_t* vConfOld, Vec_Wec_t* vGSupportOld ) {
+    Vec_Int_t *vSup, *vSupOld, *vSupNew, *vOld2New;
+    Gia_Man_t *patch;
+    int nid, nidOld, stat, statOld, g, k, nKept = 0;
+    vOld2New = Vec_IntInvert( vNew2Old, -1 );
+    Vec_IntFillExtra( vOld2New, Vec_IntSize(vStatOld), -1 );
+    vSupNew = Vec_IntAlloc( 16 );
+    Vec_IntForEachEntry( vNew2Old, nidOld, nid ) {
+        if (nidOld < 0 || nidOld >= Vec_IntSize(vStatOld)) continue;
+        stat = Vec_IntEntry( pMan->vStat, nid );
+        if (stat != CEC_FD_UNKNOWN && stat != CEC_FD_TRIVIAL) continue;
+        statOld = Vec_IntEntry( vStatOld, nidOld );
+        if (statOld <= 0 && (pMan->pPars->fAbsItp || (statOld != CEC_FD_SAT && statOld != CEC_FD_UNSOLVE))) continue;
+        // rename the old support
+        vSupOld = Vec_WecEntry( vGSupportOld, nidOld );
+        Vec_IntClear( vSupNew );
+        Vec_IntForEachEntry( vSupOld, g, k ) {
+            if (Vec_IntEntry(vOld2New, g) < 0) break;
+            Vec_IntPush( vSupNew, Vec_IntEntry(vOld2New, g) );
+        }
+        if (Vec_IntSize(vSupNew) != Vec_IntSize(vSupOld)) continue;
+        vSup = Vec_WecEntry( pMan->vGSupport, nid );
+        if (statOld > 0) {
+            patch = Gia_ManDup( (Gia_Man_t*) Vec_PtrEntry(vVeryStatOld, nidOld) );
+            Cec_ManFdUpdateStatForce( pMan, nid, vSupNew, patch, Cec_ManFdRawCost(pMan, nid, vSupNew, patch) );
+        } else {
+            if (!Vec_IntEqual(vSup, vSupNew)) continue;
+            Cec_ManFdUpdateStatForce( pMan, nid, NULL, statOld == CEC_FD_SAT ? NULL : CEC_FD_PATCH_UNSOLVE, -1 );
+        }
+        Vec_IntWriteEntry( pMan->vConf, nid, Vec_IntEntry(vConfOld, nidOld) );
+        nKept++;
+    }
+    Vec_IntFree( vSupNew );
+    Vec_IntFree( vOld2New );
+    return nKept;
+}
+// moves the manager to the updated circuit p; the dist rows of pGia and pAbs, the status (-k) and the learned
+// clauses of the nodes whose TFI is unchanged are reused, the other tables are linear passes and are rebuilt
+// (the merge frontier, its support and the levels depend on the PO side, the solver on the new pAbs)
 void Cec_ManFdUpdate( Cec_ManFd_t* pMan, Gia_Man_t* p ) {
     Gia_Man_t *pTemp, *pTemp2;
     Gia_Obj_t *pObjbuf, *pObjbuf1, *pObjbuf2;
     Vec_Int_t *vIntBuff;
-    int buf, i, j, nid, bnid, bias, flag, neg;
+    Vec_Int_t *vNew2Old = NULL, *vOld2New, *vStatOld = NULL, *vConfOld = NULL;
+    Vec_Int_t *vAbsNew2Old = NULL, *vAbsMapOld = NULL, *vMergeOld = NULL;
+    Vec_Ptr_t *vVeryStatOld = NULL;
+    Vec_Wec_t *vGSupportOld = NULL;
+    Gia_Man_t *pAbsOld = NULL;
+    Cec_ManDist_t *dist_long_old = NULL, *dist_short_old = NULL;
+    Cec_ManDist_t *dist_long_abs_old = NULL, *dist_short_abs_old = NULL;
+    int buf, i, j, nid, bnid, bias, flag, neg, nKept;
     int debug = 0;
+    abctime clk, clkMerge;
 
     assert(p);
 
     if (pMan->pGia != NULL) {
+        // the nodes whose TFI is not touched by the replacement keep their dist rows and status
+        vNew2Old = Cec_ManFdMapUnchanged( pMan->pGia, p );
         Gia_ManFillValue( pMan->pGia );
         
         if (pMan->pPars->fVerbose) printf("GiaMap\n");
@@ -2936,6 +3531,10 @@ void Cec_ManFdUpdate( Cec_ManFd_t* pMan, Gia_Man_t* p ) {
         // printf("start to update the clauses\n");
         // printf("Giasize: %d -> %d\n", Gia_ManObjNum(pMan->pGia), Gia_ManObjNum(p));
         // Vec_WecPrint( pMan->vClauses, 0 );
+        // a learned clause is kept only if the TFI of each of its nodes is unchanged; the nodes matched
+        // by Cec_ManMatch from the POs may have another function, and the clause is not implied there
+        vOld2New = Vec_IntInvert( vNew2Old, -1 );
+        Vec_IntFillExtra( vOld2New, Gia_ManObjNum(pMan->pGia), -1 );
         Vec_WecForEachLevel( pMan->vClauses, vIntBuff, i ) {
             flag = 0;
             Vec_IntForEachEntry( vIntBuff, buf, j ) {
@@ -2943,8 +3542,8 @@ void Cec_ManFdUpdate( Cec_ManFd_t* pMan, Gia_Man_t* p ) {
                 bnid = abs(buf);
                 nid = bnid % Gia_ManObjNum(pMan->pGia);
                 bias = bnid / Gia_ManObjNum(pMan->pGia);
-                if (Gia_ObjValue(Gia_ManObj(pMan->pGia, nid)) >= 0) {
-                    nid = Gia_ObjId( p, Gia_ObjCopy(p, Gia_ManObj(pMan->pGia, nid)));
+                if (Vec_IntEntry(vOld2New, nid) >= 0) {
+                    nid = Vec_IntEntry( vOld2New, nid );
                     bnid = bias * Gia_ManObjNum(p) + nid;
                     Vec_IntWriteEntry( vIntBuff, j, neg * bnid );
                 } else {
@@ -2956,9 +3555,23 @@ void Cec_ManFdUpdate( Cec_ManFd_t* pMan, Gia_Man_t* p ) {
                 Vec_IntClear( vIntBuff );
             }
         }
-        Vec_WecPrint( pMan->vClauses, 0 );
+        Vec_IntFree( vOld2New );
+        if (pMan->pPars->fVerbose) Vec_WecPrint( pMan->vClauses, 0 );
 
         Vec_WecKeepLevels( pMan->vClauses, 0 );
+        dist_long_old = pMan->dist_long;     pMan->dist_long = NULL;
+        dist_short_old = pMan->dist_short;   pMan->dist_short = NULL;
+        dist_long_abs_old = pMan->dist_long_abs;    pMan->dist_long_abs = NULL;
+        dist_short_abs_old = pMan->dist_short_abs;  pMan->dist_short_abs = NULL;
+        pAbsOld = pMan->pAbs;                pMan->pAbs = NULL;
+        vAbsMapOld = pMan->vAbsMap;          pMan->vAbsMap = NULL;
+        vMergeOld = pMan->vMerge;            pMan->vMerge = NULL;
+        if (pMan->pPars->fKeepStat) {
+            vStatOld = pMan->vStat;          pMan->vStat = NULL;
+            vConfOld = pMan->vConf;          pMan->vConf = NULL;
+            vVeryStatOld = pMan->vVeryStat;  pMan->vVeryStat = NULL;
+            vGSupportOld = pMan->vGSupport;  pMan->vGSupport = NULL;
+        }
         Cec_ManFdStop( pMan, 1 );
         // write the status back (vClause, vVarMap, vNodeInit)
     } else {
@@ -2997,11 +3610,17 @@ void Cec_ManFdUpdate( Cec_ManFd_t* pMan, Gia_Man_t* p ) {
     }
 
     // dist
-    pMan->dist_long = Cec_ManDist( pMan->pGia, 1 );
-    pMan->dist_short = Cec_ManDist( pMan->pGia, 0 );
+    clk = Abc_Clock();
+    pMan->dist_long = Cec_ManDistUpdate( pMan->pGia, 1, dist_long_old, vNew2Old );
+    pMan->dist_short = Cec_ManDistUpdate( pMan->pGia, 0, dist_short_old, vNew2Old );
+    Cec_ManDistFree( dist_long_old );
+    Cec_ManDistFree( dist_short_old );
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_DIST, Abc_Clock() - clk, 0 );
     if (debug) printf("2\n");
+    clk = Abc_Clock();
     pMan->vMerge = Vec_IntAlloc(1);
     Cec_ManGetMerge_old( pMan->pGia, pMan->pObj1, pMan->pObj2, pMan->vMerge );
+    clkMerge = Abc_Clock() - clk;
     if (pMan->vNodeInit == NULL) { // vNodeInit contain all nodes not shared, might contain frt if GType & 1
         if (pMan->pPars->GType & 1) pMan->vNodeInit = Vec_IntDup( pMan->vMerge );
         else pMan->vNodeInit = Vec_IntAlloc(1);
@@ -3017,6 +3636,7 @@ void Cec_ManFdUpdate( Cec_ManFd_t* pMan, Gia_Man_t* p ) {
     if (debug) printf("4\n");
 
     // pAbs
+    clk = Abc_Clock();
     pMan->pAbs = Cec_ManGetAbs( pMan->pGia, pMan->pObj1, pMan->pObj2, pMan->vMerge, 0 );
     pMan->vAbsMap = Vec_IntAlloc(1);
     Cec_ManGiaMapId( pMan->pGia, pMan->vAbsMap );
@@ -3024,20 +3644,28 @@ void Cec_ManFdUpdate( Cec_ManFd_t* pMan, Gia_Man_t* p ) {
     Vec_IntFillExtra( pMan->vGiaMap, Gia_ManObjNum(pMan->pAbs), -1 );
     pMan->pObjAbs1 = Gia_ObjCopy( pMan->pAbs, pMan->pObj1 );
     pMan->pObjAbs2 = Gia_ObjCopy( pMan->pAbs, pMan->pObj2 );
-    pMan->dist_long_abs = Cec_ManDist( pMan->pAbs, 1 );
-    pMan->dist_short_abs = Cec_ManDist( pMan->pAbs, 0 );
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_ABS, Abc_Clock() - clk, 0 );
+    clk = Abc_Clock();
+    if (pAbsOld != NULL)
+        vAbsNew2Old = Cec_ManFdMapUnchangedAbs( pMan, pAbsOld, vAbsMapOld, vMergeOld, vNew2Old );
+    pMan->dist_long_abs = Cec_ManDistUpdate( pMan->pAbs, 1, dist_long_abs_old, vAbsNew2Old );
+    pMan->dist_short_abs = Cec_ManDistUpdate( pMan->pAbs, 0, dist_short_abs_old, vAbsNew2Old );
+    Cec_ManDistFree( dist_long_abs_old );
+    Cec_ManDistFree( dist_short_abs_old );
+    Vec_IntFreeP( &vAbsNew2Old );
+    Vec_IntFreeP( &vAbsMapOld );
+    Vec_IntFreeP( &vMergeOld );
+    if (pAbsOld != NULL) Gia_ManStop( pAbsOld );
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_DIST, Abc_Clock() - clk, 0 );
+    if (pMan->pPars->fVerbose) 
+        printf("dist memory: gia %.2f MB, abs %.2f MB\n", 
+            (Cec_ManDistMemory(pMan->dist_long) + Cec_ManDistMemory(pMan->dist_short)) / (1 << 20),
+            (Cec_ManDistMemory(pMan->dist_long_abs) + Cec_ManDistMemory(pMan->dist_short_abs)) / (1 << 20) );
     if (debug) printf("5\n");
-    // vMergeSupport
-    pMan->vMergeSupport = Vec_WecStart( Gia_ManObjNum(pMan->pGia) );
-        Gia_ManForEachObj( pMan->pGia, pObjbuf, i ) {
-        if ( Gia_ObjIsAnd(pObjbuf) == 0 ) continue;
-        if ( Gia_ObjColors(pMan->pGia, Gia_ObjId(pMan->pGia,pObjbuf)) == 3 ) continue;
-        Gia_ManFillValue( pMan->pGia );
-        Cec_ManSubcircuit( pMan->pGia, pObjbuf, pMan->vMerge, 0, 1, 0 );
-        Vec_IntForEachEntry( pMan->vMerge, nid, j ) {
-            Vec_WecPush( pMan->vMergeSupport, Gia_ObjId(pMan->pGia, pObjbuf), (Gia_ManObj(pMan->pGia, nid)->Value != -1) );
-        } // change to fMark1
-    }
+    // vMergeSupp
+    clk = Abc_Clock();
+    Cec_ManFdSetMergeSupp( pMan );
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_MERGE, clkMerge + Abc_Clock() - clk, 0 );
     if (debug) printf("6\n");
 
     // vLevel1, vLevel2
@@ -3046,11 +3674,20 @@ void Cec_ManFdUpdate( Cec_ManFd_t* pMan, Gia_Man_t* p ) {
     Cec_ManFdSetLevel( pMan );
     if (debug) printf("7\n");
 
-    // vCuts
-    pMan->vCuts = Gia_ManExploreCuts( pMan->pAbs, 8, -1, 1 );
-
-
     Cec_ManFdPrepareSolver( pMan );
+
+    // status of the unchanged nodes
+    if (vStatOld != NULL) {
+        nKept = Cec_ManFdKeepStat( pMan, vNew2Old, vStatOld, vVeryStatOld, vConfOld, vGSupportOld );
+        if (pMan->pPars->fVerbose) printf("the status of %d nodes is kept after update\n", nKept);
+        Vec_PtrForEachEntry( Gia_Man_t *, vVeryStatOld, pTemp, i )
+            if (pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) Gia_ManStop( pTemp );
+        Vec_PtrFree( vVeryStatOld );
+        Vec_IntFree( vStatOld );
+        Vec_IntFree( vConfOld );
+        Vec_WecFree( vGSupportOld );
+    }
+    Vec_IntFreeP( &vNew2Old );
 }
 Cec_ManFd_t* Cec_ManFdStart( Gia_Man_t* p, Cec_ParFd_t* pPars, char* pFileName ) {
     Vec_Int_t *vIntBuff;
@@ -3059,7 +3696,25 @@ Cec_ManFd_t* Cec_ManFdStart( Gia_Man_t* p, Cec_ParFd_t* pPars, char* pFileName )
     Cec_ManFd_t* pMan = ABC_ALLOC( Cec_ManFd_t, 1 );
     pMan->pGia = NULL;
     pMan->pSat = NULL;
-    
+    pMan->clkInc = pMan->clkItp = 0;
+    pMan->nBench = 0;
+    pMan->vSimsPi = pMan->vSims = NULL;
+    pMan->nSimWords = pMan->nSimPats = 0;
+    pMan->nSimQueries = pMan->nSimRefuted = 0;
+    pMan->pCache = NULL;
+    pMan->vCachePatch = NULL;
+    pMan->vCacheLimit = pMan->vCacheKey = pMan->vCacheHash = pMan->vCacheLocal = NULL;
+    pMan->nCacheQueries = pMan->nCacheHits = 0;
+    if (pPars->fCache) Cec_ManFdCacheStart( pMan );
+    pMan->clkStart = Abc_Clock();
+    memset( pMan->clkProf, 0, sizeof(pMan->clkProf) );
+    memset( pMan->nProfCalls, 0, sizeof(pMan->nProfCalls) );
+    memset( pMan->nProfConfs, 0, sizeof(pMan->nProfConfs) );
+    memset( pMan->MemProf, 0, sizeof(pMan->MemProf) );
+    pMan->vProfQuery = pPars->pProfile ? Vec_IntAlloc( 1000 ) : NULL;
+    pMan->vProfTime  = pPars->pProfile ? Vec_WrdAlloc( 1000 ) : NULL;
+    pMan->vItpMin    = Vec_WrdStart( 9 );
+    pMan->pCost      = Cec_CostManStart();
 
     Cec_ManFdSetPars( pMan, pPars );
     Cec_ManFdUpdate( pMan, p );
@@ -3079,6 +3734,8 @@ void  Cec_ManFdStop( Cec_ManFd_t* pMan, int fRange ) {
     Gia_Man_t* pTemp;
     int i;
 
+    if (fRange >= 2 && pMan->pPars->pProfile)
+        Cec_ManFdProfWrite( pMan, pMan->pPars->pProfile );
     if (fRange >= 0) {
         sat_solver2_delete( pMan->pSat );
         pMan->pSat = NULL;
@@ -3086,45 +3743,63 @@ void  Cec_ManFdStop( Cec_ManFd_t* pMan, int fRange ) {
         Vec_IntFree( pMan->vVarMap );
         // pMan->nClauses = 0;
         
-        Vec_WecFree( pMan->vGSupport );
+        Vec_WecFreeP( &pMan->vGSupport );
         Vec_FltFree( pMan->vCostTh );
 
-        Vec_IntFree( pMan->vConf );
-        Vec_IntFree( pMan->vStat );
-        Vec_PtrForEachEntry( Gia_Man_t *, pMan->vVeryStat, pTemp, i )
-            if (pTemp != NULL && pTemp != 1 && pTemp != 2) Gia_ManStop( pTemp );
-        Vec_PtrFree( pMan->vVeryStat );
+        // the status is detached (NULL) when it is moved to the updated circuit
+        Vec_IntFreeP( &pMan->vConf );
+        Vec_IntFreeP( &pMan->vStat );
+        if (pMan->vVeryStat != NULL) {
+            Vec_PtrForEachEntry( Gia_Man_t *, pMan->vVeryStat, pTemp, i )
+                if (pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) Gia_ManStop( pTemp );
+            Vec_PtrFreeP( &pMan->vVeryStat );
+        }
+        Vec_WrdFreeP( &pMan->vSims );
         // pMan->iter = 1;   
     }
 
     if (fRange >= 1) {
-        for (i = 0; i < Gia_ManObjNum(pMan->pGia); i++) {
-            ABC_FREE( pMan->dist_long[i] );
-            ABC_FREE( pMan->dist_short[i] );
-        }
-        ABC_FREE( pMan->dist_long );
-        ABC_FREE( pMan->dist_short );
+        Cec_ManDistFree( pMan->dist_long );
+        Cec_ManDistFree( pMan->dist_short );
 
-        Vec_IntFree( pMan->vMerge );
-        Vec_IntFree( pMan->vAbsMap );
+        Vec_IntFreeP( &pMan->vMerge );
+        Vec_IntFreeP( &pMan->vAbsMap );
         Vec_IntFree( pMan->vGiaMap );
-        for (i = 0; i < Gia_ManObjNum(pMan->pAbs); i++) {
-            ABC_FREE( pMan->dist_long_abs[i] );
-            ABC_FREE( pMan->dist_short_abs[i] );
-        }
-        ABC_FREE( pMan->dist_long_abs );
-        ABC_FREE( pMan->dist_short_abs );
-        Vec_WecFree( pMan->vMergeSupport );
+        Cec_ManDistFree( pMan->dist_long_abs );
+        Cec_ManDistFree( pMan->dist_short_abs );
+        Vec_WrdFree( pMan->vMergeSupp );
         Vec_IntFree( pMan->vLevel1 );
         Vec_IntFree( pMan->vLevel2 );
-        Vec_WecFree( pMan->vCuts );
 
         // Gia_ManStop( pMan->pGia );
-        Gia_ManStop( pMan->pAbs );
+        // pAbs and its tables are detached (NULL) when they are reused by the updated circuit
+        if (pMan->pAbs != NULL) Gia_ManStop( pMan->pAbs );
         pMan->pGia = NULL;
     }
 
     if (fRange >= 2) {
+        if (pMan->pPars->fBench && pMan->nBench > 0) {
+            printf("bench total for %d nodes:\n", pMan->nBench);
+            Abc_PrintTime( 1, "Incremental  ", pMan->clkInc );
+            Abc_PrintTime( 1, "Interpolation", pMan->clkItp );
+        }
+        if (pMan->pPars->fVerbose && pMan->nSimQueries > 0)
+            printf("simulation: %d of %d queries are SAT with %d patterns\n", pMan->nSimRefuted, pMan->nSimQueries, pMan->nSimPats);
+        if (pMan->pCache && pMan->nCacheQueries > 0)
+            printf("cache: %d of %d queries are hits (%.1f %%), %d keys\n", pMan->nCacheHits, pMan->nCacheQueries,
+                100.0 * pMan->nCacheHits / pMan->nCacheQueries, Hsh_VecSize(pMan->pCache));
+        Cec_ManFdCacheStop( pMan );
+        if (pMan->pPars->fItpMin && pMan->pPars->fVerbose)
+            printf("patch minimization: chain %d -> %d (%.2f sec), sweep %d -> %d (%.2f sec), supp %d -> %d (%.2f sec)\n",
+                (int)Vec_WrdEntry(pMan->vItpMin, 0), (int)Vec_WrdEntry(pMan->vItpMin, 1), 1.0*Vec_WrdEntry(pMan->vItpMin, 2)/CLOCKS_PER_SEC,
+                (int)Vec_WrdEntry(pMan->vItpMin, 3), (int)Vec_WrdEntry(pMan->vItpMin, 4), 1.0*Vec_WrdEntry(pMan->vItpMin, 5)/CLOCKS_PER_SEC,
+                (int)Vec_WrdEntry(pMan->vItpMin, 6), (int)Vec_WrdEntry(pMan->vItpMin, 7), 1.0*Vec_WrdEntry(pMan->vItpMin, 8)/CLOCKS_PER_SEC);
+        Vec_WrdFreeP( &pMan->vItpMin );
+        Cec_CostManStop( pMan->pCost );
+        pMan->pCost = NULL;
+        Vec_IntFreeP( &pMan->vProfQuery );
+        Vec_WrdFreeP( &pMan->vProfTime );
+        Vec_WrdFreeP( &pMan->vSimsPi );
         Vec_IntFree( pMan->vNodeInit );
         Vec_WecFree( pMan->vClauses );
         ABC_FREE( pMan );
@@ -3133,53 +3808,445 @@ void  Cec_ManFdStop( Cec_ManFd_t* pMan, int fRange ) {
 }
 
 
-Gia_Man_t* Cec_ManFdGetFd_Inc( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSupportGlobal ) {
-    Gia_Man_t* pFdMiter, *pFdPatch, *pTemp;
-    sat_solver2* pSat;
+// F is not a function of G if two patterns agree on every node of G but differ on F;
+// the patterns are random at the beginning and the SAT answers of the solver are added to them
+#define CEC_FD_SIM_WORDS        4   // the words of random patterns
+#define CEC_FD_SIM_WORDS_MAX   16   // the max words of patterns, no more counter-examples are kept after that
+void Cec_ManFdSimStart( Cec_ManFd_t* pMan ) {
+    word* pSimsPi;
+    int i, k, w;
+    Vec_WrdFreeP( &pMan->vSims );
+    if (pMan->vSimsPi == NULL || Vec_WrdSize(pMan->vSimsPi) != pMan->nSimWords * Gia_ManCiNum(pMan->pGia)) {
+        Vec_WrdFreeP( &pMan->vSimsPi );
+        pMan->nSimWords = CEC_FD_SIM_WORDS;
+        pMan->nSimPats = 64 * CEC_FD_SIM_WORDS;
+        pMan->vSimsPi = Vec_WrdStart( pMan->nSimWords * Gia_ManCiNum(pMan->pGia) );
+        // the second half repeats the first half with one CI flipped in each pattern
+        Gia_ManRandomW( 1 );
+        for (i = 0; i < Gia_ManCiNum(pMan->pGia); i++) {
+            pSimsPi = Vec_WrdEntryP( pMan->vSimsPi, i * pMan->nSimWords );
+            for (w = 0; w < pMan->nSimWords / 2; w++) 
+                pSimsPi[w + pMan->nSimWords / 2] = pSimsPi[w] = Gia_ManRandomW( 0 );
+            for (k = i; k < 32 * pMan->nSimWords; k += Gia_ManCiNum(pMan->pGia)) 
+                Abc_TtXorBit( pSimsPi, k + 32 * pMan->nSimWords );
+        }
+    }
+    pMan->vSims = Gia_ManSimPatSimOut( pMan->pGia, pMan->vSimsPi, 0 );
+}
+void Cec_ManFdSimWord( Cec_ManFd_t* pMan, int w ) {
+    // simulates one word of the patterns
+    Gia_Man_t* p = pMan->pGia;
+    Gia_Obj_t* pObj;
+    word *pSims = Vec_WrdArray( pMan->vSims ), Sim0, Sim1;
+    int i, nWords = pMan->nSimWords;
+    Gia_ManForEachCi( p, pObj, i ) 
+        pSims[Gia_ObjId(p, pObj) * nWords + w] = Vec_WrdEntry( pMan->vSimsPi, i * nWords + w );
+    Gia_ManForEachAnd( p, pObj, i ) {
+        Sim0 = pSims[Gia_ObjFaninId0(pObj, i) * nWords + w];
+        Sim1 = pSims[Gia_ObjFaninId1(pObj, i) * nWords + w];
+        if (Gia_ObjFaninC0(pObj)) Sim0 = ~Sim0;
+        if (Gia_ObjFaninC1(pObj)) Sim1 = ~Sim1;
+        pSims[i * nWords + w] = Gia_ObjIsXor(pObj) ? Sim0 ^ Sim1 : Sim0 & Sim1;
+    }
+}
+void Cec_ManFdSimAddCex( Cec_ManFd_t* pMan ) {
+    // the last SAT answer of pSat gives two patterns (copy A and copy B) that agree on G and differ on F
+    Gia_Obj_t* pObj;
+    Vec_Wrd_t* vSimsPi;
+    int i, k, w, var;
+    if (pMan->vSims == NULL) return;
+    if (pMan->nSimPats + 2 > 64 * pMan->nSimWords) {
+        if (2 * pMan->nSimWords > CEC_FD_SIM_WORDS_MAX) return;
+        vSimsPi = Vec_WrdStart( 2 * pMan->nSimWords * Gia_ManCiNum(pMan->pGia) );
+        for (i = 0; i < Gia_ManCiNum(pMan->pGia); i++) 
+            memcpy( Vec_WrdEntryP(vSimsPi, 2 * i * pMan->nSimWords), Vec_WrdEntryP(pMan->vSimsPi, i * pMan->nSimWords), sizeof(word) * pMan->nSimWords );
+        Vec_WrdFree( pMan->vSimsPi );
+        pMan->vSimsPi = vSimsPi;
+        pMan->nSimWords *= 2;
+        Vec_WrdFree( pMan->vSims );
+        pMan->vSims = Gia_ManSimPatSimOut( pMan->pGia, pMan->vSimsPi, 0 );
+    }
+    w = pMan->nSimPats / 64; // both patterns are in the same word
+    for (k = 0; k < 2; k++, pMan->nSimPats++) {
+        Gia_ManForEachCi( pMan->pGia, pObj, i ) {
+            var = Cec_ManFdMapVarSingle( pMan, Gia_ObjId(pMan->pGia, pObj), 1 );
+            if (var >= 0 && sat_solver2_var_value( pMan->pSat, var + k * pMan->nVars ))
+                Abc_TtSetBit( Vec_WrdEntryP(pMan->vSimsPi, i * pMan->nSimWords), pMan->nSimPats );
+        }
+    }
+    Cec_ManFdSimWord( pMan, w );
+}
+int Cec_ManFdSimRefute( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport ) {
+    // returns 1 if F is proved not to be a function of G by the patterns
+    Vec_Wrd_t* vKeys;
+    word *pSims, *pF, *pG, Salt, Key;
+    int nWords = pMan->nSimWords, nPats = pMan->nSimPats;
+    int i, k, g, b, e, a, c, fRefuted = 0;
+    if (pMan->vSims == NULL) return 0;
+    assert( nPats <= (1 << 12) );
+    pMan->nSimQueries++;
+    pSims = Vec_WrdArray( pMan->vSims );
+    pF = pSims + nid * nWords;
+    // hash the values of G in each pattern
+    vKeys = Vec_WrdStart( nPats );
+    Vec_IntForEachEntry( vFdSupport, g, i ) {
+        if (g < 0) continue;
+        pG = pSims + g * nWords;
+        Salt = ((word)g + 1) * ABC_CONST(0x9E3779B97F4A7C15);
+        Salt ^= Salt >> 29;
+        for (k = 0; k < nPats; k++)
+            if (Abc_TtGetBit( pG, k )) Vec_WrdArray(vKeys)[k] ^= Salt;
+    }
+    // the key is the hash with the value of F and the pattern index in the lower bits
+    for (k = 0; k < nPats; k++) {
+        Key = Vec_WrdEntry( vKeys, k ) & ~(word)0x1FFF;
+        Vec_WrdWriteEntry( vKeys, k, Key | ((word)Abc_TtGetBit(pF, k) << 12) | (word)k );
+    }
+    Vec_WrdSort( vKeys, 0 );
+    // in a run of the same hash, compare the patterns with F = 0 to those with F = 1
+    for (b = 0; b < nPats && !fRefuted; b = e) {
+        for (e = b + 1; e < nPats && (Vec_WrdEntry(vKeys, e) >> 13) == (Vec_WrdEntry(vKeys, b) >> 13); e++);
+        if (((Vec_WrdEntry(vKeys, b) >> 12) & 1) == ((Vec_WrdEntry(vKeys, e-1) >> 12) & 1)) continue;
+        for (a = b; a < e && !fRefuted && !((Vec_WrdEntry(vKeys, a) >> 12) & 1); a++)
+        for (c = e - 1; c > a && !fRefuted && ((Vec_WrdEntry(vKeys, c) >> 12) & 1); c--) {
+            Vec_IntForEachEntry( vFdSupport, g, i ) {
+                if (g < 0) continue;
+                pG = pSims + g * nWords;
+                if (Abc_TtGetBit( pG, (int)(Vec_WrdEntry(vKeys, a) & 0xFFF) ) != Abc_TtGetBit( pG, (int)(Vec_WrdEntry(vKeys, c) & 0xFFF) )) break;
+            }
+            if (i == Vec_IntSize(vFdSupport)) fRefuted = 1;
+        }
+    }
+    Vec_WrdFree( vKeys );
+    pMan->nSimRefuted += fRefuted;
+    return fRefuted;
+}
+// the profiler of &fdrw: the time, calls and conflicts of each phase are always collected (the clock is cheap
+// compared to the phases), the time of each query is only kept with -Y; both are written at the end of the run
+static char* s_FdProfNames[CEC_FD_PROF_NUM] = { "dist", "merge", "abs", "itp", "syn", "cost", "replace" };
+static double Cec_ManFdProfMemory() {
+#ifndef _WIN32
+    struct rusage ru;
+    getrusage( RUSAGE_SELF, &ru );
+#ifdef __APPLE__
+    return (double)ru.ru_maxrss / (1 << 20); // bytes
+#else
+    return (double)ru.ru_maxrss / (1 << 10); // kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
+void Cec_ManFdProfAdd( Cec_ManFd_t* pMan, int Phase, abctime clk, int nConfs ) {
+    pMan->clkProf[Phase] += clk;
+    pMan->nProfCalls[Phase]++;
+    pMan->nProfConfs[Phase] += nConfs;
+    // the peak only grows, so sampling it is enough for the expensive phases
+    if (Phase != CEC_FD_PROF_COST && Phase != CEC_FD_PROF_ITP)
+        pMan->MemProf[Phase] = Abc_MaxDouble( pMan->MemProf[Phase], Cec_ManFdProfMemory() );
+}
+void Cec_ManFdProfQuery( Cec_ManFd_t* pMan, int nid, int nSupp, Gia_Man_t* pPatch, int nConfs, abctime clk ) {
+    if (pMan->vProfQuery == NULL) return;
+    Vec_IntPush( pMan->vProfQuery, nid );
+    Vec_IntPush( pMan->vProfQuery, nSupp );
+    Vec_IntPush( pMan->vProfQuery, pPatch == NULL ? 0 : (pPatch == CEC_FD_PATCH_UNSOLVE ? 1 : (pPatch == CEC_FD_PATCH_HUGE ? 2 : 3)) );
+    Vec_IntPush( pMan->vProfQuery, nConfs );
+    Vec_WrdPush( pMan->vProfTime, (word)clk );
+}
+void Cec_ManFdProfWrite( Cec_ManFd_t* pMan, char* pFileName ) {
+    static char* pResNames[4] = { "sat", "unsolve", "huge", "unsat" };
+    static char* pMinNames[3] = { "chain", "sweep", "supp" };
+    char Buffer[1000];
+    FILE* pFile;
+    int i, Total = 0;
+    pMan->MemProf[CEC_FD_PROF_ITP] = pMan->MemProf[CEC_FD_PROF_COST] = Cec_ManFdProfMemory();
+    snprintf( Buffer, sizeof(Buffer), "%s.json", pFileName );
+    if ((pFile = fopen( Buffer, "wb" )) == NULL) {
+        printf("Cannot open file \"%s\" for writing the profile.\n", Buffer);
+        return;
+    }
+    fprintf( pFile, "{\n" );
+    fprintf( pFile, "  \"version\": 1,\n" );
+    if (pMan->pGia)
+        fprintf( pFile, "  \"gia\": { \"objs\": %d, \"ands\": %d },\n", Gia_ManObjNum(pMan->pGia), Gia_ManAndNum(pMan->pGia) );
+    fprintf( pFile, "  \"total_sec\": %.6f,\n", 1.0*(Abc_Clock() - pMan->clkStart)/CLOCKS_PER_SEC );
+    // the memory is the peak RSS of the whole process (getrusage), not the memory of this manager
+    fprintf( pFile, "  \"process_peak_rss_mb\": %.2f,\n", Cec_ManFdProfMemory() );
+    fprintf( pFile, "  \"phases\": [\n" );
+    for (i = 0; i < CEC_FD_PROF_NUM; i++)
+        fprintf( pFile, "    { \"name\": \"%s\", \"sec\": %.6f, \"calls\": %d, \"conflicts\": %llu, \"process_peak_rss_mb\": %.2f }%s\n",
+            s_FdProfNames[i], 1.0*pMan->clkProf[i]/CLOCKS_PER_SEC, pMan->nProfCalls[i], (unsigned long long)pMan->nProfConfs[i],
+            pMan->MemProf[i], i == CEC_FD_PROF_NUM-1 ? "" : "," );
+    fprintf( pFile, "  ],\n" );
+    fprintf( pFile, "  \"patch_min\": [\n" );
+    for (i = 0; i < 3; i++)
+        fprintf( pFile, "    { \"stage\": \"%s\", \"ands_before\": %d, \"ands_after\": %d, \"sec\": %.6f }%s\n", pMinNames[i],
+            (int)Vec_WrdEntry(pMan->vItpMin, 3*i), (int)Vec_WrdEntry(pMan->vItpMin, 3*i+1), 1.0*Vec_WrdEntry(pMan->vItpMin, 3*i+2)/CLOCKS_PER_SEC, i == 2 ? "" : "," );
+    fprintf( pFile, "  ],\n" );
+    fprintf( pFile, "  \"sim\": { \"queries\": %d, \"refuted\": %d },\n", pMan->nSimQueries, pMan->nSimRefuted );
+    fprintf( pFile, "  \"cache\": { \"queries\": %d, \"hits\": %d }\n", pMan->nCacheQueries, pMan->nCacheHits );
+    fprintf( pFile, "}\n" );
+    fclose( pFile );
+    snprintf( Buffer, sizeof(Buffer), "%s.csv", pFileName );
+    if ((pFile = fopen( Buffer, "wb" )) == NULL) {
+        printf("Cannot open file \"%s\" for writing the profile.\n", Buffer);
+        return;
+    }
+    fprintf( pFile, "node,support,result,conflicts,sec\n" );
+    for (i = 0; pMan->vProfQuery && 4*i < Vec_IntSize(pMan->vProfQuery); i++, Total++)
+        fprintf( pFile, "%d,%d,%s,%d,%.6f\n", Vec_IntEntry(pMan->vProfQuery, 4*i), Vec_IntEntry(pMan->vProfQuery, 4*i+1),
+            pResNames[Vec_IntEntry(pMan->vProfQuery, 4*i+2)], Vec_IntEntry(pMan->vProfQuery, 4*i+3), 1.0*Vec_WrdEntry(pMan->vProfTime, i)/CLOCKS_PER_SEC );
+    fclose( pFile );
+    printf("The profile is written into \"%s.json\" and \"%s.csv\" (%d queries).\n", pFileName, pFileName, Total);
+}
+// minimizes a patch by Int2_ManMinimize() with the cones of G in pGia as the care set;
+// returns the patch itself if it is not reduced, otherwise a new patch (the old one is not freed)
+Gia_Man_t* Cec_ManFdMinPatch( Cec_ManFd_t* pMan, Vec_Int_t* vFdSupport, Gia_Man_t* pPatch ) {
+    Gia_Man_t *pCare, *pOut = pPatch;
+    Vec_Int_t* vValues;
+    abctime clk = Abc_Clock();
+    if (Gia_ManAndNum(pPatch) == 0) return pPatch;
+    // the care miter overwrites the Value fields of pGia, which are restored
+    vValues = Gia_ManSaveValue( pMan->pGia );
+    pCare = Cec_ManFdQueryMiter( pMan->pGia, -1, vFdSupport );
+    Gia_ManLoadValue( pMan->pGia, vValues );
+    Vec_IntFree( vValues );
+    if (Gia_ManCoNum(pCare) == Gia_ManCiNum(pPatch))
+        pOut = Int2_ManMinimize( pPatch, pCare, pMan->pPars->nBTLimit, pMan->vItpMin );
+    Gia_ManStop( pCare );
+    if (pOut != pPatch && Gia_ManAndNum(pOut) >= Gia_ManAndNum(pPatch)) {
+        Gia_ManStop( pOut );
+        pOut = pPatch;
+    }
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_SYN, Abc_Clock() - clk, 0 );
+    return pOut;
+}
+// the cleanup of the patches and circuits, timed as CEC_FD_PROF_SYN
+Gia_Man_t* Cec_ManFdSimpSyn( Cec_ManFd_t* pMan, Gia_Man_t* pGia, int fSat, int fVerbose, int nRuns ) {
+    abctime clk = Abc_Clock();
+    Gia_Man_t* pOut = Cec_ManSimpSyn( pGia, fSat, fVerbose, nRuns );
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_SYN, Abc_Clock() - clk, 0 );
+    return pOut;
+}
+Gia_Man_t* Cec_ManFdFraigSyn( Cec_ManFd_t* pMan, Gia_Man_t* pGia, int nConflict ) {
+    abctime clk = Abc_Clock();
+    Gia_Man_t* pOut = Cec_ManFraigSyn_naive( pGia, nConflict );
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_SYN, Abc_Clock() - clk, 0 );
+    return pOut;
+}
+// the cache of the queries: the key of a query is its cone (the TFI of F and G) written in a DFS order where
+// the fanin with the smaller structural hash is visited first and the CIs are numbered by the first visit;
+// two queries with the same key are the same up to renaming the CIs, so they have the same answer and patch
+void Cec_ManFdCacheStart( Cec_ManFd_t* pMan ) {
+    pMan->pCache      = Hsh_VecManStart( 1000 );
+    pMan->vCachePatch = Vec_PtrAlloc( 1000 );
+    pMan->vCacheLimit = Vec_IntAlloc( 1000 );
+    pMan->vCacheKey   = Vec_IntAlloc( 1000 );
+    pMan->vCacheHash  = Vec_IntAlloc( 1000 );
+    pMan->vCacheLocal = Vec_IntAlloc( 1000 );
+}
+void Cec_ManFdCacheStop( Cec_ManFd_t* pMan ) {
+    Gia_Man_t* pTemp;
+    int i;
+    if (pMan->pCache == NULL) return;
+    Vec_PtrForEachEntry( Gia_Man_t *, pMan->vCachePatch, pTemp, i )
+        if (pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) Gia_ManStop( pTemp );
+    Vec_PtrFreeP( &pMan->vCachePatch );
+    Vec_IntFreeP( &pMan->vCacheLimit );
+    Vec_IntFreeP( &pMan->vCacheKey );
+    Vec_IntFreeP( &pMan->vCacheHash );
+    Vec_IntFreeP( &pMan->vCacheLocal );
+    Hsh_VecManStop( pMan->pCache );
+    pMan->pCache = NULL;
+}
+unsigned Cec_ManFdCacheHash_rec( Gia_Man_t* p, Gia_Obj_t* pObj, Vec_Int_t* vHash ) {
+    unsigned h0, h1;
+    if (Gia_ObjIsTravIdCurrent( p, pObj )) return (unsigned)Vec_IntEntry( vHash, Gia_ObjId(p, pObj) );
+    Gia_ObjSetTravIdCurrent( p, pObj );
+    if (Gia_ObjIsCi(pObj)) h0 = 0x5BD1E995;
+    else if (Gia_ObjIsConst0(pObj)) h0 = 0x1B873593;
+    else {
+        h0 = Cec_ManFdCacheHash_rec( p, Gia_ObjFanin0(pObj), vHash ) ^ (Gia_ObjFaninC0(pObj) ? 0xA5A5A5A5 : 0);
+        h1 = Cec_ManFdCacheHash_rec( p, Gia_ObjFanin1(pObj), vHash ) ^ (Gia_ObjFaninC1(pObj) ? 0xA5A5A5A5 : 0);
+        if (h0 > h1) ABC_SWAP( unsigned, h0, h1 );
+        h0 = h0 * 0x9E3779B1 + h1;
+        h0 ^= h0 >> 15;
+    }
+    Vec_IntWriteEntry( vHash, Gia_ObjId(p, pObj), (int)h0 );
+    return h0;
+}
+void Cec_ManFdCacheKey_rec( Gia_Man_t* p, Gia_Obj_t* pObj, Vec_Int_t* vHash, Vec_Int_t* vLocal, Vec_Int_t* vKey, int* pnLocal ) {
+    Gia_Obj_t *pFan0, *pFan1;
+    int fCompl0, fCompl1;
+    if (Gia_ObjIsTravIdCurrent( p, pObj )) return;
+    Gia_ObjSetTravIdCurrent( p, pObj );
+    if (Gia_ObjIsCi(pObj)) {
+        Vec_IntPush( vKey, -1 );
+        Vec_IntWriteEntry( vLocal, Gia_ObjId(p, pObj), (*pnLocal)++ );
+        return;
+    }
+    assert( Gia_ObjIsAnd(pObj) );
+    pFan0 = Gia_ObjFanin0(pObj);  fCompl0 = Gia_ObjFaninC0(pObj);
+    pFan1 = Gia_ObjFanin1(pObj);  fCompl1 = Gia_ObjFaninC1(pObj);
+    if ((unsigned)(Vec_IntEntry(vHash, Gia_ObjId(p, pFan1)) ^ (fCompl1 ? 0xA5A5A5A5 : 0)) < (unsigned)(Vec_IntEntry(vHash, Gia_ObjId(p, pFan0)) ^ (fCompl0 ? 0xA5A5A5A5 : 0))) {
+        ABC_SWAP( Gia_Obj_t *, pFan0, pFan1 );
+        ABC_SWAP( int, fCompl0, fCompl1 );
+    }
+    Cec_ManFdCacheKey_rec( p, pFan0, vHash, vLocal, vKey, pnLocal );
+    Cec_ManFdCacheKey_rec( p, pFan1, vHash, vLocal, vKey, pnLocal );
+    Vec_IntPush( vKey, Abc_Var2Lit( Vec_IntEntry(vLocal, Gia_ObjId(p, pFan0)), fCompl0 ) );
+    Vec_IntPush( vKey, Abc_Var2Lit( Vec_IntEntry(vLocal, Gia_ObjId(p, pFan1)), fCompl1 ) );
+    Vec_IntWriteEntry( vLocal, Gia_ObjId(p, pObj), (*pnLocal)++ );
+}
+// returns the entry of the query in the cache (added if new), or -1 if the query is not cached
+int Cec_ManFdCacheFind( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport ) {
+    Gia_Man_t* p = pMan->pGia;
+    int i, g, iEntry, nLocal = 1;
+    if (pMan->pCache == NULL || pMan->pPars->fAbsItp) return -1;
+    if (Vec_IntFindMin( vFdSupport ) < 0) return -1;
+    Vec_IntFillExtra( pMan->vCacheHash, Gia_ManObjNum(p), 0 );
+    Vec_IntFillExtra( pMan->vCacheLocal, Gia_ManObjNum(p), 0 );
+    // structural hash of the cone
+    Gia_ManIncrementTravId( p );
+    Cec_ManFdCacheHash_rec( p, Gia_ManObj(p, nid), pMan->vCacheHash );
+    Vec_IntForEachEntry( vFdSupport, g, i )
+        Cec_ManFdCacheHash_rec( p, Gia_ManObj(p, g), pMan->vCacheHash );
+    // the key: the cone in the canonical order, then F and G
+    Vec_IntClear( pMan->vCacheKey );
+    Gia_ManIncrementTravId( p );
+    Gia_ObjSetTravIdCurrent( p, Gia_ManConst0(p) );
+    Vec_IntWriteEntry( pMan->vCacheLocal, 0, 0 );
+    Cec_ManFdCacheKey_rec( p, Gia_ManObj(p, nid), pMan->vCacheHash, pMan->vCacheLocal, pMan->vCacheKey, &nLocal );
+    Vec_IntForEachEntry( vFdSupport, g, i )
+        Cec_ManFdCacheKey_rec( p, Gia_ManObj(p, g), pMan->vCacheHash, pMan->vCacheLocal, pMan->vCacheKey, &nLocal );
+    Vec_IntPush( pMan->vCacheKey, -2 );
+    Vec_IntPush( pMan->vCacheKey, Vec_IntEntry(pMan->vCacheLocal, nid) );
+    Vec_IntForEachEntry( vFdSupport, g, i )
+        Vec_IntPush( pMan->vCacheKey, Vec_IntEntry(pMan->vCacheLocal, g) );
+    iEntry = Hsh_VecManAdd( pMan->pCache, pMan->vCacheKey );
+    if (iEntry == Vec_IntSize(pMan->vCacheLimit)) {
+        Vec_PtrPush( pMan->vCachePatch, NULL );
+        Vec_IntPush( pMan->vCacheLimit, -1 );
+    }
+    pMan->nCacheQueries++;
+    return iEntry;
+}
+// returns 1 if the entry answers the query with the current conflict limit; the patch is a copy
+int Cec_ManFdCacheGet( Cec_ManFd_t* pMan, int iEntry, Gia_Man_t** ppPatch ) {
+    Gia_Man_t* pPatch = (Gia_Man_t*) Vec_PtrEntry( pMan->vCachePatch, iEntry );
+    int nLimit = Vec_IntEntry( pMan->vCacheLimit, iEntry );
+    if (nLimit < 0) return 0;
+    // UNSOLVE is kept only for the limits that are not larger
+    if (pPatch == CEC_FD_PATCH_UNSOLVE && pMan->pPars->nBTLimit > nLimit) return 0;
+    *ppPatch = (pPatch == NULL || pPatch == CEC_FD_PATCH_UNSOLVE) ? pPatch : Gia_ManDup( pPatch );
+    pMan->nCacheHits++;
+    return 1;
+}
+void Cec_ManFdCacheSet( Cec_ManFd_t* pMan, int iEntry, Gia_Man_t* pPatch, int nConf ) {
+    Gia_Man_t* pOld = (Gia_Man_t*) Vec_PtrEntry( pMan->vCachePatch, iEntry );
+    // the query is not in the solver or is undecided without a single conflict
+    if (pPatch == CEC_FD_PATCH_HUGE || (pPatch == CEC_FD_PATCH_UNSOLVE && nConf == 0)) return;
+    if (pOld != NULL && pOld != CEC_FD_PATCH_UNSOLVE && pOld != CEC_FD_PATCH_HUGE) Gia_ManStop( pOld );
+    Vec_PtrWriteEntry( pMan->vCachePatch, iEntry, (pPatch == NULL || pPatch == CEC_FD_PATCH_UNSOLVE) ? pPatch : Gia_ManDup(pPatch) );
+    Vec_IntWriteEntry( pMan->vCacheLimit, iEntry, pMan->pPars->nBTLimit );
+}
+Gia_Man_t* Cec_ManFdGetFd_Inc( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSupportGlobal, Vec_Int_t* stat ) {
+    Gia_Man_t *pFdPatch;
     abctime clk;
     Vec_Int_t *vFdSupport = vFdSupportGlobal ? Vec_IntDup(vFdSupportGlobal) : Vec_IntDup(Vec_WecEntry(pMan->vGSupport, nidGlobal));
     Vec_Int_t *vIntBuff;
-    int i;
     Vec_Wec_t *vLearnt = Vec_WecAlloc(100);
-    
-    pTemp = pMan->pPars->fAbsItp ? pMan->pAbs : pMan->pGia;
-    pSat = Int2_ManSolver( pTemp, 0 );
-    Cec_ManFdAddClause( pMan, pSat );
-    
-    Cec_ManFdMapVar( pMan, vFdSupport, 1 );
-    Vec_IntRemoveAll( vFdSupport, -1, 0 );
+    int i, nConf = 0;
     int varObj = Cec_ManFdMapVarSingle( pMan, nidGlobal, 1 );
-    assert(varObj != -1);
+
+    Cec_ManFdMapVar( pMan, vFdSupport, 1 );
+    if (varObj == -1 || Vec_IntFind( vFdSupport, -1 ) != -1) { // not in the solver
+        if (stat) Vec_IntPush( stat, 0 );
+        Vec_IntFree( vFdSupport );
+        Vec_WecFree( vLearnt );
+        return CEC_FD_PATCH_UNSOLVE;
+    }
     clk = Abc_Clock();
     // char* patchName = ABC_ALLOC( char, 100 );
     // sprintf(patchName, "patch_%d.dimac", nidGlobal);
     // pMan->pSat->verbosity = 1;
     // Sat_Solver2WriteDimacs( pMan->pSat, patchName, 0, 0, 0 );
-    printf("GiaSize:%d, VarNum:%d\n", Gia_ManObjNum(pMan->pGia), pMan->nVars);
-    printf("learnt clause size (before): %d\n", Vec_WecSize(pMan->vClauses));
-    // Vec_WecPrint( pMan->vClauses, 0 );
-    pFdPatch = Int2_ManFd( pSat, vFdSupport, varObj, pMan->pPars->nBTLimit, 0 );
-    Sat_Solver2Learnts( pSat, vLearnt );
-    // Vec_WecPrint( vLearnt, 0 );
+    pFdPatch = Int2_ManFdInc( pMan->pSat, vFdSupport, varObj, pMan->pPars->nBTLimit, vLearnt, &nConf );
+    if (stat) Vec_IntPush( stat, nConf );
+    if (pFdPatch == NULL && !pMan->pPars->fAbsItp) Cec_ManFdSimAddCex( pMan );
+    // keep the short learned clauses for the next candidates
     Vec_WecForEachLevel( vLearnt, vIntBuff, i ) {
-        // Vec_IntPrint(vIntBuff); 
         Cec_ManFdMapLit( pMan, vIntBuff, 0 );
-        // Vec_IntPrint(vIntBuff);
         Vec_IntAppend( Vec_WecPushLevel( pMan->vClauses ), vIntBuff );
     }
+    Cec_ManFdAddClause( pMan, 0 );
     Vec_WecFree( vLearnt );
-    printf("learnt clause size (after): %d\n", Vec_WecSize(pMan->vClauses));
-    // Vec_WecPrint( pMan->vClauses, 0 );
     
     if (pMan->pPars->fVerbose) {
-        if (pFdPatch != NULL && pFdPatch != 1 && pFdPatch != 2) 
-            Abc_Print(1, "Find a patch for node %d with size %d with G sized %d require %.6f\n", 
+        if (pFdPatch != NULL && pFdPatch != CEC_FD_PATCH_UNSOLVE && pFdPatch != CEC_FD_PATCH_HUGE) 
+            Abc_Print(1, "Find a patch for node %d with size %d and G sized %d require %.6f\n", 
                 nidGlobal, Gia_ManAndNum(pFdPatch), Vec_IntSize(vFdSupport), 1.0*((double)(Abc_Clock() - clk))/((double)((__clock_t) 1000000)));
     }
 
     Vec_IntFree( vFdSupport );
     return pFdPatch;
 }
+static Gia_Man_t* Cec_ManFdSolve_int( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSupportGlobal, Vec_Int_t* stat ) {
+    // runs the selected engine; in the benchmark mode, the other engine is also run and both are timed
+    Gia_Man_t *pFdPatch, *pFdPatch2, *pTemp;
+    Vec_Int_t *vConf;
+    abctime clk, clk2;
+    int fInc = pMan->pPars->fInc, iCache;
+    // the patterns are on pGia, so the queries on pAbs are not checked
+    if (!pMan->pPars->fAbsItp && Cec_ManFdSimRefute( pMan, nidGlobal, vFdSupportGlobal ? vFdSupportGlobal : Vec_WecEntry(pMan->vGSupport, nidGlobal) )) {
+        if (stat) Vec_IntPush( stat, 0 );
+        return NULL;
+    }
+    if (!pMan->pPars->fBench) {
+        iCache = Cec_ManFdCacheFind( pMan, nidGlobal, vFdSupportGlobal ? vFdSupportGlobal : Vec_WecEntry(pMan->vGSupport, nidGlobal) );
+        if (iCache >= 0 && Cec_ManFdCacheGet( pMan, iCache, &pFdPatch )) {
+            if (stat) Vec_IntPush( stat, 0 );
+            return pFdPatch;
+        }
+        vConf = stat ? stat : Vec_IntAlloc( 1 );
+        pFdPatch = fInc ? Cec_ManFdGetFd_Inc( pMan, nidGlobal, vFdSupportGlobal, vConf ) : Cec_ManFdGetFd( pMan, nidGlobal, vFdSupportGlobal, vConf );
+        if (pMan->pPars->fItpMin && pFdPatch != NULL && pFdPatch != CEC_FD_PATCH_UNSOLVE && pFdPatch != CEC_FD_PATCH_HUGE) {
+            pFdPatch = Cec_ManFdMinPatch( pMan, vFdSupportGlobal ? vFdSupportGlobal : Vec_WecEntry(pMan->vGSupport, nidGlobal), pTemp = pFdPatch );
+            if (pFdPatch != pTemp) Gia_ManStop( pTemp );
+        }
+        if (iCache >= 0) Cec_ManFdCacheSet( pMan, iCache, pFdPatch, Vec_IntSize(vConf) > 0 ? Vec_IntEntryLast(vConf) : 0 );
+        if (vConf != stat) Vec_IntFree( vConf );
+        return pFdPatch;
+    }
+    clk = Abc_Clock();
+    pFdPatch = fInc ? Cec_ManFdGetFd_Inc( pMan, nidGlobal, vFdSupportGlobal, stat ) : Cec_ManFdGetFd( pMan, nidGlobal, vFdSupportGlobal, stat );
+    clk = Abc_Clock() - clk;
+    clk2 = Abc_Clock();
+    pFdPatch2 = fInc ? Cec_ManFdGetFd( pMan, nidGlobal, vFdSupportGlobal, 0 ) : Cec_ManFdGetFd_Inc( pMan, nidGlobal, vFdSupportGlobal, 0 );
+    clk2 = Abc_Clock() - clk2;
+    pMan->clkInc += fInc ? clk : clk2;
+    pMan->clkItp += fInc ? clk2 : clk;
+    pMan->nBench++;
+    printf("bench node %6d: |G| = %4d  inc %9.6f sec (%s)  itp %9.6f sec (%s)\n", nidGlobal, 
+        Vec_IntSize(vFdSupportGlobal ? vFdSupportGlobal : Vec_WecEntry(pMan->vGSupport, nidGlobal)),
+        1.0*(fInc ? clk : clk2)/CLOCKS_PER_SEC, Cec_ManFdResultName(fInc ? pFdPatch : pFdPatch2),
+        1.0*(fInc ? clk2 : clk)/CLOCKS_PER_SEC, Cec_ManFdResultName(fInc ? pFdPatch2 : pFdPatch));
+    if (pFdPatch2 != NULL && pFdPatch2 != CEC_FD_PATCH_UNSOLVE && pFdPatch2 != CEC_FD_PATCH_HUGE) Gia_ManStop( pFdPatch2 );
+    return pFdPatch;
+}
+Gia_Man_t* Cec_ManFdSolve( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSupportGlobal, Vec_Int_t* stat ) {
+    Gia_Man_t *pFdPatch;
+    Vec_Int_t *vConf = stat ? stat : Vec_IntAlloc( 1 );
+    int nConfs = Vec_IntSize(vConf);
+    abctime clk = Abc_Clock();
+    pFdPatch = Cec_ManFdSolve_int( pMan, nidGlobal, vFdSupportGlobal, vConf );
+    clk = Abc_Clock() - clk;
+    nConfs = Vec_IntSize(vConf) > nConfs ? Vec_IntEntryLast(vConf) : 0;
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_ITP, clk, nConfs );
+    Cec_ManFdProfQuery( pMan, nidGlobal, Vec_IntSize(vFdSupportGlobal ? vFdSupportGlobal : Vec_WecEntry(pMan->vGSupport, nidGlobal)), pFdPatch, nConfs, clk );
+    if (vConf != stat) Vec_IntFree( vConf );
+    return pFdPatch;
+}
 Gia_Man_t* Cec_ManFdGetFd( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSupportGlobal, Vec_Int_t* stat ) {
     Gia_Man_t *pGia = pMan->pPars->fAbsItp ? pMan->pAbs : pMan->pGia;
     Gia_Man_t *pFdPatch; // * pFdMiter, , *pTemp;
@@ -3193,11 +4260,11 @@ Gia_Man_t* Cec_ManFdGetFd( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSuppo
     abctime clk;
 
     clk = Abc_Clock();
-    pFdPatch = Cec_ManItp( pGia, Gia_ObjId(pGia, pObj), vFdSupport, pMan->pPars->nBTLimit, -1, vIntBuff );
+    pFdPatch = Cec_ManItpMan( NULL, pMan->pPars->fTrace, pGia, Gia_ObjId(pGia, pObj), vFdSupport, pMan->pPars->nBTLimit, -1, vIntBuff );
     if (stat) Vec_IntAppend( stat, vIntBuff );
     // Vec_IntWriteEntry( pMan->vConf, nidGlobal, Vec_IntEntry(vIntBuff, 0) );
     if (pMan->pPars->fVerbose) {
-        if (pFdPatch != NULL && pFdPatch != 1) 
+        if (pFdPatch != NULL && pFdPatch != CEC_FD_PATCH_UNSOLVE) 
             Abc_Print(1, "Find a patch for node %d with size %d and G sized %d require %.6f\n", 
                 nidGlobal, Gia_ManAndNum(pFdPatch), Vec_IntSize(vFdSupport), 1.0*((double)(Abc_Clock() - clk))/((double)((__clock_t) 1000000)));
         // if (Vec_IntSize(vFdSupport) == 1) {
@@ -3217,10 +4284,17 @@ Gia_Man_t* Cec_ManFdGetFd( Cec_ManFd_t* pMan, int nidGlobal, Vec_Int_t* vFdSuppo
 }
 
 float Cec_ManFdRawCost( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_Man_t* patch ) {
+    abctime clk = Abc_Clock();
+    float Cost = Cec_ManFdRawCost_int( pMan, nid, vFdSupport, patch );
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_COST, Abc_Clock() - clk, 0 );
+    return Cost;
+}
+static float Cec_ManFdRawCost_int( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_Man_t* patch ) {
     int fAbs = pMan->pPars->fAbs;
     int fDistAbs;
     int cnt, val, dist_out_sup, dist_out, dist_in, dist_in_org, i, nidPO;
-    int** dist_lib, **dist_lib_org;
+    Cec_ManDist_t* dist_lib_org;
+    Vec_Int_t* vCiDist = NULL;
     int ftype = pMan->pPars->costType;
     float coef = pMan->pPars->coefPatch;
     float dist, dist_buf;
@@ -3229,7 +4303,7 @@ float Cec_ManFdRawCost( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_M
     Gia_Obj_t* pObjbuf;
     Vec_Wec_t* vWecBuff;
 
-    if (patchEval == NULL || patchEval == 1 || patchEval == 2) return -1.0;
+    if (patchEval == NULL || patchEval == CEC_FD_PATCH_UNSOLVE || patchEval == CEC_FD_PATCH_HUGE) return -1.0;
     switch ( ftype ) {
         case CEC_FD_COSTSUPMAX:
         case CEC_FD_COSTSUPRMS:
@@ -3243,13 +4317,14 @@ float Cec_ManFdRawCost( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_M
             fDistAbs = fAbs ? 1 : 0;
             break;
     }
-    if (Cec_ManFdGetLevelType(pMan, 1)) {
-        dist_lib = Cec_ManDist( patchEval, 0 );
+    if (Cec_ManFdGetLevelType(pMan, 1))
         dist_lib_org = fDistAbs ? pMan->dist_short_abs : pMan->dist_short;
-    } else {
-        dist_lib = Cec_ManDist( patchEval, 1 );
+    else
         dist_lib_org = fDistAbs ? pMan->dist_long_abs : pMan->dist_long;
-    }
+    // the path lengths from the CIs of the patch to its CO, only for the costs that use them
+    if (ftype == CEC_FD_COSTTWOPATHOLD || ftype == CEC_FD_COSTTWOPATHRMS || ftype == CEC_FD_COSTTWOPATHMAX || ftype == CEC_FD_COSTTWOPATHMIN ||
+        ftype == CEC_FD_COSTSUPRMS || ftype == CEC_FD_COSTSUPMAX || ftype == CEC_FD_COSTSUPMIN)
+        vCiDist = Cec_CostCiDist( pMan->pCost, patchEval, !Cec_ManFdGetLevelType(pMan, 1) );
     switch ( ftype ) {
         case CEC_FD_COSTDUMMY:
             dist = 0.0;
@@ -3266,16 +4341,16 @@ float Cec_ManFdRawCost( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_M
             
             if (pMan->pPars->fVerbose) printf("cost of %d: \n", nid);
             if (Gia_ManCoDriverId(patchEval,0) == 0) { // constant 0
-                dist = dist_lib_org[Cec_ManFdGetPO(pMan, nid, 0, 1)][nid];
+                dist = Cec_ManDistEntry(dist_lib_org, Cec_ManFdGetPO(pMan, nid, 0, 1), nid);
                 dist *= coef;
             }
             else {
                 Vec_IntForEachEntry( vFdSupportEval, val, i ) {
                     
-                    dist_in = dist_lib[Gia_ManCoDriverId(patchEval,0)][Gia_ManCiIdToId(patchEval, i)];
+                    dist_in = Vec_IntEntry(vCiDist, i);
                     if (dist_in == -1) continue; // 1. if no And between Co and Ci, 2. if the PI doesn't connect to PO
-                    dist_out_sup = dist_lib_org[Cec_ManFdGetPO(pMan, nid, 0, 0)][val];
-                    dist_out = dist_lib_org[Cec_ManFdGetPO(pMan, nid, 0, 1)][nid];
+                    dist_out_sup = Cec_ManDistEntry(dist_lib_org, Cec_ManFdGetPO(pMan, nid, 0, 0), val);
+                    dist_out = Cec_ManDistEntry(dist_lib_org, Cec_ManFdGetPO(pMan, nid, 0, 1), nid);
                     dist_buf = (dist_out_sup == -1) ? 
                                 1.0 * (dist_out + dist_in) : 
                                 coef * (dist_in + dist_out) + (1.0 - coef) * dist_out_sup;
@@ -3301,15 +4376,15 @@ float Cec_ManFdRawCost( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_M
             dist = 0.0;
             cnt = 0;
             if (Gia_ManCoDriverId(patchEval,0) == 0) { // constant 0
-                dist = dist_lib_org[Cec_ManFdGetPO(pMan, nid, 0, 1)][nid];
+                dist = Cec_ManDistEntry(dist_lib_org, Cec_ManFdGetPO(pMan, nid, 0, 1), nid);
             } else {
                 Vec_IntForEachEntry( vFdSupportEval, val, i ) {
-                    dist_in = dist_lib[Gia_ManCoDriverId(patchEval,0)][Gia_ManCiIdToId(patchEval, i)];
+                    dist_in = Vec_IntEntry(vCiDist, i);
                     if (dist_in == -1) continue; // 1. if no And between Co and Ci, 2. if the PI doesn't connect to PO
                     dist_out_sup = Gia_ObjColor(pMan->pGia, nid, 0) ? 
-                                    Vec_IntEntry(pMan->vLevel2, val) : Vec_IntEntry(pMan->vLevel1, val); // dist_lib_org[Cec_ManFdGetPO(pMan, nid, 0, 0)][val];
+                                    Vec_IntEntry(pMan->vLevel2, val) : Vec_IntEntry(pMan->vLevel1, val); // Cec_ManDistEntry(dist_lib_org, Cec_ManFdGetPO(pMan, nid, 0, 0), val);
                     dist_out = Gia_ObjColor(pMan->pGia, nid, 0) ? 
-                                    Vec_IntEntry(pMan->vLevel1, nid) : Vec_IntEntry(pMan->vLevel2, nid); // dist_lib_org[Cec_ManFdGetPO(pMan, nid, 0, 1)][nid];
+                                    Vec_IntEntry(pMan->vLevel1, nid) : Vec_IntEntry(pMan->vLevel2, nid); // Cec_ManDistEntry(dist_lib_org, Cec_ManFdGetPO(pMan, nid, 0, 1), nid);
                     // printf("  %d: out %d, in %d, sup %d\n", val, dist_out, dist_in, dist_out_sup);
                     assert( dist_out_sup >= 0 );
                     dist_buf = 1.0 * (dist_out + dist_in) * (dist_out + dist_in) + 1.0 * (dist_out_sup * dist_out_sup);
@@ -3349,14 +4424,14 @@ float Cec_ManFdRawCost( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_M
             dist = 0.0;
             cnt = 0;
             if (Gia_ManCoDriverId(patchEval,0) == 0) { // constant 0
-                dist = dist_lib_org[Cec_ManFdGetPO(pMan, nid, 1, 1)][Cec_ManFdMapIdSingle(pMan, nid, 1)];
+                dist = Cec_ManDistEntry(dist_lib_org, Cec_ManFdGetPO(pMan, nid, 1, 1), Cec_ManFdMapIdSingle(pMan, nid, 1));
             }
             else {
                 Vec_IntForEachEntry( vFdSupportEval, val, i ) {
-                    dist_in = dist_lib[Gia_ManCoDriverId(patchEval,0)][Gia_ManCiIdToId(patchEval, i)];
+                    dist_in = Vec_IntEntry(vCiDist, i);
                     if (dist_in == -1) continue; // 1. if no And between Co and Ci, 2. if the PI doesn't connect to PO
-                    dist_out_sup = dist_lib_org[Cec_ManFdGetPO(pMan, nid, 1, 1)][Cec_ManFdMapIdSingle(pMan, val, 1)];
-                    dist_out = dist_lib_org[Cec_ManFdGetPO(pMan, nid, 1, 1)][Cec_ManFdMapIdSingle(pMan, nid, 1)];
+                    dist_out_sup = Cec_ManDistEntry(dist_lib_org, Cec_ManFdGetPO(pMan, nid, 1, 1), Cec_ManFdMapIdSingle(pMan, val, 1));
+                    dist_out = Cec_ManDistEntry(dist_lib_org, Cec_ManFdGetPO(pMan, nid, 1, 1), Cec_ManFdMapIdSingle(pMan, nid, 1));
                     dist_buf = dist_out_sup < 0 ? 
                                 1.0 * (dist_out + dist_in) : 
                                 Cec_ManFdGetLevelType(pMan, 3) ? 
@@ -3384,9 +4459,6 @@ float Cec_ManFdRawCost( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_M
             break;
     }
 
-    for (i = 0; i < Gia_ManObjNum(patchEval); i++) 
-        ABC_FREE( dist_lib[i] );
-    ABC_FREE( dist_lib );
     return dist;
 }
 
@@ -3399,7 +4471,7 @@ void Cec_ManFdUpdateStatForce( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport
   assert( Vec_IntEntry(pMan->vStat, nid) != CEC_FD_LOCK && Vec_IntEntry(pMan->vStat, nid) != CEC_FD_IGNORE );
   Gia_Man_t* patchOld = (Gia_Man_t*) Vec_PtrEntry( pMan->vVeryStat, nid );
   if (patch == NULL) Vec_IntWriteEntry(pMan->vStat, nid, CEC_FD_SAT);
-  else if (patch == 1) Vec_IntWriteEntry(pMan->vStat, nid, CEC_FD_UNSOLVE);
+  else if (patch == CEC_FD_PATCH_UNSOLVE) Vec_IntWriteEntry(pMan->vStat, nid, CEC_FD_UNSOLVE);
   else if ((Vec_FltEntry(pMan->vCostTh, nid) >= 0) && (cost > Vec_FltEntry(pMan->vCostTh, nid))) Vec_IntWriteEntry(pMan->vStat, nid, CEC_FD_HUGE);
   /// else if (coef != 0.0 && Gia_ManAndNum(patch) > coef * Gia_ManAndNum(pMan->pAbs)) Vec_IntWriteEntry(pMan->vStat, nid, CEC_FD_HUGE);
   else Vec_IntWriteEntry(pMan->vStat, nid, pMan->iter);
@@ -3412,7 +4484,7 @@ void Cec_ManFdUpdateStatForce( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport
     }
   }
   
-  if (patchOld != NULL && patchOld != 1 && patchOld != 2) Gia_ManStop( patchOld );
+  if (patchOld != NULL && patchOld != CEC_FD_PATCH_UNSOLVE && patchOld != CEC_FD_PATCH_HUGE) Gia_ManStop( patchOld );
   Vec_PtrWriteEntry( pMan->vVeryStat, nid, patch );
   if (pMan->pPars->fVerbose) {
     printf("stat of node %d is updated: %d --> %d\n", nid, preStat, Vec_IntEntry(pMan->vStat, nid) );
@@ -3421,7 +4493,6 @@ void Cec_ManFdUpdateStatForce( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport
   }
 }
 int Cec_ManFdUpdateStat( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_Man_t* patch, int fStrict ) {
-    int entry, i;
     float coef = pMan->pPars->coefPatch;
     int stat = Vec_IntEntry(pMan->vStat, nid);
     int statSup;
@@ -3437,14 +4508,15 @@ int Cec_ManFdUpdateStat( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vFdSupport, Gia_
         return 1;
       }
     }
-    else if (patch == 1) { // UNSOLVE
+    else if (patch == CEC_FD_PATCH_UNSOLVE) { // UNSOLVE
       if (stat == CEC_FD_UNKNOWN || stat == CEC_FD_UNSOLVE) {
         Cec_ManFdUpdateStatForce( pMan, nid, vFdSupport, patch, cost );
         return 1;
       }
     }
     else {
-      if (pMan->pPars->fTrim) patchfin = Cec_ManSimpSyn( patch, 0, pMan->pPars->fVerbose, -1 );
+      // with -q, the patches are already minimized when they are found
+      if (pMan->pPars->fTrim && !pMan->pPars->fItpMin) patchfin = Cec_ManFdSimpSyn( pMan, patch, 0, pMan->pPars->fVerbose, -1 );
       else patchfin = Gia_ManDup( patch );
       cost = Cec_ManFdRawCost( pMan, nid, vFdSupport, patchfin );
       assert(cost >= 0);
@@ -3473,7 +4545,7 @@ void Cec_ManFdCleanOneUnknown( Cec_ManFd_t* pMan, int nid ) {
     && Vec_IntEntry(pMan->vStat, nid) != CEC_FD_HUGE
     && Vec_IntEntry(pMan->vStat, nid) != CEC_FD_UNSOLVE) return;
   if (pMan->pPars->fVerbose) printf("clean unknown nid: %d\n", nid);
-  pTemp = pMan->pPars->fInc ? Cec_ManFdGetFd_Inc( pMan, nid, 0 ) : Cec_ManFdGetFd( pMan, nid, 0, vIntBuff );
+  pTemp = Cec_ManFdSolve( pMan, nid, 0, vIntBuff );
   if (Cec_ManFdUpdateStat( pMan, nid, 0, pTemp, fStrict )) {
     Vec_IntWriteEntry( pMan->vConf, nid, Vec_IntEntry(vIntBuff, 0));
   }
@@ -3482,19 +4554,340 @@ void Cec_ManFdCleanOneUnknown( Cec_ManFd_t* pMan, int nid ) {
       // printf("nid:%d______%s\n", nid, pTemp == NULL ? "SAT" : pTemp == 1 ? "UNSOLVE" : "UNSAT");
       // Abc_PrintTime(-1, "Time: ", Abc_Clock() - clk);
       Abc_Print(1, "Time: %9.6f sec\n", 1.0*((double)(Abc_Clock() - clk))/((double)((__clock_t) 1000000)));
-      if (pTemp != NULL && pTemp != 1 && pTemp != 2) printf("patch size = %d\n", Gia_ManAndNum(pTemp)); //Gia_ManPrintStats(pTemp, 0);
+      if (pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) printf("patch size = %d\n", Gia_ManAndNum(pTemp)); //Gia_ManPrintStats(pTemp, 0);
   }
-  if (pTemp != NULL && pTemp != 1 && pTemp != 2) Gia_ManStop( pTemp );
+  if (pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) Gia_ManStop( pTemp );
   Vec_IntFree( vIntBuff );
 }
 void Cec_ManFdCleanUnknown( Cec_ManFd_t* pMan, int fGetColor ) {
-    int i, nid, stat;
     Vec_Int_t* vCare = Cec_ManGetColorNd( pMan->pGia, fGetColor );
     // Vec_IntPrint(vCare);
-    Vec_IntForEachEntry( vCare, nid, i ) {
-        
-        Cec_ManFdCleanOneUnknown( pMan, nid );
+    Cec_ManFdCleanUnknownBatch( pMan, vCare );
+    Vec_IntFree( vCare );
+}
+// the groups of queries of a batch are given to the shares in turn; every share owns a copy of the circuit and a CNF
+// manager and runs the one-shot interpolation engine on its groups, so the answer of a query depends only on its group
+typedef struct Cec_FdShares_t_ Cec_FdShares_t;
+struct Cec_FdShares_t_
+{
+    Gia_Man_t **     pGias;          // the copy of the circuit owned by each share
+    Cnf_Man_t **     pCnfMans;       // the CNF manager owned by each share
+    Vec_Int_t *      vF;             // the node of each query (shared, read only)
+    Vec_Wec_t *      vG;             // the support of each query (shared, read only)
+    Vec_Wec_t *      vGroup;         // the queries of each group, which have similar supports (shared, read only)
+    Vec_Wec_t *      vUnion;         // the union of the supports of each group (shared, read only)
+    Vec_Ptr_t *      vPatch;         // the patch of each query (shared, one entry per query)
+    Vec_Int_t *      vConf;          // the conflicts of each query (shared, one entry per query)
+    Vec_Wrd_t *      vTime;          // the time of each query (shared, one entry per query)
+    int              nShares;
+    int              nBTLimit;
+    int              fTrace;
+};
+void Cec_ManFdSolveShare( void* pArg, int iShare ) {
+    Cec_FdShares_t* p = (Cec_FdShares_t*) pArg;
+    Vec_Int_t* vStat = Vec_IntAlloc( 1 );
+    Vec_Int_t* vFs = Vec_IntAlloc( 1 );
+    Vec_Ptr_t* vPatches = Vec_PtrAlloc( 1 );
+    Vec_Wec_t* vTargetG = Vec_WecAlloc( 1 );
+    Vec_Int_t* vPos = Vec_IntStartFull( Gia_ManObjNum(p->pGias[iShare]) );
+    Vec_Int_t* vGroup, *vUnion;
+    Gia_Man_t* pPatch;
+    abctime clk;
+    int iGroup, iQuery, k, j, g;
+    for ( iGroup = iShare; iGroup < Vec_WecSize(p->vGroup); iGroup += p->nShares ) {
+        vGroup = Vec_WecEntry( p->vGroup, iGroup );
+        iQuery = Vec_IntEntry( vGroup, 0 );
+        Vec_IntClear( vStat );
+        clk = Abc_Clock();
+        if (Vec_IntSize(vGroup) == 1) {
+            pPatch = Cec_ManItpMan( p->pCnfMans[iShare], p->fTrace, p->pGias[iShare], Vec_IntEntry(p->vF, iQuery), 
+                        Vec_WecEntry(p->vG, iQuery), p->nBTLimit, -1, vStat );
+            Vec_PtrWriteEntry( p->vPatch, iQuery, pPatch );
+            Vec_IntWriteEntry( p->vConf, iQuery, Vec_IntEntry(vStat, 0) );
+            Vec_WrdWriteEntry( p->vTime, iQuery, (word)(Abc_Clock() - clk) );
+            continue;
+        }
+        // the support of each query as the positions in the union
+        vUnion = Vec_WecEntry( p->vUnion, iGroup );
+        Vec_IntForEachEntry( vUnion, g, j )
+            Vec_IntWriteEntry( vPos, g, j );
+        Vec_IntClear( vFs );
+        Vec_WecClear( vTargetG );
+        Vec_IntForEachEntry( vGroup, iQuery, k ) {
+            Vec_IntPush( vFs, Vec_IntEntry(p->vF, iQuery) );
+            Vec_WecPushLevel( vTargetG );
+            Vec_IntForEachEntry( Vec_WecEntry(p->vG, iQuery), g, j )
+                Vec_WecPush( vTargetG, k, Vec_IntEntry(vPos, g) );
+        }
+        Vec_IntForEachEntry( vUnion, g, j )
+            Vec_IntWriteEntry( vPos, g, -1 );
+        Vec_PtrClear( vPatches );
+        Cec_ManItpBatchMan( p->pCnfMans[iShare], p->pGias[iShare], vFs, vUnion, vTargetG, p->nBTLimit, vPatches, vStat );
+        // the time of the group is shared by its queries
+        clk = (Abc_Clock() - clk) / Vec_IntSize(vGroup);
+        Vec_IntForEachEntry( vGroup, iQuery, k ) {
+            Vec_PtrWriteEntry( p->vPatch, iQuery, Vec_PtrEntry(vPatches, k) );
+            Vec_IntWriteEntry( p->vConf, iQuery, Vec_IntEntry(vStat, k) );
+            Vec_WrdWriteEntry( p->vTime, iQuery, (word)clk );
+        }
+    }
+    Vec_PtrFree( vPatches );
+    Vec_WecFree( vTargetG );
+    Vec_IntFree( vPos );
+    Vec_IntFree( vFs );
+    Vec_IntFree( vStat );
+}
+// groups the queries with similar supports, at most nBatch in a group; a query joins a group with the same support
+// (in the same order), or else one of the last CEC_FD_GROUP_NEAR open groups if the union of the supports stays within
+// one node in eight of the smallest support of the group and the query; each query is its own group if nBatch is at
+// most 1; the union of the supports of each group is returned in vUnion (the first support, then the added nodes)
+#define CEC_FD_GROUP_NEAR 32
+Vec_Wec_t* Cec_ManFdGroupQueries( Vec_Wec_t* vG, int nBatch, Vec_Wec_t* vUnion ) {
+    Vec_Wec_t* vGroup = Vec_WecAlloc( Vec_WecSize(vG) );
+    Vec_Int_t* vHash = Vec_IntAlloc( Vec_WecSize(vG) );
+    Vec_Int_t* vMin = Vec_IntAlloc( Vec_WecSize(vG) ); // the smallest support in each group
+    Vec_Int_t* vOpen = Vec_IntAlloc( 16 ); // the groups that are not full
+    Vec_Int_t* vMark = Vec_IntAlloc( 1000 ); // the last group whose union contains the node
+    Vec_Int_t* vIntBuff;
+    int i, k, m, j, g, iGroup, Hash, nNew, nMin, fSame;
+    Vec_WecClear( vUnion );
+    Vec_WecForEachLevel( vG, vIntBuff, i ) {
+        Hash = Vec_IntSize(vIntBuff);
+        Vec_IntForEachEntry( vIntBuff, j, k ) {
+            Hash = Hash * 7937 + j;
+            Vec_IntFillExtra( vMark, j + 1, -1 );
+        }
+        iGroup = -1;
+        fSame = 0;
+        if (nBatch > 1) {
+            Vec_IntForEachEntry( vOpen, j, k ) {
+                if (Vec_IntEntry(vHash, j) != Hash) continue;
+                if (!Vec_IntEqual( vIntBuff, Vec_WecEntry(vG, Vec_IntEntry(Vec_WecEntry(vGroup, j), 0)) )) continue;
+                iGroup = j;
+                fSame = 1;
+                break;
+            }
+            for (k = Vec_IntSize(vOpen) - 1; iGroup == -1 && k >= 0 && k >= Vec_IntSize(vOpen) - CEC_FD_GROUP_NEAR; k--) {
+                j = Vec_IntEntry( vOpen, k );
+                Vec_IntForEachEntry( Vec_WecEntry(vUnion, j), g, m )
+                    Vec_IntWriteEntry( vMark, g, j );
+                nNew = 0;
+                Vec_IntForEachEntry( vIntBuff, g, m )
+                    nNew += (Vec_IntEntry(vMark, g) != j);
+                nMin = Abc_MinInt( Vec_IntEntry(vMin, j), Vec_IntSize(vIntBuff) );
+                if (8 * (Vec_IntSize(Vec_WecEntry(vUnion, j)) + nNew) <= 9 * nMin) iGroup = j;
+            }
+        }
+        if (iGroup == -1) {
+            iGroup = Vec_WecSize( vGroup );
+            Vec_WecPushLevel( vGroup );
+            Vec_IntAppend( Vec_WecPushLevel(vUnion), vIntBuff );
+            Vec_IntPush( vHash, Hash );
+            Vec_IntPush( vMin, Vec_IntSize(vIntBuff) );
+            if (nBatch > 1) Vec_IntPush( vOpen, iGroup );
+        } else if (!fSame) {
+            // the nodes of the union were marked by iGroup in the last check
+            Vec_IntForEachEntry( vIntBuff, g, k )
+                if (Vec_IntEntry(vMark, g) != iGroup)
+                    Vec_WecPush( vUnion, iGroup, g );
+            Vec_IntWriteEntry( vMin, iGroup, Abc_MinInt(Vec_IntEntry(vMin, iGroup), Vec_IntSize(vIntBuff)) );
+        }
+        Vec_WecPush( vGroup, iGroup, i );
+        if (nBatch > 1 && Vec_IntSize(Vec_WecEntry(vGroup, iGroup)) == nBatch) Vec_IntRemove( vOpen, iGroup );
+    }
+    Vec_IntFree( vHash );
+    Vec_IntFree( vMin );
+    Vec_IntFree( vOpen );
+    Vec_IntFree( vMark );
+    return vGroup;
+}
+// solves the queries (vF[i], vG[i]) on pGia or pAbs (fAbsItp) in the groups of Cec_ManFdGroupQueries; the groups are 
+// given to nThreads workers, each with a copy of the circuit, and the results are written in the order of the queries;
+// returns the number of groups
+int Cec_ManFdSolveQueries( Cec_ManFd_t* pMan, Vec_Int_t* vF, Vec_Wec_t* vG, Vec_Ptr_t* vPatch, Vec_Int_t* vConf, Vec_Wrd_t* vTime ) {
+    Gia_Man_t *pGia = pMan->pPars->fAbsItp ? pMan->pAbs : pMan->pGia;
+    Cec_FdShares_t Shares;
+    Vec_Wec_t *vGroup, *vUnion = Vec_WecAlloc( Vec_WecSize(vG) );
+    int nThreads = pMan->pPars->nThreads;
+    int i, nGroups;
+    Vec_PtrFill( vPatch, Vec_IntSize(vF), NULL );
+    Vec_IntFill( vConf, Vec_IntSize(vF), 0 );
+    Vec_WrdFill( vTime, Vec_IntSize(vF), 0 );
+    vGroup = Cec_ManFdGroupQueries( vG, pMan->pPars->nBatch, vUnion );
+    nGroups = Vec_WecSize( vGroup );
+    nThreads = Abc_MaxInt( 1, Abc_MinInt( nThreads, nGroups ) );
+    Shares.pGias    = ABC_ALLOC( Gia_Man_t *, nThreads );
+    Shares.pCnfMans = ABC_ALLOC( Cnf_Man_t *, nThreads );
+    Shares.vF       = vF;
+    Shares.vG       = vG;
+    Shares.vGroup   = vGroup;
+    Shares.vUnion   = vUnion;
+    Shares.vPatch   = vPatch;
+    Shares.vConf    = vConf;
+    Shares.vTime    = vTime;
+    Shares.nShares  = nThreads;
+    Shares.nBTLimit = pMan->pPars->nBTLimit;
+    Shares.fTrace   = pMan->pPars->fTrace;
+    for (i = 0; i < nThreads; i++) {
+        Shares.pGias[i]    = Gia_ManDup( pGia ); // the object ids are kept
+        Shares.pCnfMans[i] = Cnf_ManStart();
+    }
+    Util_TaskParallelFor( nThreads, nThreads, Cec_ManFdSolveShare, &Shares );
+    for (i = 0; i < nThreads; i++) {
+        Gia_ManStop( Shares.pGias[i] );
+        Cnf_ManStop( Shares.pCnfMans[i] );
+    }
+    ABC_FREE( Shares.pGias );
+    ABC_FREE( Shares.pCnfMans );
+    Vec_WecFree( vGroup );
+    Vec_WecFree( vUnion );
+    return nGroups;
+}
+// the groups are solved by sat_solver2, which has no proof trace; the parameter is reset to report it once per manager
+static int Cec_ManFdBatchSize( Cec_ManFd_t* pMan ) {
+    if ( pMan->pPars->fTrace && pMan->pPars->nBatch > 1 ) {
+        printf( "The proof trace engine solves one node per solver; batching (-B %d) is turned off.\n", pMan->pPars->nBatch );
+        pMan->pPars->nBatch = 0;
+    }
+    return pMan->pPars->nBatch;
+}
+// same as calling Cec_ManFdCleanOneUnknown on each node of vCand with the one-shot engine (fInc == 0); with nThreads > 0
+// the queries are solved in parallel and the results are merged in the order of vCand, so the outcome does not depend
+// on nThreads; with nBatch > 1 the queries with similar supports are solved in groups, also without threads; a group
+// shares the CNF of the union of the supports, and the queries with the same support also share the learned clauses,
+// so a query that is undecided within -C alone may be decided in its group, while the decided answers are the same
+void Cec_ManFdCleanUnknownBatch( Cec_ManFd_t* pMan, Vec_Int_t* vCand ) {
+    Gia_Man_t *pTemp, *pTemp2;
+    Vec_Int_t *vNid, *vF, *vConf, *vIntBuff, *vCache;
+    Vec_Wrd_t *vTime;
+    Vec_Wec_t *vG;
+    Vec_Ptr_t *vPatch;
+    int nBatch = Cec_ManFdBatchSize( pMan );
+    int fStrict = pMan->pPars->costType == CEC_FD_COSTCINUM ? 0 : 1;
+    int i, nid, stat, iCache, nGroups, nConfs = 0;
+    abctime clk = Abc_Clock(), clkItp;
+    if (pMan->pPars->nThreads <= 0 && nBatch <= 1) {
+        Vec_IntForEachEntry( vCand, nid, i ) 
+            Cec_ManFdCleanOneUnknown( pMan, nid );
+        return;
+    }
+
+    // collect the queries
+    vNid = Vec_IntAlloc( Vec_IntSize(vCand) );
+    vF = Vec_IntAlloc( Vec_IntSize(vCand) );
+    vG = Vec_WecAlloc( Vec_IntSize(vCand) );
+    vCache = Vec_IntAlloc( Vec_IntSize(vCand) );
+    Vec_IntForEachEntry( vCand, nid, i ) {
+        stat = Vec_IntEntry(pMan->vStat, nid);
+        if (stat != CEC_FD_UNKNOWN && stat != CEC_FD_HUGE && stat != CEC_FD_UNSOLVE) continue;
+        if (!pMan->pPars->fAbsItp && Cec_ManFdSimRefute( pMan, nid, Vec_WecEntry(pMan->vGSupport, nid) )) {
+            if (Cec_ManFdUpdateStat( pMan, nid, 0, NULL, fStrict )) Vec_IntWriteEntry( pMan->vConf, nid, 0 );
+            continue;
+        }
+        iCache = Cec_ManFdCacheFind( pMan, nid, Vec_WecEntry(pMan->vGSupport, nid) );
+        if (iCache >= 0 && Cec_ManFdCacheGet( pMan, iCache, &pTemp )) {
+            if (Cec_ManFdUpdateStat( pMan, nid, 0, pTemp, fStrict )) Vec_IntWriteEntry( pMan->vConf, nid, 0 );
+            if (pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) Gia_ManStop( pTemp );
+            continue;
+        }
+        Vec_IntPush( vCache, iCache );
+        Vec_IntPush( vNid, nid );
+        Vec_IntPush( vF, pMan->pPars->fAbsItp ? Cec_ManFdMapIdSingle(pMan, nid, 1) : nid );
+        vIntBuff = Vec_WecPushLevel( vG );
+        Vec_IntAppend( vIntBuff, Vec_WecEntry(pMan->vGSupport, nid) );
+        if (pMan->pPars->fAbsItp) Cec_ManFdMapId( pMan, vIntBuff, 1 );
+    }
+    vPatch = Vec_PtrAlloc( Vec_IntSize(vNid) );
+    vConf = Vec_IntAlloc( Vec_IntSize(vNid) );
+    vTime = Vec_WrdAlloc( Vec_IntSize(vNid) );
+
+    // solve the queries
+    clkItp = Abc_Clock();
+    nGroups = Cec_ManFdSolveQueries( pMan, vF, vG, vPatch, vConf, vTime );
+    clkItp = Abc_Clock() - clkItp;
+
+    // merge the results in the order of the candidates
+    Vec_IntForEachEntry( vNid, nid, i ) {
+        pTemp = (Gia_Man_t*) Vec_PtrEntry( vPatch, i );
+        if (pMan->pPars->fItpMin && pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) {
+            pTemp = Cec_ManFdMinPatch( pMan, Vec_WecEntry(pMan->vGSupport, nid), pTemp2 = pTemp );
+            if (pTemp != pTemp2) Gia_ManStop( pTemp2 );
+        }
+        if (pMan->pPars->fVerbose) printf("clean unknown nid: %d (%s, conf: %d)\n", nid, Cec_ManFdResultName(pTemp), Vec_IntEntry(vConf, i));
+        if (Vec_IntEntry(vCache, i) >= 0) Cec_ManFdCacheSet( pMan, Vec_IntEntry(vCache, i), pTemp, Vec_IntEntry(vConf, i) );
+        Cec_ManFdProfQuery( pMan, nid, Vec_IntSize(Vec_WecEntry(vG, i)), pTemp, Vec_IntEntry(vConf, i), (abctime)Vec_WrdEntry(vTime, i) );
+        nConfs += Vec_IntEntry(vConf, i);
+        if (Cec_ManFdUpdateStat( pMan, nid, 0, pTemp, fStrict )) {
+            Vec_IntWriteEntry( pMan->vConf, nid, Vec_IntEntry(vConf, i) );
+        }
+        if (pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) Gia_ManStop( pTemp );
     }
+    if (pMan->pPars->fVerbose) 
+        Abc_Print(1, "Solved %d nodes in %d groups with %d threads in %9.6f sec\n", Vec_IntSize(vNid), nGroups, 
+            Abc_MaxInt( 1, Abc_MinInt( pMan->pPars->nThreads, nGroups ) ), 1.0*(Abc_Clock() - clk)/CLOCKS_PER_SEC);
+    // the wall time of the batch, the time of each query is in the CSV
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_ITP, clkItp, nConfs );
+
+    Vec_IntFree( vNid );
+    Vec_IntFree( vCache );
+    Vec_WrdFree( vTime );
+    Vec_IntFree( vF );
+    Vec_WecFree( vG );
+    Vec_PtrFree( vPatch );
+    Vec_IntFree( vConf );
+}
+// solves the queries (vNid[i], vSupp[i]) ahead of a sequential traversal and keeps the answers only in the cache;
+// Cec_ManFdSolve finds the answer of a query when the traversal issues it, and the answers of the queries that are
+// never issued are not used; the queries that are refuted by simulation or already cached are skipped
+void Cec_ManFdSolveAhead( Cec_ManFd_t* pMan, Vec_Int_t* vNid, Vec_Wec_t* vSupp ) {
+    Gia_Man_t *pTemp, *pTemp2;
+    Vec_Int_t *vF, *vConf, *vCache;
+    Vec_Wrd_t *vTime;
+    Vec_Wec_t *vG;
+    Vec_Ptr_t *vPatch;
+    int i, nid, iCache, nConfs = 0, nLookups = 0;
+    int nSimQueries = pMan->nSimQueries, nSimRefuted = pMan->nSimRefuted;
+    abctime clk = Abc_Clock();
+    if (Cec_ManFdBatchSize( pMan ) <= 1 || pMan->pCache == NULL || pMan->pPars->fAbsItp || pMan->pPars->fInc) return;
+    vF = Vec_IntAlloc( Vec_IntSize(vNid) );
+    vG = Vec_WecAlloc( Vec_IntSize(vNid) );
+    vCache = Vec_IntAlloc( Vec_IntSize(vNid) );
+    Vec_IntForEachEntry( vNid, nid, i ) {
+        if (Cec_ManFdSimRefute( pMan, nid, Vec_WecEntry(vSupp, i) )) continue;
+        iCache = Cec_ManFdCacheFind( pMan, nid, Vec_WecEntry(vSupp, i) );
+        nLookups += (iCache >= 0);
+        if (iCache < 0 || Vec_IntEntry(pMan->vCacheLimit, iCache) >= 0) continue;
+        Vec_IntPush( vCache, iCache );
+        Vec_IntPush( vF, nid );
+        Vec_IntAppend( Vec_WecPushLevel( vG ), Vec_WecEntry(vSupp, i) );
+    }
+    // the lookups above are not queries of the traversal
+    pMan->nCacheQueries -= nLookups;
+    pMan->nSimQueries = nSimQueries;
+    pMan->nSimRefuted = nSimRefuted;
+    vPatch = Vec_PtrAlloc( Vec_IntSize(vF) );
+    vConf = Vec_IntAlloc( Vec_IntSize(vF) );
+    vTime = Vec_WrdAlloc( Vec_IntSize(vF) );
+    if (Vec_IntSize(vF) > 0)
+        Cec_ManFdSolveQueries( pMan, vF, vG, vPatch, vConf, vTime );
+    Vec_PtrForEachEntry( Gia_Man_t *, vPatch, pTemp, i ) {
+        if (pMan->pPars->fItpMin && pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) {
+            pTemp = Cec_ManFdMinPatch( pMan, Vec_WecEntry(vG, i), pTemp2 = pTemp );
+            if (pTemp != pTemp2) Gia_ManStop( pTemp2 );
+        }
+        Cec_ManFdCacheSet( pMan, Vec_IntEntry(vCache, i), pTemp, Vec_IntEntry(vConf, i) );
+        nConfs += Vec_IntEntry( vConf, i );
+        if (pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) Gia_ManStop( pTemp );
+    }
+    if (pMan->pPars->fVerbose)
+        Abc_Print(1, "Solved %d of %d queries ahead in %9.6f sec\n", Vec_IntSize(vF), Vec_IntSize(vNid), 1.0*(Abc_Clock() - clk)/CLOCKS_PER_SEC);
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_ITP, Abc_Clock() - clk, nConfs );
+    Vec_IntFree( vF );
+    Vec_WecFree( vG );
+    Vec_IntFree( vCache );
+    Vec_PtrFree( vPatch );
+    Vec_IntFree( vConf );
+    Vec_WrdFree( vTime );
 }
 int Cec_ManFdTraverseUnknownCone( Cec_ManFd_t* pMan, int nid, int nHeight ) {
     Gia_Obj_t* pObj = Gia_ManObj( pMan->pGia, nid );
@@ -3783,7 +5176,7 @@ Vec_Int_t* Cec_ManFdTraverseUnknownFrt_old( Cec_ManFd_t* pMan, int nStart, int n
     // vCost = Vec_IntStart( Gia_ManObjNum(pMan->pAbs) );
     // nidbuf = Gia_ObjId( pMan->pAbs, pCo );
     // for (k = 1; k < Gia_ManObjNum(pMan->pAbs); k++) {
-    //     Vec_IntWriteEntry( vCost, k, pMan->dist_long_abs[nidbuf][k] );
+    //     Vec_IntWriteEntry( vCost, k, Cec_ManDistEntry(pMan->dist_long_abs, nidbuf, k) );
     // }
     Gia_ManFillValue( pMan->pAbs );
     // problem: currently use In-order, not pre-order
@@ -3869,8 +5262,8 @@ int Cec_ManFdCntFrtChange( Cec_ManFd_t* pMan, Vec_Int_t* vFrt, int nid, int fOrg
     // Vec_Int_t* vFrtNid = Vec_IntStart( Vec_IntSize(pMan->vMerge) );
     int i, nidbuf, buf, cnt = 0;
     if (fOrg) {
-        Vec_IntForEachEntry( Vec_WecEntry(pMan->vMergeSupport, nid), buf, i ) {
-           if (buf == 1 && Vec_IntEntry( vFrt, i ) == 0) {
+        Cec_ManFdForEachMergeSupp( pMan, nid, i ) {
+           if (Vec_IntEntry( vFrt, i ) == 0) {
                Vec_IntWriteEntry( vFrt, i, 1 );
                cnt++;
            }
@@ -4026,6 +5419,9 @@ int Cec_ManFdTraverseUnknownCheck( Cec_ManFd_t* pMan, Gia_Man_t* pCheckTFI, Vec_
     // Cec_ManCommit( pMan, pCheckTFI, vUsedFrt, nidTrav );
 }
 
+// the nodes of a level are tried one by one, since a commit changes pCheckTFI and hence the nodes after it that are
+// tried; with -B, the first query of each candidate of the level (Cec_ManFdShrinkFirstQuery) is solved ahead in groups
+// (Cec_ManFdSolveAhead), and the traversal takes the answers from the cache, or ignores them for the skipped nodes
 Vec_Int_t* Cec_ManFdTraverseUnknownFrt( Cec_ManFd_t* pMan, int fColor, int nRange, int fType, Vec_Flt_t* vCoef ) {
     // int fJumpFar = 0;
     assert( fColor == 1 || fColor == 2 );
@@ -4038,6 +5434,7 @@ Vec_Int_t* Cec_ManFdTraverseUnknownFrt( Cec_ManFd_t* pMan, int fColor, int nRang
     Vec_Int_t* vStat = Vec_IntStart(4);
     Vec_IntFill( vStat, 4, 0 );
     Vec_Ptr_t* vNdCone;
+    Vec_Wec_t* vSupp;
     Gia_Man_t* pCheckTFI = Gia_ManDup( pMan->pAbs );
     Gia_Man_t* pPatch;
     // Gia_Obj_t* pCo = fColor == 1 ? pMan->pObjAbs1 : pMan->pObjAbs2;
@@ -4104,6 +5501,21 @@ Vec_Int_t* Cec_ManFdTraverseUnknownFrt( Cec_ManFd_t* pMan, int fColor, int nRang
     for (buf = lv + nRange; buf > lv - nRange; buf--) {
         vIntBuff = Vec_IntFindAll( pMan->pAbs->vLevels, buf, 0 );
         Vec_IntSelectSortCost( vIntBuff->pArray, Vec_IntSize(vIntBuff), vOrder );
+        if (pMan->pPars->nBatch > 1) {
+            vCand = Vec_IntAlloc( Vec_IntSize(vIntBuff) );
+            vSupp = Vec_WecAlloc( Vec_IntSize(vIntBuff) );
+            Vec_IntForEachEntry( vIntBuff, nidbuf, k ) {
+                nidbufGlob = Cec_ManFdMapIdSingle( pMan, nidbuf, 0 );
+                if (Cec_ManFdToSolve( pMan, nidbufGlob ) == 0) continue;
+                if (Gia_ObjColors( pMan->pGia, nidbufGlob ) != fColor) continue;
+                if (Gia_ObjValue( Gia_ManObj( pCheckTFI, nidbuf ) ) != -1) continue;
+                Vec_IntPush( vCand, nidbufGlob );
+                Cec_ManFdShrinkFirstQuery( pMan, nidbufGlob, Vec_WecPushLevel( vSupp ) );
+            }
+            Cec_ManFdSolveAhead( pMan, vCand, vSupp );
+            Vec_WecFree( vSupp );
+            Vec_IntFree( vCand );
+        }
         cntFail = 0;
         Vec_IntForEachEntry( vIntBuff, nidbuf, k ) {
             nidbufGlob = Cec_ManFdMapIdSingle( pMan, nidbuf, 0 );
@@ -4203,14 +5615,14 @@ void Cec_ManFdShrinkLevelTest( Cec_ManFd_t* pMan, int nid, int lv_lim ) {
         if ( Gia_ObjLevelId( pMan->pAbs, nidAbs ) >= lv_lim ) Vec_IntPush( vFdSupportNew, nidSup );
     }
     vStat = Vec_IntAlloc(1);
-    patch = Cec_ManFdGetFd( pMan, nid, vFdSupportNew, vStat );
+    patch = Cec_ManFdSolve( pMan, nid, vFdSupportNew, vStat );
     nidAbs = Cec_ManFdMapIdSingle( pMan, nid, 1 );
     printf("nid %d conflict required %d\n", nid, nidAbs, Vec_IntEntry( vStat, 0 ));
     Vec_IntClear( vStat );
-    if (patch != NULL && patch != 1 && patch != 2) {
+    if (patch != NULL && patch != CEC_FD_PATCH_UNSOLVE && patch != CEC_FD_PATCH_HUGE) {
         patch = Cec_ManPatchCleanSupport( pTemp = patch, vFdSupportNew );
         Gia_ManStop(pTemp);
-        patch = Cec_ManSimpSyn( pTemp = patch, 1, 0, -1 );
+        patch = Cec_ManFdSimpSyn( pMan, pTemp = patch, 1, 0, -1 );
         Gia_ManStop(pTemp);
         printf("nid %d(%d) with shrink lv_lim %d have found patch sized %d\n", nid, nidAbs, lv_lim, Gia_ManAndNum(patch));
         printf("G support: ");
@@ -4236,7 +5648,7 @@ void Cec_ManFdShrink( Cec_ManFd_t* pMan, int nid ) {
     }
     
     abctime clk;
-    Vec_Int_t* vIntBuff, *vSupport, *vStat = Vec_IntAlloc(1);
+    Vec_Int_t* vIntBuff, *vStat = Vec_IntAlloc(1);
     Vec_Wec_t *vFdSupportSplit, *vWecBuff;
     int fLocalShrink = pMan->pPars->fLocalShrink;
     int fMin = Cec_ManFdGetLevelType( pMan, 3 );
@@ -4246,9 +5658,9 @@ void Cec_ManFdShrink( Cec_ManFd_t* pMan, int nid ) {
     //                 pMan->pPars->costType == CEC_FD_COSTTWOPATHOLD) ? 1 : 0;
     int fStrict = 0;
     float coef = pMan->pPars->coefPatch;
-    int toShrink, i, nidbuff, buf, val, entry;
-    int** dist_long = pMan->dist_long;
-    int** dist_short = pMan->dist_short;
+    int toShrink, i, nidbuff, buf, val;
+    Cec_ManDist_t* dist_long = pMan->dist_long;
+    Cec_ManDist_t* dist_short = pMan->dist_short;
     Gia_Man_t *p = pMan->pGia;
     Gia_Man_t *pTemp;
     Gia_Obj_t *pObj;
@@ -4337,13 +5749,11 @@ void Cec_ManFdShrink( Cec_ManFd_t* pMan, int nid ) {
         Gia_ManFillValue(p);
         // Vec_IntPrint(vIntBuff);
         Vec_IntClear( vStat );
-        pTemp = pMan->pPars->fInc ? Cec_ManFdGetFd_Inc( pMan, nid, vIntBuff ) : Cec_ManFdGetFd( pMan, nid, vIntBuff, vStat );
-        if (pTemp != NULL && pTemp != 1 && pTemp != 2) {
+        pTemp = Cec_ManFdSolve( pMan, nid, vIntBuff, vStat );
+        if (pTemp != NULL && pTemp != CEC_FD_PATCH_UNSOLVE && pTemp != CEC_FD_PATCH_HUGE) {
             
-            vSupport = Vec_IntDup( Vec_WecEntry(pMan->vMergeSupport, nid) );
             // Vec_IntPrint(vIntBuff);
-            Vec_IntForEachEntry( vSupport, entry, i ) {
-                if (entry == 0) continue;
+            Cec_ManFdForEachMergeSupp( pMan, nid, i ) {
                 nidbuff = Vec_IntEntry( pMan->vMerge, i );
                 // printf("nidbuff %d\n", nidbuff);
                 if (Vec_IntFind( vIntBuff, nidbuff ) != -1) continue;
@@ -4361,7 +5771,7 @@ void Cec_ManFdShrink( Cec_ManFd_t* pMan, int nid ) {
                     break;
                 }
             }
-            if (i == Vec_IntSize(vSupport)) {
+            if (i == Vec_IntSize(pMan->vMerge)) {
                 printf("Not shrinked in support\n");
                 if (Vec_IntEntry( pMan->vStat, nid ) == CEC_FD_TRIVIAL) 
                     Vec_IntWriteEntry( pMan->vStat, nid, CEC_FD_UNSHRINKABLE );
@@ -4383,33 +5793,47 @@ void Cec_ManFdShrink( Cec_ManFd_t* pMan, int nid ) {
 
 
 }
-// find a patch with fewest frontier nodes
-void Cec_ManFdShrinkSimple( Cec_ManFd_t* pMan, int nid, int fClean ) {
-    assert( Gia_ObjColors( pMan->pGia, nid ) == 1 || Gia_ObjColors( pMan->pGia, nid ) == 2 );
-    if( Cec_ManFdToSolve( pMan, nid ) == 0 ) return;
+// the frontier nodes in the support of nid in the order in which Cec_ManFdShrinkSimple tries to drop them
+Vec_Int_t* Cec_ManFdShrinkOrder( Cec_ManFd_t* pMan, int nid ) {
     int cktOth = Gia_ObjColors( pMan->pGia, nid ) == 1 ? 2 : 1;
-    int nidSup, i, buf, flag;
-    // int clean_support = 0;
+    int nidSup, i;
     Vec_Int_t* vIntBuff;
-    Vec_Int_t* vFdSupportNew = Vec_WecEntry(pMan->vGSupport, nid);
     Vec_Int_t* vFdSupportFrt = Vec_IntAlloc( 8 );
-    Gia_Man_t* patch;// , patchOpt;
-
-    Vec_IntForEachEntry( vFdSupportNew, nidSup, i ) 
+    Vec_IntForEachEntry( Vec_WecEntry(pMan->vGSupport, nid), nidSup, i ) 
         if ( Gia_ObjColors( pMan->pGia, nidSup ) == 3 ) Vec_IntPush( vFdSupportFrt, nidSup );
     vIntBuff = Vec_IntAlloc( Vec_IntSize(vFdSupportFrt) );
     Vec_IntForEachEntry( vFdSupportFrt, nidSup, i ) 
         Vec_IntPush( vIntBuff, Vec_IntEntry( cktOth == 1 ? pMan->vLevel1 : pMan->vLevel2, nidSup ) );
     Vec_IntSelectSortCost2( vFdSupportFrt->pArray, Vec_IntSize(vFdSupportFrt), vIntBuff->pArray );
     Vec_IntFree( vIntBuff );
+    return vFdSupportFrt;
+}
+// the support of the first query of Cec_ManFdShrinkSimple on nid: the first frontier node is dropped, if any
+void Cec_ManFdShrinkFirstQuery( Cec_ManFd_t* pMan, int nid, Vec_Int_t* vSupp ) {
+    Vec_Int_t* vFdSupportFrt = Cec_ManFdShrinkOrder( pMan, nid );
+    Vec_IntClear( vSupp );
+    Vec_IntAppend( vSupp, Vec_WecEntry(pMan->vGSupport, nid) );
+    if (Vec_IntSize(vFdSupportFrt) > 0)
+        Vec_IntDrop( vSupp, Vec_IntFind( vSupp, Vec_IntEntry(vFdSupportFrt, 0) ) );
+    Vec_IntFree( vFdSupportFrt );
+}
+// find a patch with fewest frontier nodes
+void Cec_ManFdShrinkSimple( Cec_ManFd_t* pMan, int nid, int fClean ) {
+    assert( Gia_ObjColors( pMan->pGia, nid ) == 1 || Gia_ObjColors( pMan->pGia, nid ) == 2 );
+    if( Cec_ManFdToSolve( pMan, nid ) == 0 ) return;
+    int nidSup, i, buf, flag;
+    // int clean_support = 0;
+    Vec_Int_t* vFdSupportNew = Vec_WecEntry(pMan->vGSupport, nid);
+    Vec_Int_t* vFdSupportFrt = Cec_ManFdShrinkOrder( pMan, nid );
+    Gia_Man_t* patch;// , patchOpt;
 
     flag = 0;
     Vec_IntForEachEntry( vFdSupportFrt, nidSup, i ) {
         buf = Vec_IntFind( vFdSupportNew, nidSup );
         if (buf != -1) {
             Vec_IntDrop( vFdSupportNew, buf );
-            patch = Cec_ManFdGetFd( pMan, nid, vFdSupportNew, 0 );
-            if (patch != NULL && patch != 1 && patch != 2) {
+            patch = Cec_ManFdSolve( pMan, nid, vFdSupportNew, 0 );
+            if (patch != NULL && patch != CEC_FD_PATCH_UNSOLVE && patch != CEC_FD_PATCH_HUGE) {
                 if (fClean) {
                     Gia_ManStop(Cec_ManPatchCleanSupport( patch, vFdSupportNew ));
                     Gia_ManStop(patch);
@@ -4478,6 +5902,12 @@ Gia_Man_t*    Cec_ManFdReplaceOne( Cec_ManFd_t* pMan, int nid ) {
   return pOut;
 }
 Gia_Man_t*  Cec_ManFdReplaceMulti( Cec_ManFd_t* pMan, Vec_Int_t* vF ) {
+    abctime clk = Abc_Clock();
+    Gia_Man_t* pOut = Cec_ManFdReplaceMulti_int( pMan, vF );
+    Cec_ManFdProfAdd( pMan, CEC_FD_PROF_REPLACE, Abc_Clock() - clk, 0 );
+    return pOut;
+}
+static Gia_Man_t*  Cec_ManFdReplaceMulti_int( Cec_ManFd_t* pMan, Vec_Int_t* vF ) {
     Gia_Man_t *pGia = pMan->pGia;
     Gia_Man_t *pOut, *pTemp, *pTemp2, *pFdPatch, *pGia_forCp;
     Gia_Obj_t *pObjbuf, *pSupportbuf, *pObjCp;
@@ -4800,7 +6230,7 @@ Gia_Man_t* Cec_ManFdVisSupport( Cec_ManFd_t* pMan, int nid, int fPatch ) {
     Gia_Obj_t* pObj;
     int i, nidbuf, buf;
 
-    if (fPatch && (pFdPatch == NULL || pFdPatch == 1 || pFdPatch == 2)) {
+    if (fPatch && (pFdPatch == NULL || pFdPatch == CEC_FD_PATCH_UNSOLVE || pFdPatch == CEC_FD_PATCH_HUGE)) {
         printf("Node %d has no patch\n", nid);
         return NULL;
     } else {
@@ -4922,7 +6352,7 @@ void Cec_ManFdPlot( Cec_ManFd_t* pMan, int fAbs, int fVecAbs, int fColor, char*
   
 }
 void Cec_ManFdReport( Cec_ManFd_t* pMan ) {
-    int nid, i, color, stat, check, nid2, j, is_cec = pMan->pPars->fSyn, cnt_xor, cnt_mux, cnt, buf;
+    int nid, i, color, stat, nid2, j, is_cec = pMan->pPars->fSyn, cnt_xor, cnt_mux, cnt, buf;
     float val;
     char* str = ABC_ALLOC(char, 100);
     Vec_Int_t * vUnsat, *vUnsat_Abs, *vSat, *vSat_Abs, *vUnsatAll, *vUnsatAll_Abs, *vUnsat_Abs_stat0; 
@@ -5013,18 +6443,13 @@ void Cec_ManFdReport( Cec_ManFd_t* pMan ) {
         pTemp = Cec_ManGetTFI( pMan->pAbs, vObjBuff, 0 );
         Cec_ManDistEasy( pTemp, 0, Gia_ObjId(pTemp, Gia_ObjFanin0(Gia_ManCo(pTemp, 0))), 1 );
         Gia_ManCountMuxXor(pTemp, &cnt_xor, &cnt_mux);
-        cnt = 0;
-        Vec_IntForEachEntry( Vec_WecEntry(pMan->vMergeSupport, nid), check, j ) {
-            if (check) { cnt+=1; }
-        }
+        cnt = Cec_ManFdMergeSuppNum( pMan, nid );
         printf("absSize = %d, absHeight = %d, #Ci = %d, #absXor = %d, #absMux = %d\n", 
             Gia_ManAndNum(pTemp), Gia_ManLevelNum(pTemp), cnt, cnt_xor, cnt_mux);
         printf("absSupport: \n");
-        Vec_IntForEachEntry( Vec_WecEntry(pMan->vMergeSupport, nid), check, j ) {
-            if (check) {
-                nid2 = Vec_IntEntry(pMan->vMerge, j);
-                printf( "%d (%d): max_dist = %d, level_self = %d\n", nid2, Cec_ManFdMapIdSingle(pMan, nid2, 1), Gia_ObjValue(Gia_ManCi(pTemp, j)),Vec_IntEntry(vIntBuff, nid2) );
-            }
+        Cec_ManFdForEachMergeSupp( pMan, nid, j ) {
+            nid2 = Vec_IntEntry(pMan->vMerge, j);
+            printf( "%d (%d): max_dist = %d, level_self = %d\n", nid2, Cec_ManFdMapIdSingle(pMan, nid2, 1), Gia_ObjValue(Gia_ManCi(pTemp, j)),Vec_IntEntry(vIntBuff, nid2) );
         }
         Gia_ManStop(pTemp);
 
@@ -26,16 +26,7 @@
 #include "misc/util/utilTruth.h"
 //#include "bdd/cudd/cuddInt.h"
 
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilTask.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -44,12 +35,6 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-#ifndef ABC_USE_PTHREADS
-
-int Cec_GiaSplitTest( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent ) { return -1; }
-
-#else // pthreads are used
-
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -544,41 +529,28 @@ typedef struct Par_ThData_t_
     Cnf_Dat_t * pCnf;
     int         iThread;
     int         nTimeOut;
-    int         fWorking;
     int         Result;
     int         nVars;
     int         nConfs;
 } Par_ThData_t;
-void * Cec_GiaSplitWorkerThread( void * pArg )
+void * Cec_GiaSplitWorkerTask( void * pArg )
 {
     Par_ThData_t * pThData = (Par_ThData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->p == NULL )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        pThData->Result = Cnf_GiaSolveOne( pThData->p, pThData->pCnf, pThData->nTimeOut, &pThData->nVars, &pThData->nConfs );
-        pThData->fWorking = 0;
-    }
-    assert( 0 );
+    assert( pThData->p != NULL );
+    pThData->Result = Cnf_GiaSolveOne( pThData->p, pThData->pCnf, pThData->nTimeOut, &pThData->nVars, &pThData->nConfs );
     return NULL;
 }
 int Cec_GiaSplitTestInt( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent )
 {
     abctime clkTotal = Abc_Clock();
     Par_ThData_t ThData[PAR_THR_MAX];
-    pthread_t WorkerThread[PAR_THR_MAX];
+    Util_Task_t * pTasks[PAR_THR_MAX] = {NULL};
+    Util_TaskMan_t * pMan;
     Vec_Ptr_t * vStack;
     Cnf_Dat_t * pCnf;
     double Progress = 0;
     int i, status, nSatVars, nSatConfs;
-    int nIter = 0, RetValue = -1, fWorkToDo = 1;
+    int nIter = 0, RetValue = -1;
     Abc_CexFreeP( &p->pCexComb );
     if ( fVerbose )
         printf( "Solving CEC problem by cofactoring with the following parameters:\n" );
@@ -612,113 +584,102 @@ int Cec_GiaSplitTestInt( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax,
     // create local copy
     vStack = Vec_PtrAlloc( 1000 );
     Vec_PtrPush( vStack, Gia_ManDup(p) );
-    // start threads
+    // one cofactor per slot (the manager was subtracted above)
+    pMan = Util_TaskManStart( nProcs + 1 );
     for ( i = 0; i < nProcs; i++ )
     {
         ThData[i].p        = NULL;
         ThData[i].pCnf     = NULL;
         ThData[i].iThread  = i;
         ThData[i].nTimeOut = nTimeOut;
-        ThData[i].fWorking = 0;
         ThData[i].Result   = -1;
         ThData[i].nVars    = -1;
         ThData[i].nConfs   = -1;
-        status = pthread_create( WorkerThread + i, NULL,Cec_GiaSplitWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
     }
-    // look at the threads
-    while ( fWorkToDo )
+    // look at the tasks
+    while ( 1 )
     {
-        fWorkToDo = (int)(Vec_PtrSize(vStack) > 0);
-        for ( i = 0; i < nProcs; i++ )
+        Gia_Man_t * pLast;
+        int Depth;
+        // give the cofactors to the idle slots
+        for ( i = 0; i < nProcs && Vec_PtrSize(vStack) > 0; i++ )
         {
-            // check if this thread is working
-            if ( ThData[i].fWorking )
-            {
-                fWorkToDo = 1;
-                continue;
-            }
-            // check if this thread has recently finished
-            if ( ThData[i].p != NULL )
-            {
-                Gia_Man_t * pLast = ThData[i].p;
-                int Depth = pLast->vCofVars ? Vec_IntSize(pLast->vCofVars) : 0;
-                if ( pLast->vCofVars == NULL )
-                    pLast->vCofVars = Vec_IntAlloc( 100 );
-                if ( fVerbose )
-                    Cec_GiaSplitPrint( i+1, Depth, ThData[i].nVars, ThData[i].nConfs, ThData[i].Result, Progress, Abc_Clock() - clkTotal );
-                if ( ThData[i].Result == 0 ) // SAT
-                {
-                    p->pCexComb = pLast->pCexComb;  pLast->pCexComb = NULL;
-                    RetValue = 0;
-                    goto finish;
-                }
-                if ( ThData[i].Result == -1 ) // UNDEC
-                {
-                    // determine cofactoring variable
-                    int nFanouts, Cost, iVar = Gia_SplitCofVar( pLast, LookAhead, &nFanouts, &Cost );
-                    // cofactor
-                    Gia_Man_t * pPart = Gia_ManDupCofactorVar( pLast, iVar, 0 );
-                    pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
-                    Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
-                    Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
-                    Vec_PtrPush( vStack, pPart );
-                    // print results
-                    if ( fVeryVerbose )
-                    {
-//                        Cec_GiaSplitPrintRefs( pLast );
-                        printf( "Var = %5d. Fanouts = %5d. Cost = %8d.  AndBefore = %6d.  AndAfter = %6d.\n", 
-                            iVar, nFanouts, Cost, Gia_ManAndNum(pLast), Gia_ManAndNum(pPart) );
-//                        Cec_GiaSplitPrintRefs( pPart );
-                    }
-                    // cofactor
-                    pPart = Gia_ManDupCofactorVar( pLast, iVar, 1 );
-                    pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
-                    Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
-                    Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
-                    Vec_PtrPush( vStack, pPart );
-                    // keep working
-                    fWorkToDo = 1;
-                    nIter++;
-                }
-                else
-                    Progress += 1.0 / pow((double)2, (double)Depth);
-                Gia_ManStopP( &ThData[i].p );
-                if ( ThData[i].pCnf == NULL )
-                    continue;
-                Cnf_DataFree( ThData[i].pCnf );
-                ThData[i].pCnf = NULL;
-            }
-            if ( Vec_PtrSize(vStack) == 0 )
+            if ( pTasks[i] )
                 continue;
-            // start a new thread
             assert( ThData[i].p == NULL );
             ThData[i].p = (Gia_Man_t*)Vec_PtrPop( vStack );
             ThData[i].pCnf = Cec_GiaDeriveGiaRemapped( ThData[i].p );
-            ThData[i].fWorking = 1;
+            pTasks[i] = Util_TaskSpawn( pMan, Cec_GiaSplitWorkerTask, ThData + i );
         }
-        if ( nIterMax && nIter >= nIterMax )
+        // wait for a slot to finish
+        if ( (i = Util_TaskWaitAny( pTasks, nProcs )) < 0 )
             break;
+        Util_TaskFree( pTasks[i] );
+        pTasks[i] = NULL;
+        pLast = ThData[i].p;
+        Depth = pLast->vCofVars ? Vec_IntSize(pLast->vCofVars) : 0;
+        if ( pLast->vCofVars == NULL )
+            pLast->vCofVars = Vec_IntAlloc( 100 );
+        if ( fVerbose )
+            Cec_GiaSplitPrint( i+1, Depth, ThData[i].nVars, ThData[i].nConfs, ThData[i].Result, Progress, Abc_Clock() - clkTotal );
+        if ( ThData[i].Result == 0 ) // SAT
+        {
+            p->pCexComb = pLast->pCexComb;  pLast->pCexComb = NULL;
+            RetValue = 0;
+            goto finish;
+        }
+        if ( ThData[i].Result == -1 ) // UNDEC
+        {
+            // determine cofactoring variable
+            int nFanouts, Cost, iVar = Gia_SplitCofVar( pLast, LookAhead, &nFanouts, &Cost );
+            // cofactor
+            Gia_Man_t * pPart = Gia_ManDupCofactorVar( pLast, iVar, 0 );
+            pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
+            Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
+            Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
+            Vec_PtrPush( vStack, pPart );
+            // print results
+            if ( fVeryVerbose )
+            {
+//                Cec_GiaSplitPrintRefs( pLast );
+                printf( "Var = %5d. Fanouts = %5d. Cost = %8d.  AndBefore = %6d.  AndAfter = %6d.\n", 
+                    iVar, nFanouts, Cost, Gia_ManAndNum(pLast), Gia_ManAndNum(pPart) );
+//                Cec_GiaSplitPrintRefs( pPart );
+            }
+            // cofactor
+            pPart = Gia_ManDupCofactorVar( pLast, iVar, 1 );
+            pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
+            Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
+            Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
+            Vec_PtrPush( vStack, pPart );
+            nIter++;
+        }
+        else
+            Progress += 1.0 / pow((double)2, (double)Depth);
+        Gia_ManStopP( &ThData[i].p );
+        if ( ThData[i].pCnf )
+            Cnf_DataFree( ThData[i].pCnf );
+        ThData[i].pCnf = NULL;
+        if ( nIterMax && nIter >= nIterMax )
+            goto finish;
     }
-    if ( !fWorkToDo )
-        RetValue = 1;
+    RetValue = 1;
 finish:
-    // wait till threads finish
-    for ( i = 0; i < nProcs; i++ )
-        if ( ThData[i].fWorking )
-            i = -1;
-    // stop threads
+    // wait till the running problems finish
+    while ( (i = Util_TaskWaitAny( pTasks, nProcs )) >= 0 )
+    {
+        Util_TaskFree( pTasks[i] );
+        pTasks[i] = NULL;
+    }
+    Util_TaskManStop( pMan );
+    // cleanup
     for ( i = 0; i < nProcs; i++ )
     {
-        assert( !ThData[i].fWorking );
-        // cleanup
         Gia_ManStopP( &ThData[i].p );
         if ( ThData[i].pCnf == NULL )
             continue;
         Cnf_DataFree( ThData[i].pCnf );
         ThData[i].pCnf = NULL;
-        // stop
-        ThData[i].p = NULL;
-        ThData[i].fWorking = 1;
     }
     // finish
     Cec_GiaSplitClean( vStack );
@@ -838,8 +799,6 @@ void Cec_GiaPrintCofStats2( Gia_Man_t * p )
     }
 }
 
-#endif // pthreads are used
-
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -23,16 +23,7 @@
 #include "aig/gia/giaAig.h"
 #include "proof/cec/cec.h"
 
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilTask.h"
 
 
 ABC_NAMESPACE_IMPL_START
@@ -80,105 +71,33 @@ void Ssw_SignalCorrespondenceArray1( Vec_Ptr_t * vGias, Ssw_Pars_t * pPars )
   SeeAlso     []
 
 ***********************************************************************/
-#ifndef ABC_USE_PTHREADS
-
-void Ssw_SignalCorrespondenceArray( Vec_Ptr_t * vGias, Ssw_Pars_t * pPars )
-{
-    Ssw_SignalCorrespondenceArray1( vGias, pPars );
-}
-
-#else // pthreads are used
-
-
-#define PAR_THR_MAX 100
-typedef struct Par_ScorrThData_t_
+typedef struct Par_ScorrTask_t_
 {
     Cec_ParCor_t CorPars;
-    Gia_Man_t *  p;
-    int *        pMap;
-    int          iThread;
-    int          nTimeOut;
-    int          fWorking;
-} Par_ScorrThData_t;
-
-void * Ssw_GiaWorkerThread( void * pArg )
+    Vec_Ptr_t *  vGias;
+} Par_ScorrTask_t;
+
+void Ssw_GiaProcessItem( void * pArg, int i )
 {
-    Par_ScorrThData_t * pThData = (Par_ScorrThData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->p == NULL )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        Cec_ManLSCorrespondenceClasses( pThData->p, &pThData->CorPars );
-        pThData->fWorking = 0;
-    }
-    assert( 0 );
-    return NULL;
+    Par_ScorrTask_t * p = (Par_ScorrTask_t *)pArg;
+    // each task works on its own copy of the parameters
+    Cec_ParCor_t CorPars = p->CorPars;
+    Cec_ManLSCorrespondenceClasses( (Gia_Man_t *)Vec_PtrEntry(p->vGias, i), &CorPars );
 }
 
 void Ssw_SignalCorrespondenceArray( Vec_Ptr_t * vGias, Ssw_Pars_t * pPars )
 {
-    //abctime clkTotal = Abc_Clock();
-    Par_ScorrThData_t ThData[PAR_THR_MAX];
-    pthread_t WorkerThread[PAR_THR_MAX];
-    int i, status, nProcs = pPars->nProcs;
-    Vec_Ptr_t * vStack;
-    Cec_ParCor_t CorPars, * pCorPars = &CorPars;
-    Cec_ManCorSetDefaultParams( pCorPars );
+    Par_ScorrTask_t Task;
     if ( pPars->fVerbose )
-        printf( "Running concurrent &scorr with %d processes.\n", nProcs );
+        printf( "Running concurrent &scorr with %d processes.\n", pPars->nProcs );
     fflush( stdout );
     if ( pPars->nProcs < 2 )
         return Ssw_SignalCorrespondenceArray1( vGias, pPars );
-    // subtract manager thread
-    nProcs--;
-    assert( nProcs >= 1 && nProcs <= PAR_THR_MAX );
-    // start threads
-    for ( i = 0; i < nProcs; i++ )
-    {
-        ThData[i].CorPars  = *pCorPars;
-        ThData[i].iThread  = i;
-        //ThData[i].nTimeOut = pPars->nTimeOut;
-        ThData[i].fWorking = 0;
-        status = pthread_create( WorkerThread + i, NULL, Ssw_GiaWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
-    }
-    // look at the threads
-    vStack = Vec_PtrDup( vGias );
-    while ( Vec_PtrSize(vStack) > 0 )
-    {
-        for ( i = 0; i < nProcs; i++ )
-        {
-            if ( ThData[i].fWorking )
-                continue;
-            ThData[i].p = (Gia_Man_t*)Vec_PtrPop( vStack );
-            ThData[i].fWorking = 1;   
-            break;
-        }
-    }
-    Vec_PtrFree( vStack );    
-    // wait till threads finish
-    for ( i = 0; i < nProcs; i++ )
-        if ( ThData[i].fWorking )
-            i = -1;
-    // stop threads
-    for ( i = 0; i < nProcs; i++ )
-    {
-        assert( !ThData[i].fWorking );
-        // stop
-        ThData[i].p = NULL;
-        ThData[i].fWorking = 1;
-    }
-
+    Cec_ManCorSetDefaultParams( &Task.CorPars );
+    Task.vGias = vGias;
+    Util_TaskParallelFor( pPars->nProcs, Vec_PtrSize(vGias), Ssw_GiaProcessItem, &Task );
 }
 
-#endif // pthreads are used
-
 
 /**Function*************************************************************
 
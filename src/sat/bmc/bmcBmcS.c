@@ -46,16 +46,7 @@
 
 
 
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-    #include "../lib/pthread.h"
-#else
-    #include <pthread.h>
-    #include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilTask.h"
 
 
 ABC_NAMESPACE_IMPL_START
@@ -723,6 +714,7 @@ int Bmcs_ManPerformOne( Gia_Man_t * pGia, Bmc_AndPar_t * pPars )
   SeeAlso     []
 
 ***********************************************************************/
+// without threads, the race would run the solvers one after another
 #ifndef ABC_USE_PTHREADS
 
 int Bmcs_ManPerformMulti( Gia_Man_t * pGia, Bmc_AndPar_t * pPars ) { return Bmcs_ManPerformOne(pGia, pPars); }
@@ -735,74 +727,41 @@ typedef struct Par_ThData_t_
     bmc_sat_solver *  pSat;
     int         iLit;
     int         iThread;
-    int         fWorking;
     int         status;
 } Par_ThData_t;
 
-void * Bmcs_ManWorkerThread( void * pArg )
+void * Bmcs_ManWorkerTask( void * pArg )
 {
     Par_ThData_t * pThData = (Par_ThData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->pSat == NULL )
-        {
-            pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-
-        pThData->status = bmc_sat_solver_solve( pThData->pSat, &pThData->iLit, 1 );
-
-        //printf( "Thread %d finished with status %d\n", pThData->iThread, pThData->status );
-
-        pThData->fWorking = 0;
-    }
-    assert( 0 );
+    assert( pThData->pSat != NULL );
+    pThData->status = bmc_sat_solver_solve( pThData->pSat, &pThData->iLit, 1 );
+    //printf( "Thread %d finished with status %d\n", pThData->iThread, pThData->status );
     return NULL;
 }
 
-int Bmcs_ManPerform_Solve( Bmcs_Man_t * p, int iLit, pthread_t * WorkerThread, Par_ThData_t * ThData, int nProcs, int * pSolver )
+int Bmcs_ManPerform_Solve( Bmcs_Man_t * p, int iLit, Util_TaskMan_t * pMan, Par_ThData_t * ThData, int nProcs, int * pSolver )
 {
+    Util_Task_t * pTasks[PAR_THR_MAX];
     int i, status = -1;
-    // set new problem
-    for ( i = 0; i < nProcs; i++ )
-    {
-        ThData[i].iLit = iLit;
-        assert( ThData[i].fWorking == 0 );
-    }
     // start solvers on a new problem
     for ( i = 0; i < nProcs; i++ )
-        ThData[i].fWorking = 1;
-    // check if any of the solvers finished
-    while ( i == nProcs )
     {
-        for ( i = 0; i < nProcs; i++ )
-        {
-            if ( ThData[i].fWorking )
-                continue;
-            // set stop request
-            p->fStopNow = 1;
-            // remember status
-            status = ThData[i].status;
-            //printf( "Solver %d returned status %d.\n", i, status );
-            *pSolver = i;
-            break;
-        }
-    }
-    // wait till threads finish
-    while ( i < nProcs )
-    {
-        for ( i = 0; i < nProcs; i++ )
-            if ( ThData[i].fWorking )
-                break;
+        ThData[i].iLit = iLit;
+        pTasks[i] = Util_TaskSpawn( pMan, Bmcs_ManWorkerTask, ThData + i );
     }
+    // the first solver to finish stops the others
+    i = Util_TaskWaitAny( pTasks, nProcs );
+    assert( i >= 0 );
+    p->fStopNow = 1;
+    status = ThData[i].status;
+    //printf( "Solver %d returned status %d.\n", i, status );
+    *pSolver = i;
+    // wait till the tasks finish
     for ( i = 0; i < nProcs; i++ )
     {
+        Util_TaskWait( pTasks[i] );
+        Util_TaskFree( pTasks[i] );
         ThData[i].iLit = -1;
-        assert( ThData[i].fWorking == 0 );
     }
     // reset stop request
     p->fStopNow = 0;
@@ -812,20 +771,18 @@ int Bmcs_ManPerform_Solve( Bmcs_Man_t * p, int iLit, pthread_t * WorkerThread, P
 int Bmcs_ManPerformMulti( Gia_Man_t * pGia, Bmc_AndPar_t * pPars )
 {
     abctime clkStart = Abc_Clock();
-    pthread_t WorkerThread[PAR_THR_MAX];
     Par_ThData_t ThData[PAR_THR_MAX];
     Bmcs_Man_t * p = Bmcs_ManStart( pGia, pPars );
     int f, k = 0, i = Gia_ManPoNum(pGia), status, RetValue = -1, nClauses = 0, Solver = 0;
+    // the solvers race, so each has its own worker (the manager is extra)
+    Util_TaskMan_t * pMan = Util_TaskManStart( pPars->nProcs + 1 );
     Abc_CexFreeP( &pGia->pCexSeq );
-    // start threads
     for ( i = 0; i < pPars->nProcs; i++ )
     {
         ThData[i].pSat     = p->pSats[i];
         ThData[i].iLit     = -1;
         ThData[i].iThread  =  i;
-        ThData[i].fWorking =  0;
         ThData[i].status   = -1;
-        status = pthread_create( WorkerThread + i, NULL, Bmcs_ManWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
     }
     // solve properties in each timeframe
     for ( f = 0; !pPars->nFramesMax || f < pPars->nFramesMax; f += pPars->nFramesAdd )
@@ -857,7 +814,7 @@ int Bmcs_ManPerformMulti( Gia_Man_t * pGia, Bmc_AndPar_t * pPars )
                 int iLit = Abc_Var2Lit( Vec_IntEntry(&p->vFr2Sat, iObj), 0 );
                 if ( pPars->nTimeOut && (Abc_Clock() - clkStart)/CLOCKS_PER_SEC >= pPars->nTimeOut )
                     break;
-                status = Bmcs_ManPerform_Solve( p, iLit, WorkerThread, ThData, pPars->nProcs, &Solver );
+                status = Bmcs_ManPerform_Solve( p, iLit, pMan, ThData, pPars->nProcs, &Solver );
                 p->timeSat += Abc_Clock() - clk;
                 if ( status == l_False ) // unsat
                 {
@@ -892,13 +849,7 @@ int Bmcs_ManPerformMulti( Gia_Man_t * pGia, Bmc_AndPar_t * pPars )
         if ( k < pPars->nFramesAdd )
             break;
     }
-    // stop threads
-    for ( i = 0; i < pPars->nProcs; i++ )
-    {
-        assert( !ThData[i].fWorking );
-        ThData[i].pSat = NULL;
-        ThData[i].fWorking = 1;
-    }
+    Util_TaskManStop( pMan );
     p->timeOth = Abc_Clock() - clkStart - p->timeUnf - p->timeCnf - p->timeSat;
     if ( RetValue == -1 && !pPars->fNotVerbose )
         printf( "No output failed in %d frames.  ", f + (k < pPars->nFramesAdd ? k+1 : 0) );
@@ -1666,6 +1666,8 @@ void sat_solver2_rollback( sat_solver2* s )
         // temporarily, perform more general proof reduction
 //        Sat_ProofReduce( s->pPrf1, &s->claProofs, s->hProofPivot );
     }
+    else if ( veci_size(&s->claProofs) > (int)s->stats.learnts )
+        veci_resize(&s->claProofs, s->stats.learnts); // partial interpolants of pInt2
     assert( s->pPrf2 == NULL );
 //    if ( s->pPrf2 )
 //        Prf_ManShrink( s->pPrf2, s->stats.learnts );
@@ -1713,6 +1715,45 @@ void sat_solver2_rollback( sat_solver2* s )
     }
 }
 
+// bookmarks the solver before the pending top-level units are propagated
+// (the units are taken off the trail and re-enqueued by sat_solver2_enqueue_units(),
+// so that the implications derived from them are rolled back together with the proof)
+void sat_solver2_bookmark_units( sat_solver2* s )
+{
+    int c, x;
+    assert( solver2_dlevel(s) == 0 );
+    for ( c = s->qtail-1; c >= s->qhead; c-- )
+    {
+        x = lit_var(s->trail[c]);
+        var_set_value(s, x, varX);
+        s->reasons[x] = 0;
+        s->units[x] = 0;
+        order_unassigned(s, x);
+    }
+    s->qtail = s->qhead;
+    sat_solver2_bookmark( s );
+}
+
+// enqueues the original unit clauses at the top level; returns 0 if one of them is falsified
+int sat_solver2_enqueue_units( sat_solver2* s )
+{
+    Sat_Mem_t * pMem = &s->Mem;
+    clause * c;
+    int i, k;
+    assert( solver2_dlevel(s) == 0 );
+    Sat_MemForEachClause2( pMem, c, i, k )
+    {
+        if ( c->size != 1 || var_value(s, lit_var(c->lits[0])) == lit_sign(c->lits[0]) )
+            continue;
+        if ( var_value(s, lit_var(c->lits[0])) != varX )
+            return 0;
+        if ( s->fProofLogging )
+            var_set_unit_clause( s, lit_var(c->lits[0]), Sat_MemHand(pMem, i, k) );
+        solver2_enqueue( s, c->lits[0], 0 );
+    }
+    return 1;
+}
+
 // returns memory in bytes used by the SAT solver
 double sat_solver2_memory( sat_solver2* s, int fAll )
 {
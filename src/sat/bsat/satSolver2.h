@@ -52,6 +52,8 @@ extern int          sat_solver2_addclause(sat_solver2* s, lit* begin, lit* end,
 extern int          sat_solver2_simplify(sat_solver2* s);
 extern int          sat_solver2_solve(sat_solver2* s, lit* begin, lit* end, ABC_INT64_T nConfLimit, ABC_INT64_T nInsLimit, ABC_INT64_T nConfLimitGlobal, ABC_INT64_T nInsLimitGlobal);
 extern void         sat_solver2_rollback(sat_solver2* s);
+extern void         sat_solver2_bookmark_units(sat_solver2* s);
+extern int          sat_solver2_enqueue_units(sat_solver2* s);
 extern void         sat_solver2_reducedb(sat_solver2* s);
 extern double       sat_solver2_memory( sat_solver2* s, int fAll );
 extern double       sat_solver2_memory_proof( sat_solver2* s );
@@ -76,6 +78,8 @@ extern void *       Sat_ProofInterpolant( sat_solver2 * s, void * pGloVars );
 extern word *       Sat_ProofInterpolantTruth( sat_solver2 * s, void * pGloVars );
 extern void         Sat_ProofCheck( sat_solver2 * s );
 
+struct Cnf_Man_t_;
+
 // interpolation APIs
 extern Int2_Man_t * Int2_ManStart( sat_solver2 * pSat, int * pGloVars, int nGloVars );
 extern void         Int2_ManStop( Int2_Man_t * p );
@@ -83,9 +87,18 @@ extern int          Int2_ManChainStart( Int2_Man_t * p, clause * c );
 extern int          Int2_ManChainResolve( Int2_Man_t * p, clause * c, int iLit, int varA );
 extern void *       Int2_ManReadInterpolant( sat_solver2 * s );
 
+// the values returned by the FD engines that are not patches (NULL stands for SAT)
+#define CEC_FD_PATCH_UNSOLVE ((Gia_Man_t *)(ABC_PTRUINT_T)1)
+#define CEC_FD_PATCH_HUGE    ((Gia_Man_t *)(ABC_PTRUINT_T)2)
+
 extern sat_solver2 *Int2_ManSolver( Gia_Man_t *p, Vec_Int_t *vNdMap );
-extern Gia_Man_t *  Int2_ManFd( sat_solver2 * pSat, Vec_Int_t* vG, int varF, int nConflicts, int fVerbose );
+extern Gia_Man_t *  Int2_ManFdInc( sat_solver2 * pSat, Vec_Int_t* vG, int varF, int nConflicts, Vec_Wec_t* vLearnt, int* nConf );
 extern Gia_Man_t *  Int2_ManFdSimp( Gia_Man_t * p, int nConflim, int* nConf );
+extern Gia_Man_t *  Int2_ManFdSimpMan( struct Cnf_Man_t_ * pCnfMan, Gia_Man_t * p, int nConflim, int* nConf );
+extern void         Int2_ManFdBatchMan( struct Cnf_Man_t_ * pCnfMan, Gia_Man_t * p, int nTargets, Vec_Wec_t * vTargetG, int nConflim, Vec_Ptr_t * vPatches, Vec_Int_t * vConf );
+extern Gia_Man_t *  Int2_ManFdTrace( Gia_Man_t * p, int nConflim, int* nConf );
+extern Gia_Man_t *  Int2_ManFdTraceMan( struct Cnf_Man_t_ * pCnfMan, Gia_Man_t * p, int nConflim, int* nConf );
+extern Gia_Man_t *  Int2_ManMinimize( Gia_Man_t * p, Gia_Man_t * pCare, int nConfLim, Vec_Wrd_t * vStats );
 
 //=================================================================================================
 // Solver representation:
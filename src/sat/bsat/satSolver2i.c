@@ -19,9 +19,12 @@
 ***********************************************************************/
 
 #include "satSolver2.h"
+#include "satSolver.h"
+#include "satStore.h"
 // #include "aig/gia/gia.h"
 #include "aig/gia/giaAig.h"
 #include "sat/cnf/cnf.h"
+#include "sat/satoko/satoko.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -153,7 +156,7 @@ int Int2_ManChainResolve( Int2_Man_t * p, clause * c, int iLit, int varA )
     if ( iLit2 < 0 || Abc_Lit2Var(iLit2) >= Gia_ManObjNum(p->pGia) ) {
         // printf("iLit = %d, iLit2 = %d, varA = %d, clauseA = %d, clauseLearn = %d, cLast = %d\n", iLit, iLit2, varA, c->partA, c->lrn, c->lits[c->size]);
         // Gia_SelfDefShow( p->pGia, "current_patch.dot", 0, 0, NULL );
-        Gia_ManStop(p->pGia);
+        Gia_ManStopP(&p->pGia);
         return -1;
     } 
     
@@ -292,7 +295,7 @@ sat_solver2 * Int2_ManSolver( Gia_Man_t *p, Vec_Int_t *vVarMap ) {
     assert( vVarMap == NULL || Vec_IntSize(vVarMap) == Gia_ManObjNum(p) );
     // derive CNFs
     pMan = Gia_ManToAigSimple( p );
-    pCnf = Cnf_Derive( pMan, Gia_ManCoNum(p) );
+    pCnf = Cnf_DeriveSimple( pMan, Gia_ManCoNum(p) ); // every node gets a variable, so that any node can be F or G
     pSat = sat_solver2_new();
     sat_solver2_setnvars( pSat, 3 * pCnf->nVars + 1 );
     
@@ -308,70 +311,96 @@ sat_solver2 * Int2_ManSolver( Gia_Man_t *p, Vec_Int_t *vVarMap ) {
         }
     }
     
+    // unit clauses go last, otherwise clauses falsified by them at the top level
+    // would produce learned clauses before the interpolation manager is started
+    for ( k = 0; k < 2; k++ )
     for ( i = 0; i < pCnf->nClauses; i++ )
     {
+        if ( (pCnf->pClauses[i+1] - pCnf->pClauses[i] == 1) != k ) continue;
         Cid = sat_solver2_addclause( pSat, pCnf->pClauses[i], pCnf->pClauses[i+1], -1 );
         clause2_set_partA( pSat, Cid, 1 ); // this API should be called for each clause of A
     }
 
     Cnf_DataLift( pCnf, pCnf->nVars );
+    for ( k = 0; k < 2; k++ )
     for ( i = 0; i < pCnf->nClauses; i++ )
-        sat_solver2_addclause( pSat, pCnf->pClauses[i], pCnf->pClauses[i+1], -1 );
+        if ( (pCnf->pClauses[i+1] - pCnf->pClauses[i] == 1) == k )
+            sat_solver2_addclause( pSat, pCnf->pClauses[i], pCnf->pClauses[i+1], -1 );
     Cnf_DataLift( pCnf, -pCnf->nVars );
 
     for ( i = 0; i < pCnf->nVars; i++ )
         sat_solver2_add_controlBuffer( pSat, i, pCnf->nVars + i, 2 * pCnf->nVars + i, 0, 0, -1 );
     // Sat_Solver2WriteDimacs( pSat, "patch_new.dimac", 0, 0, 0 ); // bound equiv vars
+    sat_solver2_bookmark_units( pSat );
 
     Cnf_DataFree( pCnf );
     Aig_ManStop( pMan );
     return pSat;
 }
-Gia_Man_t * Int2_ManFd( sat_solver2 * pSat, Vec_Int_t* vG, int varF, int nConflicts, int fVerbose ) {
-    Gia_Man_t * pInter;
-    Vec_Int_t* assumptions;
-    assert( pSat->size % 3 == 1 );
+/**Function*************************************************************
+
+  Synopsis    [Incremental FD query on the persistent solver of Int2_ManSolver().]
+
+  Description [The solver should be bookmarked by sat_solver2_bookmark_units().
+  The variables in vG become global, the query is solved under the assumptions
+  (control of vG is 0, varF is 1 in copy A and 0 in copy B), the learned clauses
+  of size at most 3 are collected into vLearnt, and the solver is rolled back
+  to the bookmark.  Returns the interpolant, 0 for SAT, 1 for undecided.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t * Int2_ManFdInc( sat_solver2 * pSat, Vec_Int_t* vG, int varF, int nConflicts, Vec_Wec_t* vLearnt, int* nConf ) {
+    Sat_Mem_t * pSatMem = &pSat->Mem;
+    Int2_Man_t * pInt;
+    Gia_Man_t * pInter = NULL;
+    Vec_Int_t * assumptions;
+    clause * c;
     int nVars = (pSat->size - 1) / 3;
-    int i, var, status;
-    assumptions = Vec_IntAlloc( 2 + Vec_IntSize(vG) ); // or all var should be set
+    int i, k, var, status;
+    ABC_INT64_T nConfStart = pSat->stats.conflicts;
+    assert( pSat->size % 3 == 1 );
+    assert( pSat->pInt2 == NULL );
+    // the interpolants of A-clauses are cached for the previous G
+    Sat_MemForEachClause2( pSatMem, c, i, k )
+        if ( c->partA )
+            clause_set_id( c, -1 );
+    assumptions = Vec_IntAlloc( 2 + Vec_IntSize(vG) );
     Vec_IntForEachEntry( vG, var, i ) {
-        assert(var_is_partA( pSat, var ) == 1);
+        assert( var_is_partA( pSat, var ) == 1 );
         var_set_partA( pSat, var, 0 );
-        Vec_IntPush( assumptions, toLitCond( 2 * nVars + var, 1 ) ); // all G should be 0
-        // Vec_IntWriteEntry( vG, i, 2 * nVars + var );
+        Vec_IntPush( assumptions, toLitCond( 2 * nVars + var, 1 ) ); // all G should be equal
     }
-    // printf("pre:\n");
-    // Sat_Solver2WriteDimacs( pSat, "patch.dimac", 0, 0, 0 );
     Vec_IntPush( assumptions, toLitCond( varF, 0 ) );
-    Vec_IntPush( assumptions, toLitCond( varF + nVars, 1 ) ); // F should be 1
-    pSat->pInt2 = Int2_ManStart( pSat, Vec_IntArray(vG), Vec_IntSize(vG) );
+    Vec_IntPush( assumptions, toLitCond( varF + nVars, 1 ) ); // F should be different
+    status = sat_solver2_enqueue_units( pSat );
+    assert( status );
+    pSat->pInt2 = pInt = Int2_ManStart( pSat, Vec_IntArray(vG), Vec_IntSize(vG) );
     status = sat_solver2_solve( pSat, Vec_IntArray(assumptions), Vec_IntLimit(assumptions), nConflicts, 0, 0, 0 );
-    Vec_IntForEachEntry( vG, var, i ) {
+    if ( nConf ) *nConf = (int)(pSat->stats.conflicts - nConfStart);
+    if ( status == l_False )
+        pInter = pSat->pInt2 ? (Gia_Man_t *)Int2_ManReadInterpolant( pSat ) : CEC_FD_PATCH_UNSOLVE; // the proof is broken
+    else if ( status == l_Undef )
+        pInter = CEC_FD_PATCH_UNSOLVE;
+    if ( vLearnt )
+        Sat_Solver2Learnts( pSat, vLearnt );
+    pSat->pInt2 = NULL;
+    Int2_ManStop( pInt );
+    sat_solver2_rollback( pSat );
+    Vec_IntForEachEntry( vG, var, i )
         var_set_partA( pSat, var, 1 );
-    }
-    // Sat_Solver2KeepLearnt( pSat );
-
     Vec_IntFree( assumptions );
-    if ( status == l_False ) {
-        if (pSat->pInt2) {
-            pInter = (Gia_Man_t*) Int2_ManReadInterpolant( pSat );
-        } else {
-            printf("problemetic!\n");
-            // Gia_SelfDefShow( pSat->pInt2->pGia, "problemetic.dot", 0, 0, NULL );
-            pInter = -1;
-        }
-    }
-    if ( status == l_False ) {
-        return pInter;
-    } else if ( status == l_Undef ) {
-        return -1;
-    } else {
-        // int * Sat_Solver2GetModel( sat_solver2 * p, int * pVars, int nVars )
-        return 0;
-    }
+    return pInter;
 }
 
 Gia_Man_t * Int2_ManFdSimp( Gia_Man_t * p, int nConflim, int* nConf ) {
+    return Int2_ManFdSimpMan( NULL, p, nConflim, nConf );
+}
+// same as above; the CNF is derived with pCnfMan instead of the global CNF manager
+// when it is given, so that several threads can run the query at the same time
+Gia_Man_t * Int2_ManFdSimpMan( Cnf_Man_t * pCnfMan, Gia_Man_t * p, int nConflim, int* nConf ) {
     // extern void Sat_SolverClauseWriteDimacs( FILE * pFile, clause * pC, int fIncrement );
     Sat_Mem_t * pSatMem;
     clause* c;
@@ -397,7 +426,7 @@ Gia_Man_t * Int2_ManFdSimp( Gia_Man_t * p, int nConflim, int* nConf ) {
     }
 
     pMan = Gia_ManToAigSimple( p );
-    pCnf = Cnf_Derive( pMan, Gia_ManCoNum(p) );
+    pCnf = pCnfMan ? Cnf_DeriveWithMan( pCnfMan, pMan, Gia_ManCoNum(p) ) : Cnf_Derive( pMan, Gia_ManCoNum(p) );
 
     Vec_IntForEachEntry( vGVars, nid, i ) {
         Vec_IntWriteEntry( vGVars, i, Abc_Lit2Var(Gia_ObjValue(Gia_ManObj(p, nid)))); // the last one is the output variable
@@ -539,6 +568,763 @@ Gia_Man_t * Int2_ManFdSimp( Gia_Man_t * p, int nConflim, int* nConf ) {
     }
 
 }
+
+/**Function*************************************************************
+
+  Synopsis    [Solver of Int2_ManFdBatchMan() for the targets with the same G.]
+
+  Description [Loads the CNF into copy A and copy B, with the equality 
+  clauses of all G of the union. The G in vOwn are global, while the 
+  other G are local to copy A; their controls are assumed to be 1 by the
+  caller, so that their equality clauses are not used.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static sat_solver2 * Int2_ManFdBatchSolver( Cnf_Dat_t * pCnf, Vec_Int_t * vGVars, Vec_Int_t * vOwn )
+{
+    sat_solver2 * pSat;
+    lit Lits[3];
+    int i, k, Var, Cid;
+    pSat = sat_solver2_new();
+    sat_solver2_setnvars( pSat, 3 * pCnf->nVars );
+    for ( i = 0; i < pCnf->nVars; i++ )
+        var_set_partA( pSat, i, 1 );
+    Vec_IntForEachEntry( vOwn, Var, i )
+        var_set_partA( pSat, Var, 0 );
+
+    // add the clauses of A and B, unit clauses go last as in Int2_ManSolver()
+    for ( k = 0; k < 2; k++ )
+    for ( i = 0; i < pCnf->nClauses; i++ )
+    {
+        if ( (pCnf->pClauses[i+1] - pCnf->pClauses[i] == 1) != k ) continue;
+        Cid = sat_solver2_addclause( pSat, pCnf->pClauses[i], pCnf->pClauses[i+1], -1 );
+        clause2_set_partA( pSat, Cid, 1 );
+    }
+    Cnf_DataLift( pCnf, pCnf->nVars );
+    for ( k = 0; k < 2; k++ )
+    for ( i = 0; i < pCnf->nClauses; i++ )
+        if ( (pCnf->pClauses[i+1] - pCnf->pClauses[i] == 1) == k )
+            sat_solver2_addclause( pSat, pCnf->pClauses[i], pCnf->pClauses[i+1], -1 );
+    Cnf_DataLift( pCnf, -pCnf->nVars );
+
+    // add the equality clauses of G
+    Vec_IntForEachEntry( vGVars, Var, i ) {
+        Lits[0] = toLitCond( Var, 0 );
+        Lits[1] = toLitCond( pCnf->nVars + Var, 1 );
+        Lits[2] = toLitCond( 2*pCnf->nVars + Var, 0 );
+        sat_solver2_addclause( pSat, Lits, Lits + 3, -1 );
+        Lits[0] = toLitCond( Var, 1 );
+        Lits[1] = toLitCond( pCnf->nVars + Var, 0 );
+        Lits[2] = toLitCond( 2*pCnf->nVars + Var, 0 );
+        sat_solver2_addclause( pSat, Lits, Lits + 3, -1 );
+    }
+    sat_solver2_bookmark_units( pSat );
+    return pSat;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Batched FD queries of several targets with similar G.]
+
+  Description [The COs of p are the union of the G of the queries followed 
+  by the nTargets targets. Entry t of vTargetG lists the positions of the G 
+  of target t among the first COs (if vTargetG is NULL, every target uses 
+  all of them). The CNF of p is derived once. The targets with the same G 
+  are solved one after another by one solver of Int2_ManFdBatchSolver(),
+  under the assumptions of Int2_ManFdSimpMan() (control of its own G is 0, 
+  the target is 1 in copy A and 0 in copy B) and the controls of the other 
+  G set to 1, and the solver is rolled back to the bookmark after each of 
+  them. The learned clauses of size at most 3 that are in one copy are 
+  added back as the clauses of that copy, so that the next targets start 
+  from them. The interpolation of sat_solver2 labels the variables once per 
+  solver, so the targets with different G use different solvers. Pushes 
+  the interpolant, 0 for SAT, or 1 for undecided into vPatches and the 
+  conflicts into vConf in the order of the targets.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Int2_ManFdBatchMan( Cnf_Man_t * pCnfMan, Gia_Man_t * p, int nTargets, Vec_Wec_t * vTargetG, int nConflim, Vec_Ptr_t * vPatches, Vec_Int_t * vConf ) {
+    Sat_Mem_t * pSatMem;
+    sat_solver2 * pSat = NULL;
+    Int2_Man_t * pInt;
+    Gia_Man_t * pInter;
+    Gia_Obj_t * pObj;
+    Aig_Man_t * pMan;
+    Cnf_Dat_t * pCnf;
+    Vec_Int_t * vGVars, * vFVars, * vLits, * vClause, * vOwn, * vOrder;
+    Vec_Wec_t * vLearnt;
+    clause * c;
+    int nGs = Gia_ManCoNum(p) - nTargets;
+    int nStart = Vec_PtrSize(vPatches);
+    int i, k, t, s, Var, iVar, Pos, Cid, status, fPartA;
+    ABC_INT64_T nConfStart;
+    assert( Gia_ManRegNum(p) == 0 );
+    assert( nTargets > 0 && nGs >= 0 );
+    assert( vTargetG == NULL || Vec_WecSize(vTargetG) == nTargets );
+    assert( Vec_IntSize(vConf) == nStart );
+
+    // derive the CNF
+    pMan = Gia_ManToAigSimple( p );
+    pCnf = pCnfMan ? Cnf_DeriveWithMan( pCnfMan, pMan, Gia_ManCoNum(p) ) : Cnf_Derive( pMan, Gia_ManCoNum(p) );
+    vGVars = Vec_IntAlloc( nGs );
+    vFVars = Vec_IntAlloc( nTargets );
+    Gia_ManForEachCo( p, pObj, i ) {
+        Var = pCnf->pVarNums[Abc_Lit2Var(Gia_ObjValue(Gia_ObjFanin0(pObj)))];
+        assert( Var >= 0 );
+        Vec_IntPush( i < nGs ? vGVars : vFVars, Var );
+    }
+
+    // the targets with the same G are solved one after another
+    vOrder = Vec_IntAlloc( nTargets );
+    for ( t = 0; t < nTargets; t++ ) {
+        Vec_IntForEachEntry( vOrder, s, i )
+            if ( vTargetG == NULL || Vec_IntEqual( Vec_WecEntry(vTargetG, s), Vec_WecEntry(vTargetG, t) ) )
+                break;
+        if ( i < Vec_IntSize(vOrder) ) continue;
+        for ( s = t; s < nTargets; s++ )
+            if ( vTargetG == NULL || Vec_IntEqual( Vec_WecEntry(vTargetG, s), Vec_WecEntry(vTargetG, t) ) )
+                Vec_IntPush( vOrder, s );
+    }
+    assert( Vec_IntSize(vOrder) == nTargets );
+    Vec_PtrFillExtra( vPatches, nStart + nTargets, NULL );
+    Vec_IntFillExtra( vConf, nStart + nTargets, 0 );
+
+    vLits = Vec_IntAlloc( nGs + 2 );
+    vOwn = Vec_IntAlloc( nGs );
+    vLearnt = Vec_WecAlloc( 100 );
+    Vec_IntForEachEntry( vOrder, t, s ) {
+        Var = Vec_IntEntry( vFVars, t );
+        if ( pSat == NULL ) {
+            Vec_IntClear( vOwn );
+            if ( vTargetG == NULL )
+                Vec_IntAppend( vOwn, vGVars );
+            else
+                Vec_IntForEachEntry( Vec_WecEntry(vTargetG, t), Pos, i )
+                    Vec_IntPush( vOwn, Vec_IntEntry(vGVars, Pos) );
+            pSat = Int2_ManFdBatchSolver( pCnf, vGVars, vOwn );
+        }
+        // the interpolants of A-clauses are cached for the previous target
+        pSatMem = &pSat->Mem;
+        Sat_MemForEachClause2( pSatMem, c, i, k )
+            if ( c->partA )
+                clause_set_id( c, -1 );
+        // the other controls go first, so that their equality clauses are satisfied before they can propagate
+        Vec_IntClear( vLits );
+        Vec_IntForEachEntry( vGVars, iVar, i )
+            if ( var_is_partA( pSat, iVar ) )
+                Vec_IntPush( vLits, toLitCond( 2*pCnf->nVars + iVar, 0 ) );
+        Vec_IntForEachEntry( vOwn, iVar, i )
+            Vec_IntPush( vLits, toLitCond( 2*pCnf->nVars + iVar, 1 ) );
+        Vec_IntPush( vLits, toLitCond( Var, 0 ) );
+        Vec_IntPush( vLits, toLitCond( pCnf->nVars + Var, 1 ) ); // F should be different
+        status = sat_solver2_enqueue_units( pSat );
+        assert( status );
+        nConfStart = pSat->stats.conflicts;
+        pSat->pInt2 = pInt = Int2_ManStart( pSat, Vec_IntArray(vOwn), Vec_IntSize(vOwn) );
+        status = sat_solver2_solve( pSat, Vec_IntArray(vLits), Vec_IntLimit(vLits), nConflim, 0, 0, 0 );
+        Vec_IntWriteEntry( vConf, nStart + t, (int)(pSat->stats.conflicts - nConfStart) );
+        pInter = NULL;
+        if ( status == l_False )
+            pInter = pSat->pInt2 ? (Gia_Man_t *)Int2_ManReadInterpolant( pSat ) : CEC_FD_PATCH_UNSOLVE; // the proof is broken
+        else if ( status == l_Undef )
+            pInter = CEC_FD_PATCH_UNSOLVE;
+        Vec_PtrWriteEntry( vPatches, nStart + t, pInter );
+        Vec_WecClear( vLearnt );
+        Sat_Solver2Learnts( pSat, vLearnt );
+        pSat->pInt2 = NULL;
+        Int2_ManStop( pInt );
+        sat_solver2_rollback( pSat );
+        // the next target has different G
+        if ( s == nTargets - 1 || (vTargetG && !Vec_IntEqual( Vec_WecEntry(vTargetG, t), Vec_WecEntry(vTargetG, Vec_IntEntry(vOrder, s + 1)) )) ) {
+            sat_solver2_delete( pSat );
+            pSat = NULL;
+            continue;
+        }
+        // a learned clause without the controls is derived from the clauses of one copy
+        for ( k = 0; k < 2; k++ )
+        Vec_WecForEachLevel( vLearnt, vClause, i ) {
+            if ( (Vec_IntSize(vClause) == 1) != k ) continue;
+            if ( Vec_IntFindMax(vClause) < 2 * pCnf->nVars ) fPartA = 1;
+            else if ( Vec_IntFindMin(vClause) >= 2 * pCnf->nVars && Vec_IntFindMax(vClause) < 4 * pCnf->nVars ) fPartA = 0;
+            else continue;
+            Cid = sat_solver2_addclause( pSat, Vec_IntArray(vClause), Vec_IntLimit(vClause), -1 );
+            clause2_set_partA( pSat, Cid, fPartA );
+        }
+        sat_solver2_bookmark_units( pSat );
+    }
+    assert( pSat == NULL );
+
+    // clean up
+    Vec_WecFree( vLearnt );
+    Vec_IntFree( vLits );
+    Vec_IntFree( vOwn );
+    Vec_IntFree( vOrder );
+    Vec_IntFree( vGVars );
+    Vec_IntFree( vFVars );
+    Cnf_DataFree( pCnf );
+    Aig_ManStop( pMan );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [FD query solved without the interpolation of sat_solver2.]
+
+  Description [Same query and result as Int2_ManFdSimpMan(). The query is
+  solved by satoko, whose proof-tracing hook (satoko_set_trace_func())
+  records the root clauses and the learned clauses into the proof trace
+  (Sto_Man_t). After UNSAT, the trace is replayed by Inta_ManInterpolate(),
+  which labels the root clauses and the resolution steps in the same way as
+  Int2_ManChainStart() and Int2_ManChainResolve(), and the interpolant is
+  copied into a hashed GIA whose CIs are the G of the query. Any solver that
+  can report its root and learned clauses in the order of derivation can
+  produce the trace. The assumptions of Int2_ManFdSimpMan() are added as 
+  unit clauses, so the trace ends with the empty clause. Returns NULL if
+  SAT and CEC_FD_PATCH_UNSOLVE if undecided.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Int2_FdTrace_t_ Int2_FdTrace_t;
+struct Int2_FdTrace_t_ {
+    Sto_Man_t *      pStore;       // the proof trace
+    Vec_Int_t *      vLits;        // the clause being recorded
+};
+static void Int2_ManFdTraceAdd( void * pData, unsigned * pLits, int nLits ) {
+    Int2_FdTrace_t * p = (Int2_FdTrace_t *)pData;
+    int RetValue;
+    // the store sorts the literals, while the first literal of a learned clause is watched by satoko
+    Vec_IntClear( p->vLits );
+    Vec_IntPushArray( p->vLits, (int *)pLits, nLits );
+    RetValue = Sto_ManAddClause( p->pStore, (lit *)Vec_IntArray(p->vLits), (lit *)Vec_IntLimit(p->vLits) );
+    assert( RetValue );
+    (void) RetValue;
+}
+Gia_Man_t * Int2_ManFdTrace( Gia_Man_t * p, int nConflim, int* nConf ) {
+    return Int2_ManFdTraceMan( NULL, p, nConflim, nConf );
+}
+Gia_Man_t * Int2_ManFdTraceMan( Cnf_Man_t * pCnfMan, Gia_Man_t * p, int nConflim, int* nConf ) {
+    satoko_t * pSat;
+    Int2_FdTrace_t Trace;
+    Inta_Man_t * pManInter;
+    Gia_Man_t * pInter;
+    Gia_Obj_t * pObj_gia;
+    Aig_Man_t * pMan, * pAigInter;
+    Aig_Obj_t * pObj;
+    Vec_Int_t * vGVars;
+    Cnf_Dat_t * pCnf;
+    int varF = -1, Var, status, fOk = 1;
+    int nid, i;
+    lit Lits[2];
+    assert( Gia_ManRegNum(p) == 0 );
+
+    vGVars = Vec_IntAlloc( Gia_ManCoNum(p) );
+    Gia_ManForEachCo( p, pObj_gia, i ) {
+        if (i != Gia_ManCoNum(p) - 1) Vec_IntPush( vGVars, Gia_ObjFaninId0p(p, pObj_gia) );
+        else varF = Gia_ObjFaninId0p(p, pObj_gia);
+    }
+    // the interpolant of the trace needs at least one global variable
+    if ( Vec_IntSize(vGVars) == 0 ) {
+        Vec_IntFree( vGVars );
+        return Int2_ManFdSimpMan( pCnfMan, p, nConflim, nConf );
+    }
+
+    pMan = Gia_ManToAigSimple( p );
+    pCnf = pCnfMan ? Cnf_DeriveWithMan( pCnfMan, pMan, Gia_ManCoNum(p) ) : Cnf_Derive( pMan, Gia_ManCoNum(p) );
+    Vec_IntForEachEntry( vGVars, nid, i ) {
+        pObj = (Aig_Obj_t*) Vec_PtrGetEntry( pMan->vObjs, Abc_Lit2Var(Gia_ObjValue(Gia_ManObj(p, nid))) );
+        assert( pCnf->pVarNums[pObj->Id] >= 0 );
+        Vec_IntWriteEntry( vGVars, i, pCnf->pVarNums[pObj->Id] );
+    }
+    pObj = (Aig_Obj_t*) Vec_PtrGetEntry( pMan->vObjs, Abc_Lit2Var(Gia_ObjValue(Gia_ManObj(p, varF))) );
+    assert( pCnf->pVarNums[pObj->Id] >= 0 );
+    varF = pCnf->pVarNums[pObj->Id];
+
+    pSat = satoko_create();
+    satoko_setnvars( pSat, 2 * pCnf->nVars );
+    Trace.pStore = Sto_ManAlloc();
+    Trace.vLits  = Vec_IntAlloc( 100 );
+    satoko_set_trace_func( pSat, Int2_ManFdTraceAdd, &Trace );
+
+    // clauses of A: the first copy with F = 1
+    for ( i = 0; fOk && i < pCnf->nClauses; i++ )
+        fOk = satoko_add_clause( pSat, pCnf->pClauses[i], pCnf->pClauses[i+1] - pCnf->pClauses[i] );
+    Lits[0] = toLitCond( varF, 0 );
+    fOk = fOk && satoko_add_clause( pSat, (int *)Lits, 1 );
+    Sto_ManMarkClausesA( Trace.pStore );
+
+    // clauses of B: the second copy with F = 0 and the same G
+    Cnf_DataLift( pCnf, pCnf->nVars );
+    for ( i = 0; fOk && i < pCnf->nClauses; i++ )
+        fOk = satoko_add_clause( pSat, pCnf->pClauses[i], pCnf->pClauses[i+1] - pCnf->pClauses[i] );
+    Cnf_DataLift( pCnf, -pCnf->nVars );
+    Lits[0] = toLitCond( pCnf->nVars + varF, 1 );
+    fOk = fOk && satoko_add_clause( pSat, (int *)Lits, 1 );
+    Vec_IntForEachEntry( vGVars, Var, i ) {
+        Lits[0] = toLitCond( Var, 0 );
+        Lits[1] = toLitCond( pCnf->nVars + Var, 1 );
+        fOk = fOk && satoko_add_clause( pSat, (int *)Lits, 2 );
+        Lits[0] = toLitCond( Var, 1 );
+        Lits[1] = toLitCond( pCnf->nVars + Var, 0 );
+        fOk = fOk && satoko_add_clause( pSat, (int *)Lits, 2 );
+    }
+    Sto_ManMarkRoots( Trace.pStore );
+    Cnf_DataFree( pCnf );
+    Aig_ManStop( pMan );
+
+    // the conflict is found while adding the clauses, the trace has no empty clause
+    if ( !fOk ) {
+        satoko_destroy( pSat );
+        Sto_ManFree( Trace.pStore );
+        Vec_IntFree( Trace.vLits );
+        Vec_IntFree( vGVars );
+        return Int2_ManFdSimpMan( pCnfMan, p, nConflim, nConf );
+    }
+
+    status = satoko_solve_assumptions_limit( pSat, NULL, 0, nConflim );
+    *nConf = satoko_conflictnum( pSat );
+    satoko_destroy( pSat );
+    Vec_IntFree( Trace.vLits );
+    if ( status != SATOKO_UNSAT ) {
+        Sto_ManFree( Trace.pStore );
+        Vec_IntFree( vGVars );
+        return status == SATOKO_SAT ? NULL : CEC_FD_PATCH_UNSOLVE;
+    }
+
+    // replay the trace
+    pManInter = Inta_ManAlloc();
+    pAigInter = (Aig_Man_t *)Inta_ManInterpolate( pManInter, Trace.pStore, 0, vGVars, 0 );
+    Inta_ManFree( pManInter );
+    Sto_ManFree( Trace.pStore );
+    Vec_IntFree( vGVars );
+    if ( pAigInter == NULL )
+        return CEC_FD_PATCH_UNSOLVE;
+    pInter = Gia_ManFromAig( pAigInter );
+    Aig_ManStop( pAigInter );
+    ABC_FREE( pInter->pName );
+    pInter->pName = Abc_UtilStrsav( "interpolant" );
+    return pInter;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Minimisation of the interpolants of the FD queries.]
+
+  Description [The interpolant is rebuilt in three stages, each kept only
+  if it does not increase the number of AND nodes.
+  (1) chain: the AND/OR chains of the resolution steps are flattened into
+  supergates, duplicated leaves are removed, complementary leaves give the
+  constant, and the leaves (a | b) are absorbed or simplified by the other
+  leaves of the same supergate.
+  (2) sweep: the nodes of the interpolant are composed with the care 
+  circuit pCare (its first COs are the G, in the order of the CIs of the 
+  interpolant) and simulated; the nodes with equal signatures are proved 
+  equal by SAT on the composed circuit and merged.
+  (3) supp: each G input is replaced by a constant if the interpolant does
+  not change on the values of G produced by pCare.
+  Without pCare, any value of G is a care value. Since the interpolant only
+  has to agree with F on the values of G produced by the circuit, the 
+  stages 2 and 3 use these values as the care set. vStats, if given, 
+  accumulates the AND nodes before and after, and the time of each stage.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+typedef struct Int2_Min_t_ Int2_Min_t;
+struct Int2_Min_t_
+{
+    Gia_Man_t *     pComb;     // the care circuit composed with the interpolants
+    Vec_Int_t *     vCiLits;   // the literals of G in pComb
+    Vec_Wrd_t *     vSims;     // the simulation info of the objects of pComb
+    sat_solver *    pSat;      // the CNF of pComb (the variable of an object is its ID)
+    int             nSatObjs;  // the number of objects of pComb in the solver
+    int             nWords;    // the number of simulation words
+    int             nConfLim;  // the conflict limit of a check
+};
+static int Int2_ManMinSuper_rec( Gia_Man_t * p, Gia_Obj_t * pObj, Vec_Int_t * vSuper, int fFirst ) 
+{
+    if ( !fFirst && (!Gia_ObjIsAnd(pObj) || Gia_ObjRefNum(p, pObj) > 1) )
+    {
+        Vec_IntPush( vSuper, Gia_ObjId(p, pObj) );
+        return 0;
+    }
+    if ( Gia_ObjFaninC0(pObj) ) Vec_IntPush( vSuper, -Gia_ObjFaninId0p(p, pObj)-1 );
+    else Int2_ManMinSuper_rec( p, Gia_ObjFanin0(pObj), vSuper, 0 );
+    if ( Gia_ObjFaninC1(pObj) ) Vec_IntPush( vSuper, -Gia_ObjFaninId1p(p, pObj)-1 );
+    else Int2_ManMinSuper_rec( p, Gia_ObjFanin1(pObj), vSuper, 0 );
+    return 0;
+}
+static int Int2_ManMinChain_rec( Gia_Man_t * pNew, Gia_Man_t * p, Gia_Obj_t * pObj )
+{
+    Vec_Int_t * vSuper, * vLits;
+    Gia_Obj_t * pLeaf;
+    int i, k, Entry, iLit, iLit0, iLit1, fChange = 1;
+    if ( ~pObj->Value )
+        return pObj->Value;
+    assert( Gia_ObjIsAnd(pObj) );
+    // the leaves are the IDs of the positive leaves and -ID-1 of the complemented ones
+    vSuper = Vec_IntAlloc( 16 );
+    Int2_ManMinSuper_rec( p, pObj, vSuper, 1 );
+    vLits = Vec_IntAlloc( Vec_IntSize(vSuper) );
+    Vec_IntForEachEntry( vSuper, Entry, i )
+    {
+        pLeaf = Gia_ManObj( p, Entry < 0 ? -Entry-1 : Entry );
+        Vec_IntPush( vLits, Abc_LitNotCond( Int2_ManMinChain_rec(pNew, p, pLeaf), Entry < 0 ) );
+    }
+    Vec_IntFree( vSuper );
+    // simplify the leaves: x & x = x, x & !x = 0, x & (!x | y) = x & y, x & (x | y) = x
+    while ( fChange )
+    {
+        fChange = 0;
+        Vec_IntUniqify( vLits );
+        if ( Vec_IntSize(vLits) > 0 && Vec_IntEntry(vLits, 0) == 0 )
+        {
+            Vec_IntFree( vLits );
+            return pObj->Value = 0;
+        }
+        if ( Vec_IntSize(vLits) > 0 && Vec_IntEntry(vLits, 0) == 1 )
+        {
+            Vec_IntDrop( vLits, 0 );
+            fChange = 1;
+            continue;
+        }
+        for ( i = 1; i < Vec_IntSize(vLits); i++ )
+            if ( Vec_IntEntry(vLits, i-1) == Abc_LitNot(Vec_IntEntry(vLits, i)) )
+            {
+                Vec_IntFree( vLits );
+                return pObj->Value = 0;
+            }
+        Vec_IntForEachEntry( vLits, iLit, i )
+        {
+            if ( !Abc_LitIsCompl(iLit) || !Gia_ObjIsAnd(Gia_ManObj(pNew, Abc_Lit2Var(iLit))) )
+                continue;
+            // iLit = !a | !b
+            iLit0 = Gia_ObjFaninLit0p( pNew, Gia_ManObj(pNew, Abc_Lit2Var(iLit)) );
+            iLit1 = Gia_ObjFaninLit1p( pNew, Gia_ManObj(pNew, Abc_Lit2Var(iLit)) );
+            for ( k = 0; k < Vec_IntSize(vLits); k++ )
+            {
+                if ( k == i ) continue;
+                if ( Vec_IntEntry(vLits, k) == Abc_LitNot(iLit0) || Vec_IntEntry(vLits, k) == Abc_LitNot(iLit1) )
+                    break; // absorbed
+                if ( Vec_IntEntry(vLits, k) == iLit0 ) { Vec_IntWriteEntry( vLits, i, Abc_LitNot(iLit1) ); break; }
+                if ( Vec_IntEntry(vLits, k) == iLit1 ) { Vec_IntWriteEntry( vLits, i, Abc_LitNot(iLit0) ); break; }
+            }
+            if ( k == Vec_IntSize(vLits) )
+                continue;
+            if ( Vec_IntEntry(vLits, i) == iLit )
+                Vec_IntDrop( vLits, i );
+            fChange = 1;
+            break;
+        }
+    }
+    // build a balanced tree
+    if ( Vec_IntSize(vLits) == 0 )
+        Vec_IntPush( vLits, 1 );
+    while ( Vec_IntSize(vLits) > 1 )
+    {
+        for ( i = k = 0; i + 1 < Vec_IntSize(vLits); i += 2 )
+            Vec_IntWriteEntry( vLits, k++, Gia_ManHashAnd(pNew, Vec_IntEntry(vLits, i), Vec_IntEntry(vLits, i+1)) );
+        if ( i < Vec_IntSize(vLits) )
+            Vec_IntWriteEntry( vLits, k++, Vec_IntEntry(vLits, i) );
+        Vec_IntShrink( vLits, k );
+    }
+    pObj->Value = Vec_IntEntry( vLits, 0 );
+    Vec_IntFree( vLits );
+    return pObj->Value;
+}
+static Gia_Man_t * Int2_ManMinChain( Gia_Man_t * p )
+{
+    Gia_Man_t * pNew, * pTemp;
+    Gia_Obj_t * pObj;
+    int i;
+    Gia_ManCreateRefs( p );
+    Gia_ManFillValue( p );
+    pNew = Gia_ManStart( Gia_ManObjNum(p) );
+    pNew->pName = Abc_UtilStrsav( p->pName );
+    Gia_ManConst0(p)->Value = 0;
+    Gia_ManForEachCi( p, pObj, i )
+        pObj->Value = Gia_ManAppendCi( pNew );
+    Gia_ManHashStart( pNew );
+    Gia_ManForEachCo( p, pObj, i )
+        Int2_ManMinChain_rec( pNew, p, Gia_ObjFanin0(pObj) );
+    Gia_ManForEachCo( p, pObj, i )
+        Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(pObj) );
+    Gia_ManHashStop( pNew );
+    ABC_FREE( p->pRefs );
+    pNew = Gia_ManCleanup( pTemp = pNew );
+    Gia_ManStop( pTemp );
+    return pNew;
+}
+// composes p with the care circuit; the Value of the objects of p are the literals in pComb
+static int Int2_ManMinEmbed( Int2_Min_t * q, Gia_Man_t * p )
+{
+    Gia_Obj_t * pObj;
+    int i;
+    Gia_ManConst0(p)->Value = 0;
+    Gia_ManForEachCi( p, pObj, i )
+        pObj->Value = Vec_IntEntry( q->vCiLits, i );
+    Gia_ManForEachAnd( p, pObj, i )
+        pObj->Value = Gia_ManHashAnd( q->pComb, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+    return Gia_ObjFanin0Copy( Gia_ManCo(p, 0) );
+}
+// simulates and loads into the solver the objects of pComb added since the last call
+static void Int2_ManMinUpdate( Int2_Min_t * q )
+{
+    Gia_Obj_t * pObj;
+    word * pSim, * pSim0, * pSim1;
+    int i, w;
+    for ( i = Vec_WrdSize(q->vSims) / q->nWords; i < Gia_ManObjNum(q->pComb); i++ )
+    {
+        pObj = Gia_ManObj( q->pComb, i );
+        Vec_WrdFillExtra( q->vSims, (i+1) * q->nWords, 0 );
+        pSim = Vec_WrdEntryP( q->vSims, i * q->nWords );
+        if ( Gia_ObjIsCi(pObj) )
+        {
+            for ( w = 0; w < q->nWords; w++ )
+                pSim[w] = Abc_RandomW( 0 );
+            continue;
+        }
+        if ( !Gia_ObjIsAnd(pObj) )
+            continue;
+        pSim0 = Vec_WrdEntryP( q->vSims, Gia_ObjFaninId0(pObj, i) * q->nWords );
+        pSim1 = Vec_WrdEntryP( q->vSims, Gia_ObjFaninId1(pObj, i) * q->nWords );
+        for ( w = 0; w < q->nWords; w++ )
+            pSim[w] = (Gia_ObjFaninC0(pObj) ? ~pSim0[w] : pSim0[w]) & (Gia_ObjFaninC1(pObj) ? ~pSim1[w] : pSim1[w]);
+    }
+    sat_solver_setnvars( q->pSat, Gia_ManObjNum(q->pComb) );
+    for ( i = q->nSatObjs; i < Gia_ManObjNum(q->pComb); i++ )
+    {
+        pObj = Gia_ManObj( q->pComb, i );
+        if ( Gia_ObjIsAnd(pObj) )
+            sat_solver_add_and( q->pSat, i, Gia_ObjFaninId0(pObj, i), Gia_ObjFaninId1(pObj, i), Gia_ObjFaninC0(pObj), Gia_ObjFaninC1(pObj), 0 );
+    }
+    q->nSatObjs = Gia_ManObjNum(q->pComb);
+}
+// returns 1 if the two literals of pComb are equal on the care set
+static int Int2_ManMinEquiv( Int2_Min_t * q, int iLit0, int iLit1 )
+{
+    word * pSim0 = Vec_WrdEntryP( q->vSims, Abc_Lit2Var(iLit0) * q->nWords );
+    word * pSim1 = Vec_WrdEntryP( q->vSims, Abc_Lit2Var(iLit1) * q->nWords );
+    lit Lits[2];
+    int w, k;
+    if ( iLit0 == iLit1 )
+        return 1;
+    for ( w = 0; w < q->nWords; w++ )
+        if ( (Abc_LitIsCompl(iLit0) ? ~pSim0[w] : pSim0[w]) != (Abc_LitIsCompl(iLit1) ? ~pSim1[w] : pSim1[w]) )
+            return 0;
+    // the literals of GIA are the literals of the solver
+    for ( k = 0; k < 2; k++ )
+    {
+        Lits[0] = Abc_LitNotCond( iLit0, k );
+        Lits[1] = Abc_LitNotCond( iLit1, !k );
+        if ( sat_solver_solve( q->pSat, Lits, Lits + 2, (ABC_INT64_T)q->nConfLim, 0, 0, 0 ) != l_False )
+            return 0;
+    }
+    return 1;
+}
+static Gia_Man_t * Int2_ManMinSweep( Int2_Min_t * q, Gia_Man_t * p )
+{
+    Gia_Man_t * pNew, * pTemp;
+    Gia_Obj_t * pObj;
+    Vec_Int_t * vComb, * vClass, * vNext;
+    word * pSim;
+    int i, j, w, iLit, fCompl, Key, nBins = 1 << 10;
+    Int2_ManMinEmbed( q, p );
+    Int2_ManMinUpdate( q );
+    vComb = Vec_IntStartFull( Gia_ManObjNum(p) );
+    Gia_ManForEachObj( p, pObj, i )
+        if ( Gia_ObjIsCi(pObj) || Gia_ObjIsAnd(pObj) || i == 0 )
+            Vec_IntWriteEntry( vComb, i, pObj->Value );
+    // the nodes are hashed by the signature normalized to have the first bit 0
+    vClass = Vec_IntStartFull( nBins );
+    vNext  = Vec_IntStartFull( Gia_ManObjNum(p) );
+    pNew = Gia_ManStart( Gia_ManObjNum(p) );
+    pNew->pName = Abc_UtilStrsav( p->pName );
+    Gia_ManFillValue( p );
+    Gia_ManConst0(p)->Value = 0;
+    Gia_ManForEachCi( p, pObj, i )
+        pObj->Value = Gia_ManAppendCi( pNew );
+    Gia_ManHashStart( pNew );
+    Gia_ManForEachObj1( p, pObj, i )
+    {
+        if ( Gia_ObjIsCo(pObj) )
+            continue;
+        iLit   = Vec_IntEntry( vComb, i );
+        pSim   = Vec_WrdEntryP( q->vSims, Abc_Lit2Var(iLit) * q->nWords );
+        fCompl = (int)((pSim[0] & 1) ^ Abc_LitIsCompl(iLit));
+        if ( Gia_ObjIsAnd(pObj) && Int2_ManMinEquiv( q, Abc_LitNotCond(iLit, fCompl), 0 ) )
+        {
+            pObj->Value = fCompl;
+            continue;
+        }
+        for ( Key = w = 0; w < q->nWords; w++ )
+            Key = Key * 0x9E3779B1 + (int)(((fCompl ^ Abc_LitIsCompl(iLit)) ? ~pSim[w] : pSim[w]) % 0x7FFFFFFF);
+        Key = (Key & 0x7FFFFFFF) % nBins;
+        for ( j = Gia_ObjIsAnd(pObj) ? Vec_IntEntry(vClass, Key) : -1; j >= 0; j = Vec_IntEntry(vNext, j) )
+        {
+            int iLitJ   = Vec_IntEntry( vComb, j );
+            int fComplJ = (int)((Vec_WrdEntry(q->vSims, Abc_Lit2Var(iLitJ) * q->nWords) & 1) ^ Abc_LitIsCompl(iLitJ));
+            if ( Int2_ManMinEquiv( q, Abc_LitNotCond(iLit, fCompl), Abc_LitNotCond(iLitJ, fComplJ) ) )
+            {
+                pObj->Value = Abc_LitNotCond( Gia_ManObj(p, j)->Value, fCompl ^ fComplJ );
+                break;
+            }
+        }
+        if ( j >= 0 )
+            continue;
+        if ( Gia_ObjIsAnd(pObj) )
+            pObj->Value = Gia_ManHashAnd( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+        Vec_IntWriteEntry( vNext, i, Vec_IntEntry(vClass, Key) );
+        Vec_IntWriteEntry( vClass, Key, i );
+    }
+    Gia_ManForEachCo( p, pObj, i )
+        Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(pObj) );
+    Gia_ManHashStop( pNew );
+    Vec_IntFree( vComb );
+    Vec_IntFree( vClass );
+    Vec_IntFree( vNext );
+    pNew = Gia_ManCleanup( pTemp = pNew );
+    Gia_ManStop( pTemp );
+    return pNew;
+}
+// the copy of p with the CI iCi replaced by the constant Value
+static Gia_Man_t * Int2_ManMinCofactor( Gia_Man_t * p, int iCi, int Value )
+{
+    Gia_Man_t * pNew, * pTemp;
+    Gia_Obj_t * pObj;
+    int i;
+    pNew = Gia_ManStart( Gia_ManObjNum(p) );
+    pNew->pName = Abc_UtilStrsav( p->pName );
+    Gia_ManConst0(p)->Value = 0;
+    Gia_ManForEachCi( p, pObj, i )
+        pObj->Value = Gia_ManAppendCi( pNew );
+    Gia_ManCi(p, iCi)->Value = Value;
+    Gia_ManHashStart( pNew );
+    Gia_ManForEachAnd( p, pObj, i )
+        pObj->Value = Gia_ManHashAnd( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+    Gia_ManForEachCo( p, pObj, i )
+        Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(pObj) );
+    Gia_ManHashStop( pNew );
+    pNew = Gia_ManCleanup( pTemp = pNew );
+    Gia_ManStop( pTemp );
+    return pNew;
+}
+static Gia_Man_t * Int2_ManMinSupp( Int2_Min_t * q, Gia_Man_t * p )
+{
+    Gia_Man_t * pCof;
+    Gia_Obj_t * pObj;
+    int i, c, iLit, iLitCof;
+    p = Gia_ManDup( p );
+    Gia_ManForEachCi( p, pObj, i )
+    {
+        ABC_FREE( p->pRefs );
+        Gia_ManCreateRefs( p );
+        if ( Gia_ObjRefNum(p, Gia_ManCi(p, i)) == 0 )
+            continue;
+        for ( c = 0; c < 2; c++ )
+        {
+            pCof    = Int2_ManMinCofactor( p, i, c );
+            iLit    = Int2_ManMinEmbed( q, p );
+            iLitCof = Int2_ManMinEmbed( q, pCof );
+            Int2_ManMinUpdate( q );
+            if ( Gia_ManAndNum(pCof) <= Gia_ManAndNum(p) && Int2_ManMinEquiv( q, iLit, iLitCof ) )
+            {
+                Gia_ManStop( p );
+                p = pCof;
+                break;
+            }
+            Gia_ManStop( pCof );
+        }
+    }
+    return p;
+}
+static void Int2_ManMinAccept( Gia_Man_t ** pp, Gia_Man_t * pNew, Vec_Wrd_t * vStats, int Stage, abctime clk )
+{
+    if ( vStats )
+    {
+        Vec_WrdFillExtra( vStats, 3 * (Stage + 1), 0 );
+        Vec_WrdAddToEntry( vStats, 3 * Stage + 0, Gia_ManAndNum(*pp) );
+    }
+    if ( Gia_ManAndNum(pNew) <= Gia_ManAndNum(*pp) )
+    {
+        Gia_ManStop( *pp );
+        *pp = pNew;
+    }
+    else
+        Gia_ManStop( pNew );
+    if ( vStats )
+    {
+        Vec_WrdAddToEntry( vStats, 3 * Stage + 1, Gia_ManAndNum(*pp) );
+        Vec_WrdAddToEntry( vStats, 3 * Stage + 2, Abc_Clock() - clk );
+    }
+}
+Gia_Man_t * Int2_ManMinimize( Gia_Man_t * p, Gia_Man_t * pCare, int nConfLim, Vec_Wrd_t * vStats )
+{
+    Int2_Min_t Min, * q = &Min;
+    Gia_Man_t * pCur = Gia_ManDup( p );
+    Gia_Obj_t * pObj;
+    abctime clk;
+    lit Lit;
+    int i;
+    assert( Gia_ManCoNum(p) == 1 );
+    assert( pCare == NULL || Gia_ManCoNum(pCare) >= Gia_ManCiNum(p) );
+
+    clk = Abc_Clock();
+    Int2_ManMinAccept( &pCur, Int2_ManMinChain(pCur), vStats, 0, clk );
+    if ( Gia_ManAndNum(pCur) == 0 )
+        return pCur;
+
+    // compose the care circuit and the CIs of the interpolant
+    memset( q, 0, sizeof(Int2_Min_t) );
+    q->pComb    = Gia_ManStart( 1000 );
+    q->vCiLits  = Vec_IntAlloc( Gia_ManCiNum(p) );
+    q->nWords   = 4;
+    q->vSims    = Vec_WrdAlloc( 1000 * q->nWords );
+    q->nConfLim = nConfLim;
+    q->pSat     = sat_solver_new();
+    Gia_ManHashStart( q->pComb );
+    if ( pCare )
+    {
+        Gia_ManConst0(pCare)->Value = 0;
+        Gia_ManForEachCi( pCare, pObj, i )
+            pObj->Value = Gia_ManAppendCi( q->pComb );
+        Gia_ManForEachAnd( pCare, pObj, i )
+            pObj->Value = Gia_ManHashAnd( q->pComb, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+        for ( i = 0; i < Gia_ManCiNum(p); i++ )
+            Vec_IntPush( q->vCiLits, Gia_ObjFanin0Copy(Gia_ManCo(pCare, i)) );
+    }
+    else
+    {
+        for ( i = 0; i < Gia_ManCiNum(p); i++ )
+            Vec_IntPush( q->vCiLits, Gia_ManAppendCi(q->pComb) );
+    }
+    sat_solver_setnvars( q->pSat, 1 );
+    Lit = toLitCond( 0, 1 );
+    sat_solver_addclause( q->pSat, &Lit, &Lit + 1 );
+    Abc_RandomW( 1 );
+    Int2_ManMinUpdate( q );
+
+    clk = Abc_Clock();
+    Int2_ManMinAccept( &pCur, Int2_ManMinSweep(q, pCur), vStats, 1, clk );
+    clk = Abc_Clock();
+    Int2_ManMinAccept( &pCur, Int2_ManMinSupp(q, pCur), vStats, 2, clk );
+
+    sat_solver_delete( q->pSat );
+    Gia_ManHashStop( q->pComb );
+    Gia_ManStop( q->pComb );
+    Vec_IntFree( q->vCiLits );
+    Vec_WrdFree( q->vSims );
+    return pCur;
+}
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "cnf.h"
+#include "misc/util/utilTask.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -27,7 +28,9 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-static Cnf_Man_t * s_pManCnf = NULL;
+// each thread has its own manager, released by Util_TaskThreadExit()
+// in the threads other than the one that started ABC
+static ABC_THREAD_LOCAL Cnf_Man_t * s_pManCnf = NULL;
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -49,6 +52,7 @@ void Cnf_ManPrepare()
     {
 //        printf( "\n\nCreating CNF manager!!!!!\n\n" );
         s_pManCnf = Cnf_ManStart();
+        Util_TaskAtThreadExit( Cnf_ManFree );
     }
 }
 Cnf_Man_t * Cnf_ManRead()
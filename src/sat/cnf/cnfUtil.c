@@ -27,15 +27,7 @@
 #include <unistd.h>
 #endif
 
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#endif
-
-#endif
+#include "misc/util/utilTask.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -125,114 +117,64 @@ Vec_Int_t * Cnf_RunSolverArray(int nProcs, int TimeOut, int fVerbose)
   SeeAlso     []
 
 ***********************************************************************/
-#ifndef ABC_USE_PTHREADS
-
-Vec_Int_t *Cnf_RunSolver(int nProcs, int TimeOut, int fVerbose)
+typedef struct Cnf_Task_t_
 {
-    return Cnf_RunSolverArray(nProcs, TimeOut, fVerbose);
-}
-
-#else // pthreads are used
-
-#define PAR_THR_MAX 100
-typedef struct Cnf_ThData_t_
-{
-    Vec_Int_t *vRes;
     int Index;
     int Rand;
     int nTimeOut;
-    int fWorking;
     int fVerbose;
-} Cnf_ThData_t;
+} Cnf_Task_t;
 
-void *Cnf_WorkerThread(void *pArg)
+void *Cnf_RunSolverTask(void *pArg)
 {
-    Cnf_ThData_t *pThData = (Cnf_ThData_t *)pArg;
-    volatile int *pPlace = &pThData->fWorking;
-    while (1)
-    {
-        while (*pPlace == 0)
-            ;
-        assert(pThData->fWorking);
-        if (pThData->Index == -1)
-        {
-            pthread_exit(NULL);
-            assert(0);
-            return NULL;
-        }
-        pThData->vRes = Cnf_RunSolverOnce(pThData->Index, pThData->Rand, pThData->nTimeOut, pThData->fVerbose);
-        pThData->fWorking = 0;
-    }
-    assert(0);
-    return NULL;
+    Cnf_Task_t *p = (Cnf_Task_t *)pArg;
+    return Cnf_RunSolverOnce(p->Index, p->Rand, p->nTimeOut, p->fVerbose);
 }
 
 Vec_Int_t *Cnf_RunSolver(int nProcs, int TimeOut, int fVerbose)
 {
-    Vec_Int_t *vRes = NULL;
-    Cnf_ThData_t ThData[PAR_THR_MAX];
-    pthread_t WorkerThread[PAR_THR_MAX];
-    int i, k, status;
+    Vec_Int_t *vRes = NULL, *vCur;
+    Cnf_Task_t *pTasks;
+    Util_Task_t **ppFutures;
+    Util_TaskMan_t *pMan;
+    int i;
     if (fVerbose)
         printf("Running concurrent solving with %d processes.\n", nProcs);
     fflush(stdout);
     if (nProcs < 2)
         return Cnf_RunSolverArray(nProcs, TimeOut, fVerbose);
-    // subtract manager thread
-    // nProcs--;
-    assert(nProcs >= 1 && nProcs <= PAR_THR_MAX);
-    // start threads
+    // all problems run at the same time (the solvers are external processes)
+    pMan = Util_TaskManStart(nProcs + 1);
+    pTasks = ABC_CALLOC(Cnf_Task_t, nProcs);
+    ppFutures = ABC_CALLOC(Util_Task_t *, nProcs);
     for (i = 0; i < nProcs; i++)
     {
-        ThData[i].vRes     = NULL;
-        ThData[i].Index    = -1;
-        ThData[i].Rand     = Abc_Random(0) % 0x1000000;
-        ThData[i].nTimeOut = TimeOut;
-        ThData[i].fWorking = 0;
-        ThData[i].fVerbose = fVerbose;
-        status = pthread_create(WorkerThread + i, NULL, Cnf_WorkerThread, (void *)(ThData + i));
-        assert(status == 0);
-    }
-    // look at the threads
-    for (k = 0; k < nProcs;)
-    {
-        for (i = 0; i < nProcs; i++)
-        {
-            if (ThData[i].fWorking)
-                continue;
-            if (ThData[i].vRes)
-            {
-                k = nProcs;
-                break;
-            }
-            ThData[i].Index = k++;
-            ThData[i].fWorking = 1;
-            break;
-        }
+        pTasks[i].Index    = i;
+        pTasks[i].Rand     = Abc_Random(0) % 0x1000000;
+        pTasks[i].nTimeOut = TimeOut;
+        pTasks[i].fVerbose = fVerbose;
+        ppFutures[i] = Util_TaskSpawn(pMan, Cnf_RunSolverTask, pTasks + i);
     }
-    // wait till threads finish
-    for (i = 0; i < nProcs; i++)
-        if (ThData[i].fWorking)
-            i = -1;
-    // stop threads
-    for (i = 0; i < nProcs; i++)
+    // the first solution cancels the problems that did not start yet
+    while ((i = Util_TaskWaitAny(ppFutures, nProcs)) >= 0)
     {
-        assert(!ThData[i].fWorking);
-        if (ThData[i].vRes && vRes == NULL)
+        vCur = (Vec_Int_t *)Util_TaskWait(ppFutures[i]);
+        Util_TaskFree(ppFutures[i]);
+        ppFutures[i] = NULL;
+        if (vCur && vRes == NULL)
         {
-            vRes = ThData[i].vRes;
-            ThData[i].vRes = NULL;
+            vRes = vCur;
+            Util_TaskManCancel(pMan);
         }
-        Vec_IntFreeP(&ThData[i].vRes);
-        // stop
-        ThData[i].Index = -1;
-        ThData[i].fWorking = 1;
+        else
+            Vec_IntFreeP(&vCur);
     }
+    Util_TaskManStop(pMan);
+    ABC_FREE(ppFutures);
+    ABC_FREE(pTasks);
     return vRes;
 }
 
-#endif // pthreads are used
-
 
 
 /**Function*************************************************************
@@ -139,6 +139,14 @@ extern int satoko_conflictnum(satoko_t *);
 extern void satoko_set_stop(satoko_t *, int *);
 extern void satoko_set_stop_func(satoko_t *s, int (*fnct)(int));
 extern void satoko_set_runid(satoko_t *, int);
+/* Procedure to log the resolution proof.
+ * - The callback receives the user data, the literals and the size of each
+ *   clause added by satoko_add_clause(), before it is simplified, of each
+ *   learnt clause, in the order of derivation, and of the empty clause (size
+ *   0) when a conflict is found at level 0.
+ * - The literals belong to the solver and should not be modified.
+ */
+extern void satoko_set_trace_func(satoko_t *, void (*)(void *, unsigned *, int), void *);
 extern int satoko_read_cex_varvalue(satoko_t *, int);
 extern abctime satoko_set_runtime_limit(satoko_t *, abctime);
 extern char satoko_var_polarity(satoko_t *, unsigned);
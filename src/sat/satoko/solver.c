@@ -350,6 +350,8 @@ static inline void solver_handle_conflict(solver_t *s, unsigned confl_cref)
     s->sum_lbd += lbd;
     b_queue_push(s->bq_lbd, lbd);
     solver_cancel_until(s, bt_level);
+    if (s->pFuncTrace)
+        s->pFuncTrace(s->pTraceData, vec_uint_data(s->temp_lits), vec_uint_size(s->temp_lits));
     cref = UNDEF;
     if (vec_uint_size(s->temp_lits) > 1) {
         cref = solver_clause_create(s, s->temp_lits, 1);
@@ -632,8 +634,11 @@ char solver_search(solver_t *s)
         if (confl_cref != UNDEF) {
             s->stats.n_conflicts++;
             s->stats.n_conflicts_all++;
-            if (solver_dlevel(s) == 0)
+            if (solver_dlevel(s) == 0) {
+                if (s->pFuncTrace)
+                    s->pFuncTrace(s->pTraceData, NULL, 0);
                 return SATOKO_UNSAT;
+            }
             /* Restart heuristic */
             b_queue_push(s->bq_trail, vec_uint_size(s->trail));
             if (solver_block_rst(s))
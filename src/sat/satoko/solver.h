@@ -106,6 +106,10 @@ struct solver_t_ {
     int     RunId;           
     int   (*pFuncStop)(int);  
 
+    /* Callback to log the proof (root clauses, learnt clauses, empty clause) */
+    void  (*pFuncTrace)(void *, unsigned *, int);
+    void   *pTraceData;
+
     struct satoko_stats stats;
     struct satoko_opts opts;
 };
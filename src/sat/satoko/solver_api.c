@@ -260,6 +260,8 @@ int satoko_add_clause(solver_t *s, int *lits, int size)
     unsigned cref;
 
     qsort((void *) lits, (size_t)size, sizeof(unsigned), stk_uint_compare);
+    if (s->pFuncTrace)
+        s->pFuncTrace(s->pTraceData, (unsigned *)lits, size);
     max_var = lit2var(lits[size - 1]);
     while (max_var >= vec_act_size(s->activity))
         satoko_add_variable(s, SATOKO_LIT_FALSE);
@@ -657,6 +659,12 @@ void satoko_set_runid(satoko_t *s, int id)
     s->RunId = id;
 }
 
+void satoko_set_trace_func(satoko_t *s, void (*fnct)(void *, unsigned *, int), void *data)
+{
+    s->pFuncTrace = fnct;
+    s->pTraceData = data;
+}
+
 int satoko_read_cex_varvalue(satoko_t *s, int ivar)
 {
     return satoko_var_polarity(s, ivar) == SATOKO_LIT_TRUE;
@@ -51,4 +51,223 @@ TEST(GiaTest, CanAddAnAndGate) {
   Gia_ManStop(aig_manager);
 }
 
+TEST(GiaTest, FaninDiffCoversObjectLimit) {
+  Gia_Man_t* aig_manager =  Gia_ManStart(100);
+  Gia_Obj_t* obj = Gia_ManConst0(aig_manager);
+
+  // the largest diff between an object and its fanin fits in the field
+  obj->iDiff0 = GIA_MAX_OBJS - 2;
+  EXPECT_EQ((int)obj->iDiff0, GIA_MAX_OBJS - 2);
+  // and is never confused with the "no fanin" marker
+  EXPECT_LT(GIA_MAX_OBJS - 2, GIA_NONE);
+  Gia_ManStop(aig_manager);
+}
+
+TEST(GiaTest, AppendObjGrowsUpToObjectLimit) {
+  // the storage doubles and stops one object short of the limit
+  int alloc = 100, steps = 0;
+  while (alloc < GIA_MAX_OBJS - 1) {
+    int next = Gia_ManObjAllocNext(alloc);
+    EXPECT_GT(next, alloc);
+    EXPECT_LE(next, GIA_MAX_OBJS - 1);
+    alloc = next;
+    steps++;
+  }
+  EXPECT_EQ(alloc, GIA_MAX_OBJS - 1);
+  EXPECT_LT(steps, 32);
+  EXPECT_EQ(Gia_ManObjAllocNext(GIA_MAX_OBJS / 2 - 1), GIA_MAX_OBJS - 2);
+  EXPECT_EQ(Gia_ManObjAllocNext(GIA_MAX_OBJS / 2), GIA_MAX_OBJS - 1);
+
+  // a manager started small grows while the objects are appended
+  Gia_Man_t* aig_manager =  Gia_ManStart(1);
+  int input1 = Gia_ManAppendCi(aig_manager);
+  int last = Gia_ManAppendCi(aig_manager);
+  for (int i = 0; i < (1 << 16); i++)
+    last = Gia_ManAppendAnd(aig_manager, input1, last);
+  EXPECT_EQ(Gia_ManObjNum(aig_manager), 3 + (1 << 16));
+  EXPECT_GE(aig_manager->nObjsAlloc, Gia_ManObjNum(aig_manager));
+  // the first fanin is the first CI, at the largest distance
+  Gia_Obj_t* obj = Gia_ManObj(aig_manager, Abc_Lit2Var(last));
+  EXPECT_TRUE(Gia_ObjIsAnd(obj));
+  EXPECT_EQ(Gia_ObjFaninId0p(aig_manager, obj), Abc_Lit2Var(input1));
+  EXPECT_EQ(Gia_ObjFaninId1p(aig_manager, obj), Abc_Lit2Var(last) - 1);
+  Gia_ManStop(aig_manager);
+}
+
+TEST(GiaTest, FaninRoundTripsNearObjectLimit) {
+  Gia_Man_t* aig_manager =  Gia_ManStart(100);
+  Gia_Obj_t* obj = Gia_ManConst0(aig_manager);
+  // the IDs of the last objects and their fanins are recovered from the diffs
+  int ids[3] = { GIA_MAX_OBJS - 2, GIA_MAX_OBJS - 3, GIA_MAX_OBJS / 2 };
+  for (int k = 0; k < 3; k++) {
+    int id = ids[k];
+    int fanins[3] = { 0, 1, id - 1 };
+    for (int f = 0; f < 3; f++) {
+      obj->fTerm = 0;
+      obj->iDiff0 = (unsigned)(id - fanins[f]);
+      obj->fCompl0 = 1;
+      obj->iDiff1 = (unsigned)(id - fanins[2 - f]);
+      obj->fCompl1 = 0;
+      EXPECT_TRUE(Gia_ObjIsAnd(obj));
+      EXPECT_FALSE(Gia_ObjIsCi(obj));
+      EXPECT_EQ(Gia_ObjFaninId0(obj, id), fanins[f]);
+      EXPECT_EQ(Gia_ObjFaninId1(obj, id), fanins[2 - f]);
+      EXPECT_EQ(Gia_ObjFaninLit0(obj, id), Abc_Var2Lit(fanins[f], 1));
+      EXPECT_EQ(Gia_ObjFaninLit1(obj, id), Abc_Var2Lit(fanins[2 - f], 0));
+    }
+  }
+  Gia_ManStop(aig_manager);
+}
+
+TEST(GiaTest, AppendObjQuitsAtObjectLimit) {
+  // the storage is not allocated; the limit is checked before it grows
+  EXPECT_EXIT({
+    Gia_Man_t* aig_manager = Gia_ManStart(100);
+    aig_manager->nObjs = aig_manager->nObjsAlloc = GIA_MAX_OBJS - 1;
+    Gia_ManAppendObj(aig_manager);
+  }, ::testing::ExitedWithCode(1), "");
+}
+
+TEST(GiaTest, CanLeaseAttributeColumn) {
+  Gia_Man_t* aig_manager =  Gia_ManStart(100);
+  int i, input1 = Gia_ManAppendCi(aig_manager);
+  int input2 = Gia_ManAppendCi(aig_manager);
+  Gia_ManAppendCo(aig_manager, Gia_ManAppendAnd(aig_manager, input1, input2));
+
+  int* refs = Gia_ManColLeaseInt(aig_manager, (char*)"refs", 0xFF);
+  ASSERT_TRUE(refs != NULL);
+  EXPECT_EQ((size_t)refs % 64, 0u);
+  EXPECT_GE(Gia_ManColSize(aig_manager, refs), Gia_ManObjNum(aig_manager));
+  for (i = 0; i < Gia_ManColSize(aig_manager, refs); i++)
+    EXPECT_EQ(refs[i], -1);
+  EXPECT_TRUE(Gia_ManColIsLeased(aig_manager, (char*)"refs"));
+  // the second lease of the same column fails
+  EXPECT_TRUE(Gia_ManColLeaseInt(aig_manager, (char*)"refs", 0) == NULL);
+  refs[3] = 7;
+  Gia_ManColRelease(aig_manager, refs);
+  EXPECT_FALSE(Gia_ManColIsLeased(aig_manager, (char*)"refs"));
+
+  // the contents are kept between the leases
+  refs = Gia_ManColLeaseInt(aig_manager, (char*)"refs", -1);
+  EXPECT_EQ(refs[3], 7);
+  Gia_ManColFill(aig_manager, refs, 0);
+  EXPECT_EQ(refs[3], 0);
+  Gia_ManColRelease(aig_manager, refs);
+
+  // the cross cut does not change the object values
+  Gia_ManFillValue(aig_manager);
+  EXPECT_EQ(Gia_ManCrossCut(aig_manager, 0), 3);
+  EXPECT_EQ(Gia_ManObj(aig_manager, 3)->Value, ~0u);
+  // neither does the frontier
+  Gia_Man_t* front = Gia_ManFront(aig_manager);
+  EXPECT_EQ(Gia_ManObjNum(front), Gia_ManObjNum(aig_manager));
+  EXPECT_EQ(Gia_ManObj(aig_manager, 3)->Value, ~0u);
+  EXPECT_FALSE(Gia_ManColIsLeased(aig_manager, (char*)"FrontRefs"));
+  Gia_ManStop(front);
+  Gia_ManStop(aig_manager);
+}
+
+TEST(GiaTest, ReorderKeepsFunction) {
+  Gia_Man_t* aig_manager =  Gia_ManStart(100);
+  int a = Gia_ManAppendCi(aig_manager);
+  int b = Gia_ManAppendCi(aig_manager);
+  int c = Gia_ManAppendCi(aig_manager);
+  int d = Gia_ManAppendCi(aig_manager);
+  int n1 = Gia_ManAppendAnd(aig_manager, a, b);
+  int n2 = Gia_ManAppendAnd(aig_manager, c, Abc_LitNot(d));
+  int n3 = Gia_ManAppendAnd(aig_manager, a, c);
+  int dangling = Gia_ManAppendAnd(aig_manager, b, d);
+  int n4 = Gia_ManAppendAnd(aig_manager, n1, Abc_LitNot(n2));
+  int n5 = Gia_ManAppendAnd(aig_manager, n4, n3);
+  Gia_ManAppendCo(aig_manager, Abc_LitNot(n5));
+  Gia_ManAppendCo(aig_manager, n2);
+
+  // the mapping: one LUT for each CO driver
+  aig_manager->vMapping = Vec_IntStart(Gia_ManObjNum(aig_manager));
+  Vec_IntWriteEntry(aig_manager->vMapping, Abc_Lit2Var(n5), Vec_IntSize(aig_manager->vMapping));
+  Vec_IntPush(aig_manager->vMapping, 4);
+  for (int lit : {a, b, c, d})
+    Vec_IntPush(aig_manager->vMapping, Abc_Lit2Var(lit));
+  Vec_IntPush(aig_manager->vMapping, Abc_Lit2Var(n5));
+  Vec_IntWriteEntry(aig_manager->vMapping, Abc_Lit2Var(n2), Vec_IntSize(aig_manager->vMapping));
+  Vec_IntPush(aig_manager->vMapping, 2);
+  Vec_IntPush(aig_manager->vMapping, Abc_Lit2Var(c));
+  Vec_IntPush(aig_manager->vMapping, Abc_Lit2Var(d));
+  Vec_IntPush(aig_manager->vMapping, Abc_Lit2Var(n2));
+
+  // the names of the nodes
+  aig_manager->vNamesNode = Vec_PtrStart(Gia_ManObjNum(aig_manager));
+  Vec_PtrWriteEntry(aig_manager->vNamesNode, Abc_Lit2Var(n1), Abc_UtilStrsav((char*)"n1"));
+  Vec_PtrWriteEntry(aig_manager->vNamesNode, Abc_Lit2Var(n2), Abc_UtilStrsav((char*)"n2"));
+  Vec_PtrWriteEntry(aig_manager->vNamesNode, Abc_Lit2Var(n3), Abc_UtilStrsav((char*)"n3"));
+  Vec_PtrWriteEntry(aig_manager->vNamesNode, Abc_Lit2Var(n5), Abc_UtilStrsav((char*)"n5"));
+  Vec_PtrWriteEntry(aig_manager->vNamesNode, Abc_Lit2Var(dangling), Abc_UtilStrsav((char*)"dangling"));
+
+  // the equivalence classes {n2, n3} and {n1, dangling}
+  aig_manager->pReprs = ABC_CALLOC(Gia_Rpr_t, Gia_ManObjNum(aig_manager));
+  for (int i = 0; i < Gia_ManObjNum(aig_manager); i++)
+    Gia_ObjSetRepr(aig_manager, i, GIA_VOID);
+  Gia_ObjSetRepr(aig_manager, Abc_Lit2Var(n3), Abc_Lit2Var(n2));
+  Gia_ObjSetRepr(aig_manager, Abc_Lit2Var(dangling), Abc_Lit2Var(n1));
+  aig_manager->pNexts = Gia_ManDeriveNexts(aig_manager);
+
+  for (int type = GIA_REORDER_DFS; type <= GIA_REORDER_LEVEL; type++) {
+    Gia_Man_t* reordered = Gia_ManReorder(aig_manager, type, 0);
+    ASSERT_TRUE(reordered != NULL);
+    // the dangling node is dropped
+    EXPECT_EQ(Gia_ManAndNum(reordered), Gia_ManAndNum(aig_manager) - 1);
+    EXPECT_EQ(Gia_ManCiNum(reordered), 4);
+    EXPECT_EQ(Gia_ManCoNum(reordered), 2);
+
+    Vec_Wrd_t* sims_pi = Vec_WrdStartRandom(Gia_ManCiNum(aig_manager));
+    Vec_Wrd_t* sims_old = Gia_ManSimPatSimOut(aig_manager, sims_pi, 1);
+    Vec_Wrd_t* sims_new = Gia_ManSimPatSimOut(reordered, sims_pi, 1);
+    EXPECT_TRUE(Vec_WrdEqual(sims_old, sims_new));
+    Vec_WrdFree(sims_pi);
+    Vec_WrdFree(sims_old);
+    Vec_WrdFree(sims_new);
+
+    // the names follow the nodes, the name of the dangling node is dropped
+    ASSERT_TRUE(reordered->vNamesNode != NULL);
+    int ids[4] = {-1, -1, -1, -1};
+    const char* names[4] = {"n1", "n2", "n3", "n5"};
+    for (int i = 0; i < Vec_PtrSize(reordered->vNamesNode); i++) {
+      char* name = (char*)Vec_PtrEntry(reordered->vNamesNode, i);
+      if (name == NULL)
+        continue;
+      EXPECT_STRNE(name, "dangling");
+      for (int k = 0; k < 4; k++)
+        if (!strcmp(name, names[k]))
+          ids[k] = i;
+    }
+    for (int k = 0; k < 4; k++)
+      ASSERT_GT(ids[k], 0);
+    EXPECT_EQ(Gia_ObjFaninId0p(reordered, Gia_ManCo(reordered, 0)), ids[3]);
+    EXPECT_EQ(Gia_ObjFaninId0p(reordered, Gia_ManCo(reordered, 1)), ids[1]);
+
+    // the mapping has the same LUTs over the same CIs
+    ASSERT_TRUE(Gia_ManHasMapping(reordered));
+    EXPECT_EQ(Gia_ManLutNum(reordered), 2);
+    ASSERT_TRUE(Gia_ObjIsLut(reordered, ids[3]));
+    ASSERT_TRUE(Gia_ObjIsLut(reordered, ids[1]));
+    EXPECT_EQ(Gia_ObjLutSize(reordered, ids[3]), 4);
+    EXPECT_EQ(Gia_ObjLutSize(reordered, ids[1]), 2);
+    for (int k = 0; k < 4; k++)
+      EXPECT_EQ(Gia_ObjLutFanins(reordered, ids[3])[k], Gia_ManCiIdToId(reordered, k));
+    EXPECT_EQ(Gia_ObjLutFanins(reordered, ids[1])[0], Gia_ManCiIdToId(reordered, 2));
+    EXPECT_EQ(Gia_ObjLutFanins(reordered, ids[1])[1], Gia_ManCiIdToId(reordered, 3));
+
+    // the class {n2, n3} keeps both members, the class {n1, dangling} is gone
+    ASSERT_TRUE(reordered->pReprs != NULL);
+    int repr = Abc_MinInt(ids[1], ids[2]), member = Abc_MaxInt(ids[1], ids[2]);
+    EXPECT_EQ(Gia_ObjRepr(reordered, member), repr);
+    EXPECT_EQ(Gia_ObjRepr(reordered, repr), GIA_VOID);
+    EXPECT_TRUE(Gia_ObjIsHead(reordered, repr));
+    EXPECT_EQ(Gia_ObjRepr(reordered, ids[0]), GIA_VOID);
+    EXPECT_FALSE(Gia_ObjIsHead(reordered, ids[0]));
+    Gia_ManStop(reordered);
+  }
+  Gia_ManStop(aig_manager);
+}
+
 ABC_NAMESPACE_IMPL_END